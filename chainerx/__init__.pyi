@@ -158,6 +158,10 @@ class Device:
     @property
     def name(self) -> str: ...
 
+    def get_memory_stats(self) -> tp.Dict[str, tp.Any]: ...
+
+    def reset_peak_memory_stats(self) -> None: ...
+
     def synchronize(self) -> None: ...
 
 
@@ -437,7 +441,9 @@ class ndarray:
 
 
 # chainerx_cc/chainerx/python/routines.cc
-def add(x1: tp.Any, x2: tp.Any) -> ndarray: ...
+def add(x1: tp.Any,
+        x2: tp.Any,
+        out: tp.Optional[ndarray]=None) -> ndarray: ...
 
 
 def amax(a: ndarray,
@@ -527,6 +533,9 @@ def conv_transpose(
 def copy(a: ndarray) -> ndarray: ...
 
 
+def copyto(dst: ndarray, src: ndarray) -> None: ...
+
+
 def diag(v: ndarray, k: int=..., device: tp.Optional[Device]=None) -> ndarray: ...
 
 
@@ -536,10 +545,12 @@ def diagflat(
         device: tp.Optional[Device]=None) -> ndarray: ...
 
 
-def divide(x1: tp.Any, x2: tp.Any) -> ndarray: ...
+def divide(x1: tp.Any,
+           x2: tp.Any,
+           out: tp.Optional[ndarray]=None) -> ndarray: ...
 
 
-def dot(a: ndarray, b: ndarray) -> ndarray: ...
+def dot(a: ndarray, b: ndarray, out: tp.Optional[ndarray]=None) -> ndarray: ...
 
 
 def empty(
@@ -554,7 +565,7 @@ def empty_like(a: ndarray, device: tp.Optional[Device]=None) -> ndarray: ...
 def equal(x1: ndarray, x2: ndarray) -> ndarray: ...
 
 
-def exp(x: ndarray) -> ndarray: ...
+def exp(x: ndarray, out: tp.Optional[ndarray]=None) -> ndarray: ...
 
 
 def eye(N: int,
@@ -638,7 +649,7 @@ def linspace(
         device: tp.Optional[Device]=None) -> ndarray: ...
 
 
-def log(x: ndarray) -> ndarray: ...
+def log(x: ndarray, out: tp.Optional[ndarray]=None) -> ndarray: ...
 
 
 def log_softmax(
@@ -655,6 +666,9 @@ def logsumexp(
         keepdims: bool=...) -> ndarray: ...
 
 
+def matmul(a: ndarray, b: ndarray) -> ndarray: ...
+
+
 def max_pool(
         x: ndarray,
         ksize: tp.Any,
@@ -669,7 +683,9 @@ def maximum(x1: tp.Any, x2: tp.Any) -> ndarray: ...
 def minimum(x1: tp.Any, x2: tp.Any) -> ndarray: ...
 
 
-def multiply(x1: tp.Any, x2: tp.Any) -> ndarray: ...
+def multiply(x1: tp.Any,
+             x2: tp.Any,
+             out: tp.Optional[ndarray]=None) -> ndarray: ...
 
 
 def negative(x: ndarray) -> ndarray: ...
@@ -708,7 +724,7 @@ def split(
         axis: int=...) -> tp.List[ndarray]: ...
 
 
-def sqrt(x: ndarray) -> ndarray: ...
+def sqrt(x: ndarray, out: tp.Optional[ndarray]=None) -> ndarray: ...
 
 
 def squeeze(
@@ -719,18 +735,21 @@ def squeeze(
 def stack(arrays: tp.List[ndarray], axis: int=...) -> ndarray: ...
 
 
-def subtract(x1: tp.Any, x2: tp.Any) -> ndarray: ...
+def subtract(x1: tp.Any,
+             x2: tp.Any,
+             out: tp.Optional[ndarray]=None) -> ndarray: ...
 
 
 def sum(a: ndarray,
         axis: tp.Optional[tp.Union[int, tp.List[int]]]=None,
-        keepdims: bool=...) -> ndarray: ...
+        keepdims: bool=...,
+        out: tp.Optional[ndarray]=None) -> ndarray: ...
 
 
 def take(a: ndarray, indices: ndarray, axis: tp.Optional[int]) -> ndarray: ...
 
 
-def tanh(x: ndarray) -> ndarray: ...
+def tanh(x: ndarray, out: tp.Optional[ndarray]=None) -> ndarray: ...
 
 
 def to_numpy(array: ndarray, copy: bool=...) -> numpy.ndarray: ...
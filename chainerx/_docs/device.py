@@ -15,6 +15,43 @@ def _set_docs_device():
         """Synchronizes the device.
 """)
 
+    _docs.set_doc(
+        Device.get_memory_stats,
+        """get_memory_stats()
+Returns the statistics of the memory pool of the device.
+
+The returned dictionary has the following keys. Sizes are those of the blocks
+managed by the pool, i.e. requested sizes rounded up to its allocation unit.
+
+* ``bytes_in_use``: Bytes of the blocks allocated and not freed yet.
+* ``peak_bytes_in_use``: Maximum of ``bytes_in_use`` since the device was
+  created or :meth:`reset_peak_memory_stats` was last called.
+* ``bytes_cached``: Bytes of the free blocks cached by the pool for reuse.
+* ``malloc_count``: Number of allocations.
+* ``hit_count``: Number of allocations served from cached blocks.
+* ``split_count``, ``merge_count``: Number of cached blocks split to serve
+  smaller allocations, and of adjacent free blocks merged. Always zero on the
+  native device, whose pool does not split blocks.
+* ``size_classes``: Dictionary from the largest block size of each size class
+  to a dictionary of ``malloc_count``, ``hit_count``, ``bytes_in_use`` and
+  ``bytes_cached`` of the class.
+
+Returns:
+    dict: Memory statistics.
+
+Raises:
+    ~chainerx.NotImplementedError: If the device does not have a memory pool.
+""")
+
+    _docs.set_doc(
+        Device.reset_peak_memory_stats,
+        """reset_peak_memory_stats()
+Resets ``peak_bytes_in_use`` of the memory statistics to the current bytes in
+use.
+
+.. seealso:: :meth:`get_memory_stats`
+""")
+
     _docs.set_doc(
         Device.name,
         """Device name.
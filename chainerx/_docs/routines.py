@@ -476,6 +476,33 @@ Note:
 .. seealso:: :func:`numpy.dot`
 """)
 
+    _docs.set_doc(
+        chainerx.matmul,
+        """matmul(a, b)
+Returns the matrix product of two arrays.
+
+Arrays with more than two axes are treated as stacks of matrices residing in
+the last two axes, and the leading axes are broadcast. A 1-D ``a`` (or ``b``)
+is promoted to a matrix by prepending (or appending) an axis, which is removed
+from the result.
+
+Args:
+    a (~chainerx.ndarray): The left argument.
+    b (~chainerx.ndarray): The right argument.
+
+Returns:
+    :class:`~chainerx.ndarray`: Output array.
+
+Note:
+    Scalar (0-D) arrays are not allowed.
+
+Note:
+    During backpropagation, this function propagates the gradient of the
+    output array to input arrays ``a`` and ``b``.
+
+.. seealso:: :func:`numpy.matmul`
+""")
+
 
 def _docs_logic():
     _docs.set_doc(
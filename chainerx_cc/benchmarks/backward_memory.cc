@@ -0,0 +1,77 @@
+// Reports the peak memory usage of Backward() on chains of elementwise routines, including the memory held by the forward activations,
+// and its ratio to the latter.
+//
+// Usage: benchmark_backward_memory
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/backward.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/shape.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+int main() {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::Device& device = ctx.GetNativeBackend().GetDevice(0);
+
+    std::printf("%-48s %15s %15s %9s %12s\n", "case", "activations", "backward peak", "ratio", "time");
+
+    chx::Shape shape{256, 1024};
+
+    // Tanh retains its output, which is released as soon as its backward function is called. The affine chain retains no arrays.
+    auto tanh_chain = [](const chx::Array& x) { return chx::Tanh(x) * 0.5f + x; };
+    auto affine_chain = [](const chx::Array& x) { return x * 0.5f + 1.0f; };
+
+    for (int depth : std::vector<int>{8, 32}) {
+        for (bool tanh : {true, false}) {
+            for (chx::DoubleBackpropOption double_backprop : {chx::DoubleBackpropOption::kDisable, chx::DoubleBackpropOption::kEnable}) {
+                size_t activation_bytes{0};
+                size_t peak_bytes{0};
+                double seconds = chx::benchmark::Measure(
+                        [&]() {
+                            chx::Array x = chx::Full(shape, 0.5f, device).RequireGrad();
+                            size_t bytes_before_forward = device.GetMemoryStats().bytes_in_use;
+                            chx::Array y = x;
+                            for (int i = 0; i < depth; ++i) {
+                                y = tanh ? tanh_chain(y) : affine_chain(y);
+                            }
+                            size_t bytes_before_backward = device.GetMemoryStats().bytes_in_use;
+                            activation_bytes = bytes_before_backward - bytes_before_forward;
+
+                            device.ResetPeakMemoryStats();
+                            chx::Backward(y, nonstd::nullopt, double_backprop);
+                            peak_bytes = device.GetMemoryStats().peak_bytes_in_use - bytes_before_forward;
+                        },
+                        1,
+                        5);
+
+                std::string name = std::string{tanh ? "tanh" : "affine"} + " depth=" + std::to_string(depth) +
+                                   (double_backprop == chx::DoubleBackpropOption::kEnable ? " double_backprop" : "");
+                std::printf(
+                        "%-48s %12.1f MB %12.1f MB %9.2f %9.3f ms\n",
+                        name.c_str(),
+                        activation_bytes / 1e6,
+                        peak_bytes / 1e6,
+                        static_cast<double>(peak_bytes) / activation_bytes,
+                        seconds * 1e3);
+            }
+        }
+    }
+    return 0;
+}
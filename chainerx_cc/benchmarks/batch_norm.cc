@@ -0,0 +1,67 @@
+// Compares the generic batch normalization, composed of array operations, against the native one, for the forward and the backward.
+//
+// Usage: benchmark_batch_norm [num_threads]
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "chainerx/array.h"
+#include "chainerx/axes.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/shape.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+int main(int argc, char** argv) {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::native::NativeBackend& backend = ctx.GetNativeBackend();
+    chx::Device& device = backend.GetDevice(0);
+
+    if (argc > 1) {
+        backend.SetNumThreads(std::atoi(argv[1]));
+    }
+    std::printf("%d threads\n", backend.GetNumThreads());
+    std::printf("%-48s %15s %15s %9s\n", "case", "generic", "native", "speedup");
+
+    chx::Axes axis{0, 2, 3};
+    for (const chx::Shape& x_shape : std::vector<chx::Shape>{{32, 64, 56, 56}, {32, 256, 14, 14}, {256, 1024, 1, 1}}) {
+        chx::Shape reduced_shape{1, x_shape[1], 1, 1};
+        chx::Array x = chx::Ones(x_shape, chx::Dtype::kFloat32, device);
+        chx::Array gout = chx::Ones(x_shape, chx::Dtype::kFloat32, device);
+        chx::Array gamma = chx::Ones(reduced_shape, chx::Dtype::kFloat32, device);
+        chx::Array beta = chx::Zeros(reduced_shape, chx::Dtype::kFloat32, device);
+        chx::Array running_mean = chx::Zeros(reduced_shape, chx::Dtype::kFloat32, device);
+        chx::Array running_var = chx::Ones(reduced_shape, chx::Dtype::kFloat32, device);
+
+        double generic = chx::benchmark::Measure(
+                [&]() {
+                    chx::GenericBatchNormForwardBackward fb{running_mean, running_var, 2e-5, 0.9, axis};
+                    fb.Forward(x, gamma, beta);
+                    fb.Backward(gout);
+                },
+                1,
+                5);
+        double native = chx::benchmark::Measure(
+                [&]() {
+                    std::unique_ptr<chx::BatchNormForwardBackward> fb =
+                            device.GetBatchNormForwardBackward(running_mean, running_var, 2e-5, 0.9, axis);
+                    fb->Forward(x, gamma, beta);
+                    fb->Backward(gout);
+                },
+                1,
+                5);
+        chx::benchmark::PrintComparison("batch_norm x=" + x_shape.ToString(), generic, native);
+    }
+    return 0;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace chainerx {
+namespace benchmark {
+
+// Calls `func` `n_warmup` times, then `n_repeat` times while measuring, and returns the median of the measured times in seconds.
+template <typename Func>
+double Measure(Func&& func, int n_warmup = 2, int n_repeat = 10) {
+    for (int i = 0; i < n_warmup; ++i) {
+        func();
+    }
+    std::vector<double> times;
+    times.reserve(n_repeat);
+    for (int i = 0; i < n_repeat; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        func();
+        auto end = std::chrono::steady_clock::now();
+        times.emplace_back(std::chrono::duration<double>(end - start).count());
+    }
+    std::nth_element(times.begin(), times.begin() + times.size() / 2, times.end());
+    return times[times.size() / 2];
+}
+
+// Prints a row of the form "<name> <baseline> <target> <speedup>", with times in milliseconds.
+inline void PrintComparison(const std::string& name, double baseline_seconds, double target_seconds) {
+    std::printf(
+            "%-48s %12.3f ms %12.3f ms %8.2fx\n", name.c_str(), baseline_seconds * 1e3, target_seconds * 1e3, baseline_seconds / target_seconds);
+}
+
+}  // namespace benchmark
+}  // namespace chainerx
@@ -0,0 +1,71 @@
+// Compares the time of a training iteration of a small MLP run eagerly against that replayed by CapturedStep.
+//
+// Each iteration computes the forward pass and the backward pass, and updates the parameters by SGD. The arrays are small, so that the
+// time is dominated by dispatching routines and constructing and traversing the graph.
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "chainerx/array.h"
+#include "chainerx/backprop_mode.h"
+#include "chainerx/backward.h"
+#include "chainerx/captured_step.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/linalg.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/shape.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+int main() {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::Device& device = ctx.GetNativeBackend().GetDevice(0);
+
+    std::printf("%-48s %15s %15s %9s\n", "case", "eager", "replay", "speedup");
+
+    for (int64_t units : std::vector<int64_t>{16, 256}) {
+        const int64_t batch_size = 32;
+        const int layers = 4;
+        std::vector<chx::Array> params;
+        for (int i = 0; i < layers; ++i) {
+            params.emplace_back(chx::Full({units, units}, 0.01f, device).RequireGrad());
+            params.emplace_back(chx::Zeros({units}, chx::Dtype::kFloat32, device).RequireGrad());
+        }
+
+        chx::CapturedStep::StepFunction step = [&params](const std::vector<chx::Array>& inputs) {
+            for (const chx::Array& param : params) {
+                param.ClearGrad();
+            }
+            chx::Array h = inputs[0];
+            for (size_t i = 0; i < params.size(); i += 2) {
+                h = chx::Tanh(chx::Dot(h, params[i]) + params[i + 1]);
+            }
+            chx::Array loss = chx::Sum(h);
+            chx::Backward(loss);
+
+            chx::NoBackpropModeScope scope{};
+            for (const chx::Array& param : params) {
+                param.AsGradStopped() -= 0.01f * *param.GetGrad();
+            }
+            return std::vector<chx::Array>{loss};
+        };
+        chx::CapturedStep captured_step{step};
+
+        chx::Array x = chx::Full({batch_size, units}, 0.5f, device);
+        double eager = chx::benchmark::Measure([&]() { step({x}); });
+        double replay = chx::benchmark::Measure([&]() { captured_step.Run({x}); });
+        chx::benchmark::PrintComparison(
+                "units=" + std::to_string(units) + " layers=" + std::to_string(layers) + " ops=" + std::to_string(captured_step.op_count()),
+                eager,
+                replay);
+    }
+    return 0;
+}
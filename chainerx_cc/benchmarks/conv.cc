@@ -0,0 +1,80 @@
+// Compares the native convolution through the materialized Im2Col column matrix against the implicit GEMM convolution.
+//
+// Usage: benchmark_conv [num_threads]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/axes.h"
+#include "chainerx/constant.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/im2col.h"
+#include "chainerx/native/implicit_gemm_conv.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/tensor_dot.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/shape.h"
+#include "chainerx/stack_vector.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+namespace {
+
+struct ConvCase {
+    chx::Shape x_shape;
+    chx::Shape w_shape;
+    int64_t stride;
+    int64_t pad;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::native::NativeBackend& backend = ctx.GetNativeBackend();
+    chx::Device& device = backend.GetDevice(0);
+
+    if (argc > 1) {
+        backend.SetNumThreads(std::atoi(argv[1]));
+    }
+    std::printf("%d threads\n", backend.GetNumThreads());
+    std::printf("%-48s %15s %15s %9s\n", "case", "Im2Col", "implicit GEMM", "speedup");
+
+    for (const ConvCase& c : std::vector<ConvCase>{{{8, 64, 56, 56}, {64, 64, 3, 3}, 1, 1},
+                                                   {{8, 128, 28, 28}, {128, 128, 3, 3}, 1, 1},
+                                                   {{8, 256, 14, 14}, {256, 256, 3, 3}, 1, 1},
+                                                   {{8, 3, 224, 224}, {64, 3, 7, 7}, 2, 3}}) {
+        chx::Array x = chx::Ones(c.x_shape, chx::Dtype::kFloat32, device);
+        chx::Array w = chx::Ones(c.w_shape, chx::Dtype::kFloat32, device);
+        chx::StackVector<int64_t, chx::kMaxNdim> kernel_size{c.w_shape.begin() + 2, c.w_shape.end()};
+        chx::StackVector<int64_t, chx::kMaxNdim> stride{c.stride, c.stride};
+        chx::StackVector<int64_t, chx::kMaxNdim> pad{c.pad, c.pad};
+
+        double im2col = chx::benchmark::Measure(
+                [&]() {
+                    chx::Array col = chx::native::native_internal::Im2Col(x, kernel_size, stride, pad, false, 0);
+                    chx::native::TensorDot(col, w, {1, 2, 3}, {1, 2, 3}, chx::Dtype::kFloat32).Transpose({0, 3, 1, 2});
+                },
+                1,
+                3);
+        double implicit_gemm = chx::benchmark::Measure(
+                [&]() { chx::native::native_internal::ImplicitGemmConv(x, w, nonstd::nullopt, stride, pad, false, chx::Dtype::kFloat32); },
+                1,
+                3);
+
+        std::string name = "conv x=" + c.x_shape.ToString() + " w=" + c.w_shape.ToString();
+        chx::benchmark::PrintComparison(name, im2col, implicit_gemm);
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Compares the throughput of Malloc/Free of the CUDA memory pool from multiple threads, without and with the per-thread caches.
+//
+// The pool logic does not depend on the device, so that the memory is allocated by a host allocator standing in for the CUDA allocator.
+//
+// Usage: benchmark_cuda_memory_pool [max_num_threads]
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chainerx/cuda/memory_pool.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+namespace {
+
+class HostAllocator : public chx::cuda::Allocator {
+public:
+    chx::cuda::MallocStatus Malloc(void** ptr, size_t bytesize) override {
+        *ptr = new uint8_t[bytesize];
+        return chx::cuda::MallocStatus::kSuccess;
+    }
+    void Free(void* ptr) noexcept override { delete[] static_cast<uint8_t*>(ptr); }
+};
+
+// Each thread repeatedly allocates a few arrays of the sizes typical of a training step and frees them in a different order.
+void RunThreads(chx::cuda::MemoryPool& memory_pool, int num_threads) {
+    static constexpr int kRepeat = 2000;
+    static constexpr std::array<size_t, 6> kSizes{512, 4096, 100000, 512, 65536, 2048};
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&memory_pool]() {
+            std::array<void*, kSizes.size()> ptrs{};
+            for (int i = 0; i < kRepeat; ++i) {
+                for (size_t j = 0; j < kSizes.size(); ++j) {
+                    ptrs[j] = memory_pool.Malloc(kSizes[j]);
+                }
+                for (size_t j = 0; j < kSizes.size(); ++j) {
+                    memory_pool.Free(ptrs[(j * 5 + i) % kSizes.size()]);
+                }
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    int max_num_threads = argc > 1 ? std::atoi(argv[1]) : 8;
+    std::printf("%-48s %15s %15s %9s\n", "case", "global bins", "thread cache", "speedup");
+
+    for (int num_threads = 1; num_threads <= max_num_threads; num_threads *= 2) {
+        chx::cuda::MemoryPool pool_without_cache{0, std::make_unique<HostAllocator>(), 0};
+        chx::cuda::MemoryPool pool_with_cache{0, std::make_unique<HostAllocator>()};
+        double without_cache = chx::benchmark::Measure([&]() { RunThreads(pool_without_cache, num_threads); }, 1, 5);
+        double with_cache = chx::benchmark::Measure([&]() { RunThreads(pool_with_cache, num_threads); }, 1, 5);
+        chx::benchmark::PrintComparison("malloc/free threads=" + std::to_string(num_threads), without_cache, with_cache);
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+// Compares NativeDevice::Dot, which uses BLAS for floating point dtypes when built with CHAINERX_ENABLE_BLAS, against the in-tree GEMM.
+// Also compares the fused float16 Dot against computing it in float32 through staging copies of the operands and the output.
+//
+// Usage: benchmark_dot [num_threads]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "chainerx/array.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/gemm.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+int main(int argc, char** argv) {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::native::NativeBackend& backend = ctx.GetNativeBackend();
+    chx::Device& device = backend.GetDevice(0);
+
+    if (argc > 1) {
+        backend.SetNumThreads(std::atoi(argv[1]));
+    }
+    std::printf("%d threads\n", backend.GetNumThreads());
+    std::printf("%-48s %15s %15s %9s\n", "case", "Dot", "in-tree GEMM", "speedup");
+
+    for (chx::Dtype dtype : {chx::Dtype::kFloat32, chx::Dtype::kFloat64, chx::Dtype::kInt32}) {
+        for (int64_t size : std::vector<int64_t>{64, 256, 1024}) {
+            chx::Array a = chx::Ones({size, size}, dtype, device);
+            chx::Array b = chx::Ones({size, size}, dtype, device);
+            chx::Array b_t = chx::Ones({size, size}, dtype, device).Transpose();
+            chx::Array out = chx::Empty({size, size}, dtype, device);
+
+            auto compare = [&](const std::string& name, const chx::Array& rhs) {
+                double dot = chx::benchmark::Measure([&]() { device.Dot(a, rhs, out); });
+                double gemm = chx::benchmark::Measure([&]() { chx::native::native_internal::Gemm(a, rhs, out); });
+                chx::benchmark::PrintComparison(name + " " + chx::GetDtypeName(dtype) + " size=" + std::to_string(size), dot, gemm);
+            };
+
+            compare("a @ b", b);
+            compare("a @ b.T", b_t);
+        }
+    }
+
+    std::printf("\n%-48s %15s %15s %9s\n", "case", "float32 staging", "fused", "speedup");
+    for (int64_t size : std::vector<int64_t>{64, 256, 1024}) {
+        chx::Array a = chx::Ones({size, size}, chx::Dtype::kFloat16, device);
+        chx::Array b = chx::Ones({size, size}, chx::Dtype::kFloat16, device);
+        chx::Array out = chx::Empty({size, size}, chx::Dtype::kFloat16, device);
+
+        double staging = chx::benchmark::Measure([&]() {
+            chx::Array a32 = a.AsType(chx::Dtype::kFloat32, false);
+            chx::Array b32 = b.AsType(chx::Dtype::kFloat32, false);
+            chx::Array acc = out.AsType(chx::Dtype::kFloat32);
+            device.Dot(a32, b32, acc);
+            out.Fill(0);
+            out += acc.AsType(chx::Dtype::kFloat16);
+        });
+        double fused = chx::benchmark::Measure([&]() { device.Dot(a, b, out); });
+        chx::benchmark::PrintComparison("a @ b float16 size=" + std::to_string(size), staging, fused);
+    }
+    return 0;
+}
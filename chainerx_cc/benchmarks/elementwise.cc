@@ -0,0 +1,61 @@
+// Compares native elementwise kernels running on a single thread against the intra-op thread pool.
+//
+// Usage: benchmark_elementwise [num_threads]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "chainerx/array.h"
+#include "chainerx/array_index.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/shape.h"
+#include "chainerx/slice.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+int main(int argc, char** argv) {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::native::NativeBackend& backend = ctx.GetNativeBackend();
+    chx::Device& device = backend.GetDevice(0);
+
+    int num_threads = argc > 1 ? std::atoi(argv[1]) : backend.GetNumThreads();
+
+    std::printf("%-48s %15s %15s %9s\n", "case", "1 thread", (std::to_string(num_threads) + " threads").c_str(), "speedup");
+
+    for (int64_t size : std::vector<int64_t>{1 << 12, 1 << 16, 1 << 20, 1 << 24}) {
+        chx::Shape shape{size};
+        chx::Array x1 = chx::Arange(0, size, chx::Dtype::kFloat32, device).Reshape(shape) / static_cast<float>(size);
+        chx::Array x2 = chx::OnesLike(x1, device);
+        chx::Array x1_s = chx::Arange(0, 2 * size, chx::Dtype::kFloat32, device).At({chx::Slice{0, 2 * size, 2}});
+        chx::Array x2_s = chx::OnesLike(x1_s, device);
+        chx::Array x1_t = x1.Reshape({size / 64, 64}).Transpose();
+        chx::Array out = chx::EmptyLike(x1, device);
+        chx::Array out_t = chx::Empty({64, size / 64}, chx::Dtype::kFloat32, device);
+
+        auto compare = [&](const std::string& name, auto&& func) {
+            backend.SetNumThreads(1);
+            double serial = chx::benchmark::Measure(func);
+            backend.SetNumThreads(num_threads);
+            double parallel = chx::benchmark::Measure(func);
+            chx::benchmark::PrintComparison(name + " size=" + std::to_string(size), serial, parallel);
+        };
+
+        compare("Add float32", [&]() { device.Add(x1, x2, out); });
+        compare("Add float32 (strided)", [&]() { device.Add(x1_s, x2_s, out); });
+        compare("Exp float32", [&]() { device.Exp(x1, out); });
+        compare("Tanh float32", [&]() { device.Tanh(x1, out); });
+        compare("Copy float32 (transposed)", [&]() { device.Copy(x1_t, out_t); });
+        compare("AsType float32->float64", [&]() { x1.AsType(chx::Dtype::kFloat64); });
+    }
+    return 0;
+}
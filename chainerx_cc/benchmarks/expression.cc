@@ -0,0 +1,57 @@
+// Compares elementwise expressions written with Array operators against the same expressions computed by native::expr.
+//
+// Usage: benchmark_expression [num_threads]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "chainerx/array.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/expression.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/shape.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+namespace expr = chainerx::native::expr;
+
+int main(int argc, char** argv) {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::native::NativeBackend& backend = ctx.GetNativeBackend();
+    chx::Device& device = backend.GetDevice(0);
+
+    int num_threads = argc > 1 ? std::atoi(argv[1]) : backend.GetNumThreads();
+    backend.SetNumThreads(num_threads);
+
+    std::printf("%-48s %15s %15s %9s\n", "case", "operators", "expr", "speedup");
+
+    for (int64_t size : std::vector<int64_t>{1 << 12, 1 << 16, 1 << 20, 1 << 22}) {
+        chx::Shape shape{size / 256, 256};
+        chx::Array p = chx::Arange(0, size, chx::Dtype::kFloat32, device).Reshape(shape) / static_cast<float>(size);
+        chx::Array grad = chx::OnesLike(p, device);
+        chx::Array mean = chx::Arange(0, 256, chx::Dtype::kFloat32, device) / 256;
+        chx::Array inv_std = chx::FullLike(mean, 2, device);
+
+        auto compare = [&](const std::string& name, auto&& baseline, auto&& target) {
+            double baseline_time = chx::benchmark::Measure(baseline);
+            double target_time = chx::benchmark::Measure(target);
+            chx::benchmark::PrintComparison(name + " size=" + std::to_string(size), baseline_time, target_time);
+        };
+
+        compare("p -= grad * lr",
+                [&]() { p -= grad * 0.01f; },
+                [&]() { expr::Assign(p, expr::Ref(p) - expr::Ref(grad) * 0.01f); });
+        compare("(x - mean) * inv_std",
+                [&]() { (p - mean) * inv_std; },
+                [&]() { expr::Evaluate((expr::Ref(p) - expr::Ref(mean)) * expr::Ref(inv_std)); });
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+// Compares chains of elementwise routines executed eagerly against the same chains within a native::FusionScope.
+//
+// Usage: benchmark_fusion [num_threads]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "chainerx/array.h"
+#include "chainerx/axes.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/fusion.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/shape.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+int main(int argc, char** argv) {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::native::NativeBackend& backend = ctx.GetNativeBackend();
+    chx::Device& device = backend.GetDevice(0);
+
+    int num_threads = argc > 1 ? std::atoi(argv[1]) : backend.GetNumThreads();
+    backend.SetNumThreads(num_threads);
+
+    std::printf("%-48s %15s %15s %9s\n", "case", "eager", "fused", "speedup");
+
+    for (int64_t batch_size : std::vector<int64_t>{16, 256, 4096}) {
+        chx::Shape shape{batch_size, 1000};
+        chx::Array x = chx::Arange(0, shape.GetTotalSize(), chx::Dtype::kFloat32, device).Reshape(shape) / static_cast<float>(1 << 20);
+        chx::Array t = chx::OnesLike(x, device) / 1000;
+        chx::Array b = chx::Arange(0, 1000, chx::Dtype::kFloat32, device) / 1000;
+
+        // The result is kept so that it is computed within the scope, as it would be if used afterwards.
+        auto compare = [&](const std::string& name, auto&& func) {
+            chx::Array y{};
+            double eager = chx::benchmark::Measure([&func, &y]() { y = func(); });
+            double fused = chx::benchmark::Measure([&func, &y]() {
+                chx::native::FusionScope scope{};
+                y = func();
+            });
+            chx::benchmark::PrintComparison(name + " batch=" + std::to_string(batch_size), eager, fused);
+        };
+
+        compare("tanh(x + b) * 2 - 1", [&]() { return chx::Tanh(x + b) * 2 - 1; });
+        compare("cross entropy -sum(log(x) * t) / n", [&]() { return -chx::Sum(chx::Log(x + 1) * t) / batch_size; });
+        compare("softmax exp(x) / sum(exp(x), axis=1)", [&]() {
+            chx::Array e = chx::Exp(x);
+            return e / chx::Sum(e, chx::Axes{1}, true);
+        });
+    }
+    return 0;
+}
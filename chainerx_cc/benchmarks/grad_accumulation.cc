@@ -0,0 +1,97 @@
+// Measures backprop through a weight shared by many steps, as in unrolled RNNs, whose gradient is accumulated in place by the backward
+// engine.
+//
+// The first columns compare the accumulation of the partial gradients of the steps by allocating a new sum for each step, as the engine
+// used to do, against the accumulation in place. The last columns show the time and the number of allocations of Backward() itself.
+//
+// Usage: benchmark_grad_accumulation
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "chainerx/array.h"
+#include "chainerx/backward.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/shape.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+int main() {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::Device& device = ctx.GetNativeBackend().GetDevice(0);
+
+    std::printf("%-48s %15s %15s %9s %15s %15s\n", "case", "out-of-place", "in-place", "speedup", "backward", "mallocs");
+
+    for (int64_t size : std::vector<int64_t>{1000, 1000000}) {
+        for (int steps : std::vector<int>{10, 100}) {
+            chx::Shape shape{size};
+            chx::Array w = chx::Full(shape, 0.5f, device).RequireGrad();
+            std::vector<chx::Array> partials;
+            std::vector<chx::Array> xs;
+            for (int t = 0; t < steps; ++t) {
+                partials.emplace_back(chx::Full(shape, static_cast<float>(t), device));
+                xs.emplace_back(chx::Full(shape, 1.0f / (t + 1), device));
+            }
+
+            chx::Array g{};
+            double out_of_place = chx::benchmark::Measure([&]() {
+                g = partials[0].Copy();
+                for (int t = 1; t < steps; ++t) {
+                    g = g + partials[t];
+                }
+            });
+            double in_place = chx::benchmark::Measure([&]() {
+                g = partials[0].Copy();
+                for (int t = 1; t < steps; ++t) {
+                    chx::Add(g, partials[t], g);
+                }
+            });
+
+            chx::Array y{};
+            auto forward = [&]() {
+                y = w * xs[0];
+                for (int t = 1; t < steps; ++t) {
+                    y = y + w * xs[t];
+                }
+            };
+            // The graph is consumed by Backward(), so that only Backward() is timed after each forward computation.
+            std::vector<double> backward_times;
+            int64_t malloc_count{0};
+            for (int i = 0; i < 5; ++i) {
+                forward();
+                w.ClearGrad();
+                int64_t malloc_count_before = device.GetMemoryStats().malloc_count;
+                auto start = std::chrono::steady_clock::now();
+                chx::Backward(y);
+                auto end = std::chrono::steady_clock::now();
+                backward_times.emplace_back(std::chrono::duration<double>(end - start).count());
+                malloc_count = device.GetMemoryStats().malloc_count - malloc_count_before;
+            }
+            std::sort(backward_times.begin(), backward_times.end());
+            double backward = backward_times[backward_times.size() / 2];
+
+            std::string name = "size=" + std::to_string(size) + " steps=" + std::to_string(steps);
+            std::printf(
+                    "%-48s %12.3f ms %12.3f ms %8.2fx %12.3f ms %15lld\n",
+                    name.c_str(),
+                    out_of_place * 1e3,
+                    in_place * 1e3,
+                    out_of_place / in_place,
+                    backward * 1e3,
+                    static_cast<long long>(malloc_count));
+        }
+    }
+    return 0;
+}
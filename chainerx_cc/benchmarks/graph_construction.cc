@@ -0,0 +1,120 @@
+// Measures the per-op overhead of constructing the computational graph on scalar-sized arrays, for which the bookkeeping of the graph
+// costs more than the arithmetic.
+//
+// The same chain of routines is run on arrays that do not require gradients, which builds no graph, and on arrays that do. The
+// difference of the two is reported per op, with the number of heap allocations per op. The time of Backward() per op is also reported.
+//
+// Usage: benchmark_graph_construction
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+#include "chainerx/array.h"
+#include "chainerx/backprop_mode.h"
+#include "chainerx/backward.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/shape.h"
+
+#include "benchmark.h"
+
+namespace {
+
+std::atomic<int64_t> g_allocation_count{0};
+
+}  // namespace
+
+// Counts the heap allocations of the library as well, since the replacement is global.
+void* operator new(size_t size) {
+    ++g_allocation_count;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, size_t /*size*/) noexcept { std::free(ptr); }
+
+namespace chx = chainerx;
+
+int main() {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::Device& device = ctx.GetNativeBackend().GetDevice(0);
+
+    // Each step calls 3 differentiable routines.
+    constexpr int kOpsPerStep = 3;
+
+    std::printf("%-32s %15s %15s %15s %15s %15s\n", "case", "no graph", "graph", "overhead", "allocations", "backward");
+
+    for (int steps : std::vector<int>{10, 100}) {
+        const int op_count = kOpsPerStep * steps;
+        chx::Array x = chx::Full(chx::Shape{}, 0.5f, device);
+        chx::Array w = chx::Full(chx::Shape{}, 0.9f, device);
+        chx::Array b = chx::Full(chx::Shape{}, 0.1f, device);
+
+        chx::Array y{};
+        auto forward = [&]() {
+            y = x;
+            for (int i = 0; i < steps; ++i) {
+                y = chx::Tanh(y * w + b);
+            }
+        };
+
+        double no_graph = chx::benchmark::Measure(forward);
+
+        x.RequireGrad();
+        w.RequireGrad();
+        b.RequireGrad();
+        double graph = chx::benchmark::Measure(forward);
+
+        int64_t allocation_count_before = g_allocation_count;
+        forward();
+        int64_t graph_allocation_count = g_allocation_count - allocation_count_before;
+        allocation_count_before = g_allocation_count;
+        {
+            chx::NoBackpropModeScope scope{};
+            forward();
+        }
+        int64_t no_graph_allocation_count = g_allocation_count - allocation_count_before;
+
+        // The graph is consumed by Backward(), so that only Backward() is timed after each forward computation.
+        std::vector<double> backward_times;
+        for (int i = 0; i < 10; ++i) {
+            forward();
+            x.ClearGrad();
+            w.ClearGrad();
+            b.ClearGrad();
+            auto start = std::chrono::steady_clock::now();
+            chx::Backward(y);
+            auto end = std::chrono::steady_clock::now();
+            backward_times.emplace_back(std::chrono::duration<double>(end - start).count());
+        }
+        std::sort(backward_times.begin(), backward_times.end());
+        double backward = backward_times[backward_times.size() / 2];
+
+        std::string name = "tanh(y * w + b) ops=" + std::to_string(op_count);
+        std::printf(
+                "%-32s %12.0f ns %12.0f ns %12.0f ns %15.1f %12.0f ns\n",
+                name.c_str(),
+                no_graph / op_count * 1e9,
+                graph / op_count * 1e9,
+                (graph - no_graph) / op_count * 1e9,
+                static_cast<double>(graph_allocation_count - no_graph_allocation_count) / op_count,
+                backward / op_count * 1e9);
+    }
+    return 0;
+}
@@ -0,0 +1,91 @@
+// Compares the time of Backward() on multi-branch graphs with one backward thread against that with multiple backward threads.
+//
+// Each branch is a chain of Tanh and affine routines on its own parameters, and the branches are summed up at the end, so that the op
+// nodes of different branches can be processed concurrently.
+//
+// Usage: benchmark_parallel_backward [num_threads]
+//
+// The number of threads defaults to the number of hardware threads.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "chainerx/array.h"
+#include "chainerx/backward.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/shape.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+int main(int argc, char** argv) {
+    int num_threads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::thread::hardware_concurrency());
+    num_threads = std::max(num_threads, 2);
+
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::Device& device = ctx.GetNativeBackend().GetDevice(0);
+
+    std::printf("backward threads: %d\n", num_threads);
+    std::printf("%-48s %15s %15s %9s\n", "case", "1 thread", "threads", "speedup");
+
+    for (int64_t size : std::vector<int64_t>{1000, 100000}) {
+        for (int branches : std::vector<int>{2, 8}) {
+            const int depth = 8;
+            chx::Shape shape{size};
+            chx::Array x = chx::Full(shape, 0.5f, device).RequireGrad();
+            std::vector<chx::Array> ws;
+            for (int i = 0; i < branches; ++i) {
+                ws.emplace_back(chx::Full(shape, 1.0f / (i + 1), device).RequireGrad());
+            }
+
+            // The graph is consumed by Backward(), so that only Backward() is timed after each forward computation.
+            auto measure_backward = [&](int backward_num_threads) {
+                chx::SetBackwardNumThreads(backward_num_threads);
+                std::vector<double> times;
+                for (int trial = 0; trial < 7; ++trial) {
+                    chx::Array y = chx::Zeros(shape, x.dtype(), device);
+                    for (const chx::Array& w : ws) {
+                        chx::Array h = x;
+                        for (int i = 0; i < depth; ++i) {
+                            h = chx::Tanh(h * w + 0.5f);
+                        }
+                        y = y + h;
+                    }
+                    x.ClearGrad();
+                    for (chx::Array& w : ws) {
+                        w.ClearGrad();
+                    }
+                    auto start = std::chrono::steady_clock::now();
+                    chx::Backward(y);
+                    auto end = std::chrono::steady_clock::now();
+                    if (trial > 0) {
+                        times.emplace_back(std::chrono::duration<double>(end - start).count());
+                    }
+                }
+                std::sort(times.begin(), times.end());
+                return times[times.size() / 2];
+            };
+
+            double serial = measure_backward(1);
+            double parallel = measure_backward(num_threads);
+            chx::benchmark::PrintComparison(
+                    "size=" + std::to_string(size) + " branches=" + std::to_string(branches) + " depth=" + std::to_string(depth),
+                    serial,
+                    parallel);
+        }
+    }
+    chx::SetBackwardNumThreads(1);
+    return 0;
+}
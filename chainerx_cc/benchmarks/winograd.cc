@@ -0,0 +1,74 @@
+// Compares the implicit GEMM convolution against the Winograd convolution for 3x3 float32 convolutions with stride 1, and the
+// transposed convolution through Col2Im against the Winograd transposed convolution.
+//
+// Usage: benchmark_winograd [num_threads]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/constant.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/col2im.h"
+#include "chainerx/native/implicit_gemm_conv.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/tensor_dot.h"
+#include "chainerx/native/winograd_conv.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/manipulation.h"
+#include "chainerx/shape.h"
+#include "chainerx/stack_vector.h"
+
+#include "benchmark.h"
+
+namespace chx = chainerx;
+
+int main(int argc, char** argv) {
+    chx::Context ctx;
+    chx::SetDefaultContext(&ctx);
+    chx::native::NativeBackend& backend = ctx.GetNativeBackend();
+    chx::Device& device = backend.GetDevice(0);
+
+    if (argc > 1) {
+        backend.SetNumThreads(std::atoi(argv[1]));
+    }
+    std::printf("%d threads\n", backend.GetNumThreads());
+    std::printf("%-48s %15s %15s %9s\n", "case", "baseline", "Winograd", "speedup");
+
+    chx::StackVector<int64_t, chx::kMaxNdim> stride{1, 1};
+    chx::StackVector<int64_t, chx::kMaxNdim> pad{1, 1};
+
+    // The last case has outputs smaller than 8 and uses F(2x2, 3x3).
+    for (const chx::Shape& x_shape : std::vector<chx::Shape>{{8, 64, 56, 56}, {8, 128, 28, 28}, {8, 256, 14, 14}, {8, 512, 7, 7}}) {
+        int64_t channels = x_shape[1];
+        chx::Array x = chx::Ones(x_shape, chx::Dtype::kFloat32, device);
+        chx::Array w = chx::Ones({channels, channels, 3, 3}, chx::Dtype::kFloat32, device);
+        chx::StackVector<int64_t, chx::kMaxNdim> out_size{x_shape[2], x_shape[3]};
+
+        double implicit_gemm = chx::benchmark::Measure(
+                [&]() { chx::native::native_internal::ImplicitGemmConv(x, w, nonstd::nullopt, stride, pad, false, chx::Dtype::kFloat32); },
+                1,
+                3);
+        double winograd = chx::benchmark::Measure([&]() { chx::native::native_internal::WinogradConv(x, w, nonstd::nullopt, pad); }, 1, 3);
+        chx::benchmark::PrintComparison("conv x=" + x_shape.ToString(), implicit_gemm, winograd);
+
+        double col2im = chx::benchmark::Measure(
+                [&]() {
+                    chx::Array col = chx::RollAxis(chx::native::TensorDot(w, x, {0}, {1}, chx::Dtype::kFloat32), x.ndim() - 1);
+                    chx::native::native_internal::Col2Im(col, stride, pad, out_size);
+                },
+                1,
+                3);
+        double winograd_transpose =
+                chx::benchmark::Measure([&]() { chx::native::native_internal::WinogradConvTranspose(x, w, nonstd::nullopt, pad); }, 1, 3);
+        chx::benchmark::PrintComparison("conv_transpose x=" + x_shape.ToString(), col2im, winograd_transpose);
+    }
+    return 0;
+}
@@ -1,8 +1,17 @@
 #include "chainerx/backward.h"
 
 #include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
@@ -18,15 +27,19 @@
 #include "chainerx/backprop_mode.h"
 #include "chainerx/backward_context.h"
 #include "chainerx/backward_fwd.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/context.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/error.h"
 #include "chainerx/graph.h"
+#include "chainerx/graph_arena.h"
 #include "chainerx/macro.h"
 #include "chainerx/op_node.h"
 #include "chainerx/routines/creation.h"
 #include "chainerx/shape.h"
+#include "chainerx/thread_local_state.h"
+#include "chainerx/util.h"
 
 namespace chainerx {
 namespace {
@@ -53,14 +66,27 @@ void CheckGradCompatible(const Array& grad, const Shape& shape, Dtype dtype, Dev
     }
 }
 
+// Returns true if the partial gradient can be added to the target gradient in place instead of allocating the sum.
+// The target gradient must not be observable by anyone else, i.e. neither its body nor its data may be shared with other arrays, including
+// other gradients, views and arrays retained for the backward computation. Neither gradient may be connected to a graph, in which case the
+// sum must be recorded for double backprop. The target gradient must also be contiguous, since it may be a broadcast view otherwise.
+bool CanAccumulateGradInPlace(const Array& target_grad, const Array& partial_grad) {
+    const std::shared_ptr<ArrayBody>& target_body = GetArrayBody(target_grad);
+    return target_body.use_count() == 1 && target_grad.data().use_count() == 1 && target_body->nodes().empty() &&
+           GetArrayBody(partial_grad)->nodes().empty() && target_grad.IsContiguous();
+}
+
 }  // namespace
 
 void AccumulateGrad(nonstd::optional<Array>& target_grad, Array partial_grad, const Shape& shape, Dtype dtype, Device& device) {
     CheckGradCompatible(partial_grad, shape, dtype, device);
-    if (target_grad.has_value()) {
-        target_grad = *target_grad + partial_grad;
-    } else {
+    if (!target_grad.has_value()) {
         target_grad = std::move(partial_grad);
+    } else if (CanAccumulateGradInPlace(*target_grad, partial_grad)) {
+        // Gradients of weights shared across many ops, e.g. those of RNNs unrolled over time steps, are accumulated without allocation.
+        device.Add(*target_grad, partial_grad, *target_grad);
+    } else {
+        target_grad = *target_grad + partial_grad;
     }
 }
 
@@ -173,7 +199,7 @@ std::unordered_map<OpNode*, std::vector<uint8_t>> CreateSubgraph(
                 flags.resize(op_node->input_array_node_count());
             }
 
-            const std::vector<std::shared_ptr<ArrayNode>>& input_array_nodes = op_node->input_array_nodes();
+            const internal::GraphArenaVector<std::shared_ptr<ArrayNode>>& input_array_nodes = op_node->input_array_nodes();
             for (size_t i_input = 0; i_input < op_node->input_array_node_count(); ++i_input) {
                 if (input_array_nodes[i_input].get() == array_node) {
                     flags[i_input] = static_cast<int8_t>(true);
@@ -198,6 +224,127 @@ std::unordered_map<OpNode*, std::vector<uint8_t>> CreateSubgraph(
     return input_required_flags;
 }
 
+constexpr const char* kBackwardNumThreadsEnvVarName = "CHAINERX_BACKWARD_NUM_THREADS";
+
+// Whether the current thread is a worker of a BackwardWorkerPool.
+thread_local bool t_is_backward_worker{false};
+
+// A fixed set of worker threads calling the backward functions of op nodes that do not depend on each other.
+// Unlike native::ThreadPool, the thread submitting the tasks does not take part in their execution, so that the operations issued from the
+// backward functions are never affected by the thread-local state of the submitting thread, e.g. by an active native::FusionScope.
+//
+// This class is thread safe.
+class BackwardWorkerPool {
+public:
+    explicit BackwardWorkerPool(int num_threads) {
+        workers_.reserve(num_threads);
+        for (int i = 0; i < num_threads; ++i) {
+            workers_.emplace_back([this]() { WorkerLoop(); });
+        }
+    }
+
+    ~BackwardWorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            stopping_ = true;
+        }
+        task_submitted_.notify_all();
+        for (std::thread& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    BackwardWorkerPool(const BackwardWorkerPool&) = delete;
+    BackwardWorkerPool(BackwardWorkerPool&&) = delete;
+    BackwardWorkerPool& operator=(const BackwardWorkerPool&) = delete;
+    BackwardWorkerPool& operator=(BackwardWorkerPool&&) = delete;
+
+    int num_threads() const { return static_cast<int>(workers_.size()); }
+
+    // Queues a task to be called on one of the worker threads. The task must not throw.
+    void Submit(std::function<void()> task) {
+        {
+            std::lock_guard<std::mutex> lock{mutex_};
+            tasks_.emplace_back(std::move(task));
+        }
+        task_submitted_.notify_one();
+    }
+
+private:
+    void WorkerLoop() {
+        t_is_backward_worker = true;
+        std::unique_lock<std::mutex> lock{mutex_};
+        while (true) {
+            task_submitted_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;  // Stopping.
+            }
+            std::function<void()> task = std::move(tasks_.front());
+            tasks_.pop_front();
+            lock.unlock();
+            task();
+            task = nullptr;
+            lock.lock();
+        }
+    }
+
+    std::vector<std::thread> workers_;
+
+    // Guards the state below.
+    std::mutex mutex_;
+    std::condition_variable task_submitted_;
+    std::deque<std::function<void()>> tasks_;
+    bool stopping_{false};
+};
+
+// The number of backward threads and the pool of the worker threads, shared by all contexts.
+class BackwardThreads {
+public:
+    static BackwardThreads& GetInstance() {
+        static BackwardThreads instance{};
+        return instance;
+    }
+
+    void SetNumThreads(int num_threads) {
+        if (num_threads < 1) {
+            throw ChainerxError{"The number of threads must be positive, but given: ", num_threads};
+        }
+        std::lock_guard<std::mutex> lock{mutex_};
+        num_threads_ = num_threads;
+        if (worker_pool_ != nullptr && worker_pool_->num_threads() != num_threads) {
+            // Running backward computations keep the old pool alive.
+            worker_pool_.reset();
+        }
+    }
+
+    int GetNumThreads() {
+        std::lock_guard<std::mutex> lock{mutex_};
+        return GetNumThreadsNoLock();
+    }
+
+    // Returns the pool of the worker threads, creating it if necessary.
+    std::shared_ptr<BackwardWorkerPool> GetWorkerPool() {
+        std::lock_guard<std::mutex> lock{mutex_};
+        if (worker_pool_ == nullptr) {
+            worker_pool_ = std::make_shared<BackwardWorkerPool>(GetNumThreadsNoLock());
+        }
+        return worker_pool_;
+    }
+
+private:
+    int GetNumThreadsNoLock() {
+        if (!num_threads_) {
+            nonstd::optional<int> env = GetEnvInt(kBackwardNumThreadsEnvVarName);
+            num_threads_ = env.has_value() ? std::max(*env, 1) : 1;
+        }
+        return *num_threads_;
+    }
+
+    std::mutex mutex_;
+    nonstd::optional<int> num_threads_{};
+    std::shared_ptr<BackwardWorkerPool> worker_pool_{};
+};
+
 class BackwardImpl {
 public:
     BackwardImpl(
@@ -243,7 +390,6 @@ public:
         : BackwardImpl{inputs, outputs, backprop_id, double_backprop, {}} {}
 
     void Run() {
-        // Push initial output array nodes
         for (size_t i = 0; i < outputs_.size(); ++i) {
             const Array& output = outputs_[i];
             const std::shared_ptr<ArrayNode>& array_node = output_array_nodes_[i];
@@ -255,7 +401,20 @@ public:
             if (!emplace_result.first->second.get().has_value()) {
                 emplace_result.first->second.get() = OnesLike(output, output.device());
             }
+        }
+
+        if (!RunInParallel()) {
+            RunSerially();
+        }
+
+        // Register this graph as backpropped.
+        backprop_id_.context().SetBackpropDone(backprop_id_);
+    }
 
+private:
+    void RunSerially() {
+        // Push initial output array nodes
+        for (const std::shared_ptr<ArrayNode>& array_node : output_array_nodes_) {
             PushCreatorOpNode(array_node);
         }
 
@@ -265,6 +424,18 @@ public:
             std::shared_ptr<OpNode> op_node = std::move(candidate_op_nodes_.back());
             candidate_op_nodes_.pop_back();
 
+            // The output array nodes whose gradients are propagated by this op node.
+            // This op node is the only and last reader of their gradients, since the gradient of an array node is complete when its
+            // creator op node is popped, which has a lower rank than all the op nodes accumulating to it.
+            std::vector<std::shared_ptr<ArrayNode>> output_array_nodes;
+            {
+                auto range = output_array_node_keeper_.equal_range(op_node.get());
+                for (auto it = range.first; it != range.second; ++it) {
+                    output_array_nodes.emplace_back(std::move(it->second));
+                }
+                output_array_node_keeper_.erase(range.first, range.second);
+            }
+
             // Add GradRef for input array nodes
             for (const std::shared_ptr<ArrayNode>& input_array_node : op_node->input_array_nodes()) {
                 if (input_array_node != nullptr) {
@@ -285,25 +456,361 @@ public:
                 }
             }
 
+            // Release the arrays retained for the backward computation of this op node, unless they are needed for double backprop, in
+            // which case the backward functions may be called again.
             if (double_backprop_ == DoubleBackpropOption::kDisable) {
                 op_node->Unchain();
             }
 
-            // Erase the array node's temporarily held grad
-            {
-                auto range = output_array_node_keeper_.equal_range(op_node.get());
-                for (auto it = range.first; it != range.second; ++it) {
-                    size_t n_removed = array_node_grad_map_.erase(it->second.get());
-                    CHAINERX_ASSERT(n_removed > 0);
+            // Release the gradients of the output array nodes unless they are held by the array bodies, so that the peak memory usage is
+            // bounded by the gradients in flight instead of all the gradients of the graph.
+            for (const std::shared_ptr<ArrayNode>& output_array_node : output_array_nodes) {
+                size_t n_removed = array_node_grad_map_.erase(output_array_node.get());
+                CHAINERX_ASSERT(n_removed > 0);
+            }
+        }
+    }
+
+    // An array node reached by the traversal of RunInParallel().
+    struct ParallelArrayNode {
+        explicit ParallelArrayNode(std::shared_ptr<ArrayNode> array_node) : array_node{std::move(array_node)} {}
+
+        // Kept alive until the creator op node is processed, as in output_array_node_keeper_.
+        std::shared_ptr<ArrayNode> array_node;
+
+        // Index of the creator op node in parallel_op_nodes_, if any.
+        nonstd::optional<size_t> creator_op_node_index{};
+
+        // The gradient in array_node_grad_map_.
+        internal::GradRef* grad{nullptr};
+
+        // Partial gradients computed by the op nodes taking this array node as an input, in the order of the serial execution.
+        // They are accumulated in this order, as soon as all the preceding ones have been accumulated.
+        size_t partial_grad_count{0};
+        std::vector<nonstd::optional<Array>> partial_grads{};
+        std::vector<uint8_t> partial_grad_flags{};
+        size_t accumulated_partial_grad_count{0};
+
+        // Guards the partial gradients and the gradient.
+        std::mutex mutex{};
+    };
+
+    // An op node processed by RunInParallel().
+    struct ParallelOpNode {
+        explicit ParallelOpNode(std::shared_ptr<OpNode> op_node) : op_node{std::move(op_node)} {}
+
+        // Released when processed.
+        std::shared_ptr<OpNode> op_node;
+
+        // For each input, the index of the array node in parallel_array_nodes_ and the index of the partial gradient computed by this op
+        // node, or nullopt if the input array node is absent.
+        std::vector<nonstd::optional<std::pair<size_t, size_t>>> input_partial_grad_indices{};
+
+        // Indices of the output array nodes in parallel_array_nodes_.
+        std::vector<size_t> output_array_node_indices{};
+
+        // The number of output array nodes whose gradients are not complete yet.
+        // This op node is ready to be processed when it becomes zero.
+        size_t pending_output_count{0};
+    };
+
+    // State shared by the worker threads of RunInParallel().
+    struct ParallelExecution {
+        std::mutex mutex{};
+        std::condition_variable state_changed{};
+
+        // Indices of the op nodes which are ready to be processed. The one that comes first in the serial execution is processed first.
+        std::priority_queue<size_t, std::vector<size_t>, std::greater<size_t>> ready_op_node_indices{};
+
+        size_t processed_op_node_count{0};
+        int running_task_count{0};
+        std::exception_ptr exception{nullptr};
+
+        // Thread-local state of the thread calling Backward(), set to the worker threads.
+        ThreadLocalState thread_local_state{};
+    };
+
+    // Processes the graph by calling the backward functions of op nodes that do not depend on each other concurrently.
+    // Returns false without modifying the graph if it should be processed serially instead.
+    bool RunInParallel() {
+        // Backward functions build graphs for double backprop, which must not be done concurrently.
+        // Nested calls are not parallelized since the worker threads could all end up waiting for each other.
+        // Device operations are only recorded on the thread capturing a step.
+        if (!inputs_.empty() || double_backprop_ == DoubleBackpropOption::kEnable || t_is_backward_worker ||
+            internal::GetActiveStepCapture() != nullptr) {
+            return false;
+        }
+        BackwardThreads& backward_threads = BackwardThreads::GetInstance();
+        if (backward_threads.GetNumThreads() <= 1) {
+            return false;
+        }
+
+        PlanParallelExecution();
+        if (!HasIndependentOpNodes()) {
+            parallel_op_nodes_.clear();
+            parallel_array_nodes_.clear();
+            return false;
+        }
+        std::shared_ptr<BackwardWorkerPool> worker_pool = backward_threads.GetWorkerPool();
+
+        std::unordered_set<Device*> devices;
+        for (ParallelArrayNode& parallel_array_node : parallel_array_nodes_) {
+            // Release the creator op nodes as PushCreatorOpNode() does. They are kept alive by parallel_op_nodes_ until processed.
+            parallel_array_node.array_node->move_creator_op_node();
+
+            // Add GradRef for the array nodes.
+            ArrayNode& array_node = *parallel_array_node.array_node;
+            auto emplace_result = array_node_grad_map_.emplace(&array_node, internal::GradRef{array_node});
+            parallel_array_node.grad = &emplace_result.first->second;
+
+            devices.emplace(&array_node.device());
+        }
+
+        // Complete the operations issued from this thread before the worker threads read the arrays, e.g. those deferred by a
+        // native::FusionScope.
+        for (Device* device : devices) {
+            device->Synchronize();
+        }
+
+        ParallelExecution execution{};
+        execution.thread_local_state = ThreadLocalState::Get();
+        for (size_t i = 0; i < parallel_op_nodes_.size(); ++i) {
+            if (parallel_op_nodes_[i].pending_output_count == 0) {
+                execution.ready_op_node_indices.push(i);
+            }
+        }
+
+        size_t task_count = std::min(static_cast<size_t>(worker_pool->num_threads()), parallel_op_nodes_.size());
+        execution.running_task_count = static_cast<int>(task_count);
+        for (size_t i = 0; i < task_count; ++i) {
+            worker_pool->Submit([this, &execution]() { RunWorker(execution); });
+        }
+        {
+            std::unique_lock<std::mutex> lock{execution.mutex};
+            execution.state_changed.wait(lock, [&execution]() { return execution.running_task_count == 0; });
+        }
+
+        if (execution.exception != nullptr) {
+            std::rethrow_exception(execution.exception);
+        }
+        return true;
+    }
+
+    // Traverses the graph in the same order as RunSerially() without modifying it, and fills parallel_op_nodes_ in the order in which the
+    // op nodes would be processed serially and parallel_array_nodes_.
+    void PlanParallelExecution() {
+        std::unordered_map<const ArrayNode*, size_t> array_node_indices;
+        std::unordered_map<const OpNode*, size_t> op_node_indices;
+        std::unordered_set<const OpNode*> pushed_op_nodes;
+        std::vector<std::shared_ptr<OpNode>> candidate_op_nodes;
+
+        // Adds an array node if not seen, and pushes its creator op node into the queue as PushCreatorOpNode() does.
+        // Returns the index of the array node.
+        auto add_array_node = [this, &array_node_indices, &pushed_op_nodes, &candidate_op_nodes](
+                                      const std::shared_ptr<ArrayNode>& array_node) {
+            auto emplace_result = array_node_indices.emplace(array_node.get(), parallel_array_nodes_.size());
+            if (emplace_result.second) {
+                parallel_array_nodes_.emplace_back(array_node);
+                const std::shared_ptr<OpNode>& creator_op_node = array_node->creator_op_node();
+                if (creator_op_node != nullptr && pushed_op_nodes.emplace(creator_op_node.get()).second) {
+                    candidate_op_nodes.push_back(creator_op_node);
+                    std::push_heap(candidate_op_nodes.begin(), candidate_op_nodes.end(), OpNodeComparator{});
                 }
             }
+            return emplace_result.first->second;
+        };
+
+        for (const std::shared_ptr<ArrayNode>& array_node : output_array_nodes_) {
+            add_array_node(array_node);
         }
 
-        // Register this graph as backpropped.
-        backprop_id_.context().SetBackpropDone(backprop_id_);
+        while (!candidate_op_nodes.empty()) {
+            std::pop_heap(candidate_op_nodes.begin(), candidate_op_nodes.end(), OpNodeComparator{});
+            std::shared_ptr<OpNode> op_node = std::move(candidate_op_nodes.back());
+            candidate_op_nodes.pop_back();
+
+            op_node_indices.emplace(op_node.get(), parallel_op_nodes_.size());
+            parallel_op_nodes_.emplace_back(op_node);
+            ParallelOpNode& parallel_op_node = parallel_op_nodes_.back();
+
+            for (const std::shared_ptr<ArrayNode>& input_array_node : op_node->input_array_nodes()) {
+                if (input_array_node == nullptr) {
+                    parallel_op_node.input_partial_grad_indices.emplace_back(nonstd::nullopt);
+                    continue;
+                }
+                size_t i_array_node = add_array_node(input_array_node);
+                size_t i_partial_grad = parallel_array_nodes_[i_array_node].partial_grad_count++;
+                parallel_op_node.input_partial_grad_indices.emplace_back(std::make_pair(i_array_node, i_partial_grad));
+            }
+        }
+
+        for (size_t i = 0; i < parallel_array_nodes_.size(); ++i) {
+            ParallelArrayNode& parallel_array_node = parallel_array_nodes_[i];
+            parallel_array_node.partial_grads.resize(parallel_array_node.partial_grad_count);
+            parallel_array_node.partial_grad_flags.resize(parallel_array_node.partial_grad_count);
+
+            const std::shared_ptr<OpNode>& creator_op_node = parallel_array_node.array_node->creator_op_node();
+            if (creator_op_node == nullptr) {
+                continue;
+            }
+            size_t i_op_node = op_node_indices.at(creator_op_node.get());
+            ParallelOpNode& parallel_op_node = parallel_op_nodes_[i_op_node];
+            parallel_array_node.creator_op_node_index = i_op_node;
+            parallel_op_node.output_array_node_indices.emplace_back(i);
+            if (parallel_array_node.partial_grad_count > 0) {
+                ++parallel_op_node.pending_output_count;
+            }
+        }
+    }
+
+    // Returns whether two op nodes in parallel_op_nodes_ can be ready at the same time.
+    bool HasIndependentOpNodes() const {
+        std::vector<size_t> pending_output_counts;
+        std::vector<size_t> ready_op_node_indices;
+        for (size_t i = 0; i < parallel_op_nodes_.size(); ++i) {
+            pending_output_counts.emplace_back(parallel_op_nodes_[i].pending_output_count);
+            if (pending_output_counts.back() == 0) {
+                ready_op_node_indices.emplace_back(i);
+            }
+        }
+        std::vector<size_t> pending_partial_grad_counts;
+        for (const ParallelArrayNode& parallel_array_node : parallel_array_nodes_) {
+            pending_partial_grad_counts.emplace_back(parallel_array_node.partial_grad_count);
+        }
+
+        // If the op nodes are processed one by one and only one op node is ready at any time, they are totally ordered by their
+        // dependencies.
+        while (!ready_op_node_indices.empty()) {
+            if (ready_op_node_indices.size() > 1) {
+                return true;
+            }
+            size_t i_op_node = ready_op_node_indices.back();
+            ready_op_node_indices.pop_back();
+            for (const nonstd::optional<std::pair<size_t, size_t>>& indices : parallel_op_nodes_[i_op_node].input_partial_grad_indices) {
+                if (!indices.has_value() || --pending_partial_grad_counts[indices->first] > 0) {
+                    continue;
+                }
+                const nonstd::optional<size_t>& i_creator_op_node = parallel_array_nodes_[indices->first].creator_op_node_index;
+                if (i_creator_op_node.has_value() && --pending_output_counts[*i_creator_op_node] == 0) {
+                    ready_op_node_indices.emplace_back(*i_creator_op_node);
+                }
+            }
+        }
+        return false;
+    }
+
+    // Processes ready op nodes on a worker thread until all the op nodes are processed or any of them throws.
+    void RunWorker(ParallelExecution& execution) {
+        ThreadLocalState orig_thread_local_state = ThreadLocalState::Get();
+        ThreadLocalState::Set(execution.thread_local_state);
+
+        std::vector<size_t> completed_array_node_indices;
+        std::unique_lock<std::mutex> lock{execution.mutex};
+        while (true) {
+            execution.state_changed.wait(lock, [this, &execution]() {
+                return !execution.ready_op_node_indices.empty() || execution.processed_op_node_count == parallel_op_nodes_.size() ||
+                       execution.exception != nullptr;
+            });
+            if (execution.exception != nullptr || execution.processed_op_node_count == parallel_op_nodes_.size()) {
+                break;
+            }
+            size_t i_op_node = execution.ready_op_node_indices.top();
+            execution.ready_op_node_indices.pop();
+            lock.unlock();
+
+            completed_array_node_indices.clear();
+            try {
+                ProcessOpNodeInParallel(parallel_op_nodes_[i_op_node], completed_array_node_indices);
+            } catch (...) {
+                lock.lock();
+                if (execution.exception == nullptr) {
+                    execution.exception = std::current_exception();
+                }
+                break;
+            }
+
+            lock.lock();
+            ++execution.processed_op_node_count;
+            for (size_t i_array_node : completed_array_node_indices) {
+                const nonstd::optional<size_t>& i_creator_op_node = parallel_array_nodes_[i_array_node].creator_op_node_index;
+                if (i_creator_op_node.has_value() && --parallel_op_nodes_[*i_creator_op_node].pending_output_count == 0) {
+                    execution.ready_op_node_indices.push(*i_creator_op_node);
+                }
+            }
+            execution.state_changed.notify_all();
+        }
+
+        // The execution may be destroyed by the calling thread as soon as the lock is released.
+        --execution.running_task_count;
+        execution.state_changed.notify_all();
+        lock.unlock();
+
+        ThreadLocalState::Set(orig_thread_local_state);
+    }
+
+    // Processes an op node whose output gradients are complete, as the loop of RunSerially() does.
+    // Adds the indices of the array nodes whose gradients have been completed by this op node to completed_array_node_indices.
+    void ProcessOpNodeInParallel(ParallelOpNode& parallel_op_node, std::vector<size_t>& completed_array_node_indices) {
+        const std::shared_ptr<OpNode>& op_node = parallel_op_node.op_node;
+
+        std::vector<nonstd::optional<Array>> gxs = ComputeInputGradients(op_node);
+        CHAINERX_ASSERT(gxs.size() == parallel_op_node.input_partial_grad_indices.size());
+        for (size_t i = 0; i < gxs.size(); ++i) {
+            const nonstd::optional<std::pair<size_t, size_t>>& indices = parallel_op_node.input_partial_grad_indices[i];
+            if (!indices.has_value()) {
+                CHAINERX_ASSERT(!gxs[i].has_value());
+                continue;
+            }
+            if (AccumulatePartialGradInOrder(parallel_array_nodes_[indices->first], indices->second, std::move(gxs[i]))) {
+                completed_array_node_indices.emplace_back(indices->first);
+            }
+        }
+
+        op_node->Unchain();
+
+        // Release the gradients of the output array nodes.
+        // The other worker threads may look up the gradients of their own output array nodes at the same time.
+        {
+            std::lock_guard<std::mutex> lock{array_node_grad_map_mutex_};
+            for (size_t i_array_node : parallel_op_node.output_array_node_indices) {
+                size_t n_removed = array_node_grad_map_.erase(parallel_array_nodes_[i_array_node].array_node.get());
+                CHAINERX_ASSERT(n_removed > 0);
+            }
+        }
+        for (size_t i_array_node : parallel_op_node.output_array_node_indices) {
+            parallel_array_nodes_[i_array_node].array_node.reset();
+        }
+        parallel_op_node.op_node.reset();
+    }
+
+    // Stores a partial gradient of an array node and accumulates the stored partial gradients to the gradient in the order of the serial
+    // execution, as far as all the preceding ones are available.
+    // Returns true if all the partial gradients of the array node have been accumulated.
+    static bool AccumulatePartialGradInOrder(
+            ParallelArrayNode& parallel_array_node, size_t i_partial_grad, nonstd::optional<Array> partial_grad) {
+        std::lock_guard<std::mutex> lock{parallel_array_node.mutex};
+        parallel_array_node.partial_grads[i_partial_grad] = std::move(partial_grad);
+        parallel_array_node.partial_grad_flags[i_partial_grad] = static_cast<uint8_t>(true);
+
+        const ArrayNode& array_node = *parallel_array_node.array_node;
+        size_t& i_next = parallel_array_node.accumulated_partial_grad_count;
+        while (i_next < parallel_array_node.partial_grad_count && static_cast<bool>(parallel_array_node.partial_grad_flags[i_next])) {
+            nonstd::optional<Array>& next_partial_grad = parallel_array_node.partial_grads[i_next];
+            if (next_partial_grad.has_value()) {
+                // The partial gradient has already been checked against the array node by the op node which computed it.
+                internal::AccumulateGrad(
+                        parallel_array_node.grad->get(),
+                        std::move(*next_partial_grad),
+                        array_node.shape(),
+                        array_node.dtype(),
+                        array_node.device());
+                next_partial_grad.reset();
+            }
+            ++i_next;
+        }
+        return i_next == parallel_array_node.partial_grad_count;
     }
 
-private:
     // Runs backward functions to compute gradients of input array nodes.
     std::vector<nonstd::optional<Array>> ComputeInputGradients(const std::shared_ptr<OpNode>& op_node) {
         // A single op node has multiple backward functions, each of which computes the gradients of a subset of the inputs.
@@ -330,11 +837,18 @@ private:
             // Get the pointer to the output gradient.
             if (output_array_node != nullptr) {
                 // Output array node is alive.
-                auto it = array_node_grad_map_.find(output_array_node.get());
-                if (it != array_node_grad_map_.end()) {
+                internal::GradRef* output_grad{nullptr};
+                {
+                    std::lock_guard<std::mutex> lock{array_node_grad_map_mutex_};
+                    auto it = array_node_grad_map_.find(output_array_node.get());
+                    if (it != array_node_grad_map_.end()) {
+                        output_grad = &it->second;
+                    }
+                }
+                if (output_grad != nullptr) {
                     // The grad mapping has the gradient for the array node.
                     // Keep a pointer to the gradient in the map.
-                    output_grads.emplace_back(&it->second);
+                    output_grads.emplace_back(output_grad);
                 } else {
                     // The grad mapping has no entry for the array node.
                     // Create a new entry in temporary gradients and keep a pointer to it.
@@ -355,13 +869,15 @@ private:
         std::vector<nonstd::optional<Array>> input_grads;
         input_grads.resize(op_node->input_array_node_count());
 
-        const std::vector<uint8_t>& requires_grad = input_required_flags_[op_node.get()];
+        // Looked up only if inputs are specified, since input_required_flags_ must not be modified while processing op nodes in parallel.
+        const std::vector<uint8_t>* requires_grad = inputs_.empty() ? nullptr : &input_required_flags_.at(op_node.get());
         for (const internal::OpNodeBackwardEntry& backward_entry : op_node->backward_entries()) {
             // Compute and set gradients at the appropriate indices.
-            if (inputs_.empty() || std::any_of(
-                                           backward_entry.input_array_node_indices().begin(),
-                                           backward_entry.input_array_node_indices().end(),
-                                           [&requires_grad](size_t i_input) { return static_cast<bool>(requires_grad[i_input]); })) {
+            if (requires_grad == nullptr ||
+                std::any_of(
+                        backward_entry.input_array_node_indices().begin(),
+                        backward_entry.input_array_node_indices().end(),
+                        [requires_grad](size_t i_input) { return static_cast<bool>((*requires_grad)[i_input]); })) {
                 CallBackwardForSubsetOfInputGradients(op_node, backward_entry, output_array_nodes, input_grads, output_grads);
             }
         }
@@ -395,9 +911,6 @@ private:
             }
         }
 
-        // Erase processed OpNode from the map
-        output_array_node_keeper_.erase(op_node.get());
-
         return input_grads;
     }
 
@@ -555,6 +1068,14 @@ private:
     // gradients which are only valid during backward computation at most.
     std::unordered_map<ArrayNode*, internal::GradRef> array_node_grad_map_;
 
+    // Guards array_node_grad_map_ while op nodes are processed in parallel, in which case it is only looked up and erased from.
+    std::mutex array_node_grad_map_mutex_;
+
+    // Array nodes and op nodes processed by RunInParallel(). The op nodes are in the order of the serial execution.
+    // Deques are used since the elements are neither copyable nor movable.
+    std::deque<ParallelArrayNode> parallel_array_nodes_;
+    std::deque<ParallelOpNode> parallel_op_nodes_;
+
     std::vector<BackpropId> backprop_ids_to_stop_gradient_;
 
     // Represents the subgraph required for backprop in case any inputs are specified.
@@ -623,4 +1144,8 @@ std::vector<nonstd::optional<Array>> Grad(
     return input_grads;
 }
 
+void SetBackwardNumThreads(int num_threads) { BackwardThreads::GetInstance().SetNumThreads(num_threads); }
+
+int GetBackwardNumThreads() { return BackwardThreads::GetInstance().GetNumThreads(); }
+
 }  // namespace chainerx
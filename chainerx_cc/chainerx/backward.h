@@ -20,6 +20,8 @@ namespace internal {
 class ArrayBody;
 class ArrayNode;
 
+// Adds partial_grad to target_grad, or sets it if target_grad is empty.
+// The sum is computed in place into target_grad if it is referenced by no other array and neither gradient is connected to a graph.
 // Throws GradientError in case of mismatch in gradient array props.
 void AccumulateGrad(nonstd::optional<Array>& target_grad, Array partial_grad, const Shape& shape, Dtype dtype, Device& device);
 
@@ -45,10 +47,28 @@ void Backward(
         DoubleBackpropOption double_backprop = DoubleBackpropOption::kDisable);
 
 // Returns gradient arrays for all inputs.
+//
+// This function always runs serially, regardless of the number of backward threads.
 std::vector<nonstd::optional<Array>> Grad(
         const std::vector<ConstArrayRef>& outputs,
         const std::vector<ConstArrayRef>& inputs,
         const nonstd::optional<BackpropId>& backprop_id = nonstd::nullopt,
         DoubleBackpropOption double_backprop = DoubleBackpropOption::kDisable);
 
+// Sets the number of threads used by Backward() to call the backward functions of op nodes that do not depend on each other, e.g. those of
+// the branches of a multi-branch model or of multiple losses, concurrently.
+//
+// If the number is greater than one and the graph has such op nodes, the backward function of each op node is called on one of the worker
+// threads as soon as the gradients of all its outputs are complete, while the calling thread waits. The thread-local state of the calling
+// thread, e.g. the default device and the backprop mode, is copied to the worker threads. The partial gradients of each array are
+// accumulated in the same order as the serial execution, so that the results do not depend on the number of threads or on the scheduling.
+// Backward() runs serially if double backprop is enabled, if it is called from a backward function, or if no two op nodes of the graph are
+// independent of each other.
+//
+// The initial number is taken from the environment variable CHAINERX_BACKWARD_NUM_THREADS, defaulting to 1.
+void SetBackwardNumThreads(int num_threads);
+
+// Returns the number of threads used by Backward(). See SetBackwardNumThreads().
+int GetBackwardNumThreads();
+
 }  // namespace chainerx
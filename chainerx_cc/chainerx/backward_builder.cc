@@ -6,8 +6,6 @@
 #include <iterator>
 #include <memory>
 #include <tuple>
-#include <unordered_map>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -18,6 +16,7 @@
 #include "chainerx/backprop_mode.h"
 #include "chainerx/device.h"
 #include "chainerx/graph.h"
+#include "chainerx/graph_arena.h"
 #include "chainerx/macro.h"
 #include "chainerx/op_node.h"
 
@@ -58,12 +57,16 @@ void BackwardBuilder::Target::KeepGraphsAndArrayNodesThatRequireDefinition() {
             }
 
             // Add the array node to the mapping
-            auto insert_result = graph_to_input_array_nodes_.emplace(backprop_id, InputArrayNodes{});
-            auto& input_array_nodes = insert_result.first->second;
-            if (insert_result.second) {
+            auto it = std::find_if(
+                    graph_to_input_array_nodes_.begin(), graph_to_input_array_nodes_.end(), [&backprop_id](const auto& pair) {
+                        return pair.first == backprop_id;
+                    });
+            if (it == graph_to_input_array_nodes_.end()) {
                 // New array node for a graph. Fill all array nodes with nullptr.
-                input_array_nodes.resize(builder_.inputs_.size());
+                graph_to_input_array_nodes_.emplace_back(backprop_id, InputArrayNodes(builder_.inputs_.size()));
+                it = std::prev(graph_to_input_array_nodes_.end());
             }
+            InputArrayNodes& input_array_nodes = it->second;
             // Assign valid pointer to the array node.
             input_array_nodes[input_index] = &input_array_node;
         }
@@ -81,15 +84,15 @@ void BackwardBuilder::Target::KeepGraphsAndArrayNodesThatRequireDefinition() {
     }
 }
 
-void BackwardBuilder::Target::Define(const BackwardFunction& backward_func) {
+void BackwardBuilder::Target::Define(BackwardFunction backward_func) {
     CHAINERX_ASSERT(is_definition_required());
 
     // Find/Create an op node for each graph and register the given backward function to each of them.
-    for (const auto& pair : graph_to_input_array_nodes_) {
-        const BackpropId& backprop_id = pair.first;
-        const InputArrayNodes& input_array_nodes = pair.second;
+    for (auto it = graph_to_input_array_nodes_.begin(); it != graph_to_input_array_nodes_.end(); ++it) {
+        const BackpropId& backprop_id = it->first;
+        const InputArrayNodes& input_array_nodes = it->second;
 
-        std::vector<std::tuple<size_t, std::shared_ptr<ArrayNode>>> temp_input_array_nodes;
+        internal::GraphArenaVector<std::tuple<size_t, std::shared_ptr<ArrayNode>>> temp_input_array_nodes;
         temp_input_array_nodes.reserve(input_array_nodes.size());
         std::transform(
                 input_indices_.begin(),
@@ -100,8 +103,11 @@ void BackwardBuilder::Target::Define(const BackwardFunction& backward_func) {
                     return std::make_tuple(input_index, array_node == nullptr ? nullptr : *array_node);
                 });
 
+        // The function is copied for all the graphs but the last one.
         std::shared_ptr<OpNode>& op_node = builder_.FindOrCreateOpNode(backprop_id);
-        op_node->RegisterBackwardFunction(std::move(temp_input_array_nodes), backward_func);
+        op_node->RegisterBackwardFunction(
+                std::move(temp_input_array_nodes),
+                std::next(it) == graph_to_input_array_nodes_.end() ? std::move(backward_func) : backward_func);
     }
 }
 
@@ -136,15 +142,24 @@ BackwardBuilder::BackwardBuilder(const char* op_name, std::vector<ConstArrayRef>
 
 std::shared_ptr<OpNode>& BackwardBuilder::FindOrCreateOpNode(const BackpropId& backprop_id) {
     // Try to find an existing op node for the given graph.
-    auto insert_result = op_node_map_.emplace(backprop_id, nullptr);
+    auto it = std::find_if(
+            op_node_map_.begin(), op_node_map_.end(), [&backprop_id](const auto& pair) { return pair.first == backprop_id; });
 
     // If not found, create a new one.
-    if (insert_result.second) {
-        insert_result.first->second = OpNode::CreateWithOutputArrayNodes(op_name_, backprop_id, inputs_.size(), outputs_);
+    if (it == op_node_map_.end()) {
+        op_node_map_.emplace_back(backprop_id, OpNode::CreateWithOutputArrayNodes(op_name_, backprop_id, inputs_.size(), outputs_));
+        it = std::prev(op_node_map_.end());
     }
 
     CHAINERX_ASSERT(!op_node_map_.empty());
-    return insert_result.first->second;
+    return it->second;
+}
+
+OpNode& BackwardBuilder::GetOpNode(const BackpropId& backprop_id) const {
+    auto it = std::find_if(
+            op_node_map_.begin(), op_node_map_.end(), [&backprop_id](const auto& pair) { return pair.first == backprop_id; });
+    CHAINERX_ASSERT(it != op_node_map_.end());
+    return *it->second;
 }
 
 RetainedInputToken BackwardBuilder::RetainInput(size_t input_index) {
@@ -222,22 +237,25 @@ void BackwardBuilder::AddEdgesFromOpNodeToArrayNodeOfOuterGraphsForRetention() {
     // Add edges to input array nodes
     if (input_retention_record_.IsAnyRecorded()) {
         // Collect graphs to which the retained inputs belong.
-        // TODO(beam2d): Use a lighter container.
-        std::unordered_set<BackpropId> retained_graphs{};
+        // A linear search is used since elements are usually few.
+        std::vector<BackpropId> retained_graphs{};
         for (size_t i = 0; i < input_retention_record_.size(); ++i) {
             if (input_retention_record_.IsRecorded(i)) {
                 for (const std::shared_ptr<ArrayNode>& array_node : internal::GetArrayBody(gsl::at(inputs_, i))->nodes()) {
-                    retained_graphs.emplace(array_node->backprop_id());
+                    const BackpropId& backprop_id = array_node->backprop_id();
+                    if (std::find(retained_graphs.begin(), retained_graphs.end(), backprop_id) == retained_graphs.end()) {
+                        retained_graphs.emplace_back(backprop_id);
+                    }
                 }
             }
         }
 
         // Add edges to the input array nodes belonging to the collected graphs.
         for (const BackpropId& backprop_id : retained_graphs) {
-            const OpNode& op_node = *op_node_map_.at(backprop_id);
+            const OpNode& op_node = GetOpNode(backprop_id);
             for (const BackpropId& other_backprop_id : retained_graphs) {
                 if (backprop_id < other_backprop_id) {
-                    OpNode& other_op_node = *op_node_map_.at(other_backprop_id);
+                    OpNode& other_op_node = GetOpNode(other_backprop_id);
                     AddEdgesFromOpNodeToInputArrayNodesOfOuterGraph(op_node, other_op_node, input_retention_record_);
                 }
             }
@@ -7,7 +7,6 @@
 #include <memory>
 #include <numeric>
 #include <set>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -98,7 +97,7 @@ public:
         explicit operator bool() const { return is_definition_required(); }
 
         // Defines a backward function with respect to specified input arrays (target).
-        void Define(const BackwardFunction& backward_func);
+        void Define(BackwardFunction backward_func);
 
         bool is_definition_required() const { return !graph_to_input_array_nodes_.empty(); }
 
@@ -116,8 +115,9 @@ public:
         BackwardBuilder& builder_;
         std::vector<size_t> input_indices_;
 
-        // TODO(hvy): Consider using linear search since elements are usually few.
-        std::unordered_map<BackpropId, InputArrayNodes> graph_to_input_array_nodes_;
+        // Pairs of a backprop ID and the input array nodes of the graph.
+        // A linear search is used since elements are usually few.
+        std::vector<std::pair<BackpropId, InputArrayNodes>> graph_to_input_array_nodes_;
     };
 
     // TODO(niboshi): Add an overload to accept `const std::vector<Array>&` as `inputs` and `outputs`
@@ -187,6 +187,9 @@ private:
     // Edges from output nodes to the op node are connected.
     std::shared_ptr<internal::OpNode>& FindOrCreateOpNode(const BackpropId& backprop_id);
 
+    // Returns the op node of a graph, which must have been created.
+    internal::OpNode& GetOpNode(const BackpropId& backprop_id) const;
+
     // Add shared ptrs between op nodes and array nodes belonging to outer graphs.
     // This functions is called once when the builder is finalized.
     // These references are required to restore retained inputs/outputs.
@@ -211,7 +214,8 @@ private:
 
     // A collection of op nodes, each of which corresponds to a graph.
     // This record is increasingly populated as new graphs are encountered in multiple Define() calls.
-    std::unordered_map<BackpropId, std::shared_ptr<internal::OpNode>> op_node_map_;
+    // A linear search is used since elements are usually few.
+    std::vector<std::pair<BackpropId, std::shared_ptr<internal::OpNode>>> op_node_map_;
 
     backward_builder_detail::RetentionRecord input_retention_record_;
     backward_builder_detail::RetentionRecord output_retention_record_;
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <tuple>
 #include <unordered_map>
 #include <utility>
@@ -17,6 +18,7 @@
 #include "chainerx/backprop_mode.h"
 #include "chainerx/device.h"
 #include "chainerx/error.h"
+#include "chainerx/graph_arena.h"
 #include "chainerx/macro.h"
 #include "chainerx/op_node.h"
 #include "chainerx/routines/creation.h"
@@ -82,7 +84,7 @@ BackwardContext::BackwardContext(
     CHAINERX_ASSERT(input_grads_.size() == op_node->input_array_node_count());
 
     // Input grads must be initialized with null-body arrays.
-    const std::vector<size_t>& input_grad_indices = backward_entry.input_array_node_indices();
+    const internal::GraphArenaVector<size_t>& input_grad_indices = backward_entry.input_array_node_indices();
     CHAINERX_ASSERT(std::all_of(input_grad_indices.begin(), input_grad_indices.end(), [&](const size_t& index) {
         return internal::GetArrayBody(gsl::at(input_grads_, index)) == nullptr;
     }));
@@ -96,7 +98,7 @@ BackwardContext::BackwardContext(
 bool BackwardContext::HasOutputGrad(size_t output_index) const { return gsl::at(output_grads_, output_index)->get().has_value(); }
 
 bool BackwardContext::is_input_grad_required(size_t input_index) const {
-    const std::vector<size_t>& input_grad_indices = backward_entry_.input_array_node_indices();
+    const internal::GraphArenaVector<size_t>& input_grad_indices = backward_entry_.input_array_node_indices();
     CHAINERX_ASSERT(std::find(input_grad_indices.begin(), input_grad_indices.end(), input_index) != input_grad_indices.end());
 
     return op_node_->HasInputArrayNode(input_index);
@@ -111,7 +113,7 @@ const nonstd::optional<Array>& BackwardContext::output_grad(size_t output_index)
 }
 
 Array& BackwardContext::input_grad() {
-    const std::vector<size_t>& input_grad_indices = backward_entry_.input_array_node_indices();
+    const internal::GraphArenaVector<size_t>& input_grad_indices = backward_entry_.input_array_node_indices();
     CHAINERX_ASSERT(input_grad_indices.size() == 1);
     return input_grad(input_grad_indices.front());
 }
@@ -138,6 +140,13 @@ std::vector<const std::shared_ptr<ArrayNode>*> GetInputArrayNodesForIndex(const
     return input_array_nodes;
 }
 
+// Guards the bodies of the input array nodes, which may be looked up and fabricated at the same time by the backward functions of op nodes
+// sharing the same input when Backward() runs in parallel.
+std::mutex& GetRetainedInputMutex() {
+    static std::mutex mutex{};
+    return mutex;
+}
+
 }  // namespace
 
 Array BackwardContext::GetRetainedInput(const RetainedInputToken& token) {
@@ -150,6 +159,8 @@ Array BackwardContext::GetRetainedInput(const RetainedInputToken& token) {
     std::shared_ptr<ArrayBody>& kept_body = gsl::at(retained_input_array_bodies_, input_index);
 
     if (kept_body == nullptr) {
+        std::lock_guard<std::mutex> lock{GetRetainedInputMutex()};
+
         // Array nodes corresponding to the input_index for all graphs.
         std::vector<const std::shared_ptr<ArrayNode>*> input_array_nodes = GetInputArrayNodesForIndex(*op_node_, input_index);
 
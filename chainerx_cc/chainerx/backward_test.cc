@@ -1,9 +1,13 @@
 #include "chainerx/backward.h"
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 #include <vector>
@@ -20,6 +24,7 @@
 #include "chainerx/backward_context.h"
 #include "chainerx/check_backward.h"
 #include "chainerx/context.h"
+#include "chainerx/device.h"
 #include "chainerx/device_id.h"
 #include "chainerx/dtype.h"
 #include "chainerx/error.h"
@@ -555,6 +560,228 @@ TEST_F(BackpropTest, BackwardGivenOutputGrad) {
     CheckBackpropSingleElementExtraInputs({2.0f}, {3.0f}, {6.0f}, fprop);
 }
 
+TEST_F(BackpropTest, BackwardGivenInputGradReferenced) {
+    // The given gradient is referenced by g, so that gradients must not be accumulated into it in place.
+    Array x = Full({1}, 2.0f).RequireGrad();
+    Array g = OnesLike(x);
+    x.SetGrad(g);
+    Backward(x * 2 + x * 3);
+    ExpectEqual<float>(Full({1}, 6.0f), *x.GetGrad());
+    ExpectEqual<float>(OnesLike(x), g);
+}
+
+TEST_F(BackpropTest, BackwardSharedWeightAccumulatesGradInPlace) {
+    // A weight shared by all the steps, as in unrolled RNNs.
+    //
+    // (w) <- [mul] <- ... <- [add] <- (y)
+    // (w) <- [mul] <-
+    // ...
+    constexpr int kSteps = 20;
+    Shape shape{256};
+    Array w = Full(shape, 2.0f).RequireGrad();
+    std::vector<Array> xs = MakeFullArrays(shape, std::vector<float>(kSteps, 1.0f));
+    Array y = w * xs[0];
+    for (int t = 1; t < kSteps; ++t) {
+        y = y + w * xs[t];
+    }
+
+    Device& device = w.device();
+    int64_t malloc_count = device.GetMemoryStats().malloc_count;
+    Backward(y);
+    malloc_count = device.GetMemoryStats().malloc_count - malloc_count;
+
+    ExpectEqual<float>(Full(shape, static_cast<float>(kSteps)), *w.GetGrad());
+    // The initial gradient of y and a partial gradient of w for each step. The partial gradients are accumulated without allocation.
+    EXPECT_EQ(kSteps + 1, malloc_count);
+}
+
+TEST_F(BackpropTest, DoubleBackpropSharedWeight) {
+    // Gradients connected to the graph must not be accumulated in place.
+    Array w = Full({1}, 3.0f).RequireGrad();
+    Array y = w * w * w;
+    Backward(y, nonstd::nullopt, DoubleBackpropOption::kEnable);
+    Array gw = *w.GetGrad();  // 3w^2
+    ExpectEqual<float>(Full({1}, 27.0f), gw);
+    w.ClearGrad();
+    Backward(gw);
+    ExpectEqual<float>(Full({1}, 18.0f), *w.GetGrad());  // 6w
+}
+
+TEST_F(BackpropTest, BackwardReleasesIntermediateGradients) {
+    // A chain whose intermediate arrays are only referenced by the graph, and whose ops retain no arrays.
+    constexpr int kDepth = 16;
+    Shape shape{128, 256};
+    size_t nbytes = shape.GetTotalSize() * sizeof(float);
+    Array x = Full(shape, 0.5f).RequireGrad();
+    Array y = x * 0.5f;
+    for (int i = 1; i < kDepth; ++i) {
+        y = y * 0.5f + 1.0f;
+    }
+
+    Device& device = x.device();
+    device.ResetPeakMemoryStats();
+    size_t bytes_in_use = device.GetMemoryStats().bytes_in_use;
+    Backward(y);
+    size_t peak_increase = device.GetMemoryStats().peak_bytes_in_use - bytes_in_use;
+
+    // The gradients of the intermediate arrays are released as soon as they are propagated, so that only a few gradients and temporaries
+    // of a single backward function are alive at a time, instead of the gradients of all the kDepth arrays.
+    EXPECT_LE(peak_increase, 6 * nbytes);
+    EXPECT_TRUE(x.GetGrad().has_value());
+}
+
+// Sets the number of threads of Backward() within the scope.
+class BackwardNumThreadsScope {
+public:
+    explicit BackwardNumThreadsScope(int num_threads) : orig_num_threads_{GetBackwardNumThreads()} { SetBackwardNumThreads(num_threads); }
+    ~BackwardNumThreadsScope() { SetBackwardNumThreads(orig_num_threads_); }
+
+    BackwardNumThreadsScope(const BackwardNumThreadsScope&) = delete;
+    BackwardNumThreadsScope(BackwardNumThreadsScope&&) = delete;
+    BackwardNumThreadsScope& operator=(const BackwardNumThreadsScope&) = delete;
+    BackwardNumThreadsScope& operator=(BackwardNumThreadsScope&&) = delete;
+
+private:
+    int orig_num_threads_;
+};
+
+// Returns a copy of the input whose backward function records the ID of the thread on which it is called.
+// If throws is true, the backward function throws instead.
+Array RecordBackwardThread(const Array& x, std::vector<std::thread::id>& thread_ids, std::mutex& mutex, bool throws = false) {
+    Array y = x.AsGradStopped().Copy();
+    BackwardBuilder bb{"record_backward_thread", x, y};
+    if (BackwardBuilder::Target bt = bb.CreateTarget(0)) {
+        bt.Define([&thread_ids, &mutex, throws](BackwardContext& bctx) {
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                thread_ids.emplace_back(std::this_thread::get_id());
+            }
+            if (throws) {
+                throw ChainerxError{"Intentional error."};
+            }
+            bctx.input_grad() = *bctx.output_grad();
+        });
+    }
+    bb.Finalize();
+    return y;
+}
+
+TEST_F(BackpropTest, BackwardInvalidNumThreads) {
+    EXPECT_THROW(SetBackwardNumThreads(0), ChainerxError);
+    EXPECT_THROW(SetBackwardNumThreads(-1), ChainerxError);
+}
+
+TEST_F(BackpropTest, ParallelBackwardMultipleBranches) {
+    // Branches sharing an input, whose array body is dead, and a weight, whose partial gradients are accumulated in a fixed order.
+    auto forward = [](const Array& x, const Array& w) {
+        Array h = x * 2.0f;
+        nonstd::optional<Array> y{};
+        for (int i = 0; i < 4; ++i) {
+            Array b = h * w + static_cast<float>(i);
+            for (int j = 0; j < 3; ++j) {
+                b = Tanh(b) * w;
+            }
+            y = y.has_value() ? *y + Exp(b) : Exp(b);
+        }
+        return *y;
+    };
+    Shape shape{3, 5};
+    Array x_value = testing::BuildArray(shape).WithLinearData<float>(-1.0f, 0.125f);
+    Array w_value = testing::BuildArray(shape).WithLinearData<float>(0.5f, 0.0625f);
+
+    Array x_expected = x_value.MakeView().RequireGrad();
+    Array w_expected = w_value.MakeView().RequireGrad();
+    Backward(forward(x_expected, w_expected));
+
+    BackwardNumThreadsScope scope{4};
+    for (int trial = 0; trial < 10; ++trial) {
+        Array x = x_value.MakeView().RequireGrad();
+        Array w = w_value.MakeView().RequireGrad();
+        Backward(forward(x, w));
+
+        // Results do not depend on the scheduling.
+        ExpectEqual<float>(*x_expected.GetGrad(), *x.GetGrad());
+        ExpectEqual<float>(*w_expected.GetGrad(), *w.GetGrad());
+    }
+}
+
+TEST_F(BackpropTest, ParallelBackwardMultipleOutputs) {
+    auto forward = [](const Array& x, const Array& w) {
+        std::vector<Array> ys;
+        for (int i = 0; i < 3; ++i) {
+            ys.emplace_back(Tanh(x * w + static_cast<float>(i)) * w);
+        }
+        return ys;
+    };
+    Shape shape{4};
+    Array x_value = testing::BuildArray(shape).WithLinearData<float>(-1.0f, 0.5f);
+    Array w_value = testing::BuildArray(shape).WithLinearData<float>(0.5f, 0.25f);
+
+    Array x_expected = x_value.MakeView().RequireGrad();
+    Array w_expected = w_value.MakeView().RequireGrad();
+    std::vector<Array> ys_expected = forward(x_expected, w_expected);
+    Backward({ys_expected.begin(), ys_expected.end()});
+
+    BackwardNumThreadsScope scope{4};
+    Array x = x_value.MakeView().RequireGrad();
+    Array w = w_value.MakeView().RequireGrad();
+    std::vector<Array> ys = forward(x, w);
+    Backward({ys.begin(), ys.end()});
+
+    ExpectEqual<float>(*x_expected.GetGrad(), *x.GetGrad());
+    ExpectEqual<float>(*w_expected.GetGrad(), *w.GetGrad());
+}
+
+TEST_F(BackpropTest, ParallelBackwardThreads) {
+    BackwardNumThreadsScope scope{4};
+    std::thread::id this_thread_id = std::this_thread::get_id();
+    std::vector<std::thread::id> thread_ids;
+    std::mutex mutex;
+
+    // Backward functions of independent op nodes are called on the worker threads.
+    {
+        Array x = Full({2}, 1.0f).RequireGrad();
+        Backward(RecordBackwardThread(x, thread_ids, mutex) + RecordBackwardThread(x, thread_ids, mutex));
+        ASSERT_EQ(size_t{2}, thread_ids.size());
+        EXPECT_NE(this_thread_id, thread_ids[0]);
+        EXPECT_NE(this_thread_id, thread_ids[1]);
+        ExpectEqual<float>(Full({2}, 2.0f), *x.GetGrad());
+    }
+
+    // A graph without independent op nodes is processed serially.
+    thread_ids.clear();
+    {
+        Array x = Full({2}, 1.0f).RequireGrad();
+        Backward(RecordBackwardThread(RecordBackwardThread(x, thread_ids, mutex), thread_ids, mutex));
+        ASSERT_EQ(size_t{2}, thread_ids.size());
+        EXPECT_EQ(this_thread_id, thread_ids[0]);
+        EXPECT_EQ(this_thread_id, thread_ids[1]);
+    }
+
+    // So is a graph for double backprop.
+    thread_ids.clear();
+    {
+        Array x = Full({2}, 1.0f).RequireGrad();
+        Backward(
+                RecordBackwardThread(x, thread_ids, mutex) + RecordBackwardThread(x, thread_ids, mutex),
+                nonstd::nullopt,
+                DoubleBackpropOption::kEnable);
+        ASSERT_EQ(size_t{2}, thread_ids.size());
+        EXPECT_EQ(this_thread_id, thread_ids[0]);
+        EXPECT_EQ(this_thread_id, thread_ids[1]);
+    }
+}
+
+TEST_F(BackpropTest, ParallelBackwardThrows) {
+    BackwardNumThreadsScope scope{4};
+    std::vector<std::thread::id> thread_ids;
+    std::mutex mutex;
+
+    Array x = Full({2}, 1.0f).RequireGrad();
+    Array y = RecordBackwardThread(x, thread_ids, mutex) + RecordBackwardThread(x, thread_ids, mutex, true);
+    EXPECT_THROW(Backward(y), ChainerxError);
+}
+
 TEST_F(BackpropTest, MultipleGraphsBasic) {
     Array x1 = Full({1}, 2.0f);
     Array x2 = Full({1}, 5.0f);
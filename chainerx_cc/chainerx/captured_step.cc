@@ -0,0 +1,160 @@
+#include "chainerx/captured_step.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "chainerx/array.h"
+#include "chainerx/device.h"
+#include "chainerx/macro.h"
+#include "chainerx/routines/creation.h"
+
+namespace chainerx {
+namespace internal {
+
+class StepCapture {
+public:
+    std::vector<std::function<void()>> ops;
+
+    // The number of the device operations in progress. Only the outermost ones are recorded.
+    int device_call_depth{0};
+
+    bool is_uncapturable{false};
+};
+
+namespace {
+
+thread_local StepCapture* t_active_step_capture{nullptr};
+
+// Sets the capture in progress on this thread while alive.
+class StepCaptureScope {
+public:
+    explicit StepCaptureScope(StepCapture& capture) : orig_{t_active_step_capture} { t_active_step_capture = &capture; }
+    ~StepCaptureScope() { t_active_step_capture = orig_; }
+
+    StepCaptureScope(const StepCaptureScope&) = delete;
+    StepCaptureScope(StepCaptureScope&&) = delete;
+    StepCaptureScope& operator=(const StepCaptureScope&) = delete;
+    StepCaptureScope& operator=(StepCaptureScope&&) = delete;
+
+private:
+    StepCapture* orig_;
+};
+
+}  // namespace
+
+StepCapture* GetActiveStepCapture() { return t_active_step_capture; }
+
+Array MakeCapturedArray(const Array& array) {
+    return MakeArray(array.shape(), array.strides(), array.dtype(), array.device(), array.data(), array.offset());
+}
+
+bool CapturedDeviceCall::Enter(StepCapture& capture) { return capture.device_call_depth++ == 0; }
+
+void CapturedDeviceCall::Leave(StepCapture& capture) {
+    CHAINERX_ASSERT(capture.device_call_depth > 0);
+    --capture.device_call_depth;
+}
+
+void CapturedDeviceCall::Record(StepCapture& capture, std::function<void()> op) { capture.ops.emplace_back(std::move(op)); }
+
+UncapturableDeviceCall::UncapturableDeviceCall() : capture_{GetActiveStepCapture()} {
+    if (capture_ != nullptr) {
+        if (capture_->device_call_depth == 0) {
+            capture_->is_uncapturable = true;
+        }
+        ++capture_->device_call_depth;
+    }
+}
+
+UncapturableDeviceCall::~UncapturableDeviceCall() {
+    if (capture_ != nullptr) {
+        CHAINERX_ASSERT(capture_->device_call_depth > 0);
+        --capture_->device_call_depth;
+    }
+}
+
+}  // namespace internal
+
+CapturedStep::CapturedStep(StepFunction step) : step_{std::move(step)} {}
+
+CapturedStep::~CapturedStep() = default;
+
+bool CapturedStep::IsReplayable(const std::vector<Array>& inputs) const {
+    if (inputs.size() != inputs_.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const Array& input = inputs[i];
+        const Array& captured_input = inputs_[i];
+        if (input.shape() != captured_input.shape() || input.dtype() != captured_input.dtype() ||
+            &input.device() != &captured_input.device()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<Array> CapturedStep::Run(const std::vector<Array>& inputs) {
+    if (is_uncapturable_ || internal::GetActiveStepCapture() != nullptr) {
+        return step_(inputs);
+    }
+
+    if (is_captured_) {
+        if (!IsReplayable(inputs)) {
+            return step_(inputs);
+        }
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            inputs_[i].device().Copy(inputs[i], inputs_[i]);
+        }
+        for (const std::function<void()>& op : ops_) {
+            op();
+        }
+        return outputs_;
+    }
+
+    // Steps using devices whose operations are not recorded cannot be replayed.
+    Device* default_device = internal::GetDefaultDeviceNoExcept();
+    if ((default_device != nullptr && !default_device->SupportsStepCapture()) ||
+        std::any_of(inputs.begin(), inputs.end(), [](const Array& input) { return !input.device().SupportsStepCapture(); })) {
+        is_uncapturable_ = true;
+        return step_(inputs);
+    }
+
+    // Captures the step.
+    std::vector<Array> captured_inputs;
+    captured_inputs.reserve(inputs.size());
+    for (const Array& input : inputs) {
+        Array captured_input = EmptyLike(input, input.device());
+        captured_input.device().Copy(input, captured_input);
+        captured_inputs.emplace_back(std::move(captured_input));
+    }
+
+    internal::StepCapture capture{};
+    std::vector<Array> outputs{};
+    {
+        internal::StepCaptureScope scope{capture};
+        outputs = step_(captured_inputs);
+    }
+    CHAINERX_ASSERT(capture.device_call_depth == 0);
+
+    if (capture.is_uncapturable ||
+        std::any_of(outputs.begin(), outputs.end(), [](const Array& output) { return !output.device().SupportsStepCapture(); })) {
+        is_uncapturable_ = true;
+        return outputs;
+    }
+
+    inputs_ = std::move(captured_inputs);
+    outputs_.clear();
+    outputs_.reserve(outputs.size());
+    for (const Array& output : outputs) {
+        outputs_.emplace_back(internal::MakeCapturedArray(output));
+    }
+    ops_ = std::move(capture.ops);
+    is_captured_ = true;
+    return outputs;
+}
+
+}  // namespace chainerx
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "chainerx/array.h"
+
+namespace chainerx {
+namespace internal {
+
+class StepCapture;
+
+}  // namespace internal
+
+// Captures a step, e.g. a training iteration, whose inputs have the same shapes every time, and replays it without dispatching routines
+// or constructing and traversing the computational graph.
+//
+// The first call of Run() copies the inputs into input arrays owned by this object and calls the step function with them, while recording
+// the device operations issued from this thread, including those issued by the backward functions called in Backward(). Subsequent calls
+// copy the data of the given inputs into the same input arrays and call the recorded device operations again in the same order. The
+// operations read and write the same arrays as in the first call, which are kept alive by this object as preplanned buffers, and the
+// arrays returned by the step function are returned as outputs. The data of the outputs are therefore overwritten by the next replay.
+//
+// Replays are only valid if the step issues the same device operations every time. The step function must only depend on its inputs and
+// on arrays updated in place, e.g. parameters and their gradients, and must not read the data of arrays on the host. Gradients with respect
+// to the inputs are not computed. Gradients set by Backward() refer to the arrays updated by replays until they are set again, e.g. by
+// calling the step function without replaying.
+//
+// The step function must clear the gradients it computes, e.g. by ClearGrad(), before calling Backward(). Backward() sets a gradient that
+// is unset without a device operation, so that replays would overwrite a gradient accumulated over several calls instead of adding to it.
+//
+// If the number, shapes, dtypes or devices of the inputs differ from those of the first call, Run() calls the step function without
+// capturing or replaying. Run() also does so on every call if the step has issued a device operation that cannot be recorded, e.g. a
+// convolution, a pooling or a transfer between devices, or if the default device, an input or an output is on a device that does not
+// support capturing (see Device::SupportsStepCapture()). Only native devices support capturing, and the step must not use other devices
+// for intermediate arrays. Backward() runs serially while capturing.
+//
+// This class is not thread safe.
+class CapturedStep {
+public:
+    using StepFunction = std::function<std::vector<Array>(const std::vector<Array>& inputs)>;
+
+    explicit CapturedStep(StepFunction step);
+    ~CapturedStep();
+
+    CapturedStep(const CapturedStep&) = delete;
+    CapturedStep(CapturedStep&&) = delete;
+    CapturedStep& operator=(const CapturedStep&) = delete;
+    CapturedStep& operator=(CapturedStep&&) = delete;
+
+    // Captures, replays or calls the step, and returns its outputs.
+    std::vector<Array> Run(const std::vector<Array>& inputs);
+
+    // Returns whether the step has been captured and will be replayed for inputs like those of the first call.
+    bool is_captured() const { return is_captured_; }
+
+    // Returns the number of the recorded device operations.
+    size_t op_count() const { return ops_.size(); }
+
+private:
+    // Returns whether the inputs are like those of the capture.
+    bool IsReplayable(const std::vector<Array>& inputs) const;
+
+    StepFunction step_;
+
+    bool is_captured_{false};
+
+    // Set if the step cannot be captured, in which case it is always called without capturing.
+    bool is_uncapturable_{false};
+
+    std::vector<Array> inputs_;
+    std::vector<Array> outputs_;
+    std::vector<std::function<void()>> ops_;
+};
+
+namespace internal {
+
+// Returns the capture in progress on this thread, or nullptr if no step is being captured.
+StepCapture* GetActiveStepCapture();
+
+// Returns an array referring to the same data as the given array without any array nodes, that is used as an argument of a recorded
+// device operation.
+Array MakeCapturedArray(const Array& array);
+
+template <typename T>
+const T& CaptureDeviceCallArgument(const T& arg) {
+    return arg;
+}
+
+inline Array CaptureDeviceCallArgument(const Array& arg) { return MakeCapturedArray(arg); }
+
+// Records a device operation and its arguments to the step being captured on this thread, if any.
+//
+// Devices create one at the beginning of each operation that can be replayed, and keep it alive until the operation returns. The
+// operations issued while it is alive are not recorded, since they are issued again when the recorded operation is called.
+class CapturedDeviceCall {
+public:
+    template <typename DeviceType, typename... Params, typename... Args>
+    CapturedDeviceCall(DeviceType& device, void (DeviceType::*op)(Params...), const Args&... args) : capture_{GetActiveStepCapture()} {
+        if (capture_ != nullptr && Enter(*capture_)) {
+            Record(*capture_, [&device, op, captured_args = std::make_tuple(CaptureDeviceCallArgument(args)...)]() {
+                Call(device, op, captured_args, std::index_sequence_for<Args...>{});
+            });
+        }
+    }
+
+    ~CapturedDeviceCall() {
+        if (capture_ != nullptr) {
+            Leave(*capture_);
+        }
+    }
+
+    CapturedDeviceCall(const CapturedDeviceCall&) = delete;
+    CapturedDeviceCall(CapturedDeviceCall&&) = delete;
+    CapturedDeviceCall& operator=(const CapturedDeviceCall&) = delete;
+    CapturedDeviceCall& operator=(CapturedDeviceCall&&) = delete;
+
+private:
+    template <typename DeviceType, typename Op, typename Tuple, size_t... Is>
+    static void Call(DeviceType& device, Op op, const Tuple& args, std::index_sequence<Is...> /*indices*/) {
+        (device.*op)(std::get<Is>(args)...);
+    }
+
+    // Returns true if the operation is not issued by another operation being recorded.
+    static bool Enter(StepCapture& capture);
+
+    static void Leave(StepCapture& capture);
+
+    static void Record(StepCapture& capture, std::function<void()> op);
+
+    StepCapture* capture_;
+};
+
+// Marks the step being captured on this thread, if any, as uncapturable.
+//
+// Devices create one at the beginning of each operation that cannot be replayed, e.g. one that returns a newly allocated array, and keep
+// it alive until the operation returns. Operations issued by other operations being recorded are not affected.
+class UncapturableDeviceCall {
+public:
+    UncapturableDeviceCall();
+    ~UncapturableDeviceCall();
+
+    UncapturableDeviceCall(const UncapturableDeviceCall&) = delete;
+    UncapturableDeviceCall(UncapturableDeviceCall&&) = delete;
+    UncapturableDeviceCall& operator=(const UncapturableDeviceCall&) = delete;
+    UncapturableDeviceCall& operator=(UncapturableDeviceCall&&) = delete;
+
+private:
+    StepCapture* capture_;
+};
+
+}  // namespace internal
+}  // namespace chainerx
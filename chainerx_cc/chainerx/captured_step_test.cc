@@ -0,0 +1,197 @@
+#include "chainerx/captured_step.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/backprop_mode.h"
+#include "chainerx/backward.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/native_device.h"
+#include "chainerx/routines/connection.h"
+#include "chainerx/routines/linalg.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/shape.h"
+#include "chainerx/testing/array.h"
+#include "chainerx/testing/array_check.h"
+#include "chainerx/testing/device_session.h"
+
+namespace chainerx {
+namespace {
+
+// Native device that does not support capturing, standing in for devices whose operations are not recorded.
+class UncapturableDevice : public native::NativeDevice {
+public:
+    UncapturableDevice(native::NativeBackend& backend, int index) : native::NativeDevice{backend, index} {}
+
+    bool SupportsStepCapture() const override { return false; }
+};
+
+class UncapturableBackend : public native::NativeBackend {
+public:
+    using NativeBackend::NativeBackend;
+
+    std::string GetName() const override { return "uncapturable"; }
+
+    int GetDeviceCount() const override { return 1; }
+
+    // Allows transfers to native devices to check the results.
+    bool SupportsTransfer(Device& src_device, Device& dst_device) override {
+        return dynamic_cast<native::NativeDevice*>(&src_device) != nullptr && dynamic_cast<native::NativeDevice*>(&dst_device) != nullptr;
+    }
+
+    std::unique_ptr<Device> CreateDevice(int index) override { return std::make_unique<UncapturableDevice>(*this, index); }
+};
+
+class CapturedStepTest : public ::testing::Test {
+protected:
+    void SetUp() override { device_session_.emplace(DeviceId{native::NativeBackend::kDefaultName, 0}); }
+
+    void TearDown() override { device_session_.reset(); }
+
+    // Returns a step computing the loss of a linear layer followed by tanh and its gradients. Parameters are updated by SGD if
+    // update is true.
+    static CapturedStep::StepFunction MakeStep(const Array& w, const Array& b, bool update) {
+        return [w, b, update](const std::vector<Array>& inputs) {
+            w.ClearGrad();
+            b.ClearGrad();
+            Array loss = Sum(Tanh(Dot(inputs[0], w) + b));
+            Backward(loss);
+            if (update) {
+                NoBackpropModeScope scope{};
+                w.AsGradStopped() -= 0.1f * *w.GetGrad();
+                b.AsGradStopped() -= 0.1f * *b.GetGrad();
+            }
+            return std::vector<Array>{loss, *w.GetGrad(), *b.GetGrad()};
+        };
+    }
+
+    static Array MakeInput(int64_t batch_size, int iteration, Device& device = GetDefaultDevice()) {
+        return testing::BuildArray({batch_size, 3}).WithLinearData<float>(-0.5f + 0.1f * iteration, 0.07f).WithDevice(device);
+    }
+
+    static Array MakeW(Device& device = GetDefaultDevice()) {
+        return (*testing::BuildArray({3, 2}).WithLinearData<float>(-0.3f, 0.1f).WithDevice(device)).RequireGrad();
+    }
+
+    static Array MakeB(Device& device = GetDefaultDevice()) {
+        return (*testing::BuildArray({2}).WithData<float>({0.1f, -0.2f}).WithDevice(device)).RequireGrad();
+    }
+
+    static void ExpectOutputsAllClose(const std::vector<Array>& expected, const std::vector<Array>& actual) {
+        ASSERT_EQ(expected.size(), actual.size());
+        for (size_t i = 0; i < expected.size(); ++i) {
+            EXPECT_ARRAY_ALL_CLOSE(expected[i], actual[i]);
+        }
+    }
+
+private:
+    nonstd::optional<testing::DeviceSession> device_session_;
+};
+
+TEST_F(CapturedStepTest, Replay) {
+    Array w = MakeW();
+    Array b = MakeB();
+    CapturedStep captured_step{MakeStep(w, b, false)};
+    CapturedStep::StepFunction step = MakeStep(w, b, false);
+    EXPECT_FALSE(captured_step.is_captured());
+
+    for (int i = 0; i < 3; ++i) {
+        Array x = MakeInput(4, i);
+        std::vector<Array> expected = step({x});
+        std::vector<Array> actual = captured_step.Run({x});
+        EXPECT_TRUE(captured_step.is_captured());
+        EXPECT_LT(0U, captured_step.op_count());
+        ExpectOutputsAllClose(expected, actual);
+    }
+}
+
+TEST_F(CapturedStepTest, ReplayUpdates) {
+    Array w = MakeW();
+    Array b = MakeB();
+    Array expected_w = MakeW();
+    Array expected_b = MakeB();
+    CapturedStep captured_step{MakeStep(w, b, true)};
+    CapturedStep::StepFunction step = MakeStep(expected_w, expected_b, true);
+
+    for (int i = 0; i < 5; ++i) {
+        Array x = MakeInput(4, i);
+        std::vector<Array> expected = step({x});
+        std::vector<Array> actual = captured_step.Run({x});
+        ExpectOutputsAllClose(expected, actual);
+        EXPECT_ARRAY_ALL_CLOSE(expected_w, w);
+        EXPECT_ARRAY_ALL_CLOSE(expected_b, b);
+    }
+    EXPECT_TRUE(captured_step.is_captured());
+}
+
+TEST_F(CapturedStepTest, ShapeMismatch) {
+    Array w = MakeW();
+    Array b = MakeB();
+    CapturedStep captured_step{MakeStep(w, b, false)};
+    CapturedStep::StepFunction step = MakeStep(w, b, false);
+
+    captured_step.Run({MakeInput(4, 0)});
+    ASSERT_TRUE(captured_step.is_captured());
+    size_t op_count = captured_step.op_count();
+
+    // Inputs of other shapes are not replayed, and do not affect the subsequent replays.
+    for (int64_t batch_size : {3, 4}) {
+        Array x = MakeInput(batch_size, 1);
+        std::vector<Array> expected = step({x});
+        std::vector<Array> actual = captured_step.Run({x});
+        ExpectOutputsAllClose(expected, actual);
+        EXPECT_TRUE(captured_step.is_captured());
+        EXPECT_EQ(op_count, captured_step.op_count());
+    }
+}
+
+TEST_F(CapturedStepTest, Uncapturable) {
+    Array w = testing::BuildArray({2, 1, 2, 2}).WithLinearData<float>(-0.3f, 0.1f);
+    CapturedStep::StepFunction step = [w](const std::vector<Array>& inputs) {
+        return std::vector<Array>{Tanh(Conv(inputs[0], w, nonstd::nullopt, {1, 1}, {0, 0}))};
+    };
+    CapturedStep captured_step{step};
+
+    for (int i = 0; i < 3; ++i) {
+        Array x = testing::BuildArray({1, 1, 3, 3}).WithLinearData<float>(0.1f * i, 0.1f);
+        std::vector<Array> expected = step({x});
+        std::vector<Array> actual = captured_step.Run({x});
+        ExpectOutputsAllClose(expected, actual);
+        EXPECT_FALSE(captured_step.is_captured());
+        EXPECT_EQ(0U, captured_step.op_count());
+    }
+}
+
+TEST_F(CapturedStepTest, UnsupportedDevice) {
+    UncapturableBackend backend{GetDefaultContext()};
+    Device& device = backend.GetDevice(0);
+    DeviceScope scope{device};
+    Array w = MakeW(device);
+    Array b = MakeB(device);
+    Array expected_w = MakeW(device);
+    Array expected_b = MakeB(device);
+    CapturedStep captured_step{MakeStep(w, b, true)};
+    CapturedStep::StepFunction step = MakeStep(expected_w, expected_b, true);
+
+    for (int i = 0; i < 3; ++i) {
+        Array x = MakeInput(4, i, device);
+        std::vector<Array> expected = step({x});
+        std::vector<Array> actual = captured_step.Run({x});
+        ExpectOutputsAllClose(expected, actual);
+        EXPECT_ARRAY_ALL_CLOSE(expected_w, w);
+        EXPECT_ARRAY_ALL_CLOSE(expected_b, b);
+        EXPECT_FALSE(captured_step.is_captured());
+        EXPECT_EQ(0U, captured_step.op_count());
+    }
+}
+
+}  // namespace
+}  // namespace chainerx
@@ -11,6 +11,7 @@
 #include "chainerx/cuda/cublas.h"
 #include "chainerx/cuda/cuda_runtime.h"
 #include "chainerx/cuda/cuda_set_device_scope.h"
+#include "chainerx/memory_stats.h"
 
 namespace chainerx {
 namespace cuda {
@@ -83,5 +84,9 @@ void CudaDevice::Synchronize() {
     CheckCudaError(cudaDeviceSynchronize());
 }
 
+MemoryStats CudaDevice::GetMemoryStats() { return device_memory_pool_->GetStats(); }
+
+void CudaDevice::ResetPeakMemoryStats() { device_memory_pool_->ResetPeakStats(); }
+
 }  // namespace cuda
 }  // namespace chainerx
@@ -18,6 +18,7 @@
 #include "chainerx/cuda/cuda_conv.h"
 #include "chainerx/cuda/memory_pool.h"
 #include "chainerx/device.h"
+#include "chainerx/memory_stats.h"
 #include "chainerx/routines/pooling.h"
 #include "chainerx/scalar.h"
 #include "chainerx/stack_vector.h"
@@ -59,6 +60,11 @@ public:
 
     void Synchronize() override;
 
+    // Returns the statistics of the device memory pool.
+    MemoryStats GetMemoryStats() override;
+
+    void ResetPeakMemoryStats() override;
+
     // memory.cc
 
     std::shared_ptr<void> Allocate(size_t bytesize) override;
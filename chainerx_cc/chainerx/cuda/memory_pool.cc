@@ -1,14 +1,19 @@
 #include "chainerx/cuda/memory_pool.h"
 
 #include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <iterator>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "chainerx/cuda/cuda_runtime.h"
 #include "chainerx/cuda/cuda_set_device_scope.h"
 #include "chainerx/macro.h"
+#include "chainerx/memory_stats.h"
 
 namespace chainerx {
 namespace cuda {
@@ -72,6 +77,28 @@ void Chunk::MergeWithNext() {
     next_ = next_->next();
 }
 
+std::unique_ptr<Chunk> ThreadCache::Pop(size_t bytesize) {
+    auto it = std::find_if(chunks_.rbegin(), chunks_.rend(), [bytesize](const std::unique_ptr<Chunk>& chunk) {
+        return chunk->bytesize() == bytesize;
+    });
+    if (it == chunks_.rend()) {
+        return nullptr;
+    }
+    std::unique_ptr<Chunk> chunk = std::move(*it);
+    chunks_.erase(std::next(it).base());
+    return chunk;
+}
+
+FreeList ThreadCache::TakeOldest(size_t size) {
+    if (chunks_.size() <= size) {
+        return {};
+    }
+    auto end = chunks_.end() - size;
+    FreeList oldest{std::make_move_iterator(chunks_.begin()), std::make_move_iterator(end)};
+    chunks_.erase(chunks_.begin(), end);
+    return oldest;
+}
+
 }  // namespace cuda_internal
 
 namespace {
@@ -82,6 +109,64 @@ using FreeList = cuda_internal::FreeList;
 
 using Chunk = cuda_internal::Chunk;
 
+using ThreadCache = cuda_internal::ThreadCache;
+
+std::atomic<uint64_t> g_next_memory_pool_id{0};
+
+// Thread caches of the calling thread for each memory pool, by memory pool ID.
+// The caches are marked abandoned when the thread exits, so that the memory pools can take the chunks back.
+class ThreadCacheRegistry {
+public:
+    ThreadCacheRegistry() = default;
+
+    ThreadCacheRegistry(const ThreadCacheRegistry&) = delete;
+    ThreadCacheRegistry& operator=(const ThreadCacheRegistry&) = delete;
+
+    ~ThreadCacheRegistry() {
+        for (const auto& pair : caches_) {
+            pair.second->Abandon();
+        }
+    }
+
+    ThreadCache* Find(uint64_t pool_id) const {
+        // A thread usually uses only a few memory pools, so that a linear search is fast enough.
+        for (const auto& pair : caches_) {
+            if (pair.first == pool_id) {
+                return pair.second.get();
+            }
+        }
+        return nullptr;
+    }
+
+    void Add(uint64_t pool_id, std::shared_ptr<ThreadCache> cache) {
+        // Discards the caches of destroyed memory pools.
+        caches_.erase(
+                std::remove_if(
+                        caches_.begin(),
+                        caches_.end(),
+                        [](const std::pair<uint64_t, std::shared_ptr<ThreadCache>>& pair) { return pair.second->released(); }),
+                caches_.end());
+        caches_.emplace_back(pool_id, std::move(cache));
+    }
+
+private:
+    std::vector<std::pair<uint64_t, std::shared_ptr<ThreadCache>>> caches_;
+};
+
+ThreadCacheRegistry& GetThreadCacheRegistry() {
+    thread_local ThreadCacheRegistry t_registry{};
+    return t_registry;
+}
+
+// Returns the key of the size class of a chunk in MemoryStats::size_classes, which is the smallest power of two not less than the bytesize.
+size_t GetSizeClassKey(size_t bytesize) {
+    size_t key = kAllocationUnitSize;
+    while (key < bytesize) {
+        key *= 2;
+    }
+    return key;
+}
+
 bool IsFreeListNonEmpty(const FreeBinsMap::value_type& pair) {
     const FreeList& free_list = pair.second;
     return !free_list.empty();
@@ -147,6 +232,9 @@ std::unique_ptr<Chunk> MemoryPool::RemoveChunkFromFreeList(Chunk* chunk) {
     return removed_chunk;
 }
 
+MemoryPool::MemoryPool(int device_index, std::unique_ptr<Allocator> allocator, size_t thread_cache_size)
+    : device_index_{device_index}, allocator_{std::move(allocator)}, thread_cache_size_{thread_cache_size}, id_{g_next_memory_pool_id++} {}
+
 MemoryPool::~MemoryPool() {
     // NOTE: CudaSetDeviceScope is not available at dtor because it may throw
     int orig_device_index{0};
@@ -161,6 +249,15 @@ MemoryPool::~MemoryPool() {
             }
         }
     }
+    // Threads may still hold their caches, which are released here and discarded by the threads later.
+    for (const std::shared_ptr<ThreadCache>& thread_cache : thread_caches_) {
+        thread_cache->Release();
+        for (const std::unique_ptr<Chunk>& chunk : thread_cache->TakeOldest(0)) {
+            if (chunk->prev() == nullptr) {
+                allocator_->Free(chunk->ptr());
+            }
+        }
+    }
     // Ideally, in_use_ should be empty, but it could happen that shared ptrs to memories allocated
     // by this memory pool are released after this memory pool is destructed.
     // Our approach is that we anyway free CUDA memories held by this memory pool here in such case.
@@ -175,9 +272,106 @@ MemoryPool::~MemoryPool() {
     cudaSetDevice(orig_device_index);
 }
 
+void MemoryPool::ReturnToFreeBins(std::unique_ptr<Chunk> chunk) {
+    CHAINERX_ASSERT(chunk != nullptr);
+    std::lock_guard<std::mutex> lock{free_bins_mutex_};
+
+    // If the next chunk is free, merges them.
+    if (chunk->next() != nullptr) {
+        std::unique_ptr<Chunk> chunk_next = RemoveChunkFromFreeList(chunk->next());
+        if (chunk_next != nullptr) {
+            chunk->MergeWithNext();
+            ++merge_count_;
+        }
+    }
+
+    // If the previous chunk is free, merges them.
+    if (chunk->prev() != nullptr) {
+        std::unique_ptr<Chunk> chunk_prev = RemoveChunkFromFreeList(chunk->prev());
+        if (chunk_prev != nullptr) {
+            chunk_prev->MergeWithNext();
+            chunk = std::move(chunk_prev);
+            ++merge_count_;
+        }
+    }
+
+    PushIntoFreeList(std::move(chunk));
+}
+
+std::unique_ptr<Chunk> MemoryPool::TakeFromFreeBins(size_t allocation_size) {
+    // The chunk is split while the lock is held, since splitting modifies the adjacent chunk, which may be in the free bins.
+    std::lock_guard<std::mutex> lock{free_bins_mutex_};
+    std::unique_ptr<Chunk> chunk = PopFromFreeList(allocation_size);
+    if (chunk != nullptr) {
+        std::unique_ptr<Chunk> remaining = chunk->Split(allocation_size);
+        if (remaining != nullptr) {
+            PushIntoFreeList(std::move(remaining));
+            ++split_count_;
+        }
+    }
+    return chunk;
+}
+
+ThreadCache& MemoryPool::GetThreadCache() {
+    ThreadCacheRegistry& registry = GetThreadCacheRegistry();
+    if (ThreadCache* thread_cache = registry.Find(id_)) {
+        return *thread_cache;
+    }
+
+    // Takes back the chunks cached by exited threads before registering a new cache, so that the number of caches is bounded by the
+    // number of live threads.
+    std::vector<std::shared_ptr<ThreadCache>> abandoned_caches;
+    auto thread_cache = std::make_shared<ThreadCache>();
+    {
+        std::lock_guard<std::mutex> lock{thread_caches_mutex_};
+        auto it = std::stable_partition(thread_caches_.begin(), thread_caches_.end(), [](const std::shared_ptr<ThreadCache>& cache) {
+            return !cache->abandoned();
+        });
+        abandoned_caches.assign(std::make_move_iterator(it), std::make_move_iterator(thread_caches_.end()));
+        thread_caches_.erase(it, thread_caches_.end());
+        thread_caches_.emplace_back(thread_cache);
+    }
+    for (const std::shared_ptr<ThreadCache>& abandoned_cache : abandoned_caches) {
+        FlushThreadCache(*abandoned_cache);
+    }
+
+    registry.Add(id_, thread_cache);
+    return *thread_cache;
+}
+
+void MemoryPool::FlushThreadCache(ThreadCache& thread_cache) {
+    FreeList chunks{};
+    {
+        std::lock_guard<std::mutex> lock{thread_cache.mutex()};
+        chunks = thread_cache.TakeOldest(0);
+    }
+    for (std::unique_ptr<Chunk>& chunk : chunks) {
+        ReturnToFreeBins(std::move(chunk));
+    }
+}
+
+void MemoryPool::FlushThreadCaches() {
+    std::vector<std::shared_ptr<ThreadCache>> thread_caches{};
+    {
+        std::lock_guard<std::mutex> lock{thread_caches_mutex_};
+        thread_caches = thread_caches_;
+        thread_caches_.erase(
+                std::remove_if(
+                        thread_caches_.begin(),
+                        thread_caches_.end(),
+                        [](const std::shared_ptr<ThreadCache>& cache) { return cache->abandoned(); }),
+                thread_caches_.end());
+    }
+    for (const std::shared_ptr<ThreadCache>& thread_cache : thread_caches) {
+        FlushThreadCache(*thread_cache);
+    }
+}
+
 void MemoryPool::FreeUnusedBlocks() {
     CudaSetDeviceScope scope{device_index_};
 
+    FlushThreadCaches();
+
     std::lock_guard<std::mutex> lock{free_bins_mutex_};
 
     // Frees unused memory blocks
@@ -213,19 +407,26 @@ void* MemoryPool::Malloc(size_t bytesize) {
 
     size_t allocation_size = GetAllocationSize(bytesize);
     std::unique_ptr<Chunk> chunk{nullptr};
+    bool hit{true};
 
-    {
-        std::lock_guard<std::mutex> lock{free_bins_mutex_};
-        chunk = PopFromFreeList(allocation_size);
+    bool use_thread_cache = thread_cache_size_ > 0 && allocation_size <= kThreadCacheMaxChunkBytesize;
+    if (use_thread_cache) {
+        ThreadCache& thread_cache = GetThreadCache();
+        std::lock_guard<std::mutex> lock{thread_cache.mutex()};
+        chunk = thread_cache.Pop(allocation_size);
     }
 
-    if (chunk != nullptr) {
-        std::unique_ptr<Chunk> remaining = chunk->Split(allocation_size);
-        if (remaining != nullptr) {
-            std::lock_guard<std::mutex> lock{free_bins_mutex_};
-            PushIntoFreeList(std::move(remaining));
-        }
-    } else {
+    if (chunk == nullptr) {
+        chunk = TakeFromFreeBins(allocation_size);
+    }
+
+    if (chunk == nullptr && use_thread_cache) {
+        // Chunks of other sizes cached by this thread may be split or merged to fit.
+        FlushThreadCache(GetThreadCache());
+        chunk = TakeFromFreeBins(allocation_size);
+    }
+
+    if (chunk == nullptr) {
         void* ptr{nullptr};
         CudaSetDeviceScope scope{device_index_};
         MallocStatus status = allocator_->Malloc(&ptr, allocation_size);
@@ -239,6 +440,7 @@ void* MemoryPool::Malloc(size_t bytesize) {
         }
         CHAINERX_ASSERT(ptr != nullptr);
         chunk = std::make_unique<Chunk>(ptr, 0, allocation_size);
+        hit = false;
     }
 
     CHAINERX_ASSERT(chunk != nullptr);
@@ -246,6 +448,17 @@ void* MemoryPool::Malloc(size_t bytesize) {
     {
         std::lock_guard<std::mutex> lock{in_use_mutex_};
         in_use_.emplace(chunk_ptr, std::move(chunk));
+
+        MemoryStats::SizeClass& size_class = stats_.size_classes[GetSizeClassKey(allocation_size)];
+        ++size_class.malloc_count;
+        ++stats_.malloc_count;
+        if (hit) {
+            ++size_class.hit_count;
+            ++stats_.hit_count;
+        }
+        size_class.bytes_in_use += allocation_size;
+        stats_.bytes_in_use += allocation_size;
+        stats_.peak_bytes_in_use = std::max(stats_.peak_bytes_in_use, stats_.bytes_in_use);
     }
     return chunk_ptr;
 }
@@ -264,30 +477,29 @@ void MemoryPool::Free(void* ptr) {
         }
         chunk = std::move(it->second);
         in_use_.erase(it);
+
+        stats_.size_classes[GetSizeClassKey(chunk->bytesize())].bytes_in_use -= chunk->bytesize();
+        stats_.bytes_in_use -= chunk->bytesize();
     }
 
     CHAINERX_ASSERT(chunk != nullptr);
-    {
-        std::lock_guard<std::mutex> lock{free_bins_mutex_};
-
-        // If the next chunk is free, merges them.
-        if (chunk->next() != nullptr) {
-            std::unique_ptr<Chunk> chunk_next = RemoveChunkFromFreeList(chunk->next());
-            if (chunk_next != nullptr) {
-                chunk->MergeWithNext();
-            }
-        }
+    if (thread_cache_size_ == 0 || chunk->bytesize() > kThreadCacheMaxChunkBytesize) {
+        ReturnToFreeBins(std::move(chunk));
+        return;
+    }
 
-        // If the previous chunk is free, merges them.
-        if (chunk->prev() != nullptr) {
-            std::unique_ptr<Chunk> chunk_prev = RemoveChunkFromFreeList(chunk->prev());
-            if (chunk_prev != nullptr) {
-                chunk_prev->MergeWithNext();
-                chunk = std::move(chunk_prev);
-            }
+    // Caches the chunk in this thread. If the cache is full, returns its older half to the free bins at once.
+    ThreadCache& thread_cache = GetThreadCache();
+    FreeList evicted{};
+    {
+        std::lock_guard<std::mutex> lock{thread_cache.mutex()};
+        thread_cache.Push(std::move(chunk));
+        if (thread_cache.size() > thread_cache_size_) {
+            evicted = thread_cache.TakeOldest(thread_cache_size_ / 2);
         }
-
-        PushIntoFreeList(std::move(chunk));
+    }
+    for (std::unique_ptr<Chunk>& evicted_chunk : evicted) {
+        ReturnToFreeBins(std::move(evicted_chunk));
     }
 }
 
@@ -299,5 +511,42 @@ void MemoryPool::FreeNoExcept(void* ptr) noexcept {
     }
 }
 
+MemoryStats MemoryPool::GetStats() {
+    MemoryStats stats{};
+    {
+        std::lock_guard<std::mutex> lock{in_use_mutex_};
+        stats = stats_;
+    }
+
+    auto add_cached_chunk = [&stats](const std::unique_ptr<Chunk>& chunk) {
+        stats.size_classes[GetSizeClassKey(chunk->bytesize())].bytes_cached += chunk->bytesize();
+        stats.bytes_cached += chunk->bytesize();
+    };
+    {
+        std::lock_guard<std::mutex> lock{free_bins_mutex_};
+        stats.split_count = split_count_;
+        stats.merge_count = merge_count_;
+        for (const FreeBinsMap::value_type& pair : free_bins_) {
+            std::for_each(pair.second.begin(), pair.second.end(), add_cached_chunk);
+        }
+    }
+
+    std::vector<std::shared_ptr<ThreadCache>> thread_caches{};
+    {
+        std::lock_guard<std::mutex> lock{thread_caches_mutex_};
+        thread_caches = thread_caches_;
+    }
+    for (const std::shared_ptr<ThreadCache>& thread_cache : thread_caches) {
+        std::lock_guard<std::mutex> lock{thread_cache->mutex()};
+        std::for_each(thread_cache->chunks().begin(), thread_cache->chunks().end(), add_cached_chunk);
+    }
+    return stats;
+}
+
+void MemoryPool::ResetPeakStats() {
+    std::lock_guard<std::mutex> lock{in_use_mutex_};
+    stats_.peak_bytes_in_use = stats_.bytes_in_use;
+}
+
 }  // namespace cuda
 }  // namespace chainerx
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -10,6 +12,7 @@
 #include "chainerx/cuda/cuda_runtime.h"
 #include "chainerx/error.h"
 #include "chainerx/macro.h"
+#include "chainerx/memory_stats.h"
 
 namespace chainerx {
 namespace cuda {
@@ -30,6 +33,12 @@ constexpr size_t kAllocationUnitSize = 512;
 // If `kCompactionThreshold` or more consecutive empty free lists were found in free bins, executes `CompactFreebins`.
 constexpr size_t kCompactionThreashold = 512;
 
+// Default maximum number of free chunks cached by each thread in front of the free bins.
+constexpr size_t kDefaultThreadCacheSize = 64;
+
+// Chunks larger than this size are always returned directly to the free bins.
+constexpr size_t kThreadCacheMaxChunkBytesize = 1024 * 1024;
+
 enum class MallocStatus { kSuccess = 0, kErrorMemoryAllocation };
 
 class OutOfMemoryError : public ChainerxError {
@@ -107,14 +116,55 @@ using FreeList = std::vector<std::unique_ptr<Chunk>>;  // List of free chunks wi
 
 using FreeBinsMap = std::map<size_t, cuda_internal::FreeList>;
 
+// Free chunks recently freed by a single thread, kept in front of the free bins of a memory pool.
+//
+// Chunks in the cache are neither in use nor in the free bins. They are reused only for allocations of exactly the same size, and are not
+// merged with adjacent chunks until they are returned to the free bins.
+// Members are guarded by mutex(), which is contended only when other threads flush the cache.
+class ThreadCache {
+public:
+    // Returns the most recently cached chunk of the given bytesize, or nullptr if there is none.
+    std::unique_ptr<Chunk> Pop(size_t bytesize);
+
+    void Push(std::unique_ptr<Chunk> chunk) { chunks_.emplace_back(std::move(chunk)); }
+
+    // Removes and returns the least recently cached chunks, leaving at most `size` chunks.
+    FreeList TakeOldest(size_t size);
+
+    size_t size() const { return chunks_.size(); }
+
+    const FreeList& chunks() const { return chunks_; }
+
+    std::mutex& mutex() { return mutex_; }
+
+    // Whether the owning thread has exited, in which case the memory pool returns the chunks to the free bins on its next flush.
+    bool abandoned() const { return abandoned_; }
+    void Abandon() { abandoned_ = true; }
+
+    // Whether the memory pool has been destroyed, in which case the owning thread discards the cache.
+    bool released() const { return released_; }
+    void Release() { released_ = true; }
+
+private:
+    FreeList chunks_;  // From the least recently cached to the most recently cached.
+    std::mutex mutex_;
+    std::atomic<bool> abandoned_{false};
+    std::atomic<bool> released_{false};
+};
+
 }  // namespace cuda_internal
 
 // Memory pool.
+//
+// Each thread caches up to `thread_cache_size` recently freed chunks of at most kThreadCacheMaxChunkBytesize bytes, which are reused by
+// allocations of the same size from that thread without locking the free bins. When the cache is full, its older half is returned to the
+// free bins at once. The cache of a thread is also returned when an allocation from that thread does not fit in the free bins, and the
+// caches of all threads are returned by FreeUnusedBlocks. A thread_cache_size of 0 disables the caches.
+// Statistics are reported per power-of-two size class, since chunks of arbitrary multiples of kAllocationUnitSize are split and merged.
 // This class is thread safe.
 class MemoryPool {
 public:
-    explicit MemoryPool(int device_index, std::unique_ptr<Allocator> allocator)
-        : device_index_{device_index}, allocator_{std::move(allocator)} {}
+    explicit MemoryPool(int device_index, std::unique_ptr<Allocator> allocator, size_t thread_cache_size = kDefaultThreadCacheSize);
 
     MemoryPool(const MemoryPool&) = delete;
 
@@ -131,6 +181,12 @@ public:
 
     void FreeNoExcept(void* ptr) noexcept;
 
+    // Chunks cached by threads count as cached. The statistics are not a consistent snapshot if other threads allocate concurrently.
+    MemoryStats GetStats();
+
+    // Resets the peak of the bytes in use to the current bytes in use.
+    void ResetPeakStats();
+
 private:
     friend class cuda_internal::MemoryPoolTest;  // for unit-tests
 
@@ -140,16 +196,39 @@ private:
     std::unique_ptr<cuda_internal::Chunk> PopFromFreeList(size_t allocation_size);
     std::unique_ptr<cuda_internal::Chunk> RemoveChunkFromFreeList(cuda_internal::Chunk* chunk);
 
+    // Merges a free chunk with the adjacent free chunks, if any, and pushes it into the free bins.
+    void ReturnToFreeBins(std::unique_ptr<cuda_internal::Chunk> chunk);
+
+    // Pops a best-fit chunk from the free bins and splits it into the given size, or returns nullptr if there is none.
+    std::unique_ptr<cuda_internal::Chunk> TakeFromFreeBins(size_t allocation_size);
+
+    // Returns the cache of the calling thread, creating it on the first call from the thread.
+    cuda_internal::ThreadCache& GetThreadCache();
+
+    // Returns all the chunks in the given thread cache to the free bins.
+    void FlushThreadCache(cuda_internal::ThreadCache& thread_cache);
+
+    // Returns all the chunks in the thread caches to the free bins.
+    // Caches of exited threads are also unregistered.
+    void FlushThreadCaches();
+
     // Finds the longest consecutive empty free lists that include the section between `it_start` and `it_end`, and removes them from free
     // bins.
     void CompactFreeBins(cuda_internal::FreeBinsMap::iterator it_start, cuda_internal::FreeBinsMap::iterator it_end);
 
     int device_index_;
     std::unique_ptr<Allocator> allocator_;
+    size_t thread_cache_size_;
+    uint64_t id_;  // Unique among all the memory pools ever created, to look up thread caches.
     std::unordered_map<void*, std::unique_ptr<cuda_internal::Chunk>> in_use_;  // ptr => cuda_internal::Chunk
     cuda_internal::FreeBinsMap free_bins_;  // allocation size => cuda_internal::FreeList
-    std::mutex in_use_mutex_;
-    std::mutex free_bins_mutex_;
+    std::vector<std::shared_ptr<cuda_internal::ThreadCache>> thread_caches_;
+    MemoryStats stats_{};  // Statistics except for bytes_cached, split_count and merge_count.
+    int64_t split_count_{0};
+    int64_t merge_count_{0};
+    std::mutex in_use_mutex_;  // Guards stats_ as well.
+    std::mutex free_bins_mutex_;  // Guards split_count_ and merge_count_ as well.
+    std::mutex thread_caches_mutex_;
 };
 
 }  // namespace cuda
@@ -3,10 +3,13 @@
 #include <map>
 #include <memory>
 #include <mutex>
+#include <thread>
+#include <vector>
 
 #include <gtest/gtest.h>
 
 #include "chainerx/error.h"
+#include "chainerx/memory_stats.h"
 #include "chainerx/testing/threading.h"
 
 namespace chainerx {
@@ -17,6 +20,26 @@ class MemoryPoolTest {
 public:
     static const FreeBinsMap& GetFreeBins(const MemoryPool& pool) { return pool.free_bins_; }
     static const Allocator* GetAllocator(const MemoryPool& pool) { return pool.allocator_.get(); }
+
+    // Returns the number of chunks in the free bins.
+    static size_t GetFreeBinsChunkCount(const MemoryPool& pool) {
+        size_t count = 0;
+        for (const auto& pair : pool.free_bins_) {
+            count += pair.second.size();
+        }
+        return count;
+    }
+
+    // Returns the number of chunks cached by all the threads.
+    static size_t GetThreadCacheChunkCount(MemoryPool& pool) {
+        std::lock_guard<std::mutex> lock{pool.thread_caches_mutex_};
+        size_t count = 0;
+        for (const std::shared_ptr<ThreadCache>& thread_cache : pool.thread_caches_) {
+            std::lock_guard<std::mutex> cache_lock{thread_cache->mutex()};
+            count += thread_cache->size();
+        }
+        return count;
+    }
 };
 
 }  // namespace cuda_internal
@@ -218,10 +241,11 @@ TEST_P(MemoryPoolTestForEachAllocator, FreeUnusedBlocks) {
 
     void* ptr1 = memory_pool.Malloc(1);
     memory_pool.Free(ptr1);
-    EXPECT_FALSE(free_bins.empty());
+    EXPECT_EQ(size_t{1}, cuda_internal::MemoryPoolTest::GetThreadCacheChunkCount(memory_pool));
 
     memory_pool.FreeUnusedBlocks();
     EXPECT_TRUE(free_bins.empty());
+    EXPECT_EQ(size_t{0}, cuda_internal::MemoryPoolTest::GetThreadCacheChunkCount(memory_pool));
 }
 
 TEST_P(MemoryPoolTestForEachAllocator, MallocSplit) {
@@ -372,6 +396,209 @@ TEST(MemoryPoolTest, FreeUnusedBlocksSplitAndFreeHead) {
     EXPECT_EQ(allocator->free_called(), 0);
 }
 
+TEST(MemoryPoolTest, ThreadCacheReuse) {
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+    auto allocator = dynamic_cast<const FixedCapacityDummyAllocator*>(cuda_internal::MemoryPoolTest::GetAllocator(memory_pool));
+
+    // The freed chunk is cached by this thread instead of being pushed into the free bins.
+    void* ptr1 = memory_pool.Malloc(kAllocationUnitSize);
+    memory_pool.Free(ptr1);
+    EXPECT_EQ(size_t{0}, cuda_internal::MemoryPoolTest::GetFreeBinsChunkCount(memory_pool));
+    EXPECT_EQ(size_t{1}, cuda_internal::MemoryPoolTest::GetThreadCacheChunkCount(memory_pool));
+
+    void* ptr2 = memory_pool.Malloc(kAllocationUnitSize);
+    EXPECT_EQ(ptr1, ptr2);
+    EXPECT_EQ(size_t{0}, cuda_internal::MemoryPoolTest::GetThreadCacheChunkCount(memory_pool));
+    EXPECT_EQ(1, allocator->malloc_called());
+    memory_pool.Free(ptr2);
+}
+
+TEST(MemoryPoolTest, ThreadCacheReturnOldestHalf) {
+    static constexpr size_t kThreadCacheSize = 4;
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU), kThreadCacheSize};
+
+    std::vector<void*> ptrs;
+    for (size_t i = 0; i < kThreadCacheSize; ++i) {
+        ptrs.emplace_back(memory_pool.Malloc(kAllocationUnitSize));
+    }
+    void* last = memory_pool.Malloc(kAllocationUnitSize);
+    for (void* ptr : ptrs) {
+        memory_pool.Free(ptr);
+    }
+    EXPECT_EQ(size_t{0}, cuda_internal::MemoryPoolTest::GetFreeBinsChunkCount(memory_pool));
+    EXPECT_EQ(kThreadCacheSize, cuda_internal::MemoryPoolTest::GetThreadCacheChunkCount(memory_pool));
+
+    // The cache overflows and all but the most recent half are returned to the free bins.
+    memory_pool.Free(last);
+    EXPECT_EQ(kThreadCacheSize + 1 - kThreadCacheSize / 2, cuda_internal::MemoryPoolTest::GetFreeBinsChunkCount(memory_pool));
+    EXPECT_EQ(kThreadCacheSize / 2, cuda_internal::MemoryPoolTest::GetThreadCacheChunkCount(memory_pool));
+
+    // The most recently freed chunk is reused first.
+    void* ptr = memory_pool.Malloc(kAllocationUnitSize);
+    EXPECT_EQ(last, ptr);
+    memory_pool.Free(ptr);
+}
+
+TEST(MemoryPoolTest, ThreadCacheDisabled) {
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU), 0};
+
+    void* ptr = memory_pool.Malloc(kAllocationUnitSize);
+    memory_pool.Free(ptr);
+    EXPECT_EQ(size_t{1}, cuda_internal::MemoryPoolTest::GetFreeBinsChunkCount(memory_pool));
+    EXPECT_EQ(size_t{0}, cuda_internal::MemoryPoolTest::GetThreadCacheChunkCount(memory_pool));
+}
+
+TEST(MemoryPoolTest, ThreadCacheLargeChunk) {
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+
+    void* ptr = memory_pool.Malloc(kThreadCacheMaxChunkBytesize + 1);
+    memory_pool.Free(ptr);
+    EXPECT_EQ(size_t{1}, cuda_internal::MemoryPoolTest::GetFreeBinsChunkCount(memory_pool));
+    EXPECT_EQ(size_t{0}, cuda_internal::MemoryPoolTest::GetThreadCacheChunkCount(memory_pool));
+}
+
+TEST(MemoryPoolTest, FreeUnusedBlocksOfOtherThread) {
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+    auto allocator = dynamic_cast<const FixedCapacityDummyAllocator*>(cuda_internal::MemoryPoolTest::GetAllocator(memory_pool));
+
+    void* ptr = memory_pool.Malloc(kAllocationUnitSize);
+    memory_pool.Free(ptr);
+
+    // The chunk cached by this thread is freed from another thread.
+    std::thread thread{[&memory_pool]() { memory_pool.FreeUnusedBlocks(); }};
+    thread.join();
+    EXPECT_EQ(1, allocator->free_called());
+    EXPECT_EQ(size_t{0}, cuda_internal::MemoryPoolTest::GetThreadCacheChunkCount(memory_pool));
+}
+
+TEST(MemoryPoolTest, ThreadCacheOfExitedThread) {
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+    auto allocator = dynamic_cast<const FixedCapacityDummyAllocator*>(cuda_internal::MemoryPoolTest::GetAllocator(memory_pool));
+
+    void* ptr1{nullptr};
+    std::thread thread{[&memory_pool, &ptr1]() {
+        ptr1 = memory_pool.Malloc(kAllocationUnitSize);
+        memory_pool.Free(ptr1);
+    }};
+    thread.join();
+
+    // The chunk cached by the exited thread is returned to the free bins when this thread registers its cache.
+    void* ptr2 = memory_pool.Malloc(kAllocationUnitSize);
+    EXPECT_EQ(ptr1, ptr2);
+    EXPECT_EQ(1, allocator->malloc_called());
+    memory_pool.Free(ptr2);
+    EXPECT_EQ(size_t{1}, cuda_internal::MemoryPoolTest::GetThreadCacheChunkCount(memory_pool));
+}
+
+TEST(MemoryPoolTest, ThreadCacheOfDestroyedMemoryPool) {
+    // Chunks cached in a destroyed memory pool are never reused by another memory pool.
+    for (int i = 0; i < 2; ++i) {
+        MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+        auto allocator = dynamic_cast<const FixedCapacityDummyAllocator*>(cuda_internal::MemoryPoolTest::GetAllocator(memory_pool));
+        void* ptr = memory_pool.Malloc(kAllocationUnitSize);
+        memory_pool.Free(ptr);
+        EXPECT_EQ(1, allocator->malloc_called());
+    }
+}
+
+TEST(MemoryPoolTest, Stats) {
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU), 0};
+
+    void* ptr = memory_pool.Malloc(kAllocationUnitSize * 4);
+    memory_pool.Free(ptr);
+
+    // Both chunks are split from the cached one.
+    void* head = memory_pool.Malloc(kAllocationUnitSize * 2);
+    void* tail = memory_pool.Malloc(kAllocationUnitSize * 2 - 1);
+    {
+        MemoryStats stats = memory_pool.GetStats();
+        EXPECT_EQ(kAllocationUnitSize * 4, stats.bytes_in_use);
+        EXPECT_EQ(kAllocationUnitSize * 4, stats.peak_bytes_in_use);
+        EXPECT_EQ(size_t{0}, stats.bytes_cached);
+        EXPECT_EQ(3, stats.malloc_count);
+        EXPECT_EQ(2, stats.hit_count);
+        EXPECT_EQ(1, stats.split_count);
+        EXPECT_EQ(0, stats.merge_count);
+
+        ASSERT_EQ(size_t{2}, stats.size_classes.size());
+        const MemoryStats::SizeClass& small = stats.size_classes.at(kAllocationUnitSize * 2);
+        EXPECT_EQ(2, small.malloc_count);
+        EXPECT_EQ(2, small.hit_count);
+        EXPECT_EQ(kAllocationUnitSize * 4, small.bytes_in_use);
+        EXPECT_EQ(size_t{0}, small.bytes_cached);
+        const MemoryStats::SizeClass& large = stats.size_classes.at(kAllocationUnitSize * 4);
+        EXPECT_EQ(1, large.malloc_count);
+        EXPECT_EQ(0, large.hit_count);
+        EXPECT_EQ(size_t{0}, large.bytes_in_use);
+    }
+
+    // The freed chunks are merged back into the original one.
+    memory_pool.Free(head);
+    memory_pool.Free(tail);
+    {
+        MemoryStats stats = memory_pool.GetStats();
+        EXPECT_EQ(size_t{0}, stats.bytes_in_use);
+        EXPECT_EQ(kAllocationUnitSize * 4, stats.peak_bytes_in_use);
+        EXPECT_EQ(kAllocationUnitSize * 4, stats.bytes_cached);
+        EXPECT_EQ(1, stats.merge_count);
+        EXPECT_EQ(size_t{0}, stats.size_classes.at(kAllocationUnitSize * 2).bytes_cached);
+        EXPECT_EQ(kAllocationUnitSize * 4, stats.size_classes.at(kAllocationUnitSize * 4).bytes_cached);
+    }
+
+    memory_pool.FreeUnusedBlocks();
+    EXPECT_EQ(size_t{0}, memory_pool.GetStats().bytes_cached);
+}
+
+TEST(MemoryPoolTest, StatsThreadCache) {
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+
+    void* ptr = memory_pool.Malloc(kAllocationUnitSize);
+    memory_pool.Free(ptr);
+    EXPECT_EQ(kAllocationUnitSize, memory_pool.GetStats().bytes_cached);
+
+    ptr = memory_pool.Malloc(kAllocationUnitSize);
+    MemoryStats stats = memory_pool.GetStats();
+    EXPECT_EQ(size_t{0}, stats.bytes_cached);
+    EXPECT_EQ(2, stats.malloc_count);
+    EXPECT_EQ(1, stats.hit_count);
+    memory_pool.Free(ptr);
+}
+
+TEST(MemoryPoolTest, ResetPeakStats) {
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+
+    void* ptr1 = memory_pool.Malloc(kAllocationUnitSize);
+    void* ptr2 = memory_pool.Malloc(kAllocationUnitSize * 2);
+    memory_pool.Free(ptr2);
+    EXPECT_EQ(kAllocationUnitSize * 3, memory_pool.GetStats().peak_bytes_in_use);
+
+    memory_pool.ResetPeakStats();
+    EXPECT_EQ(kAllocationUnitSize, memory_pool.GetStats().peak_bytes_in_use);
+    memory_pool.Free(ptr1);
+    EXPECT_EQ(kAllocationUnitSize, memory_pool.GetStats().peak_bytes_in_use);
+}
+
+TEST(MemoryPoolTest, StatsThreadSafe) {
+    static constexpr size_t kRepeat = 100U;
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+
+    testing::RunThreads(3, [&memory_pool](size_t thread_index) {
+        for (size_t i = 0; i < kRepeat; ++i) {
+            if (thread_index == 0) {
+                memory_pool.GetStats();
+                memory_pool.ResetPeakStats();
+            } else {
+                void* ptr = memory_pool.Malloc(kAllocationUnitSize * (i % 3 + 1));
+                memory_pool.Free(ptr);
+            }
+        }
+    });
+
+    MemoryStats stats = memory_pool.GetStats();
+    EXPECT_EQ(size_t{0}, stats.bytes_in_use);
+    EXPECT_EQ(static_cast<int64_t>(kRepeat * 2), stats.malloc_count);
+}
+
 TEST(MemoryPoolTest, FreeUnusedBlocksThreadSafe) {
     static constexpr size_t kRepeat = 100U;
     MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
@@ -395,6 +622,31 @@ TEST(MemoryPoolTest, FreeUnusedBlocksThreadSafe) {
     });
 }
 
+TEST(MemoryPoolTest, MallocFreeMixedSizesThreadSafe) {
+    static constexpr size_t kRepeat = 100U;
+    static constexpr size_t kThreadCount = 4U;
+    MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU), 4};
+    auto allocator = dynamic_cast<const FixedCapacityDummyAllocator*>(cuda_internal::MemoryPoolTest::GetAllocator(memory_pool));
+
+    // Chunks are split, cached, returned and merged concurrently.
+    testing::RunThreads(kThreadCount, [&memory_pool](size_t thread_index) {
+        for (size_t i = 0; i < kRepeat; ++i) {
+            std::vector<void*> ptrs;
+            for (size_t j = 0; j < 6; ++j) {
+                ptrs.emplace_back(memory_pool.Malloc(kAllocationUnitSize * (1 + (i + j + thread_index) % 5)));
+            }
+            for (size_t j = 0; j < ptrs.size(); ++j) {
+                memory_pool.Free(ptrs[(j * 5 + i) % ptrs.size()]);
+            }
+        }
+    });
+
+    // All the chunks are merged back into the allocated blocks and freed.
+    memory_pool.FreeUnusedBlocks();
+    EXPECT_TRUE(cuda_internal::MemoryPoolTest::GetFreeBins(memory_pool).empty());
+    EXPECT_EQ(allocator->malloc_called(), allocator->free_called());
+}
+
 TEST(MemoryPoolTest, MallocFreeThreadSafe) {
     static constexpr size_t kRepeat = 100U;
     MemoryPool memory_pool{0, std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
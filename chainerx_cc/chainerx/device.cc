@@ -1,17 +1,24 @@
 #include "chainerx/device.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "chainerx/array.h"
+#include "chainerx/array_index.h"
+#include "chainerx/axes.h"
+#include "chainerx/backprop_mode.h"
 #include "chainerx/context.h"
 #include "chainerx/error.h"
 #include "chainerx/macro.h"
 #include "chainerx/native/native_backend.h"
 #include "chainerx/routines/creation.h"
 #include "chainerx/routines/math.h"
-#include "chainerx/routines/statistics.h"
+#include "chainerx/shape.h"
 #include "chainerx/thread_local_state.h"
 
 namespace chainerx {
@@ -22,6 +29,10 @@ void Device::CheckDevicesCompatible(const Array& array) {
     }
 }
 
+MemoryStats Device::GetMemoryStats() { throw NotImplementedError{"Memory statistics are not supported by device ", name(), "."}; }
+
+void Device::ResetPeakMemoryStats() { throw NotImplementedError{"Memory statistics are not supported by device ", name(), "."}; }
+
 namespace internal {
 
 Device* GetDefaultDeviceNoExcept() noexcept { return internal::GetInternalThreadLocalState().default_device; }
@@ -97,8 +108,9 @@ Array GenericBatchNormForwardBackward::Forward(const Array& x, const Array& gamm
     CHAINERX_ASSERT(internal::GetArrayBody(gamma)->nodes().empty());
     CHAINERX_ASSERT(internal::GetArrayBody(beta)->nodes().empty());
 
-    Array x_mean = Mean(x, axis_, true);
-    Array x_var = Var(x, axis_, true);
+    Array x_mean = internal::EmptyReduced(x.shape(), x.dtype(), axis_, true, x.device());
+    Array x_var = internal::EmptyReduced(x.shape(), x.dtype(), axis_, true, x.device());
+    x.device().MeanVar(x, axis_, x_mean, x_var);
 
     ApplyBatchNormResult result = ApplyBatchNorm(x, gamma, beta, x_mean, x_var, eps_, axis_);
     Array& out = result.out;
@@ -135,10 +147,52 @@ std::array<Array, 3> GenericBatchNormForwardBackward::Backward(const Array& gout
     return {std::move(gx), std::move(ggamma), std::move(gbeta)};
 }
 
+void Device::Mean(const Array& a, const Axes& axis, const Array& out) {
+    Sum(a, axis, out);
+    DivideAS(out, internal::CountItemsAlongAxes(a.shape(), axis), out);
+}
+
+void Device::Var(const Array& a, const Axes& axis, const Array& out) {
+    Array mean = internal::Empty(out.shape(), out.dtype(), out.strides(), *this);
+    MeanVar(a, axis, mean, out);
+}
+
+void Device::MeanVar(const Array& a, const Axes& axis, const Array& mean, const Array& var) {
+    CHAINERX_ASSERT(mean.shape() == var.shape());
+    NoBackpropModeScope scope{};
+    Mean(a, axis, mean);
+    Array diff = a - mean.Reshape(internal::ReduceShape(a.shape(), axis, true));
+    Mean(diff * diff, axis, var);
+}
+
 Array Device::FixedBatchNorm(
         const Array& x, const Array& gamma, const Array& beta, const Array& mean, const Array& var, Scalar eps, const Axes& axis) {
     ApplyBatchNormResult result = ApplyBatchNorm(x, gamma, beta, mean, var, eps, axis);
     return std::move(result.out);
 }
 
+void Device::BatchDot(const Array& a, const Array& b, const Array& out) {
+    CHAINERX_ASSERT(a.ndim() >= 2);
+    CHAINERX_ASSERT(a.ndim() == b.ndim());
+    CHAINERX_ASSERT(a.ndim() == out.ndim());
+
+    if (out.ndim() == 2) {
+        Dot(a, b, out);
+        return;
+    }
+
+    // Calls Dot() with the matrix at each index of the batch axes.
+    int8_t batch_ndim = out.ndim() - 2;
+    int64_t batch_size = std::accumulate(out.shape().begin(), out.shape().end() - 2, int64_t{1}, std::multiplies<>());
+    std::vector<ArrayIndex> index(batch_ndim, ArrayIndex{0});
+    for (int64_t i = 0; i < batch_size; ++i) {
+        int64_t rest = i;
+        for (int8_t axis = batch_ndim - 1; axis >= 0; --axis) {
+            index[axis] = ArrayIndex{rest % out.shape()[axis]};
+            rest /= out.shape()[axis];
+        }
+        Dot(a.At(index), b.At(index), out.At(index));
+    }
+}
+
 }  // namespace chainerx
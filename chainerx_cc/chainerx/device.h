@@ -9,6 +9,7 @@
 #include "chainerx/axes.h"
 #include "chainerx/backend.h"
 #include "chainerx/constant.h"
+#include "chainerx/memory_stats.h"
 #include "chainerx/scalar.h"
 #include "chainerx/shape.h"
 #include "chainerx/stack_vector.h"
@@ -144,6 +145,24 @@ public:
     // See Sum() for the explanation of arguments.
     virtual void AMax(const Array& src, const Axes& axis, const Array& out) = 0;
 
+    // Calculates the mean along specified axes.
+    // See Sum() for the explanation of arguments.
+    //
+    // The default implementation divides the sum by the number of the reduced elements.
+    virtual void Mean(const Array& a, const Axes& axis, const Array& out);
+
+    // Calculates the (biased) variance along specified axes.
+    // See Sum() for the explanation of arguments.
+    //
+    // The default implementation calls MeanVar() with a temporary array for the mean.
+    virtual void Var(const Array& a, const Axes& axis, const Array& out);
+
+    // Calculates both the mean and the (biased) variance along specified axes.
+    // See Sum() for the explanation of arguments. `mean` and `var` must have the same shape.
+    //
+    // The default implementation computes the variance as the mean of the squared deviations from the mean.
+    virtual void MeanVar(const Array& a, const Axes& axis, const Array& mean, const Array& var);
+
     // Copies the elements from one array to the other.
     //
     // The arrays must match in shape and dtype and need to reside on this device.
@@ -191,6 +210,14 @@ public:
     // Otherwise, the behavior is undefined.
     virtual void Dot(const Array& a, const Array& b, const Array& out) = 0;
 
+    // Batched matrix multiplication.
+    // Let the shapes of `a` and `b` be `(..., M, K)` and `(..., L, N)`, respectively, where the leading batch axes `...` are the same.
+    // Then, it must hold that `K == L` and the shape of `out` must be `(..., M, N)` with the same batch axes.
+    // The batch axes of `a` and `b` may have zero strides, i.e. they may be broadcast.
+    //
+    // The default implementation calls Dot() for each matrix in the batch.
+    virtual void BatchDot(const Array& a, const Array& b, const Array& out);
+
     virtual void Exp(const Array& x, const Array& out) = 0;
     virtual void Log(const Array& x, const Array& out) = 0;
 
@@ -292,6 +319,17 @@ public:
 
     virtual void Synchronize() = 0;
 
+    // Returns the statistics of the memory pool of this device.
+    // NotImplementedError is thrown by devices without a memory pool.
+    virtual MemoryStats GetMemoryStats();
+
+    // Resets MemoryStats::peak_bytes_in_use to the current bytes in use.
+    virtual void ResetPeakMemoryStats();
+
+    // Returns whether the operations of this device are recorded by CapturedStep.
+    // Steps using devices that return false are called without capturing.
+    virtual bool SupportsStepCapture() const { return false; }
+
     // TODO(sonots): optimize string concat
     std::string name() const { return backend_.GetName() + ":" + std::to_string(index_); }
 
@@ -0,0 +1,118 @@
+#include "chainerx/graph_arena.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+#include "chainerx/macro.h"
+
+namespace chainerx {
+namespace internal {
+namespace {
+
+// Every block is preceded by a header pointing to its chunk, and is aligned as operator new does.
+constexpr size_t kBlockAlignment = alignof(std::max_align_t);
+constexpr size_t kBlockHeaderSize = kBlockAlignment;
+constexpr size_t kChunkSize = size_t{64} << 10;
+
+std::atomic<int64_t> g_chunk_count{0};
+
+struct Chunk {
+    // The number of the live blocks, plus one while the chunk is the current chunk of a thread.
+    std::atomic<size_t> ref_count{1};
+};
+
+constexpr size_t kChunkHeaderSize = (sizeof(Chunk) + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+
+char* GetChunkBegin(Chunk* chunk) { return reinterpret_cast<char*>(chunk) + kChunkHeaderSize; }
+
+char* GetChunkEnd(Chunk* chunk) { return reinterpret_cast<char*>(chunk) + kChunkSize; }
+
+void ReleaseChunk(Chunk* chunk) noexcept {
+    if (chunk->ref_count.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        chunk->~Chunk();
+        std::free(chunk);  // NOLINT(cppcoreguidelines-no-malloc)
+        --g_chunk_count;
+    }
+}
+
+// The current chunk of a thread. Trivially constructible, so that accessing it needs no guard.
+thread_local Chunk* t_chunk{nullptr};
+thread_local char* t_cursor{nullptr};
+
+// Releases the current chunk when the thread exits. The blocks that are still alive keep the chunk alive.
+class CurrentChunkReleaser {
+public:
+    CurrentChunkReleaser() = default;
+    ~CurrentChunkReleaser() {
+        if (t_chunk != nullptr) {
+            ReleaseChunk(t_chunk);
+            t_chunk = nullptr;
+        }
+    }
+
+    CurrentChunkReleaser(const CurrentChunkReleaser&) = delete;
+    CurrentChunkReleaser(CurrentChunkReleaser&&) = delete;
+    CurrentChunkReleaser& operator=(const CurrentChunkReleaser&) = delete;
+    CurrentChunkReleaser& operator=(CurrentChunkReleaser&&) = delete;
+};
+
+void RenewCurrentChunk() {
+    thread_local CurrentChunkReleaser t_releaser{};
+    (void)t_releaser;  // Registers the destructor on the first call.
+
+    void* ptr = std::malloc(kChunkSize);  // NOLINT(cppcoreguidelines-no-malloc)
+    if (ptr == nullptr) {
+        throw std::bad_alloc{};
+    }
+    ++g_chunk_count;
+    if (t_chunk != nullptr) {
+        ReleaseChunk(t_chunk);
+    }
+    t_chunk = new (ptr) Chunk{};
+    t_cursor = GetChunkBegin(t_chunk);
+}
+
+size_t GetBlockSize(size_t bytesize) {
+    return kBlockHeaderSize + (bytesize + kBlockAlignment - 1) / kBlockAlignment * kBlockAlignment;
+}
+
+}  // namespace
+
+void* AllocateFromGraphArena(size_t bytesize) {
+    if (bytesize > kMaxGraphArenaBlockSize) {
+        return ::operator new(bytesize);
+    }
+    size_t block_size = GetBlockSize(bytesize);
+
+    if (t_chunk != nullptr && t_chunk->ref_count.load(std::memory_order_acquire) == 1) {
+        // All the blocks of the current chunk have been deallocated. No other thread can allocate from the chunk.
+        t_cursor = GetChunkBegin(t_chunk);
+    }
+    if (t_chunk == nullptr || GetChunkEnd(t_chunk) - t_cursor < static_cast<ptrdiff_t>(block_size)) {
+        RenewCurrentChunk();
+    }
+
+    char* block = t_cursor;
+    t_cursor += block_size;
+    t_chunk->ref_count.fetch_add(1, std::memory_order_relaxed);
+    *reinterpret_cast<Chunk**>(block) = t_chunk;
+    return block + kBlockHeaderSize;
+}
+
+void DeallocateToGraphArena(void* ptr, size_t bytesize) noexcept {
+    if (bytesize > kMaxGraphArenaBlockSize) {
+        ::operator delete(ptr);
+        return;
+    }
+    CHAINERX_ASSERT(ptr != nullptr);
+    Chunk* chunk = *reinterpret_cast<Chunk**>(static_cast<char*>(ptr) - kBlockHeaderSize);
+    ReleaseChunk(chunk);
+}
+
+int64_t GetGraphArenaChunkCount() { return g_chunk_count; }
+
+}  // namespace internal
+}  // namespace chainerx
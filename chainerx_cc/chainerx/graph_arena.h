@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+namespace chainerx {
+namespace internal {
+
+// Allocates a block for a node of a computational graph, or for a container held by one, from the graph arena of the calling thread.
+//
+// The arena carves blocks out of large chunks, so that constructing the graph of an op costs a few pointer increments instead of tens of
+// heap allocations. Each chunk counts its live blocks, and is reused from its beginning as soon as all of them are deallocated, which
+// usually happens when Backward() or the destruction of the graph releases the nodes. Blocks may be deallocated on any thread.
+//
+// Blocks larger than kMaxGraphArenaBlockSize are allocated on the heap.
+void* AllocateFromGraphArena(size_t bytesize);
+
+// Deallocates a block allocated by AllocateFromGraphArena() with the same bytesize.
+void DeallocateToGraphArena(void* ptr, size_t bytesize) noexcept;
+
+constexpr size_t kMaxGraphArenaBlockSize = 1024;
+
+// Returns the number of the chunks of the graph arenas of all threads that are currently allocated.
+int64_t GetGraphArenaChunkCount();
+
+// Standard allocator for graph nodes and their containers, that allocates from the graph arena.
+// See AllocateFromGraphArena().
+template <typename T>
+class GraphArenaAllocator {
+public:
+    using value_type = T;
+
+    GraphArenaAllocator() = default;
+
+    template <typename U>
+    GraphArenaAllocator(const GraphArenaAllocator<U>& /*other*/) {}  // NOLINT(google-explicit-constructor)
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) {
+            throw std::bad_alloc{};
+        }
+        return static_cast<T*>(AllocateFromGraphArena(n * sizeof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept { DeallocateToGraphArena(ptr, n * sizeof(T)); }
+};
+
+template <typename T, typename U>
+bool operator==(const GraphArenaAllocator<T>& /*lhs*/, const GraphArenaAllocator<U>& /*rhs*/) {
+    return true;
+}
+
+template <typename T, typename U>
+bool operator!=(const GraphArenaAllocator<T>& /*lhs*/, const GraphArenaAllocator<U>& /*rhs*/) {
+    return false;
+}
+
+template <typename T>
+using GraphArenaVector = std::vector<T, GraphArenaAllocator<T>>;
+
+}  // namespace internal
+}  // namespace chainerx
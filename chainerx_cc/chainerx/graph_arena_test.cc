@@ -0,0 +1,172 @@
+#include "chainerx/graph_arena.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "chainerx/array.h"
+#include "chainerx/backward.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/shape.h"
+
+// In the following tests, main test logic of each test case is run on a different thread than the main thread, so that the arena of the
+// thread is released when the thread exits.
+
+namespace chainerx {
+namespace internal {
+namespace {
+
+TEST(GraphArenaTest, AllocateAndDeallocate) {
+    std::thread thread{[]() {
+        int64_t chunk_count = GetGraphArenaChunkCount();
+        std::vector<void*> ptrs;
+        for (size_t bytesize : {size_t{1}, size_t{8}, size_t{24}, size_t{100}, kMaxGraphArenaBlockSize, kMaxGraphArenaBlockSize + 1}) {
+            void* ptr = AllocateFromGraphArena(bytesize);
+            ASSERT_NE(nullptr, ptr);
+            EXPECT_EQ(0U, reinterpret_cast<uintptr_t>(ptr) % alignof(std::max_align_t));
+            std::memset(ptr, 0xff, bytesize);
+            ptrs.emplace_back(ptr);
+        }
+        EXPECT_EQ(chunk_count + 1, GetGraphArenaChunkCount());
+
+        for (void* ptr : ptrs) {
+            EXPECT_EQ(1, std::count(ptrs.begin(), ptrs.end(), ptr));
+        }
+        size_t i = 0;
+        for (size_t bytesize : {size_t{1}, size_t{8}, size_t{24}, size_t{100}, kMaxGraphArenaBlockSize, kMaxGraphArenaBlockSize + 1}) {
+            DeallocateToGraphArena(ptrs[i++], bytesize);
+        }
+    }};
+    thread.join();
+}
+
+TEST(GraphArenaTest, ReleaseChunks) {
+    std::thread thread{[]() {
+        int64_t chunk_count = GetGraphArenaChunkCount();
+
+        // Allocates blocks spanning multiple chunks.
+        std::vector<void*> ptrs;
+        for (int i = 0; i < 10000; ++i) {
+            ptrs.emplace_back(AllocateFromGraphArena(64));
+        }
+        EXPECT_LT(chunk_count + 1, GetGraphArenaChunkCount());
+
+        // Only the current chunk is kept.
+        for (void* ptr : ptrs) {
+            DeallocateToGraphArena(ptr, 64);
+        }
+        EXPECT_EQ(chunk_count + 1, GetGraphArenaChunkCount());
+
+        // The current chunk is reused from its beginning.
+        void* ptr1 = AllocateFromGraphArena(64);
+        DeallocateToGraphArena(ptr1, 64);
+        void* ptr2 = AllocateFromGraphArena(64);
+        EXPECT_EQ(ptr1, ptr2);
+        DeallocateToGraphArena(ptr2, 64);
+        EXPECT_EQ(chunk_count + 1, GetGraphArenaChunkCount());
+    }};
+    thread.join();
+}
+
+TEST(GraphArenaTest, DeallocateOnAnotherThread) {
+    int64_t chunk_count = GetGraphArenaChunkCount();
+    std::vector<void*> ptrs;
+    std::thread allocating_thread{[&ptrs]() {
+        for (int i = 0; i < 10000; ++i) {
+            ptrs.emplace_back(AllocateFromGraphArena(64));
+        }
+    }};
+    allocating_thread.join();
+
+    // The chunks are kept alive by the blocks, even after the allocating thread exits.
+    EXPECT_LT(chunk_count, GetGraphArenaChunkCount());
+
+    std::thread deallocating_thread{[&ptrs]() {
+        for (void* ptr : ptrs) {
+            DeallocateToGraphArena(ptr, 64);
+        }
+    }};
+    deallocating_thread.join();
+    EXPECT_EQ(chunk_count, GetGraphArenaChunkCount());
+}
+
+TEST(GraphArenaTest, Allocator) {
+    std::thread thread{[]() {
+        int64_t chunk_count = GetGraphArenaChunkCount();
+        {
+            GraphArenaVector<int> vec{1, 2, 3};
+            vec.emplace_back(4);
+            EXPECT_EQ((std::vector<int>{1, 2, 3, 4}), std::vector<int>(vec.begin(), vec.end()));
+
+            std::shared_ptr<int> ptr = std::allocate_shared<int>(GraphArenaAllocator<int>{}, 5);
+            EXPECT_EQ(5, *ptr);
+            EXPECT_EQ(chunk_count + 1, GetGraphArenaChunkCount());
+        }
+        EXPECT_EQ(chunk_count + 1, GetGraphArenaChunkCount());
+    }};
+    thread.join();
+}
+
+TEST(GraphArenaTest, ReuseForGraphs) {
+    std::thread thread{[]() {
+        Context ctx{};
+        ContextScope context_scope{ctx};
+        Array x = Full(Shape{}, 0.5f).RequireGrad();
+        Array w = Full(Shape{}, 0.9f).RequireGrad();
+
+        // The graphs of consecutive iterations are constructed in the same chunks.
+        int64_t chunk_count{0};
+        for (int i = 0; i < 5; ++i) {
+            Array y = x;
+            for (int j = 0; j < 200; ++j) {
+                y = Tanh(y * w + x);
+            }
+            if (i == 0) {
+                chunk_count = GetGraphArenaChunkCount();
+            } else {
+                EXPECT_EQ(chunk_count, GetGraphArenaChunkCount());
+            }
+            Backward(y);
+        }
+    }};
+    thread.join();
+}
+
+TEST(GraphArenaTest, RetainedOutputs) {
+    std::thread thread{[]() {
+        Context ctx{};
+        ContextScope context_scope{ctx};
+        Array x = Full(Shape{}, 0.5f).RequireGrad();
+        Array w = Full(Shape{}, 0.9f).RequireGrad();
+
+        // Outputs kept across iterations, like a list of losses, do not pin a chunk per iteration.
+        std::vector<Array> losses;
+        int64_t chunk_count{0};
+        for (int i = 0; i < 100; ++i) {
+            Array y = x;
+            for (int j = 0; j < 200; ++j) {
+                y = Tanh(y * w + x);
+            }
+            Backward(y);
+            losses.emplace_back(y);
+            if (i == 0) {
+                chunk_count = GetGraphArenaChunkCount();
+            }
+        }
+        EXPECT_LE(GetGraphArenaChunkCount(), chunk_count + 1);
+    }};
+    thread.join();
+}
+
+}  // namespace
+}  // namespace internal
+}  // namespace chainerx
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+
+namespace chainerx {
+
+// Statistics of the memory allocated by a device through its memory pool.
+//
+// Sizes are those of the blocks managed by the pool, i.e. requested sizes rounded up to the allocation unit of the pool.
+struct MemoryStats {
+    struct SizeClass {
+        // Number of allocations, and the number of those served from blocks cached by the pool.
+        int64_t malloc_count{0};
+        int64_t hit_count{0};
+
+        // Bytes of the blocks in use and of the free blocks cached by the pool.
+        size_t bytes_in_use{0};
+        size_t bytes_cached{0};
+    };
+
+    // Bytes of the blocks returned by the pool and not freed yet.
+    size_t bytes_in_use{0};
+
+    // Maximum of bytes_in_use since the pool was created or the peak was last reset.
+    size_t peak_bytes_in_use{0};
+
+    // Bytes of the free blocks cached by the pool for reuse.
+    size_t bytes_cached{0};
+
+    // Number of allocations, and the number of those served from blocks cached by the pool without calling the underlying allocator.
+    int64_t malloc_count{0};
+    int64_t hit_count{0};
+
+    // Number of cached blocks split to serve smaller allocations, and of adjacent free blocks merged on free.
+    // Always zero for pools which do not split blocks.
+    int64_t split_count{0};
+    int64_t merge_count{0};
+
+    // Statistics per size class, keyed by the largest block size of each class. Classes which have never been used are omitted.
+    std::map<size_t, SizeClass> size_classes;
+};
+
+}  // namespace chainerx
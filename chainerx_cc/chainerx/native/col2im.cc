@@ -2,21 +2,20 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <vector>
+#include <iterator>
+#include <memory>
 
 #include "chainerx/array.h"
-#include "chainerx/array_index.h"
+#include "chainerx/backend_util.h"
 #include "chainerx/constant.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
-#include "chainerx/indexable_array.h"
-#include "chainerx/indexer.h"
 #include "chainerx/macro.h"
-#include "chainerx/native/data_type.h"
+#include "chainerx/native/im2col.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/thread_pool.h"
 #include "chainerx/routines/creation.h"
-#include "chainerx/scalar.h"
 #include "chainerx/shape.h"
-#include "chainerx/slice.h"
 #include "chainerx/stack_vector.h"
 
 namespace chainerx {
@@ -25,47 +24,45 @@ namespace native_internal {
 
 namespace {
 
-template <typename T, int8_t kKernelNdim>
-void Col2ImImpl(const Array& col, const Array& out, const StackVector<int64_t, kMaxNdim>& stride, const Indexer<2>& batch_channel_indexer) {
-    static constexpr int8_t kColNdim = 2 + 2 * kKernelNdim;
-    static constexpr int8_t kOutNdim = 2 + kKernelNdim;
-
-    CHAINERX_ASSERT(kKernelNdim == static_cast<int8_t>(stride.size()));
-    CHAINERX_ASSERT(kColNdim == col.ndim());
-    CHAINERX_ASSERT(kOutNdim == out.ndim());
-
-    Indexer<kKernelNdim> kernel_indexer{Shape{col.shape().begin() + 2, col.shape().begin() + 2 + kKernelNdim}};
-    Indexer<kKernelNdim> in_image_dims_indexer{Shape{col.shape().begin() + 2 + kKernelNdim, col.shape().end()}};
-    Indexer<kColNdim> col_indexer{col.shape()};
-    Indexer<kOutNdim> out_indexer{out.shape()};
-    IndexableArray<const T, kColNdim> col_iarray{col};
-    IndexableArray<T, kOutNdim> out_iarray{out};
-
-    // Indices over the output image.
-    NdimIndex out_image_index{kKernelNdim};
-
-    auto it_kernel = kernel_indexer.It(0);
-    auto it_in_image_dims = in_image_dims_indexer.It(0);
-    auto it_col = col_indexer.It(0);
-    auto it_out = out_indexer.It(0);
-
-    for (auto it_batch_channel = batch_channel_indexer.It(0); it_batch_channel; ++it_batch_channel) {
-        it_col.CopyIndex(it_batch_channel);
-        it_out.CopyIndex(it_batch_channel);
-
-        for (it_kernel.Restart(); it_kernel; ++it_kernel) {
-            it_col.CopyIndex(it_kernel, 2);
-
-            for (it_in_image_dims.Restart(); it_in_image_dims; ++it_in_image_dims) {
-                for (int8_t i = 0; i < kKernelNdim; ++i) {
-                    out_image_index.index()[i] = it_in_image_dims.index()[i] * stride[i] + it_kernel.index()[i];
+// Minimum number of column elements to accumulate in a single thread.
+constexpr int64_t kMinChunkSize = int64_t{1} << 15;
+
+// Accumulates the columns col of shape (k_1, ..., k_n, in_1, ..., in_n) into an image of shape (out_1, ..., out_n), both C-contiguous.
+// The roles of the input and the output are swapped compared to Im2Col, i.e. g describes the image as the input of the convolution.
+// Columns in the padding are discarded.
+template <typename T>
+void Col2ImImage(const PatchGeometry& g, const T* col, T* y) {
+    int8_t last = g.ndim - 1;
+    int64_t col_last = g.out_dims[last];
+    StackVector<int64_t, kMaxNdim> k;  // Kernel position.
+    StackVector<int64_t, kMaxNdim> o;  // Column position, except for the last axis.
+    k.resize(g.ndim);
+    o.resize(g.ndim);
+
+    for (int64_t kernel_index = 0; kernel_index < g.kernel_total; ++kernel_index) {
+        for (int64_t i = last, rest = kernel_index; i >= 0; --i) {
+            k[i] = rest % g.kernel_size[i];
+            rest /= g.kernel_size[i];
+        }
+        OutRange range = g.GetRange(last, k[last]);
+        std::fill(o.begin(), o.end(), 0);
+
+        const T* src = col + kernel_index * g.out_total;
+        for (int64_t row = 0; row < g.out_total / col_last; ++row, src += col_last) {
+            int64_t offset{};
+            if (g.GetRowOffset(k, o, &offset) && range.begin < range.end) {
+                T* y_row = y + offset + range.begin * g.stride[last] + k[last] - g.pad[last];
+                if (g.stride[last] == 1) {
+                    for (int64_t j = range.begin; j < range.end; ++j, ++y_row) {
+                        *y_row += src[j];
+                    }
+                } else {
+                    for (int64_t j = range.begin; j < range.end; ++j, y_row += g.stride[last]) {
+                        *y_row += src[j];
+                    }
                 }
-                it_col.CopyIndex(it_in_image_dims, 2 + kKernelNdim);
-                it_out.CopyIndex(out_image_index, 2);
-
-                native_internal::StorageToDataType<T>(out_iarray[it_out]) +=
-                        native_internal::StorageToDataType<const T>(col_iarray[it_col]);
             }
+            g.IncrementRow(o);
         }
     }
 }
@@ -81,47 +78,47 @@ Array Col2Im(
     int64_t channels = col.shape()[1];
     auto ndim = static_cast<int8_t>(stride.size());
     CHAINERX_ASSERT(ndim * 2 + 2 == col.ndim());
+    CHAINERX_ASSERT(ndim == static_cast<int8_t>(pad.size()));
+    CHAINERX_ASSERT(ndim == static_cast<int8_t>(out_size.size()));
+
+    Device& device = col.device();
+    Shape out_shape{batch_size, channels};
+    std::copy(out_size.begin(), out_size.end(), std::back_inserter(out_shape));
+
+    if (ndim == 0) {
+        Array out = Empty(out_shape, col.dtype(), device);
+        device.Copy(col, out);
+        return out;
+    }
 
-    Shape padded_shape{batch_size, channels};
-    for (int8_t i = 0; i < ndim; ++i) {
-        padded_shape.emplace_back(out_size[i] + 2 * pad[i] + stride[i] - 1);
+    Array out = Zeros(out_shape, col.dtype(), device);
+    Array col_contiguous = internal::AsContiguous(col);
+    PatchGeometry g{Shape{out_size.begin(), out_size.end()},
+                    {col.shape().begin() + 2, col.shape().begin() + 2 + ndim},
+                    stride,
+                    pad,
+                    {col.shape().begin() + 2 + ndim, col.shape().end()}};
+    int64_t col_size = g.kernel_total * g.out_total;
+    if (col_size == 0) {
+        // Nothing is accumulated into the zero-filled output.
+        return out;
     }
-    Array padded_out = Zeros(padded_shape, col.dtype(), col.device());
-    CHAINERX_ASSERT(ndim + 2 == padded_out.ndim());
+    std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(device.backend()).GetThreadPool();
 
-    // Write to the output array
     VisitDtype(col.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
-        Indexer<2> batch_channel_indexer{Shape{batch_size, channels}};
-
-        static_assert(4 * 2 + 2 == kMaxNdim, "4 is the maximum kernel ndim whose col ndim does not exceed kMaxNdim");
-        switch (ndim) {
-            case 0:
-                Col2ImImpl<T, 0>(col, padded_out, stride, batch_channel_indexer);
-                break;
-            case 1:
-                Col2ImImpl<T, 1>(col, padded_out, stride, batch_channel_indexer);
-                break;
-            case 2:
-                Col2ImImpl<T, 2>(col, padded_out, stride, batch_channel_indexer);
-                break;
-            case 3:
-                Col2ImImpl<T, 3>(col, padded_out, stride, batch_channel_indexer);
-                break;
-            case 4:
-                Col2ImImpl<T, 4>(col, padded_out, stride, batch_channel_indexer);
-                break;
-            default:
-                CHAINERX_NEVER_REACH();  // Never col.ndim() > kMaxNdim
-                break;
-        }
+        const T* col_ptr = static_cast<const T*>(internal::GetRawOffsetData(col_contiguous));
+        T* out_ptr = static_cast<T*>(internal::GetRawOffsetData(out));
+
+        // Each image of the batch and channel dimensions is accumulated independently, so that no two threads write to the same elements.
+        ParallelFor(*pool, batch_size * channels, std::max(int64_t{1}, kMinChunkSize / col_size), [&](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end; ++i) {
+                Col2ImImage(g, col_ptr + i * col_size, out_ptr + i * g.in_size);
+            }
+        });
     });
 
-    std::vector<ArrayIndex> slice{ArrayIndex{Slice{}}, ArrayIndex{Slice{}}};  // All batch and channel dimensions.
-    for (int8_t i = 0; i < ndim; ++i) {
-        slice.emplace_back(Slice{pad[i], pad[i] + out_size[i]});
-    }
-    return padded_out.At(slice);
+    return out;
 }
 
 }  // namespace native_internal
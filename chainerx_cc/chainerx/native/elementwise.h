@@ -1,14 +1,23 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <type_traits>
 #include <tuple>
 #include <utility>
 
+#include "chainerx/array.h"
+#include "chainerx/axes.h"
+#include "chainerx/backend_util.h"
 #include "chainerx/constant.h"
+#include "chainerx/device.h"
 #include "chainerx/index_iterator.h"
 #include "chainerx/indexable_array.h"
 #include "chainerx/indexer.h"
+#include "chainerx/macro.h"
 #include "chainerx/native/data_type.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/thread_pool.h"
 #include "chainerx/shape.h"
 #include "chainerx/squash_dims.h"
 
@@ -16,21 +25,85 @@ namespace chainerx {
 namespace native {
 namespace elementwise_detail {
 
+// Minimum number of elements processed by a single thread.
+// Smaller arrays are processed serially since the cost of waking up the workers would dominate.
+constexpr int64_t kMinChunkSize = 32768;
+
+// Processes the elements in the range [begin, end) of the squashed index space.
 template <int8_t Ndim, typename Op, typename... Ts>
-void ElementwiseKernel(Op op, const Indexer<Ndim>& indexer, const IndexableArray<Ts, Ndim>&... args) {
-    for (auto it = indexer.It(0, 1); it; ++it) {
+void ElementwiseKernel(Op op, const Indexer<Ndim>& indexer, int64_t begin, int64_t end, const IndexableArray<Ts, Ndim>&... args) {
+    for (auto it = indexer.It(begin, 1); it.raw_index() < end; ++it) {
         op(it.raw_index(), native_internal::StorageToDataType<Ts>(args[it])...);
     }
 }
 
+// Processes the elements in the range [begin, end) of arrays that are all contiguous.
+// The loop is written over raw typed pointers so that the compiler can vectorize it after inlining the op.
+template <typename Op, typename... Ts>
+void ContiguousElementwiseKernel(Op op, int64_t begin, int64_t end, native_internal::StorageType<Ts>*... ptrs) {
+    for (int64_t i = begin; i < end; ++i) {
+        op(i, native_internal::StorageToDataType<Ts>(ptrs[i])...);
+    }
+}
+
+// Calls `kernel(begin, end)` on the range [0, total_size), splitting it among the threads of the backend if it is large enough.
+template <typename Kernel>
+void ParallelLaunch(NativeBackend& backend, int64_t total_size, const Kernel& kernel) {
+    if (total_size < 2 * kMinChunkSize) {
+        kernel(int64_t{0}, total_size);
+        return;
+    }
+    std::shared_ptr<ThreadPool> pool = backend.GetThreadPool();
+    ParallelFor(*pool, total_size, kMinChunkSize, kernel);
+}
+
+template <int8_t Ndim, typename Op, typename... Ts>
+void ParallelElementwiseKernel(Op op, NativeBackend& backend, const Indexer<Ndim>& indexer, const IndexableArray<Ts, Ndim>&... args) {
+    // Each chunk works on its own copy of the op.
+    ParallelLaunch(backend, indexer.total_size(), [&](int64_t begin, int64_t end) {
+        ElementwiseKernel<Ndim, Op, Ts...>(op, indexer, begin, end, args...);
+    });
+}
+
 template <int8_t Ndim, typename Op, typename... Ts, typename... Arrays>
-void LaunchElementwiseKernel(Op&& op, const Shape& shape, const Axes& keep, const Arrays&... args) {
-    ElementwiseKernel<Ndim, Op, Ts...>(
-            op, Indexer<Ndim>{shape}, IndexableArray<Ts, Ndim>{args, GetSquashedStrides(args.strides(), keep)}...);
+void LaunchElementwiseKernel(Op&& op, NativeBackend& backend, const Shape& shape, const Axes& keep, const Arrays&... args) {
+    ParallelElementwiseKernel<Ndim, Op, Ts...>(
+            op, backend, Indexer<Ndim>{shape}, IndexableArray<Ts, Ndim>{args, GetSquashedStrides(args.strides(), keep)}...);
+}
+
+template <typename Op, typename... Ts, typename... Arrays>
+void LaunchContiguousElementwiseKernel(Op&& op, NativeBackend& backend, int64_t total_size, const Arrays&... args) {
+    // Each chunk works on its own copy of the op.
+    ParallelLaunch(backend, total_size, [&](int64_t begin, int64_t end) {
+        ContiguousElementwiseKernel<std::decay_t<Op>, Ts...>(
+                op, begin, end, static_cast<native_internal::StorageType<Ts>*>(internal::GetRawOffsetData(args))...);
+    });
+}
+
+// Returns true if the arrays are all contiguous along the only axis that is kept after squashing.
+template <typename... Arrays>
+bool IsSquashedContiguous(const Axes& keep, const Arrays&... args) {
+    CHAINERX_ASSERT(keep.size() == 1);
+    for (bool contiguous : {true, (args.strides()[keep[0]] == args.GetItemSize())...}) {
+        if (!contiguous) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <typename Array, typename... Arrays>
+NativeBackend& GetNativeBackend(const Array& first, const Arrays&... /*rest*/) {
+    return static_cast<NativeBackend&>(first.device().backend());
 }
 
 }  // namespace elementwise_detail
 
+// Applies the op to each element of the arrays.
+//
+// If all the arrays are contiguous after squashing, the op is applied in a plain loop over raw pointers which the compiler can vectorize.
+// Large arrays are partitioned into contiguous chunks of the squashed index space, which are processed in parallel by the thread pool of
+// the native backend. The op is copied for each chunk and therefore must not rely on mutable state shared among elements.
 template <typename... Ts, typename... Arrays, typename Op>
 void Elementwise(Op&& op, const Arrays&... args) {
     static_assert(sizeof...(Ts) == sizeof...(Arrays), "Data types must be specified per Array. ");
@@ -38,23 +111,28 @@ void Elementwise(Op&& op, const Arrays&... args) {
     std::tuple<Shape, Axes> squashed_result = SquashShape(args...);
     const Shape& squashed = std::get<0>(squashed_result);
     const Axes& keep = std::get<1>(squashed_result);
+    NativeBackend& backend = elementwise_detail::GetNativeBackend(args...);
 
     // TODO(hvy): Reconsider the number of statically-optimized kernels in terms of speed and binary size trade-offs.
     switch (squashed.ndim()) {
         case 1:
-            elementwise_detail::LaunchElementwiseKernel<1, Op, Ts...>(std::forward<Op>(op), squashed, keep, args...);
+            if (elementwise_detail::IsSquashedContiguous(keep, args...)) {
+                elementwise_detail::LaunchContiguousElementwiseKernel<Op, Ts...>(std::forward<Op>(op), backend, squashed[0], args...);
+            } else {
+                elementwise_detail::LaunchElementwiseKernel<1, Op, Ts...>(std::forward<Op>(op), backend, squashed, keep, args...);
+            }
             break;
         case 2:
-            elementwise_detail::LaunchElementwiseKernel<2, Op, Ts...>(std::forward<Op>(op), squashed, keep, args...);
+            elementwise_detail::LaunchElementwiseKernel<2, Op, Ts...>(std::forward<Op>(op), backend, squashed, keep, args...);
             break;
         case 3:
-            elementwise_detail::LaunchElementwiseKernel<3, Op, Ts...>(std::forward<Op>(op), squashed, keep, args...);
+            elementwise_detail::LaunchElementwiseKernel<3, Op, Ts...>(std::forward<Op>(op), backend, squashed, keep, args...);
             break;
         case 4:
-            elementwise_detail::LaunchElementwiseKernel<4, Op, Ts...>(std::forward<Op>(op), squashed, keep, args...);
+            elementwise_detail::LaunchElementwiseKernel<4, Op, Ts...>(std::forward<Op>(op), backend, squashed, keep, args...);
             break;
         default:
-            elementwise_detail::LaunchElementwiseKernel<kDynamicNdim, Op, Ts...>(std::forward<Op>(op), squashed, keep, args...);
+            elementwise_detail::LaunchElementwiseKernel<kDynamicNdim, Op, Ts...>(std::forward<Op>(op), backend, squashed, keep, args...);
             break;
     }
 }
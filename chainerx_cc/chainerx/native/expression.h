@@ -0,0 +1,451 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "chainerx/arithmetic_ops.h"
+#include "chainerx/array.h"
+#include "chainerx/backprop_mode.h"
+#include "chainerx/dtype.h"
+#include "chainerx/error.h"
+#include "chainerx/graph.h"
+#include "chainerx/native/elementwise.h"
+#include "chainerx/native/fusion.h"
+#include "chainerx/native/native_device.h"
+#include "chainerx/numeric.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/scalar.h"
+#include "chainerx/shape.h"
+
+namespace chainerx {
+namespace native {
+
+// Expression templates of elementwise arithmetic on arrays.
+//
+// An expression is built from array operands wrapped by Ref(), scalars, the arithmetic operators and the functions of this namespace, and
+// is computed by Evaluate() or Assign() in a single Elementwise() pass without allocating intermediate arrays, e.g.
+//
+//     Array y = expr::Evaluate((expr::Ref(x) - expr::Ref(mean)) * expr::Ref(inv_std));
+//     expr::Assign(p, expr::Ref(p) - expr::Ref(grad) * lr);
+//
+// Operands are broadcast to a common shape, and scalars are cast to the dtype of the array operands, as in the corresponding routines.
+// An expression is computed by the routines instead, as if it were written with Array operators, if an operand requires grad in the current
+// backprop mode, is not on a native device, or does not have the same floating-point dtype as the other operands.
+//
+// Expressions hold references to the arrays given to Ref() and must therefore be evaluated within the full-expression creating them.
+// The kernels are instantiated in the translation units using this header. With GCC, compile them with -ftree-vectorize as chainerx_native
+// so that the loops over contiguous arrays are vectorized.
+namespace expr {
+namespace expr_detail {
+
+template <typename E>
+using EnableIfExpression = std::enable_if_t<E::kIsExpression, std::nullptr_t>;
+
+}  // namespace expr_detail
+
+// Array operand.
+class Ref {
+public:
+    static constexpr bool kIsExpression = true;
+    static constexpr size_t kNumArrays = 1;
+    static constexpr size_t kNumScalars = 0;
+
+    explicit Ref(const Array& array) : array_{array} {}
+
+    template <size_t ArrayOffset, size_t ScalarOffset, typename T>
+    static T Compute(const T* arrays, const T* /*scalars*/) {
+        return arrays[ArrayOffset];
+    }
+
+    template <size_t ArrayOffset, size_t NumArrays>
+    void CollectArrays(std::array<const Array*, NumArrays>& arrays) const {
+        arrays[ArrayOffset] = &array_;
+    }
+
+    template <size_t ScalarOffset, typename T, size_t NumScalars>
+    void CollectScalars(std::array<T, NumScalars>& /*scalars*/) const {}
+
+    const Array& EvaluateEager() const { return array_; }
+
+private:
+    const Array& array_;
+};
+
+namespace expr_detail {
+
+// Scalar operand.
+class ScalarRef {
+public:
+    static constexpr bool kIsExpression = true;
+    static constexpr size_t kNumArrays = 0;
+    static constexpr size_t kNumScalars = 1;
+
+    explicit ScalarRef(Scalar scalar) : scalar_{scalar} {}
+
+    template <size_t ArrayOffset, size_t ScalarOffset, typename T>
+    static T Compute(const T* /*arrays*/, const T* scalars) {
+        return scalars[ScalarOffset];
+    }
+
+    template <size_t ArrayOffset, size_t NumArrays>
+    void CollectArrays(std::array<const Array*, NumArrays>& /*arrays*/) const {}
+
+    template <size_t ScalarOffset, typename T, size_t NumScalars>
+    void CollectScalars(std::array<T, NumScalars>& scalars) const {
+        scalars[ScalarOffset] = static_cast<T>(scalar_);
+    }
+
+    Scalar EvaluateEager() const { return scalar_; }
+
+private:
+    Scalar scalar_;
+};
+
+template <typename Op, typename L, typename R>
+class Binary {
+public:
+    static constexpr bool kIsExpression = true;
+    static constexpr size_t kNumArrays = L::kNumArrays + R::kNumArrays;
+    static constexpr size_t kNumScalars = L::kNumScalars + R::kNumScalars;
+
+    Binary(L lhs, R rhs) : lhs_{std::move(lhs)}, rhs_{std::move(rhs)} {}
+
+    template <size_t ArrayOffset, size_t ScalarOffset, typename T>
+    static T Compute(const T* arrays, const T* scalars) {
+        return Op::Apply(
+                L::template Compute<ArrayOffset, ScalarOffset>(arrays, scalars),
+                R::template Compute<ArrayOffset + L::kNumArrays, ScalarOffset + L::kNumScalars>(arrays, scalars));
+    }
+
+    template <size_t ArrayOffset, size_t NumArrays>
+    void CollectArrays(std::array<const Array*, NumArrays>& arrays) const {
+        lhs_.template CollectArrays<ArrayOffset>(arrays);
+        rhs_.template CollectArrays<ArrayOffset + L::kNumArrays>(arrays);
+    }
+
+    template <size_t ScalarOffset, typename T, size_t NumScalars>
+    void CollectScalars(std::array<T, NumScalars>& scalars) const {
+        lhs_.template CollectScalars<ScalarOffset>(scalars);
+        rhs_.template CollectScalars<ScalarOffset + L::kNumScalars>(scalars);
+    }
+
+    Array EvaluateEager() const { return Op::Eager(lhs_.EvaluateEager(), rhs_.EvaluateEager()); }
+
+private:
+    L lhs_;
+    R rhs_;
+};
+
+template <typename Op, typename E>
+class Unary {
+public:
+    static constexpr bool kIsExpression = true;
+    static constexpr size_t kNumArrays = E::kNumArrays;
+    static constexpr size_t kNumScalars = E::kNumScalars;
+
+    explicit Unary(E operand) : operand_{std::move(operand)} {}
+
+    template <size_t ArrayOffset, size_t ScalarOffset, typename T>
+    static T Compute(const T* arrays, const T* scalars) {
+        return Op::Apply(E::template Compute<ArrayOffset, ScalarOffset>(arrays, scalars));
+    }
+
+    template <size_t ArrayOffset, size_t NumArrays>
+    void CollectArrays(std::array<const Array*, NumArrays>& arrays) const {
+        operand_.template CollectArrays<ArrayOffset>(arrays);
+    }
+
+    template <size_t ScalarOffset, typename T, size_t NumScalars>
+    void CollectScalars(std::array<T, NumScalars>& scalars) const {
+        operand_.template CollectScalars<ScalarOffset>(scalars);
+    }
+
+    Array EvaluateEager() const { return Op::Eager(operand_.EvaluateEager()); }
+
+private:
+    E operand_;
+};
+
+struct AddOp {
+    template <typename T>
+    static T Apply(T x1, T x2) {
+        return ArithmeticOps<T>::Add(x1, x2);
+    }
+    template <typename X1, typename X2>
+    static Array Eager(const X1& x1, const X2& x2) {
+        return chainerx::Add(x1, x2);
+    }
+};
+
+struct SubtractOp {
+    template <typename T>
+    static T Apply(T x1, T x2) {
+        return ArithmeticOps<T>::Subtract(x1, x2);
+    }
+    template <typename X1, typename X2>
+    static Array Eager(const X1& x1, const X2& x2) {
+        return chainerx::Subtract(x1, x2);
+    }
+};
+
+struct MultiplyOp {
+    template <typename T>
+    static T Apply(T x1, T x2) {
+        return ArithmeticOps<T>::Multiply(x1, x2);
+    }
+    template <typename X1, typename X2>
+    static Array Eager(const X1& x1, const X2& x2) {
+        return chainerx::Multiply(x1, x2);
+    }
+};
+
+struct DivideOp {
+    template <typename T>
+    static T Apply(T x1, T x2) {
+        return ArithmeticOps<T>::Divide(x1, x2);
+    }
+    template <typename X1, typename X2>
+    static Array Eager(const X1& x1, const X2& x2) {
+        return chainerx::Divide(x1, x2);
+    }
+};
+
+struct ExpOp {
+    template <typename T>
+    static T Apply(T x) {
+        return chainerx::Exp(x);
+    }
+    static Array Eager(const Array& x) { return chainerx::Exp(x); }
+};
+
+struct LogOp {
+    template <typename T>
+    static T Apply(T x) {
+        return chainerx::Log(x);
+    }
+    static Array Eager(const Array& x) { return chainerx::Log(x); }
+};
+
+struct SqrtOp {
+    template <typename T>
+    static T Apply(T x) {
+        return chainerx::Sqrt(x);
+    }
+    static Array Eager(const Array& x) { return chainerx::Sqrt(x); }
+};
+
+struct TanhOp {
+    template <typename T>
+    static T Apply(T x) {
+        return chainerx::Tanh(x);
+    }
+    static Array Eager(const Array& x) { return chainerx::Tanh(x); }
+};
+
+template <size_t I, typename T>
+using Repeat = T;
+
+// Computes the expression for each element of the broadcast array operands in a single Elementwise() call.
+template <typename T, typename E, size_t... Is>
+void LaunchKernel(const E& e, const std::array<Array, sizeof...(Is)>& arrays, const Array& out, std::index_sequence<Is...> /*indices*/) {
+    struct Impl {
+        void operator()(int64_t /*i*/, Repeat<Is, T>... values, T& out) {
+            const T array_values[] = {values...};
+            out = E::template Compute<0, 0>(array_values, scalars.data());
+        }
+        std::array<T, E::kNumScalars> scalars;
+    };
+    Impl impl{};
+    e.template CollectScalars<0>(impl.scalars);
+    Elementwise<Repeat<Is, const T>..., T>(std::move(impl), arrays[Is]..., out);
+}
+
+// Array operands of an expression, and the properties of the result.
+template <typename E>
+struct Operands {
+    explicit Operands(const E& e) {
+        e.template CollectArrays<0>(arrays);
+
+        const Array& first = *arrays[0];
+        dtype = first.dtype();
+        shape = first.shape();
+        fusible = GetKind(dtype) == DtypeKind::kFloat && dynamic_cast<NativeDevice*>(&first.device()) != nullptr;
+        for (const Array* array : arrays) {
+            if (array->dtype() != dtype || &array->device() != &first.device() || array->IsBackpropRequired(AnyGraph{})) {
+                fusible = false;
+            }
+            if (array->shape() != shape) {
+                shape = internal::BroadcastShapes(shape, array->shape());
+            }
+        }
+    }
+
+    std::array<const Array*, E::kNumArrays> arrays{};
+    Dtype dtype{};
+    Shape shape{};
+    bool fusible{};
+};
+
+template <typename E>
+void ComputeInto(const E& e, const Operands<E>& operands, const Array& out) {
+    // The array operands may be the outputs of operations deferred by a FusionScope.
+    native_internal::FusionBarrier fusion_barrier{};
+
+    std::array<Array, E::kNumArrays> broadcast{};
+    for (size_t i = 0; i < E::kNumArrays; ++i) {
+        const Array& array = *operands.arrays[i];
+        broadcast[i] = array.shape() == out.shape() ? array : array.BroadcastTo(out.shape());
+    }
+    VisitFloatingPointDtype(out.dtype(), [&](auto pt) {
+        using T = typename decltype(pt)::type;
+        LaunchKernel<T>(e, broadcast, out, std::make_index_sequence<E::kNumArrays>{});
+    });
+}
+
+// Returns true if writing to out while reading the array would overwrite elements before they are read.
+inline bool MayOverlap(const Array& out, const Array& array) {
+    if (out.data() != array.data()) {
+        return false;
+    }
+    return out.offset() != array.offset() || out.strides() != array.strides() || out.shape() != array.shape();
+}
+
+}  // namespace expr_detail
+
+// Computes an expression to a new array.
+template <typename E, expr_detail::EnableIfExpression<E> = nullptr>
+Array Evaluate(const E& e) {
+    static_assert(E::kNumArrays > 0, "An expression must have at least one array operand.");
+    expr_detail::Operands<E> operands{e};
+    if (!operands.fusible) {
+        return e.EvaluateEager();
+    }
+    Array out = Empty(operands.shape, operands.dtype, operands.arrays[0]->device());
+    expr_detail::ComputeInto(e, operands, out);
+    return out;
+}
+
+// Computes an expression into an existing array, which may also be an operand of the expression, as in `out = e`.
+// The result of the expression is broadcast to the shape of out, and must have the same dtype as out.
+//
+// Assignment to an array requiring grad, or of an expression with an operand requiring grad, is not allowed.
+template <typename E, expr_detail::EnableIfExpression<E> = nullptr>
+void Assign(const Array& out, const E& e) {
+    static_assert(E::kNumArrays > 0, "An expression must have at least one array operand.");
+    expr_detail::Operands<E> operands{e};
+    if (out.IsBackpropRequired(AnyGraph{}) || !internal::GetArrayBody(out)->nodes().empty()) {
+        throw ChainerxError{"In-place assignment to output array requiring grad is not allowed."};
+    }
+    for (const Array* array : operands.arrays) {
+        if (array->IsBackpropRequired(AnyGraph{})) {
+            throw ChainerxError{"In-place assignment that involves input arrays requiring grad is not allowed."};
+        }
+    }
+    if (operands.dtype != out.dtype()) {
+        throw DtypeError{"Cannot assign an expression of dtype ", operands.dtype, " to an array of dtype ", out.dtype(), "."};
+    }
+    if (internal::BroadcastShapes(operands.shape, out.shape()) != out.shape()) {
+        throw DimensionError{"Cannot assign an expression of shape ", operands.shape, " to an array of shape ", out.shape(), "."};
+    }
+
+    bool overlap = false;
+    for (const Array* array : operands.arrays) {
+        overlap |= expr_detail::MayOverlap(out, *array);
+    }
+    if (!operands.fusible || &out.device() != &operands.arrays[0]->device() || overlap) {
+        Array value = operands.fusible ? Evaluate(e) : e.EvaluateEager();
+        NoBackpropModeScope scope{};
+        out.device().Copy(value.shape() == out.shape() ? value : value.BroadcastTo(out.shape()), out);
+        return;
+    }
+    expr_detail::ComputeInto(e, operands, out);
+}
+
+template <typename L, typename R, expr_detail::EnableIfExpression<L> = nullptr, expr_detail::EnableIfExpression<R> = nullptr>
+expr_detail::Binary<expr_detail::AddOp, L, R> operator+(L lhs, R rhs) {
+    return {std::move(lhs), std::move(rhs)};
+}
+
+template <typename L, expr_detail::EnableIfExpression<L> = nullptr>
+expr_detail::Binary<expr_detail::AddOp, L, expr_detail::ScalarRef> operator+(L lhs, Scalar rhs) {
+    return {std::move(lhs), expr_detail::ScalarRef{rhs}};
+}
+
+template <typename R, expr_detail::EnableIfExpression<R> = nullptr>
+expr_detail::Binary<expr_detail::AddOp, expr_detail::ScalarRef, R> operator+(Scalar lhs, R rhs) {
+    return {expr_detail::ScalarRef{lhs}, std::move(rhs)};
+}
+
+template <typename L, typename R, expr_detail::EnableIfExpression<L> = nullptr, expr_detail::EnableIfExpression<R> = nullptr>
+expr_detail::Binary<expr_detail::SubtractOp, L, R> operator-(L lhs, R rhs) {
+    return {std::move(lhs), std::move(rhs)};
+}
+
+template <typename L, expr_detail::EnableIfExpression<L> = nullptr>
+expr_detail::Binary<expr_detail::SubtractOp, L, expr_detail::ScalarRef> operator-(L lhs, Scalar rhs) {
+    return {std::move(lhs), expr_detail::ScalarRef{rhs}};
+}
+
+template <typename R, expr_detail::EnableIfExpression<R> = nullptr>
+expr_detail::Binary<expr_detail::SubtractOp, expr_detail::ScalarRef, R> operator-(Scalar lhs, R rhs) {
+    return {expr_detail::ScalarRef{lhs}, std::move(rhs)};
+}
+
+template <typename L, typename R, expr_detail::EnableIfExpression<L> = nullptr, expr_detail::EnableIfExpression<R> = nullptr>
+expr_detail::Binary<expr_detail::MultiplyOp, L, R> operator*(L lhs, R rhs) {
+    return {std::move(lhs), std::move(rhs)};
+}
+
+template <typename L, expr_detail::EnableIfExpression<L> = nullptr>
+expr_detail::Binary<expr_detail::MultiplyOp, L, expr_detail::ScalarRef> operator*(L lhs, Scalar rhs) {
+    return {std::move(lhs), expr_detail::ScalarRef{rhs}};
+}
+
+template <typename R, expr_detail::EnableIfExpression<R> = nullptr>
+expr_detail::Binary<expr_detail::MultiplyOp, expr_detail::ScalarRef, R> operator*(Scalar lhs, R rhs) {
+    return {expr_detail::ScalarRef{lhs}, std::move(rhs)};
+}
+
+template <typename L, typename R, expr_detail::EnableIfExpression<L> = nullptr, expr_detail::EnableIfExpression<R> = nullptr>
+expr_detail::Binary<expr_detail::DivideOp, L, R> operator/(L lhs, R rhs) {
+    return {std::move(lhs), std::move(rhs)};
+}
+
+// Scalar / expression is not provided since the corresponding routine is not supported.
+template <typename L, expr_detail::EnableIfExpression<L> = nullptr>
+expr_detail::Binary<expr_detail::DivideOp, L, expr_detail::ScalarRef> operator/(L lhs, Scalar rhs) {
+    return {std::move(lhs), expr_detail::ScalarRef{rhs}};
+}
+
+template <typename E, expr_detail::EnableIfExpression<E> = nullptr>
+expr_detail::Binary<expr_detail::MultiplyOp, E, expr_detail::ScalarRef> operator-(E e) {
+    return {std::move(e), expr_detail::ScalarRef{Scalar{-1}}};
+}
+
+template <typename E, expr_detail::EnableIfExpression<E> = nullptr>
+expr_detail::Unary<expr_detail::ExpOp, E> Exp(E e) {
+    return expr_detail::Unary<expr_detail::ExpOp, E>{std::move(e)};
+}
+
+template <typename E, expr_detail::EnableIfExpression<E> = nullptr>
+expr_detail::Unary<expr_detail::LogOp, E> Log(E e) {
+    return expr_detail::Unary<expr_detail::LogOp, E>{std::move(e)};
+}
+
+template <typename E, expr_detail::EnableIfExpression<E> = nullptr>
+expr_detail::Unary<expr_detail::SqrtOp, E> Sqrt(E e) {
+    return expr_detail::Unary<expr_detail::SqrtOp, E>{std::move(e)};
+}
+
+template <typename E, expr_detail::EnableIfExpression<E> = nullptr>
+expr_detail::Unary<expr_detail::TanhOp, E> Tanh(E e) {
+    return expr_detail::Unary<expr_detail::TanhOp, E>{std::move(e)};
+}
+
+}  // namespace expr
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,179 @@
+#include "chainerx/native/expression.h"
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/backward.h"
+#include "chainerx/device.h"
+#include "chainerx/device_id.h"
+#include "chainerx/dtype.h"
+#include "chainerx/error.h"
+#include "chainerx/native/fusion.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/shape.h"
+#include "chainerx/testing/array_check.h"
+#include "chainerx/testing/device_session.h"
+
+namespace chainerx {
+namespace native {
+namespace {
+
+Array MakeInput(const Shape& shape, Dtype dtype, int64_t seed, Device& device) {
+    Array a = Empty(shape, Dtype::kFloat64, device);
+    auto data = static_cast<double*>(a.raw_data());
+    for (int64_t i = 0; i < a.GetTotalSize(); ++i) {
+        data[i] = static_cast<double>((i * 7 + seed) % 13 + 1) / 4;
+    }
+    return a.AsType(dtype);
+}
+
+class ExpressionTest : public ::testing::TestWithParam<int> {
+protected:
+    void SetUp() override {
+        device_session_.emplace(DeviceId{"native", 0});
+        static_cast<NativeBackend&>(device().backend()).SetNumThreads(GetParam());
+    }
+
+    void TearDown() override { device_session_.reset(); }
+
+    Device& device() { return device_session_->device(); }
+
+private:
+    nonstd::optional<testing::DeviceSession> device_session_;
+};
+
+// Large enough to be split into multiple chunks.
+constexpr int64_t kRows = 300;
+constexpr int64_t kCols = 257;
+
+TEST_P(ExpressionTest, Evaluate) {
+    using expr::Ref;
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array y = MakeInput({kRows, kCols}, Dtype::kFloat32, 1, device());
+
+    Array expected = (Tanh(x * y + 2) - Exp(x) / 3) * Sqrt(y) - Log(x) + (-x);
+    Array actual =
+            expr::Evaluate((expr::Tanh(Ref(x) * Ref(y) + 2) - expr::Exp(Ref(x)) / 3) * expr::Sqrt(Ref(y)) - expr::Log(Ref(x)) + (-Ref(x)));
+    EXPECT_ARRAY_ALL_CLOSE2(expected, actual);
+}
+
+TEST_P(ExpressionTest, EvaluateScalarOperands) {
+    using expr::Ref;
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat64, 0, device());
+    EXPECT_ARRAY_ALL_CLOSE2(1 - (x * 2 + 3), expr::Evaluate(1 - (2 * Ref(x) + 3)));
+}
+
+TEST_P(ExpressionTest, EvaluateBroadcast) {
+    using expr::Ref;
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array mean = MakeInput({kCols}, Dtype::kFloat32, 1, device());
+    Array inv_std = MakeInput({kRows, 1}, Dtype::kFloat32, 2, device());
+    EXPECT_ARRAY_ALL_CLOSE2((x - mean) * inv_std, expr::Evaluate((Ref(x) - Ref(mean)) * Ref(inv_std)));
+}
+
+TEST_P(ExpressionTest, EvaluateNonContiguous) {
+    using expr::Ref;
+    Array x = MakeInput({kCols, kRows}, Dtype::kFloat32, 0, device()).Transpose();
+    Array y = MakeInput({kRows, kCols}, Dtype::kFloat32, 1, device());
+    EXPECT_ARRAY_ALL_CLOSE2(x * y - x, expr::Evaluate(Ref(x) * Ref(y) - Ref(x)));
+}
+
+TEST_P(ExpressionTest, EvaluateFloat16) {
+    using expr::Ref;
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat16, 0, device());
+    Array actual = expr::Evaluate(Ref(x) * Ref(x) + 1);
+    EXPECT_EQ(Dtype::kFloat16, actual.dtype());
+    EXPECT_ARRAY_ALL_CLOSE2(x * x + 1, actual);
+}
+
+// Integral operands are computed by the routines, with their type promotion.
+TEST_P(ExpressionTest, EvaluateIntegral) {
+    using expr::Ref;
+    Array x = Arange(kRows * kCols, Dtype::kInt32, device()).Reshape({kRows, kCols});
+    Array actual = expr::Evaluate((Ref(x) * 3 + Ref(x)) / 2);
+    EXPECT_EQ(Dtype::kFloat64, actual.dtype());
+    EXPECT_ARRAY_ALL_CLOSE2((x * 3 + x) / 2, actual);
+}
+
+TEST_P(ExpressionTest, EvaluateMixedDtypes) {
+    using expr::Ref;
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array y = MakeInput({kRows, kCols}, Dtype::kFloat64, 1, device());
+    EXPECT_THROW(expr::Evaluate(Ref(x) + Ref(y)), DtypeError);
+}
+
+TEST_P(ExpressionTest, EvaluateBackward) {
+    using expr::Ref;
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device()).RequireGrad();
+    Array y = MakeInput({kRows, kCols}, Dtype::kFloat32, 1, device());
+
+    Array z = expr::Evaluate(expr::Exp(Ref(x)) * Ref(y));
+    EXPECT_TRUE(z.IsBackpropRequired());
+    Backward(z);
+    EXPECT_ARRAY_ALL_CLOSE2(Exp(x.AsGradStopped()) * y, *x.GetGrad());
+}
+
+TEST_P(ExpressionTest, EvaluateInFusionScope) {
+    using expr::Ref;
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array expected = (x * 2 + 1) * x;
+
+    nonstd::optional<Array> actual{};
+    {
+        FusionScope scope{};
+        Array h = x * 2 + 1;
+        actual = expr::Evaluate(Ref(h) * Ref(x));
+    }
+    EXPECT_ARRAY_ALL_CLOSE2(expected, *actual);
+}
+
+TEST_P(ExpressionTest, Assign) {
+    using expr::Ref;
+    Array p = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array grad = MakeInput({kRows, kCols}, Dtype::kFloat32, 1, device());
+    Array expected = p - grad * 0.1f;
+
+    const void* data = p.raw_data();
+    expr::Assign(p, Ref(p) - Ref(grad) * 0.1f);
+    EXPECT_EQ(data, p.raw_data());
+    EXPECT_ARRAY_ALL_CLOSE2(expected, p);
+}
+
+TEST_P(ExpressionTest, AssignBroadcast) {
+    using expr::Ref;
+    Array out = Empty({kRows, kCols}, Dtype::kFloat32, device());
+    Array b = MakeInput({kCols}, Dtype::kFloat32, 0, device());
+    expr::Assign(out, Ref(b) * 2);
+    EXPECT_ARRAY_ALL_CLOSE2((b * 2).BroadcastTo(out.shape()), out);
+}
+
+// An operand overlapping the output in a different layout is computed into a temporary array first.
+TEST_P(ExpressionTest, AssignOverlap) {
+    using expr::Ref;
+    Array x = MakeInput({kRows, kRows}, Dtype::kFloat32, 0, device());
+    Array expected = x.Transpose() + 1;
+    expr::Assign(x, Ref(x.Transpose()) + 1);
+    EXPECT_ARRAY_ALL_CLOSE2(expected, x);
+}
+
+TEST_P(ExpressionTest, AssignInvalid) {
+    using expr::Ref;
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array out_dtype = Empty({kRows, kCols}, Dtype::kFloat64, device());
+    Array out_shape = Empty({kCols}, Dtype::kFloat32, device());
+    Array out_grad = Empty({kRows, kCols}, Dtype::kFloat32, device()).RequireGrad();
+    EXPECT_THROW(expr::Assign(out_dtype, Ref(x) + 1), DtypeError);
+    EXPECT_THROW(expr::Assign(out_shape, Ref(x) + 1), DimensionError);
+    EXPECT_THROW(expr::Assign(out_grad, Ref(x) + 1), ChainerxError);
+}
+
+INSTANTIATE_TEST_CASE_P(ForEachNumThreads, ExpressionTest, ::testing::Values(1, 4));
+
+}  // namespace
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,720 @@
+#include "chainerx/native/fusion.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "chainerx/arithmetic_ops.h"
+#include "chainerx/array.h"
+#include "chainerx/axes.h"
+#include "chainerx/backend_util.h"
+#include "chainerx/constant.h"
+#include "chainerx/dtype.h"
+#include "chainerx/error.h"
+#include "chainerx/indexable_array.h"
+#include "chainerx/indexer.h"
+#include "chainerx/macro.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/thread_pool.h"
+#include "chainerx/numeric.h"
+#include "chainerx/scalar.h"
+#include "chainerx/shape.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+namespace {
+
+// Number of elements processed at once by each operation of a fused pass, so that the intermediate values stay in the L1 cache.
+constexpr int64_t kTileSize = 256;
+
+// Minimum number of elements processed by a single thread, same as that of Elementwise().
+constexpr int64_t kMinChunkSize = 32768;
+
+// Maximum number of operations recorded before they are executed, which bounds the cost of looking up the operands.
+constexpr size_t kMaxNumNodes = 64;
+
+bool IsFusibleDtype(Dtype dtype) { return dtype == Dtype::kFloat32 || dtype == Dtype::kFloat64; }
+
+template <typename F>
+auto VisitFusibleDtype(Dtype dtype, F&& f) {
+    switch (dtype) {
+        case Dtype::kFloat32:
+            return std::forward<F>(f)(PrimitiveType<float>{});
+        case Dtype::kFloat64:
+            return std::forward<F>(f)(PrimitiveType<double>{});
+        default:
+            throw DtypeError{"Dtype ", dtype, " cannot be fused."};
+    }
+}
+
+// Returns true if the axes are the first or the last ones of the given number of dimensions.
+bool IsLeadingAxes(const Axes& axis) {
+    for (size_t i = 0; i < axis.size(); ++i) {
+        if (axis[i] != static_cast<int8_t>(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool IsTrailingAxes(const Axes& axis, int8_t ndim) {
+    for (size_t i = 0; i < axis.size(); ++i) {
+        if (axis[i] != static_cast<int8_t>(ndim - axis.size() + i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Copies the elements [begin, begin + n) of an array in row-major order to a buffer.
+void LoadElements(const Array& a, int64_t begin, int64_t n, void* dst) {
+    if (a.IsContiguous()) {
+        const auto* src = static_cast<const uint8_t*>(internal::GetRawOffsetData(a));
+        std::memcpy(dst, src + begin * a.GetItemSize(), n * a.GetItemSize());
+        return;
+    }
+    VisitFusibleDtype(a.dtype(), [&](auto pt) {
+        using T = typename decltype(pt)::type;
+        IndexableArray<const T, kDynamicNdim> a_iarray{a};
+        Indexer<kDynamicNdim> indexer{a.shape()};
+        T* typed_dst = static_cast<T*>(dst);
+        for (auto it = indexer.It(begin); it.raw_index() < begin + n; ++it) {
+            typed_dst[it.raw_index() - begin] = a_iarray[it];
+        }
+    });
+}
+
+// Copies a buffer to the elements [begin, begin + n) of an array in row-major order.
+void StoreElements(const Array& a, int64_t begin, int64_t n, const void* src) {
+    if (a.IsContiguous()) {
+        auto* dst = static_cast<uint8_t*>(internal::GetRawOffsetData(a));
+        std::memcpy(dst + begin * a.GetItemSize(), src, n * a.GetItemSize());
+        return;
+    }
+    VisitFusibleDtype(a.dtype(), [&](auto pt) {
+        using T = typename decltype(pt)::type;
+        IndexableArray<T, kDynamicNdim> a_iarray{a};
+        Indexer<kDynamicNdim> indexer{a.shape()};
+        const T* typed_src = static_cast<const T*>(src);
+        for (auto it = indexer.It(begin); it.raw_index() < begin + n; ++it) {
+            a_iarray[it] = typed_src[it.raw_index() - begin];
+        }
+    });
+}
+
+int64_t GetNumChunks(const ThreadPool& pool, int64_t total_size, int64_t min_chunk_size) {
+    return std::max<int64_t>(1, std::min<int64_t>(pool.num_threads(), total_size / std::max<int64_t>(min_chunk_size, 1)));
+}
+
+// Splits [0, total_size) into num_chunks contiguous chunks and calls `func(i_chunk, begin, end)` for each chunk in parallel.
+// Unlike ParallelFor, the chunk index is given so that the results of the chunks can be combined in a deterministic order.
+template <typename Func>
+void RunChunks(ThreadPool& pool, int64_t total_size, int64_t num_chunks, const Func& func) {
+    if (num_chunks <= 1) {
+        func(int64_t{0}, int64_t{0}, total_size);
+        return;
+    }
+    int64_t chunk_size = (total_size + num_chunks - 1) / num_chunks;
+    pool.Run(num_chunks, [total_size, chunk_size, &func](int64_t i_chunk) {
+        int64_t begin = std::min(i_chunk * chunk_size, total_size);
+        int64_t end = std::min(begin + chunk_size, total_size);
+        func(i_chunk, begin, end);
+    });
+}
+
+// Operand of a recorded operation.
+struct Operand {
+    // Index of the recorded operation computing the operand, or -1 if the operand is not computed in the graph.
+    int node;
+
+    // Index of the operand in the leaf arrays of the graph if node is -1.
+    int leaf;
+};
+
+struct Node {
+    FusionOp op;
+    std::vector<Operand> operands;
+    std::vector<Scalar> scalars;
+    Axes axis;  // Reduction axes of kSum.
+    Array out;
+};
+
+// Buffer of the values of a tile, either loaded from an array, computed by an operation, or both.
+struct Slot {
+    Dtype dtype;
+
+    // The array from which the values are loaded, or to which the computed values are stored. nullptr for intermediate values.
+    const Array* array;
+
+    bool load;
+
+    // If true, the values are read from and written to the array directly instead of the buffer.
+    bool direct;
+};
+
+struct Instruction {
+    FusionOp op;
+    int out_slot;
+    std::vector<int> in_slots;
+    const std::vector<Scalar>* scalars;
+};
+
+// Operations of a pass over the elements of a shape, optionally followed by a reduction of the values of a slot.
+struct Pass {
+    Shape shape;
+    std::vector<Slot> slots;
+    std::vector<Instruction> instructions;
+    const Node* sum{nullptr};
+    int sum_slot{-1};
+};
+
+template <typename T>
+void ExecuteInstruction(const Instruction& instruction, const std::vector<Slot>& slots, const std::vector<void*>& ptrs, int64_t n) {
+    T* out = static_cast<T*>(ptrs[instruction.out_slot]);
+    auto in = [&instruction, &ptrs](size_t i) { return static_cast<const T*>(ptrs[instruction.in_slots[i]]); };
+    auto scalar = [&instruction](size_t i) { return static_cast<T>((*instruction.scalars)[i]); };
+
+    switch (instruction.op) {
+        case FusionOp::kAdd: {
+            const T* x1 = in(0);
+            const T* x2 = in(1);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = ArithmeticOps<T>::Add(x1[i], x2[i]);
+            }
+            break;
+        }
+        case FusionOp::kAddAS: {
+            const T* x1 = in(0);
+            T x2 = scalar(0);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = ArithmeticOps<T>::Add(x1[i], x2);
+            }
+            break;
+        }
+        case FusionOp::kSubtract: {
+            const T* x1 = in(0);
+            const T* x2 = in(1);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = ArithmeticOps<T>::Subtract(x1[i], x2[i]);
+            }
+            break;
+        }
+        case FusionOp::kSubtractAS: {
+            const T* x1 = in(0);
+            T x2 = scalar(0);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = ArithmeticOps<T>::Subtract(x1[i], x2);
+            }
+            break;
+        }
+        case FusionOp::kMultiply: {
+            const T* x1 = in(0);
+            const T* x2 = in(1);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = ArithmeticOps<T>::Multiply(x1[i], x2[i]);
+            }
+            break;
+        }
+        case FusionOp::kMultiplyAS: {
+            const T* x1 = in(0);
+            T x2 = scalar(0);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = ArithmeticOps<T>::Multiply(x1[i], x2);
+            }
+            break;
+        }
+        case FusionOp::kDivide: {
+            const T* x1 = in(0);
+            const T* x2 = in(1);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = ArithmeticOps<T>::Divide(x1[i], x2[i]);
+            }
+            break;
+        }
+        case FusionOp::kDivideAS: {
+            const T* x1 = in(0);
+            T x2 = scalar(0);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = ArithmeticOps<T>::Divide(x1[i], x2);
+            }
+            break;
+        }
+        case FusionOp::kExp: {
+            const T* x = in(0);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = chainerx::Exp(x[i]);
+            }
+            break;
+        }
+        case FusionOp::kLog: {
+            const T* x = in(0);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = chainerx::Log(x[i]);
+            }
+            break;
+        }
+        case FusionOp::kSqrt: {
+            const T* x = in(0);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = chainerx::Sqrt(x[i]);
+            }
+            break;
+        }
+        case FusionOp::kTanh: {
+            const T* x = in(0);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = chainerx::Tanh(x[i]);
+            }
+            break;
+        }
+        case FusionOp::kAsType:
+            VisitFusibleDtype(slots[instruction.in_slots[0]].dtype, [&](auto in_pt) {
+                using InT = typename decltype(in_pt)::type;
+                const InT* a = static_cast<const InT*>(ptrs[instruction.in_slots[0]]);
+                for (int64_t i = 0; i < n; ++i) {
+                    out[i] = static_cast<T>(a[i]);
+                }
+            });
+            break;
+        case FusionOp::kIfLessElseASSA: {
+            const T* x1 = in(0);
+            const T* neg = in(1);
+            T x2 = scalar(0);
+            T pos = scalar(1);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = x1[i] < x2 ? pos : neg[i];
+            }
+            break;
+        }
+        case FusionOp::kIfGreaterElseASSA: {
+            const T* x1 = in(0);
+            const T* neg = in(1);
+            T x2 = scalar(0);
+            T pos = scalar(1);
+            for (int64_t i = 0; i < n; ++i) {
+                out[i] = x1[i] > x2 ? pos : neg[i];
+            }
+            break;
+        }
+        default:
+            CHAINERX_NEVER_REACH();
+    }
+}
+
+// Executes the instructions of a pass tile by tile. Each thread uses its own instance.
+class PassKernel {
+public:
+    explicit PassKernel(const Pass& pass)
+        : pass_{pass}, buffer_(pass.slots.size() * kTileSize * sizeof(double)), ptrs_(pass.slots.size()) {}
+
+    // Computes the elements [begin, end) of the pass shape in row-major order, and calls `on_tile(tile_begin, n, ptrs)` for each tile,
+    // where ptrs are the pointers to the values of the slots.
+    template <typename OnTile>
+    void Run(int64_t begin, int64_t end, OnTile&& on_tile) {
+        const std::vector<Slot>& slots = pass_.slots;
+        for (int64_t tile_begin = begin; tile_begin < end; tile_begin += kTileSize) {
+            int64_t n = std::min(kTileSize, end - tile_begin);
+
+            for (size_t i = 0; i < slots.size(); ++i) {
+                const Slot& slot = slots[i];
+                if (slot.direct) {
+                    ptrs_[i] = static_cast<uint8_t*>(internal::GetRawOffsetData(*slot.array)) + tile_begin * GetItemSize(slot.dtype);
+                } else {
+                    ptrs_[i] = &buffer_[i * kTileSize * sizeof(double)];
+                    if (slot.load) {
+                        LoadElements(*slot.array, tile_begin, n, ptrs_[i]);
+                    }
+                }
+            }
+
+            for (const Instruction& instruction : pass_.instructions) {
+                VisitFusibleDtype(slots[instruction.out_slot].dtype, [&](auto pt) {
+                    using T = typename decltype(pt)::type;
+                    ExecuteInstruction<T>(instruction, slots, ptrs_, n);
+                });
+            }
+
+            for (size_t i = 0; i < slots.size(); ++i) {
+                const Slot& slot = slots[i];
+                if (slot.array != nullptr && !slot.load && !slot.direct) {
+                    StoreElements(*slot.array, tile_begin, n, ptrs_[i]);
+                }
+            }
+
+            on_tile(tile_begin, n, ptrs_);
+        }
+    }
+
+private:
+    const Pass& pass_;
+    std::vector<uint8_t> buffer_;
+    std::vector<void*> ptrs_;
+};
+
+void ExecuteElementwisePass(ThreadPool& pool, const Pass& pass) {
+    int64_t total_size = pass.shape.GetTotalSize();
+    RunChunks(pool, total_size, GetNumChunks(pool, total_size, kMinChunkSize), [&pass](int64_t /*i_chunk*/, int64_t begin, int64_t end) {
+        PassKernel{pass}.Run(begin, end, [](int64_t /*tile_begin*/, int64_t /*n*/, const std::vector<void*>& /*ptrs*/) {});
+    });
+}
+
+// Stores the sums accumulated in double to the elements [begin, begin + sums.size()) of the output.
+template <typename T>
+void StoreSums(const Array& out, int64_t begin, const std::vector<double>& sums) {
+    std::vector<T> typed_sums(sums.begin(), sums.end());
+    StoreElements(out, begin, static_cast<int64_t>(typed_sums.size()), typed_sums.data());
+}
+
+// Sums are accumulated in double, even for float32 passes. Values are added one at a time in the order of the tiles, which would lose the
+// accuracy of the pairwise summation of the eager Sum if the accumulator were float.
+template <typename T>
+void ExecuteSumPass(ThreadPool& pool, const Pass& pass) {
+    const Array& out = pass.sum->out;
+    const Axes& axis = pass.sum->axis;
+    int sum_slot = pass.sum_slot;
+    int64_t total_size = pass.shape.GetTotalSize();
+    int64_t out_size = out.GetTotalSize();
+    if (total_size == 0) {
+        std::vector<T> zeros(out_size, T{0});
+        StoreElements(out, 0, out_size, zeros.data());
+        return;
+    }
+    int64_t reduce_size = total_size / out_size;
+
+    auto accumulate = [sum_slot](double* accum) {
+        return [sum_slot, accum](int64_t /*tile_begin*/, int64_t n, const std::vector<void*>& ptrs) {
+            const T* values = static_cast<const T*>(ptrs[sum_slot]);
+            double sum = *accum;
+            for (int64_t i = 0; i < n; ++i) {
+                sum += values[i];
+            }
+            *accum = sum;
+        };
+    };
+
+    if (out_size == 1) {
+        // Sums up all the elements. Each chunk computes a partial sum.
+        int64_t num_chunks = GetNumChunks(pool, total_size, kMinChunkSize);
+        std::vector<double> partial_sums(num_chunks, 0.0);
+        RunChunks(pool, total_size, num_chunks, [&](int64_t i_chunk, int64_t begin, int64_t end) {
+            PassKernel{pass}.Run(begin, end, accumulate(&partial_sums[i_chunk]));
+        });
+        double sum{0};
+        for (double partial_sum : partial_sums) {
+            sum += partial_sum;
+        }
+        auto typed_sum = static_cast<T>(sum);
+        StoreElements(out, 0, 1, &typed_sum);
+    } else if (IsTrailingAxes(axis, pass.shape.ndim())) {
+        // Each output element is the sum of a contiguous range of reduce_size elements.
+        int64_t min_chunk_size = std::max<int64_t>(1, kMinChunkSize / reduce_size);
+        RunChunks(pool, out_size, GetNumChunks(pool, out_size, min_chunk_size), [&](int64_t /*i_chunk*/, int64_t begin, int64_t end) {
+            PassKernel kernel{pass};
+            std::vector<double> sums(end - begin, 0.0);
+            for (int64_t i = begin; i < end; ++i) {
+                kernel.Run(i * reduce_size, (i + 1) * reduce_size, accumulate(&sums[i - begin]));
+            }
+            StoreSums<T>(out, begin, sums);
+        });
+    } else {
+        // The reduction axes are the leading ones. Each row of out_size elements is added to the output elements.
+        CHAINERX_ASSERT(IsLeadingAxes(axis));
+        int64_t min_chunk_size = std::max<int64_t>(1, kMinChunkSize / reduce_size);
+        RunChunks(pool, out_size, GetNumChunks(pool, out_size, min_chunk_size), [&](int64_t /*i_chunk*/, int64_t begin, int64_t end) {
+            PassKernel kernel{pass};
+            std::vector<double> sums(end - begin, 0.0);
+            for (int64_t row = 0; row < reduce_size; ++row) {
+                int64_t row_begin = row * out_size + begin;
+                kernel.Run(row_begin, row_begin + (end - begin), [&](int64_t tile_begin, int64_t n, const std::vector<void*>& ptrs) {
+                    const T* values = static_cast<const T*>(ptrs[sum_slot]);
+                    double* tile_sums = &sums[tile_begin - row_begin];
+                    for (int64_t i = 0; i < n; ++i) {
+                        tile_sums[i] += values[i];
+                    }
+                });
+            }
+            StoreSums<T>(out, begin, sums);
+        });
+    }
+}
+
+FusionGraph*& GetActiveGraph() {
+    thread_local FusionGraph* t_active_graph{nullptr};
+    return t_active_graph;
+}
+
+}  // namespace
+
+// Operations recorded in a FusionScope.
+//
+// Operations are kept in the recorded order. The operands computed by recorded operations refer to the operations, and the other
+// operands (leaves) are kept as arrays. The graph holds a reference to the output array of each operation, so that an output is known to
+// be unobservable if the graph holds the only reference to its array body and data.
+class FusionGraph {
+public:
+    bool Record(
+            FusionOp op, std::initializer_list<const Array*> inputs, std::initializer_list<Scalar> scalars, const Axes& axis, const Array& out);
+
+    void Flush();
+
+private:
+    // Returns true if the data is read or written by a recorded operation.
+    bool IsRecordedData(const std::shared_ptr<void>& data) const;
+
+    // Returns true if the array is a view of the output of a recorded operation, which has to be stored before it is read.
+    bool IsViewOfRecordedOutput(const Array& array) const;
+
+    Operand GetOperand(const Array& array);
+
+    void Execute(const std::vector<Node>& nodes, const std::vector<Array>& leaves);
+
+    std::vector<Node> nodes_;
+    std::vector<Array> leaves_;
+};
+
+bool FusionGraph::Record(
+        FusionOp op, std::initializer_list<const Array*> inputs, std::initializer_list<Scalar> scalars, const Axes& axis, const Array& out) {
+    if (!IsFusibleDtype(out.dtype())) {
+        return false;
+    }
+    for (const Array* input : inputs) {
+        if (!IsFusibleDtype(input->dtype()) || (op != FusionOp::kAsType && input->dtype() != out.dtype())) {
+            return false;
+        }
+        // In-place operations are not fused, since the output could be read by a recorded operation in the same pass.
+        if (input->data() == out.data()) {
+            return false;
+        }
+    }
+    if (IsRecordedData(out.data())) {
+        return false;
+    }
+
+    if (nodes_.size() >= kMaxNumNodes) {
+        Flush();
+    }
+    for (const Array* input : inputs) {
+        if (IsViewOfRecordedOutput(*input)) {
+            Flush();
+            break;
+        }
+    }
+
+    Node node{op, {}, scalars, axis, out};
+    for (const Array* input : inputs) {
+        node.operands.emplace_back(GetOperand(*input));
+    }
+    nodes_.emplace_back(std::move(node));
+    return true;
+}
+
+bool FusionGraph::IsRecordedData(const std::shared_ptr<void>& data) const {
+    return std::any_of(nodes_.begin(), nodes_.end(), [&data](const Node& node) { return node.out.data() == data; }) ||
+           std::any_of(leaves_.begin(), leaves_.end(), [&data](const Array& leaf) { return leaf.data() == data; });
+}
+
+bool FusionGraph::IsViewOfRecordedOutput(const Array& array) const {
+    return std::any_of(nodes_.begin(), nodes_.end(), [&array](const Node& node) {
+        return node.out.data() == array.data() && internal::GetArrayBody(node.out) != internal::GetArrayBody(array);
+    });
+}
+
+Operand FusionGraph::GetOperand(const Array& array) {
+    const std::shared_ptr<internal::ArrayBody>& body = internal::GetArrayBody(array);
+    for (size_t i = 0; i < nodes_.size(); ++i) {
+        if (internal::GetArrayBody(nodes_[i].out) == body) {
+            return {static_cast<int>(i), -1};
+        }
+    }
+    for (size_t i = 0; i < leaves_.size(); ++i) {
+        if (internal::GetArrayBody(leaves_[i]) == body) {
+            return {-1, static_cast<int>(i)};
+        }
+    }
+    leaves_.emplace_back(array);
+    return {-1, static_cast<int>(leaves_.size() - 1)};
+}
+
+void FusionGraph::Flush() {
+    if (nodes_.empty()) {
+        leaves_.clear();
+        return;
+    }
+    // The graph is cleared before the execution, so that it is left empty even if the execution fails.
+    std::vector<Node> nodes = std::move(nodes_);
+    std::vector<Array> leaves = std::move(leaves_);
+    nodes_.clear();
+    leaves_.clear();
+    Execute(nodes, leaves);
+}
+
+void FusionGraph::Execute(const std::vector<Node>& nodes, const std::vector<Array>& leaves) {
+    auto get_array = [&nodes, &leaves](const Operand& operand) -> const Array& {
+        return operand.node >= 0 ? nodes[operand.node].out : leaves[operand.leaf];
+    };
+
+    // Splits the operations into passes. A pass consists of consecutive operations of the same shape, and ends with a reduction if any.
+    std::vector<size_t> pass_of(nodes.size());
+    std::vector<size_t> pass_begins{};
+    {
+        const Shape* pass_shape{nullptr};
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            const Node& node = nodes[i];
+            const Shape& shape = node.op == FusionOp::kSum ? get_array(node.operands[0]).shape() : node.out.shape();
+            if (pass_shape == nullptr || shape != *pass_shape) {
+                pass_begins.emplace_back(i);
+                pass_shape = &shape;
+            }
+            pass_of[i] = pass_begins.size() - 1;
+            if (node.op == FusionOp::kSum) {
+                pass_shape = nullptr;
+            }
+        }
+    }
+
+    // An output is computed if it is observable or used by a computed operation, and is stored if it is observable or used in another
+    // pass. Outputs are visited from the last one so that all the users of an output are visited before it.
+    std::vector<char> live(nodes.size(), false);
+    std::vector<char> store(nodes.size(), false);
+    for (size_t i = nodes.size(); i-- > 0;) {
+        const Node& node = nodes[i];
+        if (internal::GetArrayBody(node.out).use_count() > 1 || node.out.data().use_count() > 1) {
+            live[i] = true;
+            store[i] = true;
+        }
+        if (!live[i]) {
+            continue;
+        }
+        for (const Operand& operand : node.operands) {
+            if (operand.node >= 0) {
+                live[operand.node] = true;
+                if (pass_of[operand.node] != pass_of[i]) {
+                    store[operand.node] = true;
+                }
+            }
+        }
+    }
+
+    std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(nodes.front().out.device().backend()).GetThreadPool();
+
+    for (size_t i_pass = 0; i_pass < pass_begins.size(); ++i_pass) {
+        size_t begin = pass_begins[i_pass];
+        size_t end = i_pass + 1 < pass_begins.size() ? pass_begins[i_pass + 1] : nodes.size();
+
+        Pass pass{};
+        std::vector<int> node_slots(nodes.size(), -1);
+        std::vector<int> leaf_slots(leaves.size(), -1);
+        auto get_slot = [&](const Operand& operand) {
+            int& slot = operand.node >= 0 ? node_slots[operand.node] : leaf_slots[operand.leaf];
+            if (slot < 0) {
+                // An array computed in a previous pass or a leaf.
+                const Array& array = get_array(operand);
+                slot = static_cast<int>(pass.slots.size());
+                pass.slots.push_back(Slot{array.dtype(), &array, true, array.IsContiguous()});
+            }
+            return slot;
+        };
+
+        for (size_t i = begin; i < end; ++i) {
+            const Node& node = nodes[i];
+            if (!live[i]) {
+                continue;
+            }
+            if (node.op == FusionOp::kSum) {
+                pass.shape = get_array(node.operands[0]).shape();
+                pass.sum = &node;
+                pass.sum_slot = get_slot(node.operands[0]);
+                continue;
+            }
+            pass.shape = node.out.shape();
+            Instruction instruction{node.op, -1, {}, &node.scalars};
+            for (const Operand& operand : node.operands) {
+                instruction.in_slots.emplace_back(get_slot(operand));
+            }
+            instruction.out_slot = static_cast<int>(pass.slots.size());
+            node_slots[i] = instruction.out_slot;
+            pass.slots.push_back(Slot{node.out.dtype(), store[i] ? &node.out : nullptr, false, store[i] && node.out.IsContiguous()});
+            pass.instructions.emplace_back(std::move(instruction));
+        }
+
+        if (pass.sum != nullptr) {
+            VisitFusibleDtype(pass.sum->out.dtype(), [&](auto pt) {
+                using T = typename decltype(pt)::type;
+                ExecuteSumPass<T>(*pool, pass);
+            });
+        } else if (!pass.instructions.empty()) {
+            ExecuteElementwisePass(*pool, pass);
+        }
+    }
+}
+
+bool RecordElementwise(FusionOp op, std::initializer_list<const Array*> inputs, std::initializer_list<Scalar> scalars, const Array& out) {
+    CHAINERX_ASSERT(op != FusionOp::kSum);
+    FusionGraph* graph = GetActiveGraph();
+    if (graph == nullptr) {
+        return false;
+    }
+    if (graph->Record(op, inputs, scalars, Axes{}, out)) {
+        return true;
+    }
+    graph->Flush();
+    return false;
+}
+
+bool RecordSum(const Array& a, const Axes& axis, const Array& out) {
+    FusionGraph* graph = GetActiveGraph();
+    if (graph == nullptr) {
+        return false;
+    }
+    if ((IsLeadingAxes(axis) || IsTrailingAxes(axis, a.ndim())) && graph->Record(FusionOp::kSum, {&a}, {}, axis, out)) {
+        return true;
+    }
+    graph->Flush();
+    return false;
+}
+
+void FlushFusion() {
+    if (FusionGraph* graph = GetActiveGraph()) {
+        graph->Flush();
+    }
+}
+
+FusionBarrier::FusionBarrier() : graph_{GetActiveGraph()} {
+    if (graph_ != nullptr) {
+        graph_->Flush();
+        GetActiveGraph() = nullptr;
+    }
+}
+
+FusionBarrier::~FusionBarrier() {
+    if (graph_ != nullptr) {
+        GetActiveGraph() = graph_;
+    }
+}
+
+}  // namespace native_internal
+
+FusionScope::FusionScope() {
+    native_internal::FusionGraph*& active_graph = native_internal::GetActiveGraph();
+    if (active_graph == nullptr) {
+        graph_ = std::make_unique<native_internal::FusionGraph>();
+        active_graph = graph_.get();
+    }
+}
+
+FusionScope::~FusionScope() {
+    if (graph_ != nullptr) {
+        native_internal::GetActiveGraph() = nullptr;
+        graph_->Flush();
+    }
+}
+
+void FusionScope::Flush() { native_internal::FlushFusion(); }
+
+}  // namespace native
+}  // namespace chainerx
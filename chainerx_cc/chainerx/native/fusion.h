@@ -0,0 +1,108 @@
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+
+#include "chainerx/array.h"
+#include "chainerx/axes.h"
+#include "chainerx/scalar.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+
+class FusionGraph;
+
+}  // namespace native_internal
+
+// Records elementwise operations of native devices issued from this thread, and executes them lazily in fused passes.
+//
+// Within the scope, the following device operations on float32 and float64 arrays are recorded instead of being executed immediately:
+// Add, Subtract, Multiply, Divide (and their array-scalar variants), Exp, Log, Sqrt, Tanh, AsType, IfLessElseASSA, IfGreaterElseASSA and
+// Sum along leading or trailing axes. Recorded operations of the same shape are executed in a single pass over small tiles of elements,
+// and a Sum is executed in the pass computing its input. The result of an operation is written to its output array only if the array is
+// referenced by anything other than the recorded operations at the time of execution, e.g. by a variable, a view or a node retained for
+// backpropagation. Temporaries such as `x * t` in `-(x * t).Sum() / n` are therefore never stored.
+//
+// Recorded operations are executed when the scope ends, when Flush() or NativeDevice::Synchronize() is called, and before any other
+// operation of a native device is executed from this thread. Until then, the data of the arrays computed in the scope must not be
+// accessed directly, e.g. by Array::data(). AsScalar() synchronizes the device and can be used as usual. Graph construction for
+// backpropagation is not affected, since routines still create and connect the arrays as usual and only the device operations are
+// deferred.
+//
+// Scopes can be nested, in which case the inner ones have no effect.
+// The destructor terminates the program if an error is raised while executing the operations. Call Flush() before leaving the scope to
+// handle such errors.
+class FusionScope {
+public:
+    FusionScope();
+    ~FusionScope();
+
+    FusionScope(const FusionScope&) = delete;
+    FusionScope(FusionScope&&) = delete;
+    FusionScope& operator=(const FusionScope&) = delete;
+    FusionScope& operator=(FusionScope&&) = delete;
+
+    // Executes the operations recorded so far.
+    void Flush();
+
+private:
+    // The graph of this scope, or nullptr if this scope is nested in another.
+    std::unique_ptr<native_internal::FusionGraph> graph_;
+};
+
+namespace native_internal {
+
+enum class FusionOp {
+    kAdd,
+    kAddAS,
+    kSubtract,
+    kSubtractAS,
+    kMultiply,
+    kMultiplyAS,
+    kDivide,
+    kDivideAS,
+    kExp,
+    kLog,
+    kSqrt,
+    kTanh,
+    kAsType,
+    kIfLessElseASSA,
+    kIfGreaterElseASSA,
+    kSum,
+};
+
+// Records an elementwise operation of a native device to the active FusionScope of this thread and returns true.
+// Returns false if there is no active scope or the operation cannot be fused, in which case the caller must execute it immediately.
+// The operations recorded so far are executed before returning false, so that the caller can read and write any array.
+//
+// Array operands are given in the order of the corresponding Device member function, followed by the scalar operands.
+bool RecordElementwise(FusionOp op, std::initializer_list<const Array*> inputs, std::initializer_list<Scalar> scalars, const Array& out);
+
+// Same as RecordElementwise, for Device::Sum.
+bool RecordSum(const Array& a, const Axes& axis, const Array& out);
+
+// Executes the operations recorded to the active FusionScope of this thread, if any.
+void FlushFusion();
+
+// Executes the operations recorded to the active FusionScope of this thread, if any, and suspends the recording while this object is
+// alive.
+// Native device operations which are not fused create one before accessing any array, so that the operations they issue internally are
+// executed immediately.
+class FusionBarrier {
+public:
+    FusionBarrier();
+    ~FusionBarrier();
+
+    FusionBarrier(const FusionBarrier&) = delete;
+    FusionBarrier(FusionBarrier&&) = delete;
+    FusionBarrier& operator=(const FusionBarrier&) = delete;
+    FusionBarrier& operator=(FusionBarrier&&) = delete;
+
+private:
+    FusionGraph* graph_;
+};
+
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,228 @@
+#include "chainerx/native/fusion.h"
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/axes.h"
+#include "chainerx/backward.h"
+#include "chainerx/device.h"
+#include "chainerx/device_id.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/linalg.h"
+#include "chainerx/routines/manipulation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/scalar.h"
+#include "chainerx/shape.h"
+#include "chainerx/testing/array_check.h"
+#include "chainerx/testing/device_session.h"
+
+namespace chainerx {
+namespace native {
+namespace {
+
+Array MakeInput(const Shape& shape, Dtype dtype, int64_t seed, Device& device) {
+    Array a = Empty(shape, Dtype::kFloat64, device);
+    auto data = static_cast<double*>(a.raw_data());
+    for (int64_t i = 0; i < a.GetTotalSize(); ++i) {
+        data[i] = static_cast<double>((i * 7 + seed) % 13 - 6) / 4;
+    }
+    return a.AsType(dtype);
+}
+
+class FusionTest : public ::testing::TestWithParam<int> {
+protected:
+    void SetUp() override {
+        device_session_.emplace(DeviceId{"native", 0});
+        static_cast<NativeBackend&>(device().backend()).SetNumThreads(GetParam());
+    }
+
+    void TearDown() override { device_session_.reset(); }
+
+    Device& device() { return device_session_->device(); }
+
+    // Checks that the function gives the same result within a FusionScope as without.
+    template <typename F>
+    void CheckFused(F&& f, double rtol = 1e-5, double atol = 1e-8) {
+        Array expected = f();
+        Array actual = [&f]() {
+            FusionScope scope{};
+            return f();
+        }();
+        EXPECT_ARRAY_ALL_CLOSE4(expected, actual, rtol, atol);
+    }
+
+private:
+    nonstd::optional<testing::DeviceSession> device_session_;
+};
+
+// Large enough to be split into multiple chunks.
+constexpr int64_t kRows = 300;
+constexpr int64_t kCols = 257;
+
+TEST_P(FusionTest, Elementwise) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array y = MakeInput({kRows, kCols}, Dtype::kFloat32, 1, device());
+    CheckFused([&x, &y]() { return Subtract(Tanh(x * y + 2), Divide(Exp(x), 3)) * Sqrt(Add(y, 2)) - Log(Add(Multiply(x, x), 1)); });
+}
+
+TEST_P(FusionTest, ElementwiseFloat64AsType) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    CheckFused([&x]() { return Exp(x.AsType(Dtype::kFloat64) * 2).AsType(Dtype::kFloat32) + x; });
+}
+
+TEST_P(FusionTest, ElementwiseNonContiguous) {
+    Array x = MakeInput({kCols, kRows}, Dtype::kFloat32, 0, device()).Transpose();
+    Array y = MakeInput({kRows, kCols}, Dtype::kFloat32, 1, device());
+    CheckFused([&x, &y]() { return Maximum(x * y, 0) + Minimum(x, 0.5); });
+}
+
+TEST_P(FusionTest, ElementwiseBroadcast) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array b = MakeInput({kCols}, Dtype::kFloat32, 1, device());
+    CheckFused([&x, &b]() { return Tanh(x + b) * b; });
+}
+
+TEST_P(FusionTest, SumAll) {
+    // float64 so that the result does not depend on the order of the summation, which differs from that of the eager reduction.
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat64, 0, device());
+    Array t = MakeInput({kRows, kCols}, Dtype::kFloat64, 1, device());
+    CheckFused([&x, &t]() { return -Sum(Exp(x) * t) / (kRows * kCols); });
+}
+
+TEST_P(FusionTest, SumLeadingAxes) {
+    Array x = MakeInput({kRows, 3, kCols}, Dtype::kFloat64, 0, device());
+    CheckFused([&x]() { return Sum(Tanh(x) * x, Axes{0}); });
+    CheckFused([&x]() { return Sum(Tanh(x) * x, Axes{0, 1}, true); });
+}
+
+TEST_P(FusionTest, SumTrailingAxes) {
+    Array x = MakeInput({kRows, 3, kCols}, Dtype::kFloat64, 0, device());
+    CheckFused([&x]() { return Sum(Tanh(x) * x, Axes{2}); });
+    CheckFused([&x]() { return Sum(Tanh(x) * x, Axes{1, 2}, true); });
+}
+
+TEST_P(FusionTest, SumLargeFloat32) {
+    // Long enough that accumulating one at a time in float32 would lose the accuracy of the pairwise eager reduction.
+    Array x = MakeInput({4, 1 << 18}, Dtype::kFloat32, 0, device());
+    CheckFused([&x]() { return Sum(Exp(x)); });
+    CheckFused([&x]() { return Sum(Exp(x), Axes{1}); });
+    CheckFused([&x]() { return Sum(Exp(x.Transpose()), Axes{0}); });
+}
+
+TEST_P(FusionTest, SumMiddleAxis) {
+    Array x = MakeInput({kRows, 3, kCols}, Dtype::kFloat32, 0, device());
+    CheckFused([&x]() { return Sum(Exp(x), Axes{1}) * 2; });
+}
+
+TEST_P(FusionTest, SumZeroSize) {
+    Array x = MakeInput({0, kCols}, Dtype::kFloat32, 0, device());
+    CheckFused([&x]() { return Sum(Exp(x)); });
+    CheckFused([&x]() { return Sum(Exp(x), Axes{0}); });
+}
+
+// A chain followed by a reduction whose result is broadcast to the shape of the chain, as in softmax.
+TEST_P(FusionTest, SumBroadcast) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    CheckFused([&x]() {
+        Array e = Exp(x - 1);
+        return Log(e / Sum(e, Axes{1}, true));
+    });
+}
+
+TEST_P(FusionTest, IntermediateKept) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array h_expected = Tanh(x) * 2;
+    Array y_expected = Sum(h_expected + x);
+
+    nonstd::optional<Array> h{};
+    nonstd::optional<Array> y{};
+    {
+        FusionScope scope{};
+        h = Tanh(x) * 2;
+        y = Sum(*h + x);
+    }
+    EXPECT_ARRAY_ALL_CLOSE2(h_expected, *h);
+    EXPECT_ARRAY_ALL_CLOSE3(y_expected, *y, 1e-4);
+}
+
+TEST_P(FusionTest, Backward) {
+    Array x_value = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array t = MakeInput({kRows, kCols}, Dtype::kFloat32, 1, device());
+
+    Array x_expected = x_value.MakeView().RequireGrad();
+    Backward(Sum(Tanh(x_expected) * Exp(x_expected - t)));
+
+    Array x = x_value.MakeView().RequireGrad();
+    {
+        FusionScope scope{};
+        Backward(Sum(Tanh(x) * Exp(x - t)));
+    }
+    EXPECT_ARRAY_ALL_CLOSE2(*x_expected.GetGrad(), *x.GetGrad());
+}
+
+TEST_P(FusionTest, InPlace) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    CheckFused([&x]() {
+        Array a = x * 2;
+        a += x;
+        a *= Exp(x);
+        return a - 1;
+    });
+}
+
+TEST_P(FusionTest, IntegralDtype) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array i = Arange(kRows * kCols, Dtype::kInt32, device()).Reshape({kRows, kCols});
+    CheckFused([&x, &i]() { return (i * 3 + i).AsType(Dtype::kFloat32) * x; });
+}
+
+TEST_P(FusionTest, Dot) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array w = MakeInput({kCols, 17}, Dtype::kFloat32, 1, device());
+    CheckFused([&x, &w]() { return Tanh(Dot(Tanh(x) + 1, w)); }, 1e-4);
+}
+
+TEST_P(FusionTest, Nested) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    CheckFused([&x]() {
+        Array h = Exp(x);
+        {
+            FusionScope scope{};
+            h = h * 2;
+        }
+        return h + x;
+    });
+}
+
+TEST_P(FusionTest, Flush) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat32, 0, device());
+    Array expected = x * 2;
+
+    FusionScope scope{};
+    Array y = x * 2;
+    scope.Flush();
+    EXPECT_EQ(static_cast<const float*>(expected.raw_data())[kCols + 1], static_cast<const float*>(y.raw_data())[kCols + 1]);
+
+    Array z = x * 3;
+    device().Synchronize();
+    EXPECT_EQ(static_cast<const float*>(x.raw_data())[5] * 3, static_cast<const float*>(z.raw_data())[5]);
+}
+
+TEST_P(FusionTest, AsScalar) {
+    Array x = MakeInput({kRows, kCols}, Dtype::kFloat64, 0, device());
+    auto expected = static_cast<double>(AsScalar(Sum(Exp(x))));
+
+    FusionScope scope{};
+    EXPECT_NEAR(expected, static_cast<double>(AsScalar(Sum(Exp(x)))), 1e-6 * expected);
+}
+
+INSTANTIATE_TEST_CASE_P(ForEachNumThreads, FusionTest, ::testing::Values(1, 4));
+
+}  // namespace
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,379 @@
+#include "chainerx/native/gemm.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <vector>
+
+#ifdef __F16C__
+#include <immintrin.h>
+#endif  // __F16C__
+
+#include "chainerx/array.h"
+#include "chainerx/backend_util.h"
+#include "chainerx/dtype.h"
+#include "chainerx/float16.h"
+#include "chainerx/macro.h"
+#include "chainerx/native/data_type.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/thread_pool.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+namespace {
+
+// Accumulation type of each element type.
+template <typename T>
+struct AccumType {
+    using type = T;
+};
+
+template <>
+struct AccumType<Float16> {
+    using type = float;
+};
+
+template <>
+struct AccumType<int8_t> {
+    using type = int32_t;
+};
+
+template <>
+struct AccumType<int16_t> {
+    using type = int32_t;
+};
+
+template <>
+struct AccumType<uint8_t> {
+    using type = int32_t;
+};
+
+// Converts an element of an operand to the accumulation type during packing.
+template <typename AccT, typename T>
+AccT ToAccum(T x) {
+    return static_cast<AccT>(x);
+}
+
+// Converts float16 to float32 without calling the out-of-line Float16 conversion for each element.
+// The portable version rebiases the exponent and renormalizes subnormals with a floating-point subtraction; it is exact for all inputs.
+template <>
+float ToAccum<float, Float16>(Float16 x) {
+#ifdef __F16C__
+    return _cvtsh_ss(x.data());
+#else
+    constexpr uint32_t kShiftedExponent = uint32_t{0x7c00} << 13;
+    constexpr uint32_t kMagicBits = uint32_t{113} << 23;
+    float magic{};
+    std::memcpy(&magic, &kMagicBits, sizeof(float));
+
+    uint32_t bits = (uint32_t{x.data()} & 0x7fff) << 13;
+    uint32_t exponent = bits & kShiftedExponent;
+    bits += uint32_t{127 - 15} << 23;
+    if (exponent == kShiftedExponent) {
+        // Inf or NaN.
+        bits += uint32_t{128 - 16} << 23;
+    } else if (exponent == 0) {
+        // Zero or subnormal.
+        bits += uint32_t{1} << 23;
+        float f{};
+        std::memcpy(&f, &bits, sizeof(float));
+        f -= magic;
+        std::memcpy(&bits, &f, sizeof(float));
+    }
+    bits |= (uint32_t{x.data()} & 0x8000) << 16;
+    float f{};
+    std::memcpy(&f, &bits, sizeof(float));
+    return f;
+#endif  // __F16C__
+}
+
+// Converts an accumulator to the output element type.
+template <typename T, typename AccT>
+T FromAccum(AccT x) {
+    return static_cast<T>(x);
+}
+
+#ifdef __F16C__
+template <>
+Float16 FromAccum<Float16, float>(float x) {
+    return Float16::FromData(_cvtss_sh(x, _MM_FROUND_TO_NEAREST_INT));
+}
+#endif  // __F16C__
+
+template <typename AccT>
+AccT MultiplyAdd(AccT x, AccT y, AccT z) {
+    return x * y + z;
+}
+
+bool MultiplyAdd(bool x, bool y, bool z) { return (x && y) || z; }
+
+// Blocking parameters.
+//
+// The output is computed by a micro-kernel that keeps a kMr x Nr block of accumulators in registers, where Nr is chosen so that a row
+// spans 32 bytes. A kKc x Nr sliver of packed b is meant to stay in L1 cache, and a kMc x kKc block of packed a in L2 cache.
+constexpr int64_t kMr = 6;
+constexpr int64_t kMc = 64;
+constexpr int64_t kKc = 256;
+constexpr int64_t kNc = 512;
+
+template <typename AccT>
+constexpr int64_t GetNr() {
+    return std::min<int64_t>(16, std::max<int64_t>(4, 32 / sizeof(AccT)));
+}
+
+// Minimum number of multiply-adds to run in parallel.
+constexpr int64_t kMinParallelSize = int64_t{1} << 18;
+
+// Fully unrolls the following loop with a constant trip count, so that the accumulators of the micro-kernel can be kept in registers.
+#if defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 8)
+#define CHAINERX_GEMM_UNROLL _Pragma("GCC unroll 16")
+#else
+#define CHAINERX_GEMM_UNROLL
+#endif
+
+int64_t RoundUp(int64_t x, int64_t unit) { return (x + unit - 1) / unit * unit; }
+
+// Strided 2-dimensional view of a matrix in a batch, with strides in bytes.
+template <typename T>
+class Matrix {
+public:
+    // Views the matrix at the given byte offset from the data of a, whose last two axes are the matrix axes.
+    Matrix(const Array& a, int64_t offset)
+        : data_{static_cast<uint8_t*>(internal::GetRawOffsetData(a)) + offset},
+          row_stride_{a.strides()[a.ndim() - 2]},
+          col_stride_{a.strides()[a.ndim() - 1]} {}
+
+    T& operator()(int64_t i, int64_t j) const {
+        return *reinterpret_cast<T*>(data_ + i * row_stride_ + j * col_stride_);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+private:
+    uint8_t* data_;
+    int64_t row_stride_;
+    int64_t col_stride_;
+};
+
+// Packs a[i_begin:i_begin+mc, p_begin:p_begin+kc] into panels of kMr rows, each stored column by column.
+// Rows beyond mc are filled with zeros.
+template <typename T, typename AccT>
+void PackA(const Matrix<const T>& a, int64_t i_begin, int64_t mc, int64_t p_begin, int64_t kc, AccT* packed) {
+    for (int64_t ip = 0; ip < mc; ip += kMr) {
+        int64_t mr = std::min(kMr, mc - ip);
+        for (int64_t p = 0; p < kc; ++p) {
+            for (int64_t i = 0; i < mr; ++i) {
+                packed[i] = ToAccum<AccT>(a(i_begin + ip + i, p_begin + p));
+            }
+            std::fill(packed + mr, packed + kMr, AccT{});
+            packed += kMr;
+        }
+    }
+}
+
+// Packs the panel of b[:, j_begin:j_begin+Nr] row by row. Columns beyond n are filled with zeros.
+template <typename T, typename AccT, int64_t Nr>
+void PackBPanel(const Matrix<const T>& b, int64_t k, int64_t n, int64_t j_begin, AccT* packed) {
+    int64_t nr = std::min(Nr, n - j_begin);
+    for (int64_t p = 0; p < k; ++p) {
+        for (int64_t j = 0; j < nr; ++j) {
+            packed[j] = ToAccum<AccT>(b(p, j_begin + j));
+        }
+        std::fill(packed + nr, packed + Nr, AccT{});
+        packed += Nr;
+    }
+}
+
+// Accumulates the product of a kMr x kc panel of a and a kc x Nr panel of b into the kMr x Nr block c with leading dimension ldc.
+// The fixed trip counts of the inner loops let the compiler keep the accumulators in vector registers.
+template <typename AccT, int64_t Nr>
+void MicroKernel(int64_t kc, const AccT* a, const AccT* b, AccT* c, int64_t ldc) {
+    AccT acc[kMr][Nr];
+    CHAINERX_GEMM_UNROLL
+    for (int64_t i = 0; i < kMr; ++i) {
+        CHAINERX_GEMM_UNROLL
+        for (int64_t j = 0; j < Nr; ++j) {
+            acc[i][j] = c[i * ldc + j];
+        }
+    }
+    for (int64_t p = 0; p < kc; ++p) {
+        CHAINERX_GEMM_UNROLL
+        for (int64_t i = 0; i < kMr; ++i) {
+            AccT a_value = a[i];
+            CHAINERX_GEMM_UNROLL
+            for (int64_t j = 0; j < Nr; ++j) {
+                acc[i][j] = MultiplyAdd(a_value, b[j], acc[i][j]);
+            }
+        }
+        a += kMr;
+        b += Nr;
+    }
+    CHAINERX_GEMM_UNROLL
+    for (int64_t i = 0; i < kMr; ++i) {
+        CHAINERX_GEMM_UNROLL
+        for (int64_t j = 0; j < Nr; ++j) {
+            c[i * ldc + j] = acc[i][j];
+        }
+    }
+}
+
+// Computes a single matrix product. If pool is null, the computation is done on the calling thread.
+// If accumulate is true, the product is added to out_mat.
+template <typename T>
+void MatrixGemm(
+        const Matrix<const T>& a_mat,
+        const Matrix<const T>& b_mat,
+        const Matrix<T>& out_mat,
+        int64_t m,
+        int64_t k,
+        int64_t n,
+        bool accumulate,
+        ThreadPool* pool) {
+    using AccT = typename AccumType<T>::type;
+    constexpr int64_t kNr = GetNr<AccT>();
+    static_assert(kNc % kNr == 0, "kNc must be a multiple of Nr");
+
+    bool parallel = pool != nullptr;
+
+    // Pack the whole b once. It is shared among all the blocks of the output.
+    int64_t n_panels = RoundUp(n, kNr) / kNr;
+    std::unique_ptr<AccT[]> packed_b = std::make_unique<AccT[]>(n_panels * k * kNr);
+    auto pack_b = [&b_mat, &packed_b, k, n](int64_t begin, int64_t end) {
+        for (int64_t jp = begin; jp < end; ++jp) {
+            PackBPanel<T, AccT, kNr>(b_mat, k, n, jp * kNr, packed_b.get() + jp * k * kNr);
+        }
+    };
+    if (parallel) {
+        ParallelFor(*pool, n_panels, 1, pack_b);
+    } else {
+        pack_b(0, n_panels);
+    }
+
+    // Computes the block out[ic:ic+kMc, jc:jc+kNc].
+    int64_t m_blocks = RoundUp(m, kMc) / kMc;
+    int64_t n_blocks = RoundUp(n, kNc) / kNc;
+    auto compute_blocks = [&a_mat, &out_mat, &packed_b, m, n, k, n_blocks, accumulate](int64_t begin, int64_t end) {
+        std::unique_ptr<AccT[]> packed_a = std::make_unique<AccT[]>(RoundUp(kMc, kMr) * kKc);
+        std::unique_ptr<AccT[]> c = std::make_unique<AccT[]>(RoundUp(kMc, kMr) * kNc);
+        for (int64_t i_block = begin; i_block < end; ++i_block) {
+            int64_t ic = i_block / n_blocks * kMc;
+            int64_t jc = i_block % n_blocks * kNc;
+            int64_t mc = std::min(kMc, m - ic);
+            int64_t nc = std::min(kNc, n - jc);
+            int64_t mc_padded = RoundUp(mc, kMr);
+            int64_t nc_padded = RoundUp(nc, kNr);
+
+            std::fill_n(c.get(), mc_padded * nc_padded, AccT{});
+            if (accumulate) {
+                for (int64_t i = 0; i < mc; ++i) {
+                    for (int64_t j = 0; j < nc; ++j) {
+                        c[i * nc_padded + j] = ToAccum<AccT>(out_mat(ic + i, jc + j));
+                    }
+                }
+            }
+            for (int64_t pc = 0; pc < k; pc += kKc) {
+                int64_t kc = std::min(kKc, k - pc);
+                PackA(a_mat, ic, mc, pc, kc, packed_a.get());
+                for (int64_t jr = 0; jr < nc_padded; jr += kNr) {
+                    const AccT* b_panel = packed_b.get() + ((jc + jr) / kNr * k + pc) * kNr;
+                    for (int64_t ir = 0; ir < mc_padded; ir += kMr) {
+                        MicroKernel<AccT, kNr>(kc, packed_a.get() + ir * kc, b_panel, c.get() + ir * nc_padded + jr, nc_padded);
+                    }
+                }
+            }
+
+            for (int64_t i = 0; i < mc; ++i) {
+                for (int64_t j = 0; j < nc; ++j) {
+                    out_mat(ic + i, jc + j) = FromAccum<T>(c[i * nc_padded + j]);
+                }
+            }
+        }
+    };
+    if (parallel) {
+        ParallelFor(*pool, m_blocks * n_blocks, 1, compute_blocks);
+    } else {
+        compute_blocks(0, m_blocks * n_blocks);
+    }
+}
+
+template <typename T>
+void GemmImpl(const Array& a, const Array& b, const Array& out, bool accumulate) {
+    int64_t m = a.shape()[a.ndim() - 2];
+    int64_t k = a.shape()[a.ndim() - 1];
+    int64_t n = b.shape()[b.ndim() - 1];
+
+    std::vector<int64_t> a_offsets = GetMatrixOffsets(a);
+    std::vector<int64_t> b_offsets = GetMatrixOffsets(b);
+    std::vector<int64_t> out_offsets = GetMatrixOffsets(out);
+    auto batch_size = static_cast<int64_t>(out_offsets.size());
+
+    auto compute_matrices = [&](int64_t begin, int64_t end, ThreadPool* pool) {
+        for (int64_t i = begin; i < end; ++i) {
+            MatrixGemm<T>({a, a_offsets[i]}, {b, b_offsets[i]}, {out, out_offsets[i]}, m, k, n, accumulate, pool);
+        }
+    };
+
+    // Large matrices are computed one by one, each in parallel. Otherwise, matrices in the batch are distributed over the threads.
+    std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(out.device().backend()).GetThreadPool();
+    if (m * n * k >= kMinParallelSize) {
+        compute_matrices(0, batch_size, pool.get());
+    } else if (batch_size * m * n * k >= kMinParallelSize) {
+        ParallelFor(*pool, batch_size, 1, [&compute_matrices](int64_t begin, int64_t end) { compute_matrices(begin, end, nullptr); });
+    } else {
+        compute_matrices(0, batch_size, nullptr);
+    }
+}
+
+}  // namespace
+
+std::vector<int64_t> GetMatrixOffsets(const Array& a) {
+    CHAINERX_ASSERT(a.ndim() >= 2);
+    int8_t batch_ndim = a.ndim() - 2;
+    int64_t batch_size = std::accumulate(a.shape().begin(), a.shape().end() - 2, int64_t{1}, std::multiplies<>());
+
+    std::vector<int64_t> offsets(batch_size);
+    std::vector<int64_t> index(batch_ndim);
+    int64_t offset = 0;
+    for (int64_t i = 0; i < batch_size; ++i) {
+        offsets[i] = offset;
+        // Advances the index, the last batch axis being the fastest.
+        for (int8_t axis = batch_ndim - 1; axis >= 0; --axis) {
+            offset += a.strides()[axis];
+            if (++index[axis] < a.shape()[axis]) {
+                break;
+            }
+            offset -= a.strides()[axis] * a.shape()[axis];
+            index[axis] = 0;
+        }
+    }
+    return offsets;
+}
+
+void Gemm(const Array& a, const Array& b, const Array& out, bool accumulate) {
+    CHAINERX_ASSERT(a.ndim() >= 2);
+    CHAINERX_ASSERT(a.ndim() == b.ndim());
+    CHAINERX_ASSERT(a.ndim() == out.ndim());
+    CHAINERX_ASSERT(a.dtype() == out.dtype());
+    CHAINERX_ASSERT(b.dtype() == out.dtype());
+    CHAINERX_ASSERT(std::equal(a.shape().begin(), a.shape().end() - 2, out.shape().begin()));
+    CHAINERX_ASSERT(std::equal(b.shape().begin(), b.shape().end() - 2, out.shape().begin()));
+    CHAINERX_ASSERT(b.shape()[b.ndim() - 2] == a.shape()[a.ndim() - 1]);
+    CHAINERX_ASSERT(out.shape()[out.ndim() - 2] == a.shape()[a.ndim() - 2]);
+    CHAINERX_ASSERT(out.shape()[out.ndim() - 1] == b.shape()[b.ndim() - 1]);
+
+    if (out.GetTotalSize() == 0) {
+        return;
+    }
+
+    VisitDtype(out.dtype(), [&](auto pt) {
+        using T = typename decltype(pt)::type;
+        GemmImpl<T>(a, b, out, accumulate);
+    });
+}
+
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "chainerx/array.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+
+// Returns the byte offsets from the data of a batch of matrices to each matrix, in row-major order of the batch axes.
+// The last two axes of a are the matrix axes, and the others are the batch axes.
+std::vector<int64_t> GetMatrixOffsets(const Array& a);
+
+// Computes the matrix products of a and b, and stores them into out, overwriting its contents, or adds them to out if accumulate is true.
+//
+// This is an in-tree GEMM that does not depend on BLAS. a, b and out must be arrays of the same dtype, which can be any dtype, with
+// shapes (..., M, K), (..., K, N) and (..., M, N) respectively, where the batch axes "..." are the same for all of them.
+// They can have arbitrary strides, including zero strides of broadcast batch axes; operands are packed into contiguous panels regardless
+// of their layout.
+// Float16 is converted to float32 while packing and accumulated in float32, and integers narrower than 32 bits are accumulated in int32.
+// Results are converted to the dtype of out when written, so no temporary arrays of the wider type are allocated.
+// The computation is parallelized over blocks of the output, or over the batch if each matrix is small, using the thread pool of the
+// native backend.
+void Gemm(const Array& a, const Array& b, const Array& out, bool accumulate = false);
+
+// Computes the matrix products of a and b like Gemm, but calls BLAS for float32 and float64 if available.
+// Operands are cast to the dtype of out if necessary. If accumulate is true, the products are added to out, with beta = 1 for BLAS.
+// This is the implementation of NativeDevice::Dot and NativeDevice::BatchDot, defined along with them.
+void MatrixProduct(const Array& a, const Array& b, const Array& out, bool accumulate = false);
+
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
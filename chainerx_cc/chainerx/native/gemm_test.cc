@@ -0,0 +1,210 @@
+#include "chainerx/native/gemm.h"
+
+#include <cstdint>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "chainerx/array.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/float16.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/shape.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+namespace {
+
+template <typename T>
+T& At(const Array& a, int64_t i, int64_t j) {
+    auto data = static_cast<uint8_t*>(a.raw_data()) + a.offset() + i * a.strides()[0] + j * a.strides()[1];
+    return *reinterpret_cast<T*>(data);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+// Creates a rows x cols matrix with values in {-1, 0, 1} so that products are exact in every dtype.
+// If transposed is true, the matrix is a transposed view of a contiguous array.
+template <typename T>
+Array MakeMatrix(int64_t rows, int64_t cols, bool transposed, int64_t seed, Device& device) {
+    Array a = transposed ? Empty({cols, rows}, TypeToDtype<T>, device).Transpose() : Empty({rows, cols}, TypeToDtype<T>, device);
+    for (int64_t i = 0; i < rows; ++i) {
+        for (int64_t j = 0; j < cols; ++j) {
+            At<T>(a, i, j) = static_cast<T>((i * 7 + j * 5 + seed) % 3 - 1);
+        }
+    }
+    return a;
+}
+
+template <typename T>
+T ReferenceDot(const Array& a, const Array& b, int64_t i, int64_t j) {
+    using Acc = std::conditional_t<std::is_same<T, bool>{}, bool, std::conditional_t<std::is_integral<T>{}, int64_t, double>>;
+    Acc acc{};
+    for (int64_t p = 0; p < a.shape()[1]; ++p) {
+        Acc x = static_cast<Acc>(At<T>(a, i, p));
+        Acc y = static_cast<Acc>(At<T>(b, p, j));
+        acc = static_cast<Acc>(acc + x * y);
+    }
+    return static_cast<T>(acc);
+}
+
+class GemmTest : public ::testing::TestWithParam<std::tuple<Dtype, int>> {
+protected:
+    void SetUp() override {
+        context_.GetNativeBackend().SetNumThreads(std::get<1>(GetParam()));
+        device_ = &context_.GetDevice({"native", 0});
+    }
+
+    Dtype dtype() const { return std::get<0>(GetParam()); }
+
+    Device& device() { return *device_; }
+
+private:
+    Context context_;
+    Device* device_{nullptr};
+};
+
+TEST_P(GemmTest, Gemm) {
+    VisitDtype(dtype(), [this](auto pt) {
+        using T = typename decltype(pt)::type;
+        for (auto mkn : {std::make_tuple(1, 1, 1), std::make_tuple(5, 7, 3), std::make_tuple(67, 260, 515), std::make_tuple(3, 0, 4)}) {
+            int64_t m = std::get<0>(mkn);
+            int64_t k = std::get<1>(mkn);
+            int64_t n = std::get<2>(mkn);
+            for (bool a_transposed : {false, true}) {
+                for (bool b_transposed : {false, true}) {
+                    if (m * k * n > 1000 && a_transposed != b_transposed) {
+                        continue;  // Saves time. Large sizes are for testing blocking.
+                    }
+                    Array a = MakeMatrix<T>(m, k, a_transposed, 0, device());
+                    Array b = MakeMatrix<T>(k, n, b_transposed, 1, device());
+                    Array out = Full({m, n}, 1, TypeToDtype<T>, device());
+                    Gemm(a, b, out);
+                    for (int64_t i = 0; i < m; ++i) {
+                        for (int64_t j = 0; j < n; ++j) {
+                            ASSERT_EQ(ReferenceDot<T>(a, b, i, j), At<T>(out, i, j))
+                                    << "m=" << m << " k=" << k << " n=" << n << " i=" << i << " j=" << j;
+                        }
+                    }
+                }
+            }
+        }
+    });
+}
+
+TEST_P(GemmTest, GemmStridedOut) {
+    VisitDtype(dtype(), [this](auto pt) {
+        using T = typename decltype(pt)::type;
+        int64_t m = 9;
+        int64_t k = 20;
+        int64_t n = 33;
+        Array a = MakeMatrix<T>(m, k, false, 0, device());
+        Array b = MakeMatrix<T>(k, n, false, 1, device());
+        Array out = Empty({n, m}, TypeToDtype<T>, device()).Transpose();
+        Gemm(a, b, out);
+        for (int64_t i = 0; i < m; ++i) {
+            for (int64_t j = 0; j < n; ++j) {
+                ASSERT_EQ(ReferenceDot<T>(a, b, i, j), At<T>(out, i, j));
+            }
+        }
+    });
+}
+
+TEST_P(GemmTest, GemmAccumulate) {
+    VisitDtype(dtype(), [this](auto pt) {
+        using T = typename decltype(pt)::type;
+        // Spans multiple blocks of the output in both axes.
+        int64_t m = 70;
+        int64_t k = 20;
+        int64_t n = 530;
+        Array a = MakeMatrix<T>(m, k, false, 0, device());
+        Array b = MakeMatrix<T>(k, n, true, 1, device());
+        Array out = MakeMatrix<T>(m, n, false, 2, device());
+        Array out_orig = MakeMatrix<T>(m, n, false, 2, device());
+        Gemm(a, b, out, true);
+        using Acc = std::conditional_t<std::is_same<T, bool>{}, bool, std::conditional_t<std::is_integral<T>{}, int64_t, double>>;
+        for (int64_t i = 0; i < m; ++i) {
+            for (int64_t j = 0; j < n; ++j) {
+                auto expected = static_cast<Acc>(static_cast<Acc>(At<T>(out_orig, i, j)) + static_cast<Acc>(ReferenceDot<T>(a, b, i, j)));
+                ASSERT_EQ(static_cast<T>(expected), At<T>(out, i, j));
+            }
+        }
+    });
+}
+
+TEST_P(GemmTest, GemmBatch) {
+    VisitDtype(dtype(), [this](auto pt) {
+        using T = typename decltype(pt)::type;
+        int64_t batch_size = 5;
+        int64_t m = 4;
+        int64_t k = 6;
+        int64_t n = 3;
+        // a is broadcast along the batch axis and b is a batch of transposed matrices.
+        Array a = MakeMatrix<T>(m, k, false, 0, device()).BroadcastTo({batch_size, m, k});
+        Array b = Empty({batch_size, n, k}, TypeToDtype<T>, device()).Transpose({0, 2, 1});
+        for (int64_t i = 0; i < batch_size; ++i) {
+            Array b_i = b.At({i});
+            for (int64_t p = 0; p < k; ++p) {
+                for (int64_t j = 0; j < n; ++j) {
+                    At<T>(b_i, p, j) = static_cast<T>((p + j * 3 + i) % 3 - 1);
+                }
+            }
+        }
+        Array out = Empty({batch_size, m, n}, TypeToDtype<T>, device());
+        Gemm(a, b, out);
+        for (int64_t i = 0; i < batch_size; ++i) {
+            for (int64_t r = 0; r < m; ++r) {
+                for (int64_t j = 0; j < n; ++j) {
+                    ASSERT_EQ(ReferenceDot<T>(a.At({i}), b.At({i}), r, j), At<T>(out.At({i}), r, j)) << "i=" << i;
+                }
+            }
+        }
+    });
+}
+
+// Multiplies a column of float16 values by one, which must reproduce them exactly, including subnormals and infinities.
+TEST(GemmFloat16Test, ExactConversion) {
+    Context context;
+    Device& device = context.GetDevice({"native", 0});
+    std::vector<float> values{0.0f, 1.0f, -2.5f, 65504.0f, 6.1035156e-05f, 5.9604645e-08f, -3.0517578e-05f};
+    values.emplace_back(std::numeric_limits<float>::infinity());
+    values.emplace_back(-std::numeric_limits<float>::infinity());
+    auto m = static_cast<int64_t>(values.size());
+
+    Array a = Empty({m, 1}, Dtype::kFloat16, device);
+    for (int64_t i = 0; i < m; ++i) {
+        At<Float16>(a, i, 0) = Float16{values[i]};
+    }
+    Array b = Full({1, 1}, 1, Dtype::kFloat16, device);
+    Array out = Empty({m, 1}, Dtype::kFloat16, device);
+    Gemm(a, b, out);
+    for (int64_t i = 0; i < m; ++i) {
+        EXPECT_EQ(At<Float16>(a, i, 0).data(), At<Float16>(out, i, 0).data()) << "value=" << values[i];
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(
+        ForEachDtype,
+        GemmTest,
+        ::testing::Combine(
+                ::testing::Values(
+                        Dtype::kBool,
+                        Dtype::kInt8,
+                        Dtype::kInt16,
+                        Dtype::kInt32,
+                        Dtype::kInt64,
+                        Dtype::kUInt8,
+                        Dtype::kFloat16,
+                        Dtype::kFloat32,
+                        Dtype::kFloat64),
+                ::testing::Values(1, 4)));
+
+}  // namespace
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
@@ -2,20 +2,20 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <vector>
+#include <iterator>
+#include <memory>
 
 #include "chainerx/array.h"
-#include "chainerx/array_index.h"
+#include "chainerx/backend_util.h"
 #include "chainerx/constant.h"
 #include "chainerx/device.h"
-#include "chainerx/indexable_array.h"
-#include "chainerx/indexer.h"
 #include "chainerx/macro.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/thread_pool.h"
 #include "chainerx/routines/connection.h"
 #include "chainerx/routines/creation.h"
 #include "chainerx/scalar.h"
 #include "chainerx/shape.h"
-#include "chainerx/slice.h"
 #include "chainerx/stack_vector.h"
 
 namespace chainerx {
@@ -24,59 +24,111 @@ namespace native_internal {
 
 namespace {
 
-template <typename T, int8_t kKernelNdim>
-void Im2ColImpl(
-        const Array& x,
-        const Array& out,
-        const StackVector<int64_t, kMaxNdim>& kernel_size,
-        const StackVector<int64_t, kMaxNdim>& stride,
-        const StackVector<int64_t, kMaxNdim>& out_dims,
-        const Indexer<2>& batch_channel_indexer) {
-    static constexpr int8_t kInNdim = 2 + kKernelNdim;
-    static constexpr int8_t kOutNdim = 2 + 2 * kKernelNdim;
-
-    CHAINERX_ASSERT(kKernelNdim == static_cast<int8_t>(kernel_size.size()));
-    CHAINERX_ASSERT(kKernelNdim == static_cast<int8_t>(stride.size()));
-    CHAINERX_ASSERT(kKernelNdim == static_cast<int8_t>(out_dims.size()));
-    CHAINERX_ASSERT(kInNdim == x.ndim());
-    CHAINERX_ASSERT(kOutNdim == out.ndim());
-
-    Indexer<kKernelNdim> kernel_indexer{Shape{kernel_size.begin(), kernel_size.end()}};
-    Indexer<kKernelNdim> out_dims_indexer{Shape{out_dims.begin(), out_dims.end()}};
-    Indexer<kInNdim> x_indexer{x.shape()};
-    Indexer<kOutNdim> out_indexer{out.shape()};
-    IndexableArray<const T, kInNdim> x_iarray{x};
-    IndexableArray<T, kOutNdim> out_iarray{out};
-
-    NdimIndex img_index{kKernelNdim};
-
-    auto it_kernel = kernel_indexer.It(0);
-    auto it_out_dims = out_dims_indexer.It(0);
-    auto it_x = x_indexer.It(0);
-    auto it_out = out_indexer.It(0);
-
-    for (auto it_batch_channel = batch_channel_indexer.It(0); it_batch_channel; ++it_batch_channel) {
-        it_x.CopyIndex(it_batch_channel);
-        it_out.CopyIndex(it_batch_channel);
-
-        for (it_kernel.Restart(); it_kernel; ++it_kernel) {
-            it_out.CopyIndex(it_kernel, 2);
-
-            for (it_out_dims.Restart(); it_out_dims; ++it_out_dims) {
-                for (int i = 0; i < kKernelNdim; ++i) {
-                    img_index.index()[i] = it_out_dims.index()[i] * stride[i] + it_kernel.index()[i];
+// Minimum number of output elements to fill in a single thread.
+constexpr int64_t kMinChunkSize = int64_t{1} << 15;
+
+// Fills the columns of an image of shape (in_1, ..., in_n) into col of shape (k_1, ..., k_n, out_1, ..., out_n), both C-contiguous.
+// Positions in the padding are filled with pad_value.
+template <typename T>
+void Im2ColImage(const PatchGeometry& g, const T* x, T pad_value, T* col) {
+    int8_t last = g.ndim - 1;
+    int64_t out_last = g.out_dims[last];
+    StackVector<int64_t, kMaxNdim> k;  // Kernel position.
+    StackVector<int64_t, kMaxNdim> o;  // Output position, except for the last axis.
+    k.resize(g.ndim);
+    o.resize(g.ndim);
+
+    for (int64_t kernel_index = 0; kernel_index < g.kernel_total; ++kernel_index) {
+        for (int64_t i = last, rest = kernel_index; i >= 0; --i) {
+            k[i] = rest % g.kernel_size[i];
+            rest /= g.kernel_size[i];
+        }
+        OutRange range = g.GetRange(last, k[last]);
+        std::fill(o.begin(), o.end(), 0);
+
+        // Each row is a run of output positions along the last axis.
+        T* dst = col + kernel_index * g.out_total;
+        for (int64_t row = 0; row < g.out_total / out_last; ++row, dst += out_last) {
+            int64_t offset{};
+            if (!g.GetRowOffset(k, o, &offset) || range.begin >= range.end) {
+                std::fill_n(dst, out_last, pad_value);
+            } else {
+                const T* x_row = x + offset + range.begin * g.stride[last] + k[last] - g.pad[last];
+                std::fill_n(dst, range.begin, pad_value);
+                if (g.stride[last] == 1) {
+                    std::copy_n(x_row, range.end - range.begin, dst + range.begin);
+                } else {
+                    for (int64_t j = range.begin; j < range.end; ++j, x_row += g.stride[last]) {
+                        dst[j] = *x_row;
+                    }
                 }
-                it_x.CopyIndex(img_index, 2);
-                it_out.CopyIndex(it_out_dims, 2 + kKernelNdim);
-
-                out_iarray[it_out] = x_iarray[it_x];
+                std::fill(dst + range.end, dst + out_last, pad_value);
             }
+            g.IncrementRow(o);
         }
     }
 }
 
 }  // namespace
 
+PatchGeometry::PatchGeometry(
+        const Shape& in_dims,
+        const StackVector<int64_t, kMaxNdim>& kernel_size,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        const StackVector<int64_t, kMaxNdim>& out_dims)
+    : ndim{in_dims.ndim()},
+      in_dims{in_dims.begin(), in_dims.end()},
+      kernel_size{kernel_size},
+      stride{stride},
+      pad{pad},
+      out_dims{out_dims} {
+    CHAINERX_ASSERT(ndim >= 1);
+    CHAINERX_ASSERT(ndim == static_cast<int8_t>(kernel_size.size()));
+    CHAINERX_ASSERT(ndim == static_cast<int8_t>(stride.size()));
+    CHAINERX_ASSERT(ndim == static_cast<int8_t>(pad.size()));
+    CHAINERX_ASSERT(ndim == static_cast<int8_t>(out_dims.size()));
+
+    in_strides.resize(ndim);
+    for (int8_t i = ndim - 1; i >= 0; --i) {
+        in_strides[i] = in_size;
+        in_size *= in_dims[i];
+        kernel_total *= kernel_size[i];
+        out_total *= out_dims[i];
+    }
+}
+
+OutRange PatchGeometry::GetRange(int8_t axis, int64_t k) const {
+    // o * stride + k - pad >= 0 and o * stride + k - pad < in_dim.
+    int64_t s = stride[axis];
+    int64_t lower = pad[axis] - k;
+    int64_t upper = in_dims[axis] - k + pad[axis];
+    int64_t begin = lower > 0 ? (lower + s - 1) / s : 0;
+    int64_t end = upper > 0 ? std::min((upper + s - 1) / s, out_dims[axis]) : 0;
+    return {std::min(begin, end), end};
+}
+
+bool PatchGeometry::GetRowOffset(const StackVector<int64_t, kMaxNdim>& k, const StackVector<int64_t, kMaxNdim>& o, int64_t* offset) const {
+    *offset = 0;
+    for (int8_t i = 0; i < ndim - 1; ++i) {
+        int64_t pos = o[i] * stride[i] + k[i] - pad[i];
+        if (pos < 0 || pos >= in_dims[i]) {
+            return false;
+        }
+        *offset += pos * in_strides[i];
+    }
+    return true;
+}
+
+void PatchGeometry::IncrementRow(StackVector<int64_t, kMaxNdim>& o) const {
+    for (int8_t i = ndim - 2; i >= 0; --i) {
+        if (++o[i] < out_dims[i]) {
+            break;
+        }
+        o[i] = 0;
+    }
+}
+
 Array Im2Col(
         const Array& x,
         const StackVector<int64_t, kMaxNdim>& kernel_size,
@@ -91,26 +143,12 @@ Array Im2Col(
 
     Device& device = x.device();
 
-    // Create a padded copy of the input image.
-    // TODO(hvy): Use the Pad function when implemented.
-    Shape padded_shape = x.shape();
-    std::vector<ArrayIndex> unpadded_slice{ArrayIndex{Slice{}}, ArrayIndex{Slice{}}};  // All batch and channel dimensions.
-    for (int64_t i = 0; i < ndim; ++i) {
-        padded_shape[i + 2] += pad[i] * 2 + (cover_all ? stride[i] - 1 : 0);  // Pad on both sides.
-        unpadded_slice.emplace_back(Slice{pad[i], pad[i] + x.shape()[i + 2]});
-    }
-    Array padded_x = static_cast<int64_t>(pad_value) == int64_t{0} ? Zeros(padded_shape, x.dtype(), device)
-                                                                   : Full(padded_shape, pad_value, x.dtype(), device);
-    device.Copy(x, padded_x.At(unpadded_slice));
-    CHAINERX_ASSERT(ndim + 2 == padded_x.ndim());
-
-    // Create the output array.
-    StackVector<int64_t, kMaxNdim> out_dims;  // Number of patches along each axis
+    // Compute the number of patches along each axis.
+    StackVector<int64_t, kMaxNdim> out_dims;
     for (int8_t i = 0; i < ndim; ++i) {
         out_dims.emplace_back(internal::GetConvOutDim(x.shape()[i + 2], kernel_size[i], stride[i], pad[i], cover_all));
         CHAINERX_ASSERT(out_dims.back() > 0);
     }
-    CHAINERX_ASSERT(ndim == static_cast<int8_t>(out_dims.size()));
 
     int64_t batch_size = x.shape()[0];
     int64_t channels = x.shape()[1];
@@ -121,32 +159,32 @@ Array Im2Col(
     Array out = Empty(out_shape, x.dtype(), device);
     CHAINERX_ASSERT(ndim * 2 + 2 == out.ndim());
 
-    // Write to the output array.
+    if (ndim == 0) {
+        device.Copy(x, out);
+        return out;
+    }
+
+    // Padding is handled by bounds, so that the input is neither copied nor padded unless it is not C-contiguous.
+    Array x_contiguous = internal::AsContiguous(x);
+    PatchGeometry g{Shape{x.shape().begin() + 2, x.shape().end()}, kernel_size, stride, pad, out_dims};
+    int64_t col_size = g.kernel_total * g.out_total;
+    if (col_size == 0) {
+        return out;
+    }
+    std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(device.backend()).GetThreadPool();
+
     VisitDtype(x.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
-        Indexer<2> batch_channel_indexer{Shape{batch_size, channels}};
-
-        static_assert(4 * 2 + 2 == kMaxNdim, "4 is the maximum kernel ndim whose output ndim does not exceed kMaxNdim");
-        switch (ndim) {
-            case 0:
-                Im2ColImpl<T, 0>(padded_x, out, kernel_size, stride, out_dims, batch_channel_indexer);
-                break;
-            case 1:
-                Im2ColImpl<T, 1>(padded_x, out, kernel_size, stride, out_dims, batch_channel_indexer);
-                break;
-            case 2:
-                Im2ColImpl<T, 2>(padded_x, out, kernel_size, stride, out_dims, batch_channel_indexer);
-                break;
-            case 3:
-                Im2ColImpl<T, 3>(padded_x, out, kernel_size, stride, out_dims, batch_channel_indexer);
-                break;
-            case 4:
-                Im2ColImpl<T, 4>(padded_x, out, kernel_size, stride, out_dims, batch_channel_indexer);
-                break;
-            default:
-                CHAINERX_NEVER_REACH();  // Never out.ndim() > kMaxNdim
-                break;
-        }
+        const T* x_ptr = static_cast<const T*>(internal::GetRawOffsetData(x_contiguous));
+        T* out_ptr = static_cast<T*>(internal::GetRawOffsetData(out));
+        auto pad_value_t = static_cast<T>(pad_value);
+
+        // Each image of the batch and channel dimensions is filled independently.
+        ParallelFor(*pool, batch_size * channels, std::max(int64_t{1}, kMinChunkSize / col_size), [&](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end; ++i) {
+                Im2ColImage(g, x_ptr + i * g.in_size, pad_value_t, out_ptr + i * col_size);
+            }
+        });
     });
 
     return out;
@@ -5,12 +5,53 @@
 #include "chainerx/array.h"
 #include "chainerx/constant.h"
 #include "chainerx/scalar.h"
+#include "chainerx/shape.h"
 #include "chainerx/stack_vector.h"
 
 namespace chainerx {
 namespace native {
 namespace native_internal {
 
+// Range [begin, end) of output positions along an axis.
+struct OutRange {
+    int64_t begin;
+    int64_t end;
+};
+
+// Positions of the sliding windows over a C-contiguous image of shape (in_1, ..., in_n), shared by Im2Col and Col2Im.
+//
+// The input position of the output position o at the kernel position k is o * stride + k - pad along each axis. Output rows, i.e. runs
+// of output positions along the last axis, are the unit of copies between images and columns.
+struct PatchGeometry {
+    PatchGeometry(
+            const Shape& in_dims,
+            const StackVector<int64_t, kMaxNdim>& kernel_size,
+            const StackVector<int64_t, kMaxNdim>& stride,
+            const StackVector<int64_t, kMaxNdim>& pad,
+            const StackVector<int64_t, kMaxNdim>& out_dims);
+
+    // Returns the range of output positions along the axis whose input positions at the kernel position k are inside the image.
+    OutRange GetRange(int8_t axis, int64_t k) const;
+
+    // Computes the offset of the input row read by the output row o at the kernel position k, where the last elements of k and o are
+    // ignored. Returns false if the row is in the padding.
+    bool GetRowOffset(const StackVector<int64_t, kMaxNdim>& k, const StackVector<int64_t, kMaxNdim>& o, int64_t* offset) const;
+
+    // Advances o to the next output row.
+    void IncrementRow(StackVector<int64_t, kMaxNdim>& o) const;
+
+    int8_t ndim;
+    StackVector<int64_t, kMaxNdim> in_dims;
+    StackVector<int64_t, kMaxNdim> in_strides;  // In elements.
+    StackVector<int64_t, kMaxNdim> kernel_size;
+    StackVector<int64_t, kMaxNdim> stride;
+    StackVector<int64_t, kMaxNdim> pad;
+    StackVector<int64_t, kMaxNdim> out_dims;
+    int64_t in_size{1};
+    int64_t kernel_total{1};
+    int64_t out_total{1};
+};
+
 Array Im2Col(
         const Array& x,
         const StackVector<int64_t, kMaxNdim>& kernel_size,
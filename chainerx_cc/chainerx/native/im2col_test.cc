@@ -0,0 +1,156 @@
+#include "chainerx/native/im2col.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+
+#include <gtest/gtest.h>
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/constant.h"
+#include "chainerx/device.h"
+#include "chainerx/device_id.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/col2im.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/connection.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/shape.h"
+#include "chainerx/slice.h"
+#include "chainerx/stack_vector.h"
+#include "chainerx/testing/array_check.h"
+#include "chainerx/testing/device_session.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+namespace {
+
+Array MakeInput(const Shape& shape, int64_t seed, Device& device) {
+    Array a = Empty(shape, Dtype::kFloat64, device);
+    auto data = static_cast<double*>(a.raw_data());
+    for (int64_t i = 0; i < a.GetTotalSize(); ++i) {
+        data[i] = static_cast<double>((i * 7 + seed) % 13 - 6);
+    }
+    return a;
+}
+
+// Calls func(image_index, col_index, in_bounds) for each element of the columns, where image_index is the flat index of the image
+// element read by the column element at col_index, and in_bounds is false if it is in the padding.
+template <typename Func>
+void ForEachColElement(
+        const Shape& col_shape,
+        const Shape& image_shape,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        Func&& func) {
+    auto ndim = static_cast<int8_t>(stride.size());
+    int64_t col_size = col_shape.GetTotalSize();
+    for (int64_t col_index = 0; col_index < col_size; ++col_index) {
+        StackVector<int64_t, kMaxNdim> index;
+        index.resize(col_shape.ndim());
+        int64_t rest = col_index;
+        for (int8_t i = col_shape.ndim() - 1; i >= 0; --i) {
+            index[i] = rest % col_shape[i];
+            rest /= col_shape[i];
+        }
+
+        bool in_bounds = true;
+        int64_t image_index = index[0] * image_shape[1] + index[1];
+        for (int8_t i = 0; i < ndim; ++i) {
+            int64_t pos = index[2 + ndim + i] * stride[i] + index[2 + i] - pad[i];
+            in_bounds = in_bounds && pos >= 0 && pos < image_shape[2 + i];
+            image_index = image_index * image_shape[2 + i] + pos;
+        }
+        func(image_index, col_index, in_bounds);
+    }
+}
+
+class Im2ColTest : public ::testing::TestWithParam<int> {
+protected:
+    void SetUp() override {
+        device_session_.emplace(DeviceId{"native", 0});
+        static_cast<NativeBackend&>(device().backend()).SetNumThreads(GetParam());
+    }
+
+    void TearDown() override { device_session_.reset(); }
+
+    Device& device() { return device_session_->device(); }
+
+    // Compares Im2Col and Col2Im against the element-wise definitions.
+    void CheckIm2ColCol2Im(
+            const Array& x,
+            const StackVector<int64_t, kMaxNdim>& kernel_size,
+            const StackVector<int64_t, kMaxNdim>& stride,
+            const StackVector<int64_t, kMaxNdim>& pad,
+            bool cover_all) {
+        auto ndim = static_cast<int8_t>(kernel_size.size());
+        Shape col_shape{x.shape()[0], x.shape()[1]};
+        std::copy(kernel_size.begin(), kernel_size.end(), std::back_inserter(col_shape));
+        for (int8_t i = 0; i < ndim; ++i) {
+            col_shape.emplace_back(internal::GetConvOutDim(x.shape()[2 + i], kernel_size[i], stride[i], pad[i], cover_all));
+        }
+
+        Array x_contiguous = x.Copy();
+        auto x_data = static_cast<const double*>(x_contiguous.raw_data());
+        Array col_expected = Empty(col_shape, Dtype::kFloat64, device());
+        auto col_expected_data = static_cast<double*>(col_expected.raw_data());
+        ForEachColElement(col_shape, x.shape(), stride, pad, [&](int64_t image_index, int64_t col_index, bool in_bounds) {
+            col_expected_data[col_index] = in_bounds ? x_data[image_index] : -100.0;
+        });
+        EXPECT_ARRAY_EQ(col_expected, Im2Col(x, kernel_size, stride, pad, cover_all, -100.0));
+
+        Array col = MakeInput(col_shape, 1, device());
+        auto col_data = static_cast<const double*>(col.raw_data());
+        Array y_expected = Zeros(x.shape(), Dtype::kFloat64, device());
+        auto y_expected_data = static_cast<double*>(y_expected.raw_data());
+        ForEachColElement(col_shape, x.shape(), stride, pad, [&](int64_t image_index, int64_t col_index, bool in_bounds) {
+            if (in_bounds) {
+                y_expected_data[image_index] += col_data[col_index];
+            }
+        });
+        EXPECT_ARRAY_EQ(y_expected, Col2Im(col, stride, pad, {x.shape().begin() + 2, x.shape().end()}));
+    }
+
+private:
+    nonstd::optional<testing::DeviceSession> device_session_;
+};
+
+TEST_P(Im2ColTest, Im2Col1d) { CheckIm2ColCol2Im(MakeInput({2, 3, 11}, 0, device()), {3}, {1}, {1}, false); }
+
+TEST_P(Im2ColTest, Im2Col2d) { CheckIm2ColCol2Im(MakeInput({2, 3, 7, 9}, 0, device()), {3, 2}, {1, 1}, {1, 0}, false); }
+
+TEST_P(Im2ColTest, Im2Col2dStride) { CheckIm2ColCol2Im(MakeInput({2, 2, 10, 9}, 0, device()), {3, 3}, {2, 3}, {1, 2}, false); }
+
+TEST_P(Im2ColTest, Im2Col2dCoverAll) { CheckIm2ColCol2Im(MakeInput({1, 2, 10, 8}, 0, device()), {3, 2}, {3, 3}, {1, 1}, true); }
+
+// Padding larger than the kernel leaves rows entirely in the padding.
+TEST_P(Im2ColTest, Im2Col2dLargePad) { CheckIm2ColCol2Im(MakeInput({1, 2, 4, 5}, 0, device()), {2, 2}, {1, 2}, {3, 3}, false); }
+
+TEST_P(Im2ColTest, Im2Col3d) { CheckIm2ColCol2Im(MakeInput({2, 2, 5, 6, 4}, 0, device()), {2, 3, 2}, {2, 1, 1}, {1, 1, 0}, false); }
+
+TEST_P(Im2ColTest, Im2ColNonContiguous) {
+    Array x = MakeInput({2, 3, 12, 7}, 0, device()).At({Slice{}, Slice{}, Slice{0, 12, 2}, Slice{}}).Transpose({1, 0, 2, 3});
+    CheckIm2ColCol2Im(x, {3, 3}, {1, 1}, {1, 1}, false);
+}
+
+// Patches of the zero-size image are entirely in the padding.
+TEST_P(Im2ColTest, Im2ColZeroSizeImage) { CheckIm2ColCol2Im(MakeInput({1, 2, 0, 5}, 0, device()), {2, 2}, {1, 1}, {1, 0}, false); }
+
+TEST_P(Im2ColTest, Im2ColZeroSizeKernel) { CheckIm2ColCol2Im(MakeInput({1, 2, 6, 5}, 0, device()), {0, 2}, {1, 1}, {0, 0}, false); }
+
+TEST_P(Im2ColTest, Im2ColZeroSizeBatch) { CheckIm2ColCol2Im(MakeInput({0, 2, 6, 5}, 0, device()), {3, 2}, {1, 1}, {1, 0}, false); }
+
+// Zero-size columns, as in the transposed convolution of a zero-size input, are accumulated into a non-empty image of zeros.
+TEST_P(Im2ColTest, Col2ImZeroSizeColumns) {
+    Array col = Empty({2, 3, 3, 0}, Dtype::kFloat64, device());
+    EXPECT_ARRAY_EQ(Zeros({2, 3, 2}, Dtype::kFloat64, device()), Col2Im(col, {1}, {0}, {2}));
+}
+
+INSTANTIATE_TEST_CASE_P(ForEachNumThreads, Im2ColTest, ::testing::Values(1, 4));
+
+}  // namespace
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,264 @@
+#include "chainerx/native/implicit_gemm_conv.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/array_index.h"
+#include "chainerx/backend_util.h"
+#include "chainerx/constant.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/macro.h"
+#include "chainerx/native/data_type.h"
+#include "chainerx/native/gemm.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/thread_pool.h"
+#include "chainerx/routines/connection.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/shape.h"
+#include "chainerx/slice.h"
+#include "chainerx/stack_vector.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+namespace {
+
+// Minimum number of output positions in a tile of the column matrix, below which the matrix products become too thin to be efficient.
+constexpr int64_t kMinColTileWidth = 64;
+
+// Minimum number of elements of a tile to fill in a single thread.
+constexpr int64_t kMinFillChunkSize = int64_t{1} << 15;
+
+// Dimensions of a convolution.
+//
+// Rows of the column matrix correspond to (channel, k_1, ..., k_n) and columns to (out_1, ..., out_n), both in row-major order.
+struct ConvGeometry {
+    ConvGeometry(
+            const Shape& x_shape,
+            const StackVector<int64_t, kMaxNdim>& kernel_size,
+            const StackVector<int64_t, kMaxNdim>& stride,
+            const StackVector<int64_t, kMaxNdim>& pad,
+            bool cover_all)
+        : ndim{static_cast<int8_t>(kernel_size.size())}, channels{x_shape[1]}, kernel_size{kernel_size}, stride{stride}, pad{pad} {
+        CHAINERX_ASSERT(ndim >= 1);
+        CHAINERX_ASSERT(ndim == static_cast<int8_t>(stride.size()));
+        CHAINERX_ASSERT(ndim == static_cast<int8_t>(pad.size()));
+        CHAINERX_ASSERT(ndim + 2 == x_shape.ndim());
+
+        for (int8_t i = 0; i < ndim; ++i) {
+            in_dims.emplace_back(x_shape[2 + i]);
+            out_dims.emplace_back(internal::GetConvOutDim(in_dims[i], kernel_size[i], stride[i], pad[i], cover_all));
+            CHAINERX_ASSERT(out_dims.back() > 0);
+        }
+        in_strides.resize(ndim);
+        for (int8_t i = ndim - 1; i >= 0; --i) {
+            in_strides[i] = in_size;
+            in_size *= in_dims[i];
+            kernel_total *= kernel_size[i];
+            out_total *= out_dims[i];
+        }
+    }
+
+    int64_t col_rows() const { return channels * kernel_total; }
+
+    int8_t ndim;
+    int64_t channels;
+    StackVector<int64_t, kMaxNdim> in_dims;
+    StackVector<int64_t, kMaxNdim> in_strides;  // In elements, within a channel.
+    StackVector<int64_t, kMaxNdim> kernel_size;
+    StackVector<int64_t, kMaxNdim> stride;
+    StackVector<int64_t, kMaxNdim> pad;
+    StackVector<int64_t, kMaxNdim> out_dims;
+    int64_t in_size{1};  // Number of elements in a channel.
+    int64_t kernel_total{1};
+    int64_t out_total{1};
+};
+
+// Fills rows [row_begin, row_end) of the tile of the column matrix that covers the output positions [p_begin, p_begin + width).
+// x points to a C-contiguous image of shape (channels, in_1, ..., in_n), and col to the tile with leading dimension ld.
+// Positions in the padding are filled with zeros.
+template <typename T>
+void FillColTile(
+        const ConvGeometry& g, const T* x, int64_t row_begin, int64_t row_end, int64_t p_begin, int64_t width, T* col, int64_t ld) {
+    const auto zero = static_cast<T>(0);
+    int8_t last = g.ndim - 1;
+    StackVector<int64_t, kMaxNdim> k;  // Kernel position of the row.
+    StackVector<int64_t, kMaxNdim> o;  // Output position of the column.
+    k.resize(g.ndim);
+    o.resize(g.ndim);
+
+    for (int64_t row = row_begin; row < row_end; ++row) {
+        const T* x_channel = x + row / g.kernel_total * g.in_size;
+        for (int64_t i = last, rest = row % g.kernel_total; i >= 0; --i) {
+            k[i] = rest % g.kernel_size[i];
+            rest /= g.kernel_size[i];
+        }
+        for (int64_t i = last, rest = p_begin; i >= 0; --i) {
+            o[i] = rest % g.out_dims[i];
+            rest /= g.out_dims[i];
+        }
+        T* dst = col + row * ld;
+
+        // Each iteration fills a run of output positions along the last axis.
+        for (int64_t j = 0; j < width;) {
+            int64_t run = std::min(width - j, g.out_dims[last] - o[last]);
+
+            bool inside = true;
+            int64_t offset = 0;
+            for (int8_t i = 0; i < last; ++i) {
+                int64_t pos = o[i] * g.stride[i] + k[i] - g.pad[i];
+                if (pos < 0 || pos >= g.in_dims[i]) {
+                    inside = false;
+                    break;
+                }
+                offset += pos * g.in_strides[i];
+            }
+
+            if (inside) {
+                const T* x_row = x_channel + offset;
+                int64_t pos = o[last] * g.stride[last] + k[last] - g.pad[last];
+                for (int64_t t = 0; t < run; ++t, pos += g.stride[last]) {
+                    dst[j + t] = pos >= 0 && pos < g.in_dims[last] ? x_row[pos] : zero;
+                }
+            } else {
+                std::fill_n(dst + j, run, zero);
+            }
+
+            j += run;
+            o[last] += run;
+            for (int8_t i = last; i > 0 && o[i] == g.out_dims[i]; --i) {
+                o[i] = 0;
+                ++o[i - 1];
+            }
+        }
+    }
+}
+
+int64_t GetColTileWidth(const ConvGeometry& g, int64_t max_col_tile_size) {
+    int64_t width = std::max(kMinColTileWidth, max_col_tile_size / std::max(g.col_rows(), int64_t{1}));
+    return std::min(width, g.out_total);
+}
+
+// Builds the tiles of the column matrix of each image in x, and calls func(n, p_begin, col) for each tile, where col is the tile that
+// covers the output positions [p_begin, p_begin + col.shape()[1]) of the n-th image.
+// x must be C-contiguous.
+template <typename Func>
+void ForEachColTile(const ConvGeometry& g, const Array& x, int64_t max_col_tile_size, Func&& func) {
+    CHAINERX_ASSERT(x.IsContiguous());
+    int64_t batch_size = x.shape()[0];
+    int64_t width = GetColTileWidth(g, max_col_tile_size);
+    Array col = Empty({g.col_rows(), width}, x.dtype(), x.device());
+    std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(x.device().backend()).GetThreadPool();
+
+    VisitDtype(x.dtype(), [&](auto pt) {
+        using T = typename decltype(pt)::type;
+        const T* x_ptr = static_cast<const T*>(internal::GetRawOffsetData(x));
+        T* col_ptr = static_cast<T*>(internal::GetRawOffsetData(col));
+
+        for (int64_t n = 0; n < batch_size; ++n) {
+            const T* x_image = x_ptr + n * g.channels * g.in_size;
+            for (int64_t p = 0; p < g.out_total; p += width) {
+                int64_t tile_width = std::min(width, g.out_total - p);
+                ParallelFor(*pool, g.col_rows(), std::max(int64_t{1}, kMinFillChunkSize / tile_width), [&](int64_t begin, int64_t end) {
+                    FillColTile(g, x_image, begin, end, p, tile_width, col_ptr, width);
+                });
+                func(n, p, tile_width == width ? col : col.At({Slice{}, Slice{0, tile_width}}));
+            }
+        }
+    });
+}
+
+}  // namespace
+
+Array ImplicitGemmConv(
+        const Array& x,
+        const Array& w,
+        const nonstd::optional<Array>& b,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        bool cover_all,
+        Dtype out_dtype,
+        int64_t max_col_tile_size) {
+    StackVector<int64_t, kMaxNdim> kernel_size{w.shape().begin() + 2, w.shape().end()};
+    ConvGeometry g{x.shape(), kernel_size, stride, pad, cover_all};
+    Device& device = x.device();
+    int64_t batch_size = x.shape()[0];
+    int64_t out_channels = w.shape()[0];
+
+    Shape out_shape{batch_size, out_channels};
+    std::copy(g.out_dims.begin(), g.out_dims.end(), std::back_inserter(out_shape));
+    Array y = Empty(out_shape, out_dtype, device);
+    Array y_matrices = y.Reshape({batch_size, out_channels, g.out_total});
+
+    // Operands are converted to the output dtype once, so that the matrix products do not cast each tile.
+    Array x_cast = internal::AsContiguous(x, out_dtype);
+    Array w_matrix = w.AsType(out_dtype, false).Reshape({out_channels, g.col_rows()});
+
+    // y[n, :, p:p+width] = w_matrix @ col
+    // The products are empty if there are no input channels, in which case the output is filled with zeros instead.
+    if (g.col_rows() == 0) {
+        y.Fill(0);
+    } else {
+        ForEachColTile(g, x_cast, max_col_tile_size, [&](int64_t n, int64_t p, const Array& col) {
+            device.Dot(w_matrix, col, y_matrices.At({n, Slice{}, Slice{p, p + col.shape()[1]}}));
+        });
+    }
+
+    // Add bias, if given.
+    if (b.has_value()) {
+        std::vector<ArrayIndex> slice{NewAxis{}, Slice{}};
+        for (int8_t i = 0; i < g.ndim; ++i) {
+            slice.emplace_back(NewAxis{});
+        }
+        // TODO(niboshi): Remove AsType when += supports dtype promotion.
+        y += b->At(slice).AsType(out_dtype, false);
+    }
+
+    return y;
+}
+
+Array ImplicitGemmConvGradWeight(
+        Dtype w_dtype,
+        const Shape& w_shape,
+        const Array& x,
+        const Array& gy,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        bool cover_all,
+        int64_t max_col_tile_size) {
+    StackVector<int64_t, kMaxNdim> kernel_size{w_shape.begin() + 2, w_shape.end()};
+    ConvGeometry g{x.shape(), kernel_size, stride, pad, cover_all};
+    Device& device = x.device();
+    int64_t batch_size = x.shape()[0];
+    int64_t out_channels = w_shape[0];
+
+    Array gw = Empty(w_shape, w_dtype, device);
+    Array gw_matrix = gw.Reshape({out_channels, g.col_rows()});
+    Array gy_matrices = gy.AsType(w_dtype, false).Reshape({batch_size, out_channels, g.out_total});
+    Array x_cast = internal::AsContiguous(x, w_dtype);
+
+    // gw_matrix = sum of gy[n, :, p:p+width] @ col.T over all the tiles.
+    // The first product is written directly into gw_matrix, and the others are added to it by the GEMM.
+    bool is_first = true;
+    ForEachColTile(g, x_cast, max_col_tile_size, [&](int64_t n, int64_t p, const Array& col) {
+        Array gy_tile = gy_matrices.At({n, Slice{}, Slice{p, p + col.shape()[1]}});
+        MatrixProduct(gy_tile, col.Transpose(), gw_matrix, !is_first);
+        is_first = false;
+    });
+    if (is_first) {
+        gw.Fill(0);
+    }
+
+    return gw;
+}
+
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
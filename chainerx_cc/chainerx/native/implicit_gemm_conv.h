@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/constant.h"
+#include "chainerx/dtype.h"
+#include "chainerx/shape.h"
+#include "chainerx/stack_vector.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+
+// Default upper bound of the number of elements of a tile of the column matrix.
+constexpr int64_t kDefaultMaxColTileSize = int64_t{1} << 20;
+
+// Computes the n-dimensional convolution as an implicit GEMM, without materializing the whole column matrix returned by Im2Col.
+//
+// For each image in the batch, the column matrix of shape (channels * k_1 * ... * k_n, out_1 * ... * out_n) is built tile by tile from the
+// input, with at most max_col_tile_size elements per tile (but at least 64 output positions), and multiplied by the weight matrix
+// directly into the output. Padded positions are filled with zeros while building the tiles, so no padded copy of the input is made.
+//
+// The arguments and the returned array are the same as those of Device::Conv. The number of spatial dimensions must be at least 1.
+Array ImplicitGemmConv(
+        const Array& x,
+        const Array& w,
+        const nonstd::optional<Array>& b,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        bool cover_all,
+        Dtype out_dtype,
+        int64_t max_col_tile_size = kDefaultMaxColTileSize);
+
+// Computes the gradient of the convolution with respect to the weight, building the column matrix tile by tile as ImplicitGemmConv
+// does.
+//
+// The arguments and the returned array are the same as those of Device::ConvGradWeight.
+Array ImplicitGemmConvGradWeight(
+        Dtype w_dtype,
+        const Shape& w_shape,
+        const Array& x,
+        const Array& gy,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        bool cover_all,
+        int64_t max_col_tile_size = kDefaultMaxColTileSize);
+
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
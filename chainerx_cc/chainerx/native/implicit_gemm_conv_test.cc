@@ -0,0 +1,158 @@
+#include "chainerx/native/implicit_gemm_conv.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+
+#include <gtest/gtest.h>
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/array_index.h"
+#include "chainerx/axes.h"
+#include "chainerx/constant.h"
+#include "chainerx/device.h"
+#include "chainerx/device_id.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/im2col.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/tensor_dot.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/shape.h"
+#include "chainerx/slice.h"
+#include "chainerx/stack_vector.h"
+#include "chainerx/testing/array_check.h"
+#include "chainerx/testing/device_session.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+namespace {
+
+// Small integers, so that the results are exact regardless of the order of summation.
+Array MakeInput(const Shape& shape, int64_t seed, Device& device) {
+    Array a = Empty(shape, Dtype::kFloat64, device);
+    auto data = static_cast<double*>(a.raw_data());
+    for (int64_t i = 0; i < a.GetTotalSize(); ++i) {
+        data[i] = static_cast<double>((i * 7 + seed) % 5 - 2);
+    }
+    return a;
+}
+
+// Convolution through the materialized column matrix.
+Array ReferenceConv(
+        const Array& x,
+        const Array& w,
+        const Array& b,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        bool cover_all) {
+    int8_t ndim = w.ndim() - 2;
+    StackVector<int64_t, kMaxNdim> kernel_size{w.shape().begin() + 2, w.shape().end()};
+    Array col = Im2Col(x, kernel_size, stride, pad, cover_all, 0);
+    Axes axes;
+    axes.resize(ndim + 1);
+    std::iota(axes.begin(), axes.end(), 1);
+    Array y = TensorDot(col, w, axes, axes, x.dtype()) + b;
+    Axes roll_axes{0, static_cast<int8_t>(ndim + 1)};
+    for (int8_t i = 0; i < ndim; ++i) {
+        roll_axes.emplace_back(static_cast<int8_t>(i + 1));
+    }
+    return y.Transpose(roll_axes);
+}
+
+Array ReferenceConvGradWeight(
+        const Shape& w_shape,
+        const Array& x,
+        const Array& gy,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        bool cover_all) {
+    int8_t ndim = x.ndim() - 2;
+    StackVector<int64_t, kMaxNdim> kernel_size{w_shape.begin() + 2, w_shape.end()};
+    Array col = Im2Col(x, kernel_size, stride, pad, cover_all, 0);
+    Axes out_axes{0};
+    Axes col_axes{0};
+    for (int8_t i = 0; i < ndim; ++i) {
+        out_axes.emplace_back(int64_t{2 + i});
+        col_axes.emplace_back(int64_t{2 + ndim + i});
+    }
+    return TensorDot(gy, col, out_axes, col_axes, x.dtype());
+}
+
+class ImplicitGemmConvTest : public ::testing::TestWithParam<int> {
+protected:
+    void SetUp() override {
+        device_session_.emplace(DeviceId{"native", 0});
+        static_cast<NativeBackend&>(device().backend()).SetNumThreads(GetParam());
+    }
+
+    void TearDown() override { device_session_.reset(); }
+
+    Device& device() { return device_session_->device(); }
+
+    // Compares the forward and the weight gradient computations against the reference for several tile sizes.
+    void CheckConv(
+            const Shape& x_shape,
+            const Shape& w_shape,
+            const StackVector<int64_t, kMaxNdim>& stride,
+            const StackVector<int64_t, kMaxNdim>& pad,
+            bool cover_all) {
+        Array x = MakeInput(x_shape, 0, device());
+        Array w = MakeInput(w_shape, 1, device());
+        Array b = MakeInput({w_shape[0]}, 2, device());
+
+        Array y_expected = ReferenceConv(x, w, b, stride, pad, cover_all);
+        Array gy = MakeInput(y_expected.shape(), 3, device());
+        Array gw_expected = ReferenceConvGradWeight(w_shape, x, gy, stride, pad, cover_all);
+
+        // The smallest size results in tiles of 64 output positions, which spans multiple rows of images along the last axis.
+        for (int64_t max_col_tile_size : {int64_t{1}, int64_t{1} << 12, kDefaultMaxColTileSize}) {
+            Array y = ImplicitGemmConv(x, w, b, stride, pad, cover_all, Dtype::kFloat64, max_col_tile_size);
+            EXPECT_ARRAY_EQ(y_expected, y);
+
+            Array gw = ImplicitGemmConvGradWeight(Dtype::kFloat64, w_shape, x, gy, stride, pad, cover_all, max_col_tile_size);
+            EXPECT_ARRAY_EQ(gw_expected, gw);
+        }
+    }
+
+private:
+    nonstd::optional<testing::DeviceSession> device_session_;
+};
+
+TEST_P(ImplicitGemmConvTest, Conv1d) { CheckConv({2, 3, 150}, {4, 3, 5}, {2}, {1}, false); }
+
+TEST_P(ImplicitGemmConvTest, Conv2d) { CheckConv({2, 3, 13, 17}, {5, 3, 3, 3}, {1, 1}, {1, 1}, false); }
+
+TEST_P(ImplicitGemmConvTest, Conv2dStrideCoverAll) { CheckConv({2, 2, 14, 11}, {3, 2, 3, 2}, {3, 2}, {2, 0}, true); }
+
+TEST_P(ImplicitGemmConvTest, Conv3d) { CheckConv({1, 2, 6, 7, 8}, {3, 2, 2, 3, 2}, {2, 1, 3}, {1, 0, 1}, false); }
+
+TEST_P(ImplicitGemmConvTest, ConvNonContiguousInput) {
+    Array x = MakeInput({2, 3, 12, 10}, 0, device()).At({Slice{}, Slice{}, Slice{0, 12, 2}, Slice{}});
+    Array w = MakeInput({4, 3, 3, 3}, 1, device()).Transpose({0, 1, 3, 2});
+    Array b = MakeInput({4}, 2, device());
+    Array y = ImplicitGemmConv(x, w, b, {1, 1}, {1, 1}, false, Dtype::kFloat64, 1);
+    EXPECT_ARRAY_EQ(ReferenceConv(x, w, b, {1, 1}, {1, 1}, false), y);
+}
+
+// Without input channels, the output is the bias and the weight gradient is empty.
+TEST_P(ImplicitGemmConvTest, ConvZeroChannels) {
+    Array x = MakeInput({2, 0, 5, 6}, 0, device());
+    Array w = MakeInput({3, 0, 3, 3}, 1, device());
+    Array b = MakeInput({3}, 2, device());
+    Array y = ImplicitGemmConv(x, w, b, {1, 1}, {1, 1}, false, Dtype::kFloat64);
+    EXPECT_ARRAY_EQ(Zeros({2, 3, 5, 6}, Dtype::kFloat64, device()) + b.At({NewAxis{}, Slice{}, NewAxis{}, NewAxis{}}), y);
+
+    Array gy = MakeInput(y.shape(), 3, device());
+    Array gw = ImplicitGemmConvGradWeight(Dtype::kFloat64, w.shape(), x, gy, {1, 1}, {1, 1}, false);
+    EXPECT_EQ(w.shape(), gw.shape());
+}
+
+INSTANTIATE_TEST_CASE_P(ForEachNumThreads, ImplicitGemmConvTest, ::testing::Values(1, 4));
+
+}  // namespace
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,208 @@
+#include "chainerx/native/memory_pool.h"
+
+#ifdef _WIN32
+#include <malloc.h>
+#else  // _WIN32
+#include <sys/mman.h>
+#endif  // _WIN32
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "chainerx/macro.h"
+#include "chainerx/memory_stats.h"
+
+namespace chainerx {
+namespace native {
+
+MallocStatus AlignedAllocator::Malloc(void** ptr, size_t bytesize) {
+    bool huge = use_huge_pages_ && bytesize >= kHugePageSize;
+    size_t alignment = huge ? kHugePageSize : kMemoryAlignment;
+#ifdef _WIN32
+    *ptr = _aligned_malloc(bytesize, alignment);
+    if (*ptr == nullptr) {
+        return MallocStatus::kErrorMemoryAllocation;
+    }
+#else  // _WIN32
+    if (0 != ::posix_memalign(ptr, alignment, bytesize)) {
+        *ptr = nullptr;
+        return MallocStatus::kErrorMemoryAllocation;
+    }
+#ifdef MADV_HUGEPAGE
+    if (huge) {
+        // Only a hint; the block is usable regardless of the result.
+        ::madvise(*ptr, bytesize, MADV_HUGEPAGE);
+    }
+#endif  // MADV_HUGEPAGE
+#endif  // _WIN32
+    return MallocStatus::kSuccess;
+}
+
+void AlignedAllocator::Free(void* ptr) noexcept {
+#ifdef _WIN32
+    _aligned_free(ptr);
+#else  // _WIN32
+    std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc)
+#endif  // _WIN32
+}
+
+namespace native_internal {
+
+namespace {
+
+int FloorLog2(size_t value) {
+    CHAINERX_ASSERT(value > 0);
+    int log2 = 0;
+    while (value >>= 1) {
+        ++log2;
+    }
+    return log2;
+}
+
+}  // namespace
+
+size_t GetSizeClassIndex(size_t bytesize) {
+    CHAINERX_ASSERT(bytesize > 0);
+    if (bytesize <= kSmallSizeClassLimit) {
+        return (bytesize - 1) / kMemoryAlignment;
+    }
+    // 2^p < bytesize <= 2^(p + 1) is divided into four classes of 2^(p - 2) bytes each.
+    int p = FloorLog2(bytesize - 1);
+    size_t quarter = (bytesize - 1) >> (p - 2);  // In [4, 8).
+    return kNumSmallSizeClasses + static_cast<size_t>(p - kSmallSizeClassLimitLog2) * 4 + (quarter - 4);
+}
+
+size_t GetSizeClassBytesize(size_t index) {
+    if (index < kNumSmallSizeClasses) {
+        return (index + 1) * kMemoryAlignment;
+    }
+    size_t large_index = index - kNumSmallSizeClasses;
+    int p = kSmallSizeClassLimitLog2 + static_cast<int>(large_index / 4);
+    return (large_index % 4 + 5) << (p - 2);
+}
+
+}  // namespace native_internal
+
+// All the size classes are allocated up front so that Free never reallocates the bins.
+MemoryPool::MemoryPool(std::unique_ptr<Allocator> allocator)
+    : allocator_{std::move(allocator)},
+      free_bins_(native_internal::GetSizeClassIndex(std::numeric_limits<size_t>::max()) + 1),
+      size_class_stats_(free_bins_.size()) {}
+
+MemoryPool::~MemoryPool() {
+    // Blocks in use hold a reference to the pool through their deleters (see NativeDevice::Allocate), so that only cached blocks remain.
+    FreeUnusedBlocks();
+}
+
+void MemoryPool::FreeUnusedBlocks() {
+    std::lock_guard<std::mutex> lock{free_bins_mutex_};
+    for (std::vector<void*>& free_list : free_bins_) {
+        for (void* ptr : free_list) {
+            allocator_->Free(ptr);
+        }
+        free_list.clear();
+        free_list.shrink_to_fit();
+    }
+}
+
+void* MemoryPool::Malloc(size_t bytesize) {
+    if (bytesize == 0) {
+        return nullptr;
+    }
+
+    size_t index = native_internal::GetSizeClassIndex(bytesize);
+    {
+        std::lock_guard<std::mutex> lock{free_bins_mutex_};
+        std::vector<void*>& free_list = free_bins_[index];
+        if (!free_list.empty()) {
+            void* ptr = free_list.back();
+            free_list.pop_back();
+            CountMalloc(index, true);
+            return ptr;
+        }
+    }
+
+    size_t allocation_size = native_internal::GetSizeClassBytesize(index);
+    if (allocation_size < bytesize) {
+        // The size class overflowed.
+        throw OutOfMemoryError{bytesize};
+    }
+    void* ptr{nullptr};
+    MallocStatus status = allocator_->Malloc(&ptr, allocation_size);
+    if (status == MallocStatus::kErrorMemoryAllocation) {
+        FreeUnusedBlocks();
+        status = allocator_->Malloc(&ptr, allocation_size);
+        if (status == MallocStatus::kErrorMemoryAllocation) {
+            throw OutOfMemoryError{bytesize};
+        }
+    }
+    CHAINERX_ASSERT(ptr != nullptr);
+    {
+        std::lock_guard<std::mutex> lock{free_bins_mutex_};
+        CountMalloc(index, false);
+    }
+    return ptr;
+}
+
+void MemoryPool::Free(void* ptr, size_t bytesize) noexcept {
+    if (ptr == nullptr) {
+        return;
+    }
+    size_t index = native_internal::GetSizeClassIndex(bytesize);
+    size_t allocation_size = native_internal::GetSizeClassBytesize(index);
+    std::lock_guard<std::mutex> lock{free_bins_mutex_};
+    size_class_stats_[index].bytes_in_use -= allocation_size;
+    bytes_in_use_ -= allocation_size;
+    try {
+        free_bins_[index].emplace_back(ptr);
+    } catch (...) {
+        // The block is returned to the allocator if the free list cannot grow.
+        allocator_->Free(ptr);
+    }
+}
+
+MemoryStats MemoryPool::GetStats() {
+    MemoryStats stats{};
+    std::lock_guard<std::mutex> lock{free_bins_mutex_};
+    stats.bytes_in_use = bytes_in_use_;
+    stats.peak_bytes_in_use = peak_bytes_in_use_;
+    for (size_t index = 0; index < free_bins_.size(); ++index) {
+        MemoryStats::SizeClass size_class = size_class_stats_[index];
+        if (size_class.malloc_count == 0) {
+            continue;
+        }
+        size_t allocation_size = native_internal::GetSizeClassBytesize(index);
+        size_class.bytes_cached = free_bins_[index].size() * allocation_size;
+        stats.bytes_cached += size_class.bytes_cached;
+        stats.malloc_count += size_class.malloc_count;
+        stats.hit_count += size_class.hit_count;
+        stats.size_classes.emplace(allocation_size, size_class);
+    }
+    return stats;
+}
+
+void MemoryPool::ResetPeakStats() {
+    std::lock_guard<std::mutex> lock{free_bins_mutex_};
+    peak_bytes_in_use_ = bytes_in_use_;
+}
+
+void MemoryPool::CountMalloc(size_t index, bool hit) {
+    size_t allocation_size = native_internal::GetSizeClassBytesize(index);
+    MemoryStats::SizeClass& size_class = size_class_stats_[index];
+    ++size_class.malloc_count;
+    if (hit) {
+        ++size_class.hit_count;
+    }
+    size_class.bytes_in_use += allocation_size;
+    bytes_in_use_ += allocation_size;
+    peak_bytes_in_use_ = std::max(peak_bytes_in_use_, bytes_in_use_);
+}
+
+}  // namespace native
+}  // namespace chainerx
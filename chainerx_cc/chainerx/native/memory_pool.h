@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "chainerx/error.h"
+#include "chainerx/memory_stats.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+
+class MemoryPoolTest;  // for unit-tests
+
+}  // namespace native_internal
+
+// Alignment of memory blocks allocated by the native memory pool, which is the size of a cache line and of an AVX-512 register.
+constexpr size_t kMemoryAlignment = 64;
+
+// Size of a transparent huge page. Blocks of this size or larger may be backed by huge pages (see AlignedAllocator).
+constexpr size_t kHugePageSize = size_t{2} * 1024 * 1024;
+
+enum class MallocStatus { kSuccess = 0, kErrorMemoryAllocation };
+
+class OutOfMemoryError : public ChainerxError {
+public:
+    explicit OutOfMemoryError(size_t bytesize) : ChainerxError{"Out of memory allocating ", bytesize, " bytes."} {}
+};
+
+class Allocator {
+public:
+    virtual ~Allocator() = default;
+
+    // Allocates memory aligned to at least kMemoryAlignment.
+    // This function may throw.
+    virtual MallocStatus Malloc(void** ptr, size_t bytesize) = 0;
+
+    // Frees allocated memory.
+    // This function must not throw, since it should be usable from within a destructor.
+    virtual void Free(void* ptr) noexcept = 0;
+};
+
+// Allocates host memory aligned to kMemoryAlignment.
+//
+// If use_huge_pages is true, blocks of kHugePageSize or larger are aligned to kHugePageSize and the kernel is advised to back them by
+// transparent huge pages, which reduces TLB misses and page faults on large buffers. It is silently ignored on platforms without
+// madvise(MADV_HUGEPAGE).
+class AlignedAllocator : public Allocator {
+public:
+    explicit AlignedAllocator(bool use_huge_pages = false) : use_huge_pages_{use_huge_pages} {}
+
+    MallocStatus Malloc(void** ptr, size_t bytesize) override;
+    void Free(void* ptr) noexcept override;
+
+private:
+    bool use_huge_pages_;
+};
+
+namespace native_internal {
+
+// Sizes up to kSmallSizeClassLimit are rounded up to multiples of kMemoryAlignment. Larger sizes are rounded up to one of four classes
+// between each power of two and the next one, so that at most 25% of a block is unused.
+constexpr int kSmallSizeClassLimitLog2 = 10;
+constexpr size_t kSmallSizeClassLimit = size_t{1} << kSmallSizeClassLimitLog2;
+constexpr size_t kNumSmallSizeClasses = kSmallSizeClassLimit / kMemoryAlignment;
+
+// Returns the index of the size class of a positive bytesize.
+size_t GetSizeClassIndex(size_t bytesize);
+
+// Returns the bytesize of the blocks of a size class.
+size_t GetSizeClassBytesize(size_t index);
+
+}  // namespace native_internal
+
+// Caching memory pool for host memory.
+//
+// Requested sizes are rounded up to size classes. Freed blocks are kept in a free list per size class and reused by later allocations of
+// the same class instead of being returned to the allocator, until FreeUnusedBlocks is called or the allocator runs out of memory.
+// Unlike cuda::MemoryPool, blocks are never split or merged.
+// This class is thread safe.
+class MemoryPool {
+public:
+    explicit MemoryPool(std::unique_ptr<Allocator> allocator);
+
+    MemoryPool(const MemoryPool&) = delete;
+
+    MemoryPool operator=(const MemoryPool&) = delete;
+
+    ~MemoryPool();
+
+    // Returns all the cached blocks to the allocator.
+    void FreeUnusedBlocks();
+
+    // Returns a block of at least the given bytesize, or nullptr if bytesize is 0.
+    // OutOfMemoryError is thrown if the allocator fails even after the cached blocks are freed.
+    void* Malloc(size_t bytesize);
+
+    // Caches a block returned by Malloc. bytesize must be the one given to Malloc.
+    void Free(void* ptr, size_t bytesize) noexcept;
+
+    MemoryStats GetStats();
+
+    // Resets the peak of the bytes in use to the current bytes in use.
+    void ResetPeakStats();
+
+private:
+    friend class native_internal::MemoryPoolTest;  // for unit-tests
+
+    // Updates the statistics for an allocation.
+    //
+    // Not thread-safe
+    void CountMalloc(size_t index, bool hit);
+
+    std::unique_ptr<Allocator> allocator_;
+    std::vector<std::vector<void*>> free_bins_;  // size class index => free blocks
+    std::vector<MemoryStats::SizeClass> size_class_stats_;  // size class index => statistics, except for bytes_cached
+    size_t bytes_in_use_{0};
+    size_t peak_bytes_in_use_{0};
+    std::mutex free_bins_mutex_;  // Guards the statistics as well.
+};
+
+}  // namespace native
+}  // namespace chainerx
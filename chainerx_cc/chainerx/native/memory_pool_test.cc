@@ -0,0 +1,278 @@
+#include "chainerx/native/memory_pool.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include "chainerx/macro.h"
+#include "chainerx/memory_stats.h"
+#include "chainerx/testing/threading.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+
+class MemoryPoolTest {
+public:
+    static const Allocator* GetAllocator(const MemoryPool& pool) { return pool.allocator_.get(); }
+};
+
+}  // namespace native_internal
+
+namespace {
+
+// Allocator backed by AlignedAllocator, which fails once the total size of the blocks allocated and not freed exceeds its capacity.
+class FixedCapacityDummyAllocator : public Allocator {
+public:
+    explicit FixedCapacityDummyAllocator(size_t capacity) : capacity_{capacity} {}
+
+    MallocStatus Malloc(void** ptr, size_t bytesize) override {
+        CHAINERX_ASSERT(bytesize > 0);
+        std::lock_guard<std::mutex> lock{sizes_mutex_};
+        ++malloc_called_;
+        if (capacity_ < bytesize) {
+            return MallocStatus::kErrorMemoryAllocation;
+        }
+        MallocStatus status = allocator_.Malloc(ptr, bytesize);
+        CHAINERX_ASSERT(status == MallocStatus::kSuccess);
+        sizes_[*ptr] = bytesize;
+        capacity_ -= bytesize;
+        return status;
+    }
+
+    void Free(void* ptr) noexcept override {
+        std::lock_guard<std::mutex> lock{sizes_mutex_};
+        auto it = sizes_.find(ptr);
+        CHAINERX_ASSERT(it != sizes_.end());
+        capacity_ += it->second;
+        sizes_.erase(it);
+        ++free_called_;
+        allocator_.Free(ptr);
+    }
+
+    int malloc_called() const { return malloc_called_; }
+    int free_called() const { return free_called_; }
+
+private:
+    AlignedAllocator allocator_{};
+    size_t capacity_;
+    int malloc_called_{0};
+    int free_called_{0};
+    std::mutex sizes_mutex_;
+    std::unordered_map<void*, size_t> sizes_;
+};
+
+const FixedCapacityDummyAllocator& GetDummyAllocator(const MemoryPool& memory_pool) {
+    return dynamic_cast<const FixedCapacityDummyAllocator&>(*native_internal::MemoryPoolTest::GetAllocator(memory_pool));
+}
+
+bool IsAligned(const void* ptr, size_t alignment) { return reinterpret_cast<uintptr_t>(ptr) % alignment == 0; }
+
+TEST(SizeClassTest, GetSizeClass) {
+    using native_internal::GetSizeClassBytesize;
+    using native_internal::GetSizeClassIndex;
+
+    EXPECT_EQ(size_t{0}, GetSizeClassIndex(1));
+    EXPECT_EQ(size_t{0}, GetSizeClassIndex(kMemoryAlignment));
+    EXPECT_EQ(size_t{1}, GetSizeClassIndex(kMemoryAlignment + 1));
+    EXPECT_EQ(kMemoryAlignment * 2, GetSizeClassBytesize(1));
+    EXPECT_EQ(native_internal::kNumSmallSizeClasses - 1, GetSizeClassIndex(native_internal::kSmallSizeClassLimit));
+
+    // Four classes between each power of two and the next one.
+    EXPECT_EQ(size_t{1280}, GetSizeClassBytesize(GetSizeClassIndex(1025)));
+    EXPECT_EQ(size_t{1536}, GetSizeClassBytesize(GetSizeClassIndex(1281)));
+    EXPECT_EQ(size_t{2048}, GetSizeClassBytesize(GetSizeClassIndex(2048)));
+    EXPECT_EQ(size_t{2560}, GetSizeClassBytesize(GetSizeClassIndex(2049)));
+    EXPECT_EQ(size_t{7} << 20, GetSizeClassBytesize(GetSizeClassIndex((size_t{6} << 20) + 1)));
+
+    // Classes are consecutive, increasing, and the smallest ones to fit.
+    size_t prev_bytesize = 0;
+    for (size_t index = 0; index < 100; ++index) {
+        size_t bytesize = GetSizeClassBytesize(index);
+        EXPECT_LT(prev_bytesize, bytesize);
+        EXPECT_EQ(index, GetSizeClassIndex(bytesize));
+        EXPECT_EQ(index, GetSizeClassIndex(prev_bytesize + 1));
+        EXPECT_LE(bytesize - prev_bytesize, bytesize / 4 + kMemoryAlignment);
+        prev_bytesize = bytesize;
+    }
+}
+
+TEST(AlignedAllocatorTest, Malloc) {
+    for (bool use_huge_pages : {false, true}) {
+        AlignedAllocator allocator{use_huge_pages};
+        for (size_t bytesize : {size_t{1}, size_t{100}, kHugePageSize, kHugePageSize * 2 + 1}) {
+            void* ptr{nullptr};
+            ASSERT_EQ(MallocStatus::kSuccess, allocator.Malloc(&ptr, bytesize));
+            EXPECT_TRUE(IsAligned(ptr, kMemoryAlignment));
+            if (use_huge_pages && bytesize >= kHugePageSize) {
+                EXPECT_TRUE(IsAligned(ptr, kHugePageSize));
+            }
+            static_cast<uint8_t*>(ptr)[bytesize - 1] = 1;
+            allocator.Free(ptr);
+        }
+    }
+}
+
+TEST(MemoryPoolTest, MallocZero) {
+    MemoryPool memory_pool{std::make_unique<FixedCapacityDummyAllocator>(0U)};
+    EXPECT_EQ(nullptr, memory_pool.Malloc(0));
+    memory_pool.Free(nullptr, 0);
+    EXPECT_EQ(0, GetDummyAllocator(memory_pool).malloc_called());
+}
+
+TEST(MemoryPoolTest, MallocAligned) {
+    MemoryPool memory_pool{std::make_unique<AlignedAllocator>()};
+    for (size_t bytesize = 1; bytesize < 100000; bytesize = bytesize * 3 + 1) {
+        void* ptr = memory_pool.Malloc(bytesize);
+        EXPECT_TRUE(IsAligned(ptr, kMemoryAlignment));
+        memory_pool.Free(ptr, bytesize);
+    }
+}
+
+TEST(MemoryPoolTest, MallocReuseSameSizeClass) {
+    MemoryPool memory_pool{std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+    const FixedCapacityDummyAllocator& allocator = GetDummyAllocator(memory_pool);
+
+    void* ptr1 = memory_pool.Malloc(1500);
+    memory_pool.Free(ptr1, 1500);
+
+    // 1500 and 1400 bytes are in the same size class.
+    void* ptr2 = memory_pool.Malloc(1400);
+    EXPECT_EQ(ptr1, ptr2);
+    EXPECT_EQ(1, allocator.malloc_called());
+
+    // Blocks of other size classes are not reused.
+    void* ptr3 = memory_pool.Malloc(1000);
+    EXPECT_NE(ptr1, ptr3);
+    EXPECT_EQ(2, allocator.malloc_called());
+
+    memory_pool.Free(ptr2, 1400);
+    memory_pool.Free(ptr3, 1000);
+    EXPECT_EQ(0, allocator.free_called());
+}
+
+TEST(MemoryPoolTest, FreeUnusedBlocks) {
+    MemoryPool memory_pool{std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+    const FixedCapacityDummyAllocator& allocator = GetDummyAllocator(memory_pool);
+
+    void* ptr1 = memory_pool.Malloc(100);
+    void* ptr2 = memory_pool.Malloc(10000);
+    memory_pool.Free(ptr1, 100);
+
+    // Only the cached block is freed.
+    memory_pool.FreeUnusedBlocks();
+    EXPECT_EQ(1, allocator.free_called());
+
+    memory_pool.Free(ptr2, 10000);
+    memory_pool.FreeUnusedBlocks();
+    EXPECT_EQ(2, allocator.free_called());
+
+    void* ptr3 = memory_pool.Malloc(100);
+    EXPECT_EQ(3, allocator.malloc_called());
+    memory_pool.Free(ptr3, 100);
+}
+
+TEST(MemoryPoolTest, MallocThrowOutOfMemory) {
+    MemoryPool memory_pool{std::make_unique<FixedCapacityDummyAllocator>(0U)};
+    EXPECT_THROW(memory_pool.Malloc(1), OutOfMemoryError);
+}
+
+TEST(MemoryPoolTest, MallocRetryOutOfMemory) {
+    static constexpr size_t kCapacity = 4096;
+    MemoryPool memory_pool{std::make_unique<FixedCapacityDummyAllocator>(kCapacity)};
+    const FixedCapacityDummyAllocator& allocator = GetDummyAllocator(memory_pool);
+
+    void* ptr1 = memory_pool.Malloc(1);
+    memory_pool.Free(ptr1, 1);
+
+    // The cached block of a different size class is freed to make room for the new block.
+    void* ptr2 = memory_pool.Malloc(kCapacity);
+    memory_pool.Free(ptr2, kCapacity);
+
+    EXPECT_EQ(3, allocator.malloc_called());
+    EXPECT_EQ(1, allocator.free_called());
+}
+
+TEST(MemoryPoolTest, Stats) {
+    MemoryPool memory_pool{std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+    size_t small_bytesize = native_internal::GetSizeClassBytesize(native_internal::GetSizeClassIndex(100));
+    size_t large_bytesize = native_internal::GetSizeClassBytesize(native_internal::GetSizeClassIndex(10000));
+
+    void* ptr1 = memory_pool.Malloc(100);
+    void* ptr2 = memory_pool.Malloc(10000);
+    memory_pool.Free(ptr1, 100);
+    void* ptr3 = memory_pool.Malloc(90);
+    memory_pool.Free(ptr2, 10000);
+    {
+        MemoryStats stats = memory_pool.GetStats();
+        EXPECT_EQ(small_bytesize, stats.bytes_in_use);
+        EXPECT_EQ(small_bytesize + large_bytesize, stats.peak_bytes_in_use);
+        EXPECT_EQ(large_bytesize, stats.bytes_cached);
+        EXPECT_EQ(3, stats.malloc_count);
+        EXPECT_EQ(1, stats.hit_count);
+        EXPECT_EQ(0, stats.split_count);
+        EXPECT_EQ(0, stats.merge_count);
+
+        ASSERT_EQ(size_t{2}, stats.size_classes.size());
+        const MemoryStats::SizeClass& small = stats.size_classes.at(small_bytesize);
+        EXPECT_EQ(2, small.malloc_count);
+        EXPECT_EQ(1, small.hit_count);
+        EXPECT_EQ(small_bytesize, small.bytes_in_use);
+        EXPECT_EQ(size_t{0}, small.bytes_cached);
+        const MemoryStats::SizeClass& large = stats.size_classes.at(large_bytesize);
+        EXPECT_EQ(1, large.malloc_count);
+        EXPECT_EQ(0, large.hit_count);
+        EXPECT_EQ(size_t{0}, large.bytes_in_use);
+        EXPECT_EQ(large_bytesize, large.bytes_cached);
+    }
+
+    memory_pool.Free(ptr3, 90);
+    memory_pool.FreeUnusedBlocks();
+    {
+        MemoryStats stats = memory_pool.GetStats();
+        EXPECT_EQ(size_t{0}, stats.bytes_in_use);
+        EXPECT_EQ(size_t{0}, stats.bytes_cached);
+        EXPECT_EQ(3, stats.malloc_count);
+    }
+}
+
+TEST(MemoryPoolTest, ResetPeakStats) {
+    MemoryPool memory_pool{std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+
+    void* ptr1 = memory_pool.Malloc(64);
+    void* ptr2 = memory_pool.Malloc(128);
+    memory_pool.Free(ptr2, 128);
+    EXPECT_EQ(size_t{192}, memory_pool.GetStats().peak_bytes_in_use);
+
+    memory_pool.ResetPeakStats();
+    EXPECT_EQ(size_t{64}, memory_pool.GetStats().peak_bytes_in_use);
+    memory_pool.Free(ptr1, 64);
+    EXPECT_EQ(size_t{64}, memory_pool.GetStats().peak_bytes_in_use);
+}
+
+TEST(MemoryPoolTest, MallocFreeThreadSafe) {
+    static constexpr size_t kRepeat = 100U;
+    MemoryPool memory_pool{std::make_unique<FixedCapacityDummyAllocator>(0xffffffffU)};
+
+    testing::RunThreads(3, [&memory_pool](size_t thread_index) {
+        for (size_t i = 0; i < kRepeat; ++i) {
+            if (thread_index == 0) {
+                memory_pool.FreeUnusedBlocks();
+                memory_pool.GetStats();
+            } else {
+                size_t bytesize = 1 + i * 37;
+                void* ptr = memory_pool.Malloc(bytesize);
+                static_cast<uint8_t*>(ptr)[bytesize - 1] = 1;
+                memory_pool.Free(ptr, bytesize);
+            }
+        }
+    });
+}
+
+}  // namespace
+}  // namespace native
+}  // namespace chainerx
@@ -1,15 +1,24 @@
 #include "chainerx/native/native_backend.h"
 
+#include <algorithm>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 #include <string>
+#include <thread>
 
+#include <nonstd/optional.hpp>
+
+#include "chainerx/error.h"
 #include "chainerx/native/native_device.h"
+#include "chainerx/native/thread_pool.h"
+#include "chainerx/util.h"
 
 namespace chainerx {
 namespace native {
 
 constexpr const char* NativeBackend::kDefaultName;
+constexpr const char* NativeBackend::kNumThreadsEnvVarName;
 
 namespace native_internal {
 
@@ -35,5 +44,42 @@ bool NativeBackend::SupportsTransfer(Device& src_device, Device& dst_device) {
     return &src_device.backend() == this && &dst_device.backend() == this;
 }
 
+void NativeBackend::SetNumThreads(int num_threads) {
+    if (num_threads < 1) {
+        throw ChainerxError{"The number of threads must be positive, but given: ", num_threads};
+    }
+    std::lock_guard<std::mutex> lock{mutex_};
+    num_threads_ = num_threads;
+    if (thread_pool_ != nullptr && thread_pool_->num_threads() != num_threads) {
+        thread_pool_.reset();
+    }
+}
+
+int NativeBackend::GetNumThreads() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    return GetNumThreadsNoLock();
+}
+
+int NativeBackend::GetNumThreadsNoLock() {
+    if (num_threads_) {
+        return *num_threads_;
+    }
+    if (nonstd::optional<int> env = GetEnvInt(kNumThreadsEnvVarName)) {
+        num_threads_ = std::max(*env, 1);
+    } else {
+        // hardware_concurrency() may return 0 if the value is not computable.
+        num_threads_ = std::max(static_cast<int>(std::thread::hardware_concurrency()), 1);
+    }
+    return *num_threads_;
+}
+
+std::shared_ptr<ThreadPool> NativeBackend::GetThreadPool() {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (thread_pool_ == nullptr) {
+        thread_pool_ = std::make_shared<ThreadPool>(GetNumThreadsNoLock());
+    }
+    return thread_pool_;
+}
+
 }  // namespace native
 }  // namespace chainerx
@@ -1,10 +1,14 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 
+#include <nonstd/optional.hpp>
+
 #include "chainerx/backend.h"
 #include "chainerx/device.h"
+#include "chainerx/native/thread_pool.h"
 
 namespace chainerx {
 namespace native {
@@ -25,6 +29,9 @@ NativeDevice* CreateDevice(NativeBackend& backend, int index);
 class NativeBackend : public Backend {
 public:
     static constexpr const char* kDefaultName = "native";
+    static constexpr const char* kNumThreadsEnvVarName = "CHAINERX_NATIVE_NUM_THREADS";
+    // Large memory blocks of the devices are backed by transparent huge pages unless this environment variable is set to 0.
+    static constexpr const char* kHugePagesEnvVarName = "CHAINERX_NATIVE_HUGE_PAGES";
 
     using Backend::Backend;
 
@@ -34,8 +41,30 @@ public:
 
     bool SupportsTransfer(Device& src_device, Device& dst_device) override;
 
+    // Sets the number of threads used by intra-op parallel kernels of the devices of this backend.
+    // This value is shared across threads. Kernels which are already running are not affected.
+    void SetNumThreads(int num_threads);
+
+    // Gets the number of threads used by intra-op parallel kernels.
+    // If it is not set, the value of the environment variable CHAINERX_NATIVE_NUM_THREADS is used if given, or the number of hardware
+    // threads otherwise.
+    int GetNumThreads();
+
+    // Returns the thread pool used by intra-op parallel kernels.
+    // The pool is created on the first call and is kept alive by the returned pointer even if the number of threads is changed.
+    std::shared_ptr<ThreadPool> GetThreadPool();
+
 private:
     std::unique_ptr<Device> CreateDevice(int index) override;
+
+    // Not thread safe.
+    int GetNumThreadsNoLock();
+
+    nonstd::optional<int> num_threads_{};
+
+    std::shared_ptr<ThreadPool> thread_pool_{};
+
+    std::mutex mutex_;
 };
 
 }  // namespace native
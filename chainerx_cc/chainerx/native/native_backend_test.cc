@@ -1,16 +1,23 @@
 #include "chainerx/native/native_backend.h"
 
 #include <cstring>
+#include <memory>
+#include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 #include <gtest/gtest.h>
+#include <nonstd/optional.hpp>
 
 #include "chainerx/array.h"
 #include "chainerx/context.h"
 #include "chainerx/device.h"
+#include "chainerx/error.h"
+#include "chainerx/native/thread_pool.h"
 #include "chainerx/routines/creation.h"
 #include "chainerx/testing/threading.h"
+#include "chainerx/util.h"
 
 namespace chainerx {
 namespace native {
@@ -104,6 +111,89 @@ TEST(NativeBackendTest, GetName) {
     EXPECT_EQ("native", NativeBackend{ctx}.GetName());
 }
 
+class EnvVarScope {
+public:
+    EnvVarScope(std::string name, const std::string& value) : name_(std::move(name)), old_value_{GetEnv(name_)} { SetEnv(name_, value); }
+
+    ~EnvVarScope() {
+        if (old_value_) {
+            SetEnv(name_, *old_value_);
+        } else {
+            UnsetEnv(name_);
+        }
+    }
+
+private:
+    const std::string name_{};
+    nonstd::optional<std::string> old_value_{};
+};
+
+TEST(NativeBackendTest, GetNumThreads) {
+    Context ctx;
+    {
+        NativeBackend backend{ctx};
+        EXPECT_LE(1, backend.GetNumThreads());
+    }
+    {
+        NativeBackend backend{ctx};
+        backend.SetNumThreads(3);
+        EXPECT_EQ(3, backend.GetNumThreads());
+        backend.SetNumThreads(1);
+        EXPECT_EQ(1, backend.GetNumThreads());
+        EXPECT_THROW(backend.SetNumThreads(0), ChainerxError);
+    }
+    {
+        NativeBackend backend{ctx};
+        {
+            EnvVarScope scope{NativeBackend::kNumThreadsEnvVarName, "2"};
+            EXPECT_EQ(2, backend.GetNumThreads());
+        }
+        {
+            // env is cached on the first access, so not reflected.
+            EnvVarScope scope{NativeBackend::kNumThreadsEnvVarName, "5"};
+            EXPECT_EQ(2, backend.GetNumThreads());
+        }
+    }
+    {
+        NativeBackend backend{ctx};
+        EnvVarScope scope{NativeBackend::kNumThreadsEnvVarName, "two"};
+        EXPECT_THROW(backend.GetNumThreads(), ChainerxError);
+    }
+    {
+        NativeBackend backend{ctx};
+        EnvVarScope scope{NativeBackend::kNumThreadsEnvVarName, "99999999999999999999"};
+        EXPECT_THROW(backend.GetNumThreads(), ChainerxError);
+    }
+}
+
+TEST(NativeBackendTest, GetThreadPool) {
+    Context ctx;
+    NativeBackend backend{ctx};
+    backend.SetNumThreads(2);
+
+    std::shared_ptr<ThreadPool> pool = backend.GetThreadPool();
+    EXPECT_EQ(2, pool->num_threads());
+    EXPECT_EQ(pool, backend.GetThreadPool());
+
+    // Changing the number of threads recreates the pool, while the old one stays alive.
+    backend.SetNumThreads(3);
+    std::shared_ptr<ThreadPool> pool2 = backend.GetThreadPool();
+    EXPECT_EQ(3, pool2->num_threads());
+    EXPECT_NE(pool, pool2);
+    EXPECT_EQ(2, pool->num_threads());
+}
+
+TEST(NativeBackendTest, SetAndGetNumThreadsThreadSafe) {
+    Context ctx;
+    NativeBackend backend{ctx};
+
+    testing::RunThreads(2, [&backend]() {
+        backend.SetNumThreads(2);
+        EXPECT_EQ(2, backend.GetNumThreads());
+        EXPECT_EQ(2, backend.GetThreadPool()->num_threads());
+    });
+}
+
 TEST(NativeBackendTest, SupportsTransferThreadSafe) {
     static constexpr size_t kThreadCount = 2;
 
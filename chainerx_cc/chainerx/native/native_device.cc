@@ -1,9 +1,35 @@
 #include "chainerx/native/native_device.h"
 
+#include <memory>
+#include <string>
+
+#include <nonstd/optional.hpp>
+
+#include "chainerx/memory_stats.h"
+#include "chainerx/native/fusion.h"
+#include "chainerx/native/memory_pool.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/util.h"
+
 namespace chainerx {
 namespace native {
+namespace {
+
+bool UseHugePages() {
+    nonstd::optional<std::string> env = GetEnv(NativeBackend::kHugePagesEnvVarName);
+    return !env || *env != "0";
+}
+
+}  // namespace
+
+NativeDevice::NativeDevice(NativeBackend& backend, int index)
+    : Device{backend, index}, memory_pool_{std::make_shared<MemoryPool>(std::make_unique<AlignedAllocator>(UseHugePages()))} {}
+
+void NativeDevice::Synchronize() { native_internal::FlushFusion(); }
+
+MemoryStats NativeDevice::GetMemoryStats() { return memory_pool_->GetStats(); }
 
-void NativeDevice::Synchronize() {}
+void NativeDevice::ResetPeakMemoryStats() { memory_pool_->ResetPeakStats(); }
 
 }  // namespace native
 }  // namespace chainerx
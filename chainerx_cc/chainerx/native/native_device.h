@@ -11,6 +11,7 @@
 #include "chainerx/device.h"
 #include "chainerx/indexable_array.h"
 #include "chainerx/indexer.h"
+#include "chainerx/native/memory_pool.h"
 #include "chainerx/native/native_backend.h"
 #include "chainerx/routines/pooling.h"
 #include "chainerx/scalar.h"
@@ -23,6 +24,14 @@ class NativeDevice : public Device {
 public:
     void Synchronize() override;
 
+    MemoryStats GetMemoryStats() override;
+
+    void ResetPeakMemoryStats() override;
+
+    bool SupportsStepCapture() const override { return true; }
+
+    const std::shared_ptr<MemoryPool>& memory_pool() { return memory_pool_; }
+
     // memory.cc
 
     std::shared_ptr<void> Allocate(size_t bytesize) override;
@@ -75,6 +84,9 @@ public:
 
     void Sum(const Array& a, const Axes& axis, const Array& out) override;
     void AMax(const Array& a, const Axes& axis, const Array& out) override;
+    void Mean(const Array& a, const Axes& axis, const Array& out) override;
+    void Var(const Array& a, const Axes& axis, const Array& out) override;
+    void MeanVar(const Array& a, const Axes& axis, const Array& mean, const Array& var) override;
 
     // copy.cc
 
@@ -106,6 +118,8 @@ public:
 
     void Dot(const Array& a, const Array& b, const Array& out) override;
 
+    void BatchDot(const Array& a, const Array& b, const Array& out) override;
+
     // exp_log.cc
 
     void Exp(const Array& x, const Array& out) override;
@@ -167,11 +181,18 @@ public:
             const StackVector<int64_t, kMaxNdim>& pad,
             AveragePoolPadMode pad_mode) override;
 
+    // batch_norm.cc
+
+    std::unique_ptr<BatchNormForwardBackward> GetBatchNormForwardBackward(
+            const Array& running_mean, const Array& running_var, Scalar eps, Scalar decay, const Axes& axis) override;
+
 protected:
-    NativeDevice(NativeBackend& backend, int index) : Device(backend, index) {}
+    NativeDevice(NativeBackend& backend, int index);
 
 private:
     friend NativeDevice* native_internal::CreateDevice(NativeBackend&, int);
+
+    std::shared_ptr<MemoryPool> memory_pool_;
 };
 
 }  // namespace native
@@ -4,9 +4,11 @@
 #include <cstdint>
 
 #include "chainerx/array.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/native/elementwise.h"
+#include "chainerx/native/fusion.h"
 #include "chainerx/numeric.h"
 #include "chainerx/scalar.h"
 
@@ -14,7 +16,11 @@ namespace chainerx {
 namespace native {
 
 void NativeDevice::IfLessElseASSA(const Array& x1, Scalar x2, Scalar pos, const Array& neg, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::IfLessElseASSA, x1, x2, pos, neg, out};
     CheckDevicesCompatible(x1, neg, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kIfLessElseASSA, {&x1, &neg}, {x2, pos}, out)) {
+        return;
+    }
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -27,7 +33,11 @@ void NativeDevice::IfLessElseASSA(const Array& x1, Scalar x2, Scalar pos, const
 }
 
 void NativeDevice::IfGreaterElseASSA(const Array& x1, Scalar x2, Scalar pos, const Array& neg, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::IfGreaterElseASSA, x1, x2, pos, neg, out};
     CheckDevicesCompatible(x1, neg, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kIfGreaterElseASSA, {&x1, &neg}, {x2, pos}, out)) {
+        return;
+    }
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -40,8 +50,12 @@ void NativeDevice::IfGreaterElseASSA(const Array& x1, Scalar x2, Scalar pos, con
 }
 
 void NativeDevice::Tanh(const Array& x, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Tanh, x, out};
     CheckDevicesCompatible(x, out);
     const Array& x_cast = x.dtype() == out.dtype() ? x : x.AsType(out.dtype());
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kTanh, {&x_cast}, {}, out)) {
+        return;
+    }
     VisitFloatingPointDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
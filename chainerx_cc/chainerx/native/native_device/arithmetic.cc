@@ -4,17 +4,23 @@
 
 #include "chainerx/arithmetic_ops.h"
 #include "chainerx/array.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/float16.h"
 #include "chainerx/native/elementwise.h"
+#include "chainerx/native/fusion.h"
 #include "chainerx/scalar.h"
 
 namespace chainerx {
 namespace native {
 
 void NativeDevice::Add(const Array& x1, const Array& x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Add, x1, x2, out};
     CheckDevicesCompatible(x1, x2, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kAdd, {&x1, &x2}, {}, out)) {
+        return;
+    }
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -25,7 +31,11 @@ void NativeDevice::Add(const Array& x1, const Array& x2, const Array& out) {
 }
 
 void NativeDevice::AddAS(const Array& x1, Scalar x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::AddAS, x1, x2, out};
     CheckDevicesCompatible(x1, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kAddAS, {&x1}, {x2}, out)) {
+        return;
+    }
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -37,7 +47,11 @@ void NativeDevice::AddAS(const Array& x1, Scalar x2, const Array& out) {
 }
 
 void NativeDevice::Subtract(const Array& x1, const Array& x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Subtract, x1, x2, out};
     CheckDevicesCompatible(x1, x2, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kSubtract, {&x1, &x2}, {}, out)) {
+        return;
+    }
     VisitNumericDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -48,7 +62,11 @@ void NativeDevice::Subtract(const Array& x1, const Array& x2, const Array& out)
 }
 
 void NativeDevice::SubtractAS(const Array& x1, Scalar x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::SubtractAS, x1, x2, out};
     CheckDevicesCompatible(x1, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kSubtractAS, {&x1}, {x2}, out)) {
+        return;
+    }
     VisitNumericDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -60,7 +78,11 @@ void NativeDevice::SubtractAS(const Array& x1, Scalar x2, const Array& out) {
 }
 
 void NativeDevice::Multiply(const Array& x1, const Array& x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Multiply, x1, x2, out};
     CheckDevicesCompatible(x1, x2, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kMultiply, {&x1, &x2}, {}, out)) {
+        return;
+    }
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -71,7 +93,11 @@ void NativeDevice::Multiply(const Array& x1, const Array& x2, const Array& out)
 }
 
 void NativeDevice::MultiplyAS(const Array& x1, Scalar x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::MultiplyAS, x1, x2, out};
     CheckDevicesCompatible(x1, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kMultiplyAS, {&x1}, {x2}, out)) {
+        return;
+    }
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -109,6 +135,8 @@ chainerx::Float16 FloorDivide(chainerx::Float16 x, chainerx::Float16 y) {
 }  // namespace
 
 void NativeDevice::FloorDivide(const Array& x1, const Array& x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::FloorDivide, x1, x2, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(x1, x2, out);
     VisitNumericDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
@@ -120,6 +148,8 @@ void NativeDevice::FloorDivide(const Array& x1, const Array& x2, const Array& ou
 }
 
 void NativeDevice::FloorDivideAS(const Array& x1, Scalar x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::FloorDivideAS, x1, x2, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(x1, out);
     VisitNumericDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
@@ -132,7 +162,11 @@ void NativeDevice::FloorDivideAS(const Array& x1, Scalar x2, const Array& out) {
 }
 
 void NativeDevice::Divide(const Array& x1, const Array& x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Divide, x1, x2, out};
     CheckDevicesCompatible(x1, x2, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kDivide, {&x1, &x2}, {}, out)) {
+        return;
+    }
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -143,7 +177,11 @@ void NativeDevice::Divide(const Array& x1, const Array& x2, const Array& out) {
 }
 
 void NativeDevice::DivideAS(const Array& x1, Scalar x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::DivideAS, x1, x2, out};
     CheckDevicesCompatible(x1, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kDivideAS, {&x1}, {x2}, out)) {
+        return;
+    }
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
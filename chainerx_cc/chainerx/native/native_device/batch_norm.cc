@@ -0,0 +1,369 @@
+#include "chainerx/native/native_device.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/axes.h"
+#include "chainerx/backend_util.h"
+#include "chainerx/captured_step.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/float16.h"
+#include "chainerx/macro.h"
+#include "chainerx/native/fusion.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/reduce.h"
+#include "chainerx/native/thread_pool.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/scalar.h"
+#include "chainerx/shape.h"
+
+namespace chainerx {
+namespace native {
+namespace {
+
+// Minimum number of elements processed by a single task.
+constexpr int64_t kMinChunkSize = int64_t{1} << 15;
+
+// Number of elements of a block of the statistics pass. Each block is read twice, for its mean and for the deviations from it.
+constexpr int64_t kStatsBlockSize = 4096;
+
+// View of a C-contiguous array as (outer, channels, inner), where the normalized axes are the outer and the inner ones.
+struct BatchNormLayout {
+    int64_t outer{1};
+    int64_t channels{1};
+    int64_t inner{1};
+
+    int64_t count() const { return outer * inner; }
+};
+
+// Returns the layout if the normalized axes are leading and trailing axes of the shape, which covers the normalization over the batch
+// axis and over the batch and spatial axes.
+nonstd::optional<BatchNormLayout> GetBatchNormLayout(const Shape& shape, const Axes& axis) {
+    int8_t begin = 0;  // First axis of the channels.
+    while (begin < axis.ndim() && axis[begin] == begin) {
+        ++begin;
+    }
+    int8_t end = shape.ndim() - (axis.ndim() - begin);  // End of the axes of the channels.
+    for (int8_t i = begin; i < axis.ndim(); ++i) {
+        if (axis[i] != end + (i - begin)) {
+            return nonstd::nullopt;
+        }
+    }
+
+    BatchNormLayout layout{};
+    for (int8_t i = 0; i < shape.ndim(); ++i) {
+        (i < begin ? layout.outer : i < end ? layout.channels : layout.inner) *= shape[i];
+    }
+    return layout;
+}
+
+// Grid of tasks over parts of the outer axis and chunks of the channels. Partial results of the parts are merged by the caller.
+class ChannelTasks {
+public:
+    ChannelTasks(Device& device, const BatchNormLayout& layout)
+        : layout_{layout}, pool_{static_cast<NativeBackend&>(device.backend()).GetThreadPool()} {
+        int64_t total = layout.outer * layout.channels * layout.inner;
+        int64_t tasks = std::max(int64_t{1}, std::min(int64_t{pool_->num_threads()}, total / kMinChunkSize));
+        channel_chunks_ = std::min(layout.channels, tasks);
+        parts_ = std::max(int64_t{1}, std::min(layout.outer, (tasks + channel_chunks_ - 1) / channel_chunks_));
+    }
+
+    int64_t parts() const { return parts_; }
+
+    // Calls func(part, o_begin, o_end, c_begin, c_end) for each task in parallel.
+    template <typename Func>
+    void Run(Func&& func) const {
+        ParallelFor(*pool_, parts_ * channel_chunks_, 1, [&](int64_t begin, int64_t end) {
+            for (int64_t task = begin; task < end; ++task) {
+                int64_t part = task / channel_chunks_;
+                int64_t chunk = task % channel_chunks_;
+                func(part,
+                     layout_.outer * part / parts_,
+                     layout_.outer * (part + 1) / parts_,
+                     layout_.channels * chunk / channel_chunks_,
+                     layout_.channels * (chunk + 1) / channel_chunks_);
+            }
+        });
+    }
+
+private:
+    BatchNormLayout layout_;
+    std::shared_ptr<ThreadPool> pool_;
+    int64_t parts_{1};
+    int64_t channel_chunks_{1};
+};
+
+// Computes the mean and the biased variance of each channel.
+template <typename T, typename Accum>
+std::vector<MeanVarAccum<Accum>> ComputeMeanVar(Device& device, const BatchNormLayout& layout, const T* x) {
+    int64_t channels = layout.channels;
+    int64_t inner = layout.inner;
+    ChannelTasks tasks{device, layout};
+    int64_t parts = tasks.parts();
+    std::vector<MeanVarAccum<Accum>> partials(parts * channels);
+    tasks.Run([&](int64_t part, int64_t o_begin, int64_t o_end, int64_t c_begin, int64_t c_end) {
+        int64_t block_outer = std::max(int64_t{1}, kStatsBlockSize / ((c_end - c_begin) * inner));
+        for (int64_t o0 = o_begin; o0 < o_end; o0 += block_outer) {
+            int64_t o1 = std::min(o0 + block_outer, o_end);
+            int64_t block_count = (o1 - o0) * inner;
+            for (int64_t c = c_begin; c < c_end; ++c) {
+                // The mean of the block first, and then the squared deviations from it, which stay accurate for large means.
+                Accum sum{0};
+                for (int64_t o = o0; o < o1; ++o) {
+                    const T* row = x + (o * channels + c) * inner;
+                    for (int64_t i = 0; i < inner; ++i) {
+                        sum += static_cast<Accum>(row[i]);
+                    }
+                }
+                Accum block_mean = sum / block_count;
+                Accum m2{0};
+                for (int64_t o = o0; o < o1; ++o) {
+                    const T* row = x + (o * channels + c) * inner;
+                    for (int64_t i = 0; i < inner; ++i) {
+                        Accum d = static_cast<Accum>(row[i]) - block_mean;
+                        m2 += d * d;
+                    }
+                }
+                partials[part * channels + c].Merge({block_count, block_mean, m2});
+            }
+        }
+    });
+
+    for (int64_t part = 1; part < parts; ++part) {
+        for (int64_t c = 0; c < channels; ++c) {
+            partials[c].Merge(partials[part * channels + c]);
+        }
+    }
+    partials.resize(channels);
+    return partials;
+}
+
+// Computes out = (x - mean[c]) * scale[c] + shift[c] for each element, in parallel over the outer axis.
+// The mean is subtracted first rather than folded into the shift, which would lose the precision of the deviations.
+template <typename T, typename Accum>
+void ApplyChannelAffine(
+        Device& device, const BatchNormLayout& layout, const T* x, const Accum* mean, const Accum* scale, const Accum* shift, T* out) {
+    std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(device.backend()).GetThreadPool();
+    int64_t slice_size = layout.channels * layout.inner;
+    ParallelFor(*pool, layout.outer, std::max(int64_t{1}, kMinChunkSize / slice_size), [&](int64_t begin, int64_t end) {
+        for (int64_t o = begin; o < end; ++o) {
+            for (int64_t c = 0; c < layout.channels; ++c) {
+                int64_t offset = (o * layout.channels + c) * layout.inner;
+                Accum m = mean[c];
+                Accum s = scale[c];
+                Accum t = shift[c];
+                for (int64_t i = 0; i < layout.inner; ++i) {
+                    out[offset + i] = static_cast<T>((static_cast<Accum>(x[offset + i]) - m) * s + t);
+                }
+            }
+        }
+    });
+}
+
+// Batch normalization computed in a statistics pass and a normalization pass over the input, and two passes over the input and the
+// output gradient in backward. The normalized input is never materialized.
+// Inputs that do not fit the (outer, channels, inner) layout, or with mixed dtypes, are handled by the generic implementation.
+class NativeBatchNormForwardBackward : public chainerx::GenericBatchNormForwardBackward {
+public:
+    NativeBatchNormForwardBackward(const Array& running_mean, const Array& running_var, Scalar eps, Scalar decay, const Axes& axis)
+        : GenericBatchNormForwardBackward{running_mean, running_var, eps, decay, axis} {}
+
+    Array Forward(const Array& x, const Array& gamma, const Array& beta) override {
+        internal::UncapturableDeviceCall uncapturable_call{};
+        native_internal::FusionBarrier fusion_barrier{};
+        CHAINERX_ASSERT(internal::GetArrayBody(x)->nodes().empty());
+        CHAINERX_ASSERT(internal::GetArrayBody(gamma)->nodes().empty());
+        CHAINERX_ASSERT(internal::GetArrayBody(beta)->nodes().empty());
+
+        layout_ = GetBatchNormLayout(x.shape(), axis());
+        if (!layout_.has_value() || GetKind(x.dtype()) != DtypeKind::kFloat || gamma.dtype() != x.dtype() || beta.dtype() != x.dtype() ||
+            x.GetTotalSize() == 0) {
+            layout_ = nonstd::nullopt;
+            return GenericBatchNormForwardBackward::Forward(x, gamma, beta);
+        }
+        const BatchNormLayout& layout = *layout_;
+        CHAINERX_ASSERT(gamma.GetTotalSize() == layout.channels);
+
+        Device& device = x.device();
+        Array x_contiguous = internal::AsContiguous(x);
+        Array gamma_contiguous = internal::AsContiguous(gamma);
+        Array beta_contiguous = internal::AsContiguous(beta);
+        Array out = EmptyLike(x_contiguous, device);
+        Array x_mean = EmptyLike(gamma_contiguous, device);
+        Array x_var = EmptyLike(gamma_contiguous, device);
+        Array x_inv_std = EmptyLike(gamma_contiguous, device);
+
+        VisitFloatingPointDtype(x.dtype(), [&](auto pt) {
+            using T = typename decltype(pt)::type;
+            using Accum = std::conditional_t<std::is_same<T, Float16>{}, float, T>;
+            const T* x_ptr = static_cast<const T*>(internal::GetRawOffsetData(x_contiguous));
+            const T* gamma_ptr = static_cast<const T*>(internal::GetRawOffsetData(gamma_contiguous));
+            const T* beta_ptr = static_cast<const T*>(internal::GetRawOffsetData(beta_contiguous));
+            T* mean_ptr = static_cast<T*>(internal::GetRawOffsetData(x_mean));
+            T* var_ptr = static_cast<T*>(internal::GetRawOffsetData(x_var));
+            T* inv_std_ptr = static_cast<T*>(internal::GetRawOffsetData(x_inv_std));
+
+            // The statistics are accumulated in double regardless of the dtype, so that the normalized values keep the precision of
+            // the dtype even for channels with small variances.
+            std::vector<MeanVarAccum<double>> stats = ComputeMeanVar<T, double>(device, layout, x_ptr);
+
+            auto eps_value = static_cast<double>(eps());
+            std::vector<Accum> mean(layout.channels);
+            std::vector<Accum> scale(layout.channels);
+            std::vector<Accum> shift(layout.channels);
+            for (int64_t c = 0; c < layout.channels; ++c) {
+                double var = stats[c].m2 / layout.count();
+                double inv_std = 1.0 / std::sqrt(var + eps_value);
+                mean[c] = static_cast<Accum>(stats[c].mean);
+                mean_ptr[c] = static_cast<T>(stats[c].mean);
+                var_ptr[c] = static_cast<T>(var);
+                inv_std_ptr[c] = static_cast<T>(inv_std);
+                scale[c] = static_cast<Accum>(static_cast<double>(gamma_ptr[c]) * inv_std);
+                shift[c] = static_cast<Accum>(beta_ptr[c]);
+            }
+
+            T* out_ptr = static_cast<T*>(internal::GetRawOffsetData(out));
+            ApplyChannelAffine<T, Accum>(device, layout, x_ptr, mean.data(), scale.data(), shift.data(), out_ptr);
+        });
+
+        // Update the running statistics, which have only as many elements as the channels.
+        Scalar inv_decay = Scalar{1.0 - static_cast<double>(decay())};
+        int64_t n = layout.count();
+        running_mean() *= decay();
+        running_mean() += inv_decay * x_mean;
+        running_var() *= decay();
+        running_var() += inv_decay * (static_cast<double>(n) / std::max(n - 1, int64_t{1})) * x_var;
+
+        SetForwardResults(std::move(x_contiguous), std::move(gamma_contiguous), std::move(x_mean), std::move(x_inv_std));
+        return out;
+    }
+
+    std::array<Array, 3> Backward(const Array& gout) override {
+        internal::UncapturableDeviceCall uncapturable_call{};
+        native_internal::FusionBarrier fusion_barrier{};
+        CHAINERX_ASSERT(internal::GetArrayBody(gout)->nodes().empty());
+
+        if (!layout_.has_value() || gout.dtype() != x().dtype()) {
+            return GenericBatchNormForwardBackward::Backward(gout);
+        }
+        const BatchNormLayout& layout = *layout_;
+
+        Device& device = gout.device();
+        Array gout_contiguous = internal::AsContiguous(gout);
+        Array gx = EmptyLike(x(), device);
+        Array ggamma = EmptyLike(gamma(), device);
+        Array gbeta = EmptyLike(gamma(), device);
+
+        VisitFloatingPointDtype(gout.dtype(), [&](auto pt) {
+            using T = typename decltype(pt)::type;
+            using Accum = std::conditional_t<std::is_same<T, Float16>{}, float, T>;
+            const T* x_ptr = static_cast<const T*>(internal::GetRawOffsetData(x()));
+            const T* gamma_ptr = static_cast<const T*>(internal::GetRawOffsetData(gamma()));
+            const T* mean_ptr = static_cast<const T*>(internal::GetRawOffsetData(x_mean()));
+            const T* inv_std_ptr = static_cast<const T*>(internal::GetRawOffsetData(x_inv_std()));
+            const T* gout_ptr = static_cast<const T*>(internal::GetRawOffsetData(gout_contiguous));
+            int64_t channels = layout.channels;
+            int64_t inner = layout.inner;
+
+            // First pass: sum of gout and sum of gout * (x - mean) for each channel.
+            std::vector<Accum> mean(channels);
+            for (int64_t c = 0; c < channels; ++c) {
+                mean[c] = static_cast<Accum>(mean_ptr[c]);
+            }
+            ChannelTasks tasks{device, layout};
+            int64_t parts = tasks.parts();
+            std::vector<Accum> gout_sums(parts * channels);
+            std::vector<Accum> dot_sums(parts * channels);
+            tasks.Run([&](int64_t part, int64_t o_begin, int64_t o_end, int64_t c_begin, int64_t c_end) {
+                for (int64_t c = c_begin; c < c_end; ++c) {
+                    Accum gout_sum{0};
+                    Accum dot_sum{0};
+                    for (int64_t o = o_begin; o < o_end; ++o) {
+                        int64_t offset = (o * channels + c) * inner;
+                        Accum row_gout_sum{0};
+                        Accum row_dot_sum{0};
+                        for (int64_t i = 0; i < inner; ++i) {
+                            auto g = static_cast<Accum>(gout_ptr[offset + i]);
+                            row_gout_sum += g;
+                            row_dot_sum += g * (static_cast<Accum>(x_ptr[offset + i]) - mean[c]);
+                        }
+                        gout_sum += row_gout_sum;
+                        dot_sum += row_dot_sum;
+                    }
+                    gout_sums[part * channels + c] = gout_sum;
+                    dot_sums[part * channels + c] = dot_sum;
+                }
+            });
+
+            // gx = gamma * inv_std * (gout - (x_hat * ggamma + gbeta) / n), expanded into coefficients of gout and x - mean for each
+            // channel.
+            T* ggamma_ptr = static_cast<T*>(internal::GetRawOffsetData(ggamma));
+            T* gbeta_ptr = static_cast<T*>(internal::GetRawOffsetData(gbeta));
+            std::vector<Accum> gout_coeff(channels);
+            std::vector<Accum> x_coeff(channels);
+            std::vector<Accum> bias(channels);
+            Accum inv_n = Accum{1} / layout.count();
+            for (int64_t c = 0; c < channels; ++c) {
+                Accum gout_sum{0};
+                Accum dot_sum{0};
+                for (int64_t part = 0; part < parts; ++part) {
+                    gout_sum += gout_sums[part * channels + c];
+                    dot_sum += dot_sums[part * channels + c];
+                }
+                auto inv_std = static_cast<Accum>(inv_std_ptr[c]);
+                Accum ggamma_c = dot_sum * inv_std;
+                ggamma_ptr[c] = static_cast<T>(ggamma_c);
+                gbeta_ptr[c] = static_cast<T>(gout_sum);
+
+                Accum coeff = static_cast<Accum>(gamma_ptr[c]) * inv_std;
+                gout_coeff[c] = coeff;
+                x_coeff[c] = -coeff * ggamma_c * inv_std * inv_n;
+                bias[c] = -coeff * gout_sum * inv_n;
+            }
+
+            // Second pass: gx.
+            T* gx_ptr = static_cast<T*>(internal::GetRawOffsetData(gx));
+            std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(device.backend()).GetThreadPool();
+            ParallelFor(*pool, layout.outer, std::max(int64_t{1}, kMinChunkSize / (channels * inner)), [&](int64_t begin, int64_t end) {
+                for (int64_t o = begin; o < end; ++o) {
+                    for (int64_t c = 0; c < channels; ++c) {
+                        int64_t offset = (o * channels + c) * inner;
+                        Accum m = mean[c];
+                        Accum a = gout_coeff[c];
+                        Accum b = x_coeff[c];
+                        Accum d = bias[c];
+                        for (int64_t i = 0; i < inner; ++i) {
+                            gx_ptr[offset + i] = static_cast<T>(
+                                    a * static_cast<Accum>(gout_ptr[offset + i]) + b * (static_cast<Accum>(x_ptr[offset + i]) - m) + d);
+                        }
+                    }
+                }
+            });
+        });
+
+        return {std::move(gx), std::move(ggamma), std::move(gbeta)};
+    }
+
+private:
+    nonstd::optional<BatchNormLayout> layout_{};
+};
+
+}  // namespace
+
+std::unique_ptr<BatchNormForwardBackward> NativeDevice::GetBatchNormForwardBackward(
+        const Array& running_mean, const Array& running_var, Scalar eps, Scalar decay, const Axes& axis) {
+    return std::make_unique<NativeBatchNormForwardBackward>(running_mean, running_var, eps, decay, axis);
+}
+
+}  // namespace native
+}  // namespace chainerx
@@ -3,14 +3,18 @@
 #include <cstdint>
 
 #include "chainerx/array.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/native/elementwise.h"
+#include "chainerx/native/fusion.h"
 
 namespace chainerx {
 namespace native {
 
 void NativeDevice::Equal(const Array& x1, const Array& x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Equal, x1, x2, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(x1, x2, out);
     Dtype dtype = PromoteTypes(x1.dtype(), x2.dtype());
     const Array& x1_cast = x1.dtype() == dtype ? x1 : x1.AsType(dtype);
@@ -25,6 +29,8 @@ void NativeDevice::Equal(const Array& x1, const Array& x2, const Array& out) {
 }
 
 void NativeDevice::NotEqual(const Array& x1, const Array& x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::NotEqual, x1, x2, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(x1, x2, out);
     Dtype dtype = PromoteTypes(x1.dtype(), x2.dtype());
     const Array& x1_cast = x1.dtype() == dtype ? x1 : x1.AsType(dtype);
@@ -39,6 +45,8 @@ void NativeDevice::NotEqual(const Array& x1, const Array& x2, const Array& out)
 }
 
 void NativeDevice::Greater(const Array& x1, const Array& x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Greater, x1, x2, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(x1, x2, out);
     Dtype dtype = PromoteTypes(x1.dtype(), x2.dtype());
     const Array& x1_cast = x1.dtype() == dtype ? x1 : x1.AsType(dtype);
@@ -53,6 +61,8 @@ void NativeDevice::Greater(const Array& x1, const Array& x2, const Array& out) {
 }
 
 void NativeDevice::GreaterEqual(const Array& x1, const Array& x2, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::GreaterEqual, x1, x2, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(x1, x2, out);
     Dtype dtype = PromoteTypes(x1.dtype(), x2.dtype());
     const Array& x1_cast = x1.dtype() == dtype ? x1 : x1.AsType(dtype);
@@ -67,6 +77,8 @@ void NativeDevice::GreaterEqual(const Array& x1, const Array& x2, const Array& o
 }
 
 void NativeDevice::LogicalNot(const Array& x, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::LogicalNot, x, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(x, out);
     VisitDtype(x.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
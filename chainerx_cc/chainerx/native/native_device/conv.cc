@@ -11,14 +11,18 @@
 
 #include "chainerx/array.h"
 #include "chainerx/axes.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/indexable_array.h"
 #include "chainerx/indexer.h"
 #include "chainerx/macro.h"
 #include "chainerx/native/col2im.h"
+#include "chainerx/native/fusion.h"
 #include "chainerx/native/im2col.h"
+#include "chainerx/native/implicit_gemm_conv.h"
 #include "chainerx/native/tensor_dot.h"
+#include "chainerx/native/winograd_conv.h"
 #include "chainerx/routines/connection.h"
 #include "chainerx/routines/creation.h"
 #include "chainerx/routines/manipulation.h"
@@ -36,8 +40,19 @@ Array NativeDevice::Conv(
         const StackVector<int64_t, kMaxNdim>& pad,
         bool cover_all,
         Dtype out_dtype) {
+    internal::UncapturableDeviceCall uncapturable_call{};
+    native_internal::FusionBarrier fusion_barrier{};
     int8_t ndim = w.ndim() - 2;  // Number of spatial dimensions
 
+    if (native_internal::IsWinogradConvEnabled(x, w, b, stride, pad, out_dtype)) {
+        return native_internal::WinogradConv(x, w, b, pad);
+    }
+
+    // Build the column matrix tile by tile instead of materializing it, except for the degenerate case without spatial dimensions.
+    if (x.ndim() > 2) {
+        return native_internal::ImplicitGemmConv(x, w, b, stride, pad, cover_all, out_dtype);
+    }
+
     // Compute the kernel size from the weight array.
     StackVector<int64_t, kMaxNdim> kernel_size;
     std::copy_n(w.shape().begin() + 2, ndim, std::back_inserter(kernel_size));
@@ -77,9 +92,15 @@ Array NativeDevice::ConvGradWeight(
         const StackVector<int64_t, kMaxNdim>& stride,
         const StackVector<int64_t, kMaxNdim>& pad,
         bool cover_all) {
+    internal::UncapturableDeviceCall uncapturable_call{};
+    native_internal::FusionBarrier fusion_barrier{};
     CHAINERX_ASSERT(x.ndim() == w_shape.ndim());
     int8_t ndim = x.ndim() - 2;  // Number of spatial dimensions
 
+    if (x.ndim() > 2) {
+        return native_internal::ImplicitGemmConvGradWeight(w_dtype, w_shape, x, gy, stride, pad, cover_all);
+    }
+
     // Compute the kernel size
     StackVector<int64_t, kMaxNdim> kernel_size{w_shape.begin() + 2, w_shape.end()};
 
@@ -104,6 +125,13 @@ Array NativeDevice::ConvTranspose(
         const StackVector<int64_t, kMaxNdim>& pad,
         const StackVector<int64_t, kMaxNdim>& out_size,
         Dtype out_dtype) {
+    internal::UncapturableDeviceCall uncapturable_call{};
+    native_internal::FusionBarrier fusion_barrier{};
+    // Stride 1 leaves no choice for out_size, and the transposed convolution is a convolution by the flipped kernel.
+    if (native_internal::IsWinogradConvTransposeEnabled(x, w, b, stride, pad, out_dtype)) {
+        return native_internal::WinogradConvTranspose(x, w, b, pad);
+    }
+
     Array col = TensorDot(w, x, {0}, {1}, out_dtype);  // shape: out_channel, k_1, ..., k_n, batch_size, out_1, ..., out_n
     col = RollAxis(col, x.ndim() - 1);  // batch axis is rolled to the top
 
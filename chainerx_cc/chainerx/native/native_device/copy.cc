@@ -3,14 +3,18 @@
 #include <cstdint>
 
 #include "chainerx/array.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/native/elementwise.h"
+#include "chainerx/native/fusion.h"
 
 namespace chainerx {
 namespace native {
 
 void NativeDevice::Copy(const Array& a, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Copy, a, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(a, out);
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
@@ -22,7 +26,11 @@ void NativeDevice::Copy(const Array& a, const Array& out) {
 }
 
 void NativeDevice::AsType(const Array& a, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::AsType, a, out};
     CheckDevicesCompatible(a, out);
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kAsType, {&a}, {}, out)) {
+        return;
+    }
     auto do_astype = [&](auto in_pt, auto out_pt) {
         using InT = typename decltype(in_pt)::type;
         using OutT = typename decltype(out_pt)::type;
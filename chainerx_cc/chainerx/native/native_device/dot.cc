@@ -1,20 +1,21 @@
 #include "chainerx/native/native_device.h"
 
-#include <cmath>
+#include <cstddef>
 #include <cstdint>
-#include <type_traits>
+#include <vector>
 
 #ifdef CHAINERX_ENABLE_BLAS
 #include <cblas.h>
 #endif  // CHAINERX_ENABLE_BLAS
 
 #include "chainerx/array.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
-#include "chainerx/indexable_array.h"
 #include "chainerx/macro.h"
-#include "chainerx/native/data_type.h"
 #include "chainerx/native/elementwise.h"
+#include "chainerx/native/fusion.h"
+#include "chainerx/native/gemm.h"
 #include "chainerx/routines/creation.h"
 #include "chainerx/shape.h"
 
@@ -49,44 +50,53 @@ struct GemmInputLayout {
     CBLAS_TRANSPOSE trans = CblasNoTrans;
 
     // Configure leading dimension and transposition accordingly, and makes the array C contiguous if necessary
+    // The last two axes of the array are the matrix axes, and the others are batch axes.
     Array Configure(const Array& a) {
-        CHAINERX_ASSERT(a.ndim() == 2);
+        CHAINERX_ASSERT(a.ndim() >= 2);
+        int64_t rows = a.shape()[a.ndim() - 2];
+        int64_t cols = a.shape()[a.ndim() - 1];
+        int64_t row_stride = a.strides()[a.ndim() - 2];
+        int64_t col_stride = a.strides()[a.ndim() - 1];
         // Row-major
         // Note that this condition is slightly relaxed than Array::IsContiguous() which requires
         // a.strides()[0] == a.GetItemSize() * a.shape()[1]
-        if (a.strides()[1] == a.GetItemSize() && a.strides()[0] / a.GetItemSize() >= a.shape()[1] &&
-            a.strides()[0] % a.GetItemSize() == 0) {
-            ld = a.strides()[0] / a.GetItemSize();
+        if (col_stride == a.GetItemSize() && row_stride / a.GetItemSize() >= cols && row_stride % a.GetItemSize() == 0) {
+            ld = row_stride / a.GetItemSize();
             return a;
         }
         // Column-major
-        if (a.strides()[0] == a.GetItemSize() && a.strides()[1] / a.GetItemSize() >= a.shape()[0] &&
-            a.strides()[1] % a.GetItemSize() == 0) {
-            ld = a.strides()[1] / a.GetItemSize();
+        if (row_stride == a.GetItemSize() && col_stride / a.GetItemSize() >= rows && col_stride % a.GetItemSize() == 0) {
+            ld = col_stride / a.GetItemSize();
             trans = CblasTrans;
             return a;
         }
         // Force row-major contiguous
-        ld = a.shape()[1];
+        ld = cols;
         return internal::AsContiguous(a);
     }
 };
 
-void Gemm(const Array& a, const Array& b, const Array& out) {
-    CHAINERX_ASSERT(a.ndim() == 2);
-    CHAINERX_ASSERT(b.ndim() == 2);
-    CHAINERX_ASSERT(out.ndim() == 2);
+// Computes the matrix products of batches of matrices. See native_internal::Gemm for the shapes of the operands.
+void BlasGemm(const Array& a, const Array& b, const Array& out, bool accumulate) {
+    CHAINERX_ASSERT(a.ndim() >= 2);
+    CHAINERX_ASSERT(a.ndim() == b.ndim());
+    CHAINERX_ASSERT(a.ndim() == out.ndim());
     CHAINERX_ASSERT(out.dtype() == Dtype::kFloat32 || out.dtype() == Dtype::kFloat64);
 
-    int64_t m = a.shape()[0];
-    int64_t k = a.shape()[1];
-    int64_t n = b.shape()[1];
-    CHAINERX_ASSERT(b.shape()[0] == k);
-    CHAINERX_ASSERT(out.shape()[0] == m);
-    CHAINERX_ASSERT(out.shape()[1] == n);
-
-    bool is_out_contiguous = out.IsContiguous();
-    Array out_contiguous = is_out_contiguous ? out : EmptyLike(out, out.device());
+    int64_t m = a.shape()[a.ndim() - 2];
+    int64_t k = a.shape()[a.ndim() - 1];
+    int64_t n = b.shape()[b.ndim() - 1];
+    CHAINERX_ASSERT(b.shape()[b.ndim() - 2] == k);
+    CHAINERX_ASSERT(out.shape()[out.ndim() - 2] == m);
+    CHAINERX_ASSERT(out.shape()[out.ndim() - 1] == n);
+
+    // The output can be written directly if its matrices are row-major, possibly with padding between rows.
+    int64_t out_row_stride = out.strides()[out.ndim() - 2];
+    bool is_out_row_major = out.strides()[out.ndim() - 1] == out.GetItemSize() && out_row_stride % out.GetItemSize() == 0 &&
+                            out_row_stride / out.GetItemSize() >= n;
+    // The current values are copied only if the products are added to them.
+    Array out_contiguous = is_out_row_major ? out : accumulate ? out.Copy() : EmptyLike(out, out.device());
+    int64_t ldc = is_out_row_major ? out_row_stride / out.GetItemSize() : n;
 
     auto gemm_impl = [&](auto pt) {
         using T = typename decltype(pt)::type;
@@ -96,13 +106,33 @@ void Gemm(const Array& a, const Array& b, const Array& out) {
         Array a_config = a_layout.Configure(a);
         Array b_config = b_layout.Configure(b);
 
+        // Batch strides are used as is, so that broadcast or strided batches are not copied.
+        std::vector<int64_t> a_offsets = native_internal::GetMatrixOffsets(a_config);
+        std::vector<int64_t> b_offsets = native_internal::GetMatrixOffsets(b_config);
+        std::vector<int64_t> out_offsets = native_internal::GetMatrixOffsets(out_contiguous);
+
         const T one = 1;
-        const T zero = 0;
-        const T* a_ptr = static_cast<const T*>(internal::GetRawOffsetData(a_config));
-        const T* b_ptr = static_cast<const T*>(internal::GetRawOffsetData(b_config));
-        T* out_ptr = static_cast<T*>(internal::GetRawOffsetData(out_contiguous));
-        GemmImpl<T>{}(
-                CblasRowMajor, a_layout.trans, b_layout.trans, m, n, k, one, a_ptr, a_layout.ld, b_ptr, b_layout.ld, zero, out_ptr, n);
+        const T beta = accumulate ? 1 : 0;
+        auto a_ptr = static_cast<const uint8_t*>(internal::GetRawOffsetData(a_config));
+        auto b_ptr = static_cast<const uint8_t*>(internal::GetRawOffsetData(b_config));
+        auto out_ptr = static_cast<uint8_t*>(internal::GetRawOffsetData(out_contiguous));
+        for (size_t i = 0; i < out_offsets.size(); ++i) {
+            GemmImpl<T>{}(
+                    CblasRowMajor,
+                    a_layout.trans,
+                    b_layout.trans,
+                    m,
+                    n,
+                    k,
+                    one,
+                    reinterpret_cast<const T*>(a_ptr + a_offsets[i]),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                    a_layout.ld,
+                    reinterpret_cast<const T*>(b_ptr + b_offsets[i]),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                    b_layout.ld,
+                    beta,
+                    reinterpret_cast<T*>(out_ptr + out_offsets[i]),  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+                    ldc);
+        }
     };
 
     if (a.dtype() == Dtype::kFloat32) {
@@ -112,7 +142,7 @@ void Gemm(const Array& a, const Array& b, const Array& out) {
         gemm_impl(PrimitiveType<double>{});
     }
 
-    if (!is_out_contiguous) {
+    if (!is_out_row_major) {
         out.device().Copy(out_contiguous, out);
     }
 }
@@ -120,100 +150,56 @@ void Gemm(const Array& a, const Array& b, const Array& out) {
 }  // namespace
 #endif  // CHAINERX_ENABLE_BLAS
 
-namespace {
+namespace native_internal {
 
-template <typename T>
-T MultiplyAdd(T x, T y, T z) {
-    return x * y + z;
-}
-
-bool MultiplyAdd(bool x, bool y, bool z) { return (x && y) || z; }
+void MatrixProduct(const Array& a, const Array& b, const Array& out, bool accumulate) {
+    if (out.GetTotalSize() == 0) {
+        return;
+    }
 
-float MultiplyAdd(Float16 x, Float16 y, float z) { return std::fmaf(static_cast<float>(x), static_cast<float>(y), z); }
+#ifdef CHAINERX_ENABLE_BLAS
+    if (out.dtype() == Dtype::kFloat32 || out.dtype() == Dtype::kFloat64) {
+        BlasGemm(
+                a.dtype() == out.dtype() ? a : a.AsType(out.dtype()),
+                b.dtype() == out.dtype() ? b : b.AsType(out.dtype()),
+                out,
+                accumulate);
+        return;
+    }
+#endif  // CHAINERX_ENABLE_BLAS
 
-float MultiplyAdd(float x, float y, float z) { return std::fmaf(x, y, z); }
+    // Float16 is always computed by the in-tree GEMM, which converts operands to float32 while packing them and writes the results
+    // directly into out, instead of going through float32 copies of the operands and the output.
 
-double MultiplyAdd(double x, double y, double z) { return std::fma(x, y, z); }
+    const Array& a_cast = a.dtype() == out.dtype() ? a : a.AsType(out.dtype());
+    const Array& b_cast = b.dtype() == out.dtype() ? b : b.AsType(out.dtype());
+    Gemm(a_cast, b_cast, out, accumulate);
+}
 
-}  // namespace
+}  // namespace native_internal
 
 void NativeDevice::Dot(const Array& a, const Array& b, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Dot, a, b, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(a, b, out);
 
-    // TODO(sonots): Support ndim >= 2
     if (a.ndim() != 2 || b.ndim() != 2 || out.ndim() != 2) {
         throw DimensionError{"ChainerX dot supports only 2-dimensional arrays."};
     }
 
-#ifdef CHAINERX_ENABLE_BLAS
-    if (out.dtype() == Dtype::kFloat32 || out.dtype() == Dtype::kFloat64) {
-        Gemm(a.dtype() == out.dtype() ? a : a.AsType(out.dtype()), b.dtype() == out.dtype() ? b : b.AsType(out.dtype()), out);
-        return;
-    }
-
-    if (out.dtype() == Dtype::kFloat16) {
-        Array a32 = a.AsType(Dtype::kFloat32, false);
-        Array b32 = b.AsType(Dtype::kFloat32, false);
-        Array acc = out.AsType(Dtype::kFloat32);
-        Gemm(a32, b32, acc);
-
-        // TODO(gwtnb): Replace Fill(0) and += with CopyTo when CopyTo is added
-        out.Fill(0);
-        out += acc.AsType(Dtype::kFloat16);
-        return;
-    }
-#endif  // CHAINERX_ENABLE_BLAS
-
-    const Array& a_cast = a.dtype() == out.dtype() ? a : a.AsType(out.dtype());
-    const Array& b_cast = b.dtype() == out.dtype() ? b : b.AsType(out.dtype());
+    native_internal::MatrixProduct(a, b, out);
+}
 
-    out.Fill(0);
-    VisitDtype(out.dtype(), [&](auto pt) {
-        CHAINERX_ASSERT(a_cast.dtype() == out.dtype());
-        CHAINERX_ASSERT(b_cast.dtype() == out.dtype());
+void NativeDevice::BatchDot(const Array& a, const Array& b, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::BatchDot, a, b, out};
+    native_internal::FusionBarrier fusion_barrier{};
+    CheckDevicesCompatible(a, b, out);
 
-        using T = typename decltype(pt)::type;
+    CHAINERX_ASSERT(a.ndim() >= 2);
+    CHAINERX_ASSERT(a.ndim() == b.ndim());
+    CHAINERX_ASSERT(a.ndim() == out.ndim());
 
-        IndexableArray<const T, 2> a_cast_iarray{a_cast};
-        IndexableArray<const T, 2> b_cast_iarray{b_cast};
-        IndexableArray<T, 2> out_iarray{out};
-
-        int64_t m = a_cast.shape()[0];
-        int64_t k = a_cast.shape()[1];
-        int64_t n = b_cast.shape()[1];
-        CHAINERX_ASSERT(b_cast.shape()[0] == k);
-        CHAINERX_ASSERT(out.shape()[0] == m);
-        CHAINERX_ASSERT(out.shape()[1] == n);
-
-        using AccT = std::conditional_t<std::is_same<T, Float16>{}, float, T>;
-        constexpr auto acc_dtype = PrimitiveType<AccT>::kDtype;
-
-        Array acc = out.AsType(acc_dtype, false);
-        IndexableArray<AccT, 2> acc_iarray{acc};
-        for (int64_t i = 0; i < m; ++i) {
-            for (int64_t l = 0; l < k; ++l) {
-                int64_t a_i_l[] = {i, l};
-                T a_value = native_internal::StorageToDataType<const T>(a_cast_iarray[a_i_l]);
-                for (int64_t j = 0; j < n; ++j) {
-                    int64_t acc_i_j[] = {i, j};
-                    int64_t b_l_j[] = {l, j};
-                    T b_value = native_internal::StorageToDataType<const T>(b_cast_iarray[b_l_j]);
-                    AccT& acc_value = native_internal::StorageToDataType<AccT>(acc_iarray[acc_i_j]);
-                    acc_value = MultiplyAdd(a_value, b_value, acc_value);
-                }
-            }
-        }
-        if (!std::is_same<T, AccT>{}) {
-            for (int64_t i = 0; i < m; ++i) {
-                for (int64_t j = 0; j < n; ++j) {
-                    int64_t i_j[] = {i, j};
-                    AccT acc_value = native_internal::StorageToDataType<AccT>(acc_iarray[i_j]);
-                    T& out_value = native_internal::StorageToDataType<T>(out_iarray[i_j]);
-                    out_value = static_cast<T>(acc_value);
-                }
-            }
-        }
-    });
+    native_internal::MatrixProduct(a, b, out);
 }
 
 }  // namespace native
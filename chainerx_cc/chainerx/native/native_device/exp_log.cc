@@ -3,17 +3,23 @@
 #include <cstdint>
 
 #include "chainerx/array.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/native/elementwise.h"
+#include "chainerx/native/fusion.h"
 #include "chainerx/numeric.h"
 
 namespace chainerx {
 namespace native {
 
 void NativeDevice::Exp(const Array& x, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Exp, x, out};
     CheckDevicesCompatible(x, out);
     const Array& x_cast = x.dtype() == out.dtype() ? x : x.AsType(out.dtype());
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kExp, {&x_cast}, {}, out)) {
+        return;
+    }
     VisitFloatingPointDtype(out.dtype(), [&x_cast, &out](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -24,8 +30,12 @@ void NativeDevice::Exp(const Array& x, const Array& out) {
 }
 
 void NativeDevice::Log(const Array& x, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Log, x, out};
     CheckDevicesCompatible(x, out);
     const Array& x_cast = x.dtype() == out.dtype() ? x : x.AsType(out.dtype());
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kLog, {&x_cast}, {}, out)) {
+        return;
+    }
     VisitFloatingPointDtype(out.dtype(), [&x_cast, &out](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
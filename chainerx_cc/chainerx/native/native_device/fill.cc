@@ -3,6 +3,7 @@
 #include <cstdint>
 
 #include "chainerx/array.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/indexable_array.h"
@@ -10,6 +11,7 @@
 #include "chainerx/macro.h"
 #include "chainerx/native/data_type.h"
 #include "chainerx/native/elementwise.h"
+#include "chainerx/native/fusion.h"
 #include "chainerx/scalar.h"
 #include "chainerx/shape.h"
 
@@ -17,6 +19,8 @@ namespace chainerx {
 namespace native {
 
 void NativeDevice::Fill(const Array& out, Scalar value) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Fill, out, value};
+    native_internal::FusionBarrier fusion_barrier{};
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -28,6 +32,8 @@ void NativeDevice::Fill(const Array& out, Scalar value) {
 }
 
 void NativeDevice::Arange(Scalar start, Scalar step, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Arange, start, step, out};
+    native_internal::FusionBarrier fusion_barrier{};
     VisitDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -40,6 +46,8 @@ void NativeDevice::Arange(Scalar start, Scalar step, const Array& out) {
 }
 
 void NativeDevice::Identity(const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Identity, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CHAINERX_ASSERT(out.ndim() == 2);
     CHAINERX_ASSERT(out.shape()[0] == out.shape()[1]);
 
@@ -55,6 +63,8 @@ void NativeDevice::Identity(const Array& out) {
 }
 
 void NativeDevice::Eye(int64_t k, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Eye, k, out};
+    native_internal::FusionBarrier fusion_barrier{};
     VisitDtype(out.dtype(), [k, &out](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -69,6 +79,8 @@ void NativeDevice::Eye(int64_t k, const Array& out) {
 }
 
 void NativeDevice::Diagflat(const Array& v, int64_t k, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Diagflat, v, k, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CHAINERX_ASSERT(v.ndim() == 1);
     CHAINERX_ASSERT(out.ndim() == 2);
 
@@ -105,6 +117,8 @@ void NativeDevice::Diagflat(const Array& v, int64_t k, const Array& out) {
 }
 
 void NativeDevice::Linspace(double start, double stop, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Linspace, start, stop, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CHAINERX_ASSERT(out.ndim() == 1);
     CHAINERX_ASSERT(out.shape()[0] > 0);
 
@@ -1,25 +1,84 @@
 #include "chainerx/native/native_device.h"
 
+#include <algorithm>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <vector>
 
 #include "chainerx/array.h"
+#include "chainerx/backend_util.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/indexable_array.h"
 #include "chainerx/indexer.h"
 #include "chainerx/macro.h"
 #include "chainerx/native/elementwise.h"
+#include "chainerx/native/fusion.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/thread_pool.h"
 #include "chainerx/shape.h"
 
 namespace chainerx {
 namespace native {
 
-void NativeDevice::Take(const Array& a, const Array& indices, int8_t axis, const Array& out) {
-    CHAINERX_ASSERT(GetKind(indices.dtype()) == DtypeKind::kInt || GetKind(indices.dtype()) == DtypeKind::kUInt);
-    CheckDevicesCompatible(a, indices, out);
+namespace {
 
-    const Array& indices_cast = indices.dtype() == Dtype::kInt64 ? indices : indices.AsType(Dtype::kInt64);
+// Minimum number of elements copied or added by a single thread.
+constexpr int64_t kMinChunkSize = int64_t{1} << 15;
+
+// Minimum number of elements of the column chunks of AddAt.
+constexpr int64_t kMinColumnChunkSize = 1024;
+
+// Wraps an index into [0, axis_dim).
+int64_t WrapIndex(int64_t index, int64_t axis_dim) {
+    if (index < 0) {
+        index = axis_dim - ((-index + axis_dim - 1) % axis_dim + 1);
+    } else {
+        index = index % axis_dim;
+    }
+    CHAINERX_ASSERT(0 <= index);
+    CHAINERX_ASSERT(index < axis_dim);
+    return index;
+}
+
+template <typename T>
+void WrapIndices(const Array& indices, int64_t axis_dim, std::vector<int64_t>& wrapped) {
+    IndexableArray<const T> indices_iarray{indices};
+    Indexer<> indices_indexer{indices.shape()};
+    for (auto it = indices_indexer.It(0); it; ++it) {
+        wrapped[it.raw_index()] = WrapIndex(static_cast<int64_t>(indices_iarray[it]), axis_dim);
+    }
+}
+
+// Returns the indices wrapped into [0, axis_dim), in the C order of the indices array.
+std::vector<int64_t> GetWrappedIndices(const Array& indices, int64_t axis_dim) {
+    std::vector<int64_t> wrapped(indices.GetTotalSize());
+    switch (indices.dtype()) {
+        case Dtype::kInt8:
+            WrapIndices<int8_t>(indices, axis_dim, wrapped);
+            break;
+        case Dtype::kInt16:
+            WrapIndices<int16_t>(indices, axis_dim, wrapped);
+            break;
+        case Dtype::kInt32:
+            WrapIndices<int32_t>(indices, axis_dim, wrapped);
+            break;
+        case Dtype::kInt64:
+            WrapIndices<int64_t>(indices, axis_dim, wrapped);
+            break;
+        case Dtype::kUInt8:
+            WrapIndices<uint8_t>(indices, axis_dim, wrapped);
+            break;
+        default:
+            CHAINERX_NEVER_REACH();
+    }
+    return wrapped;
+}
 
+void TakeGeneric(const Array& a, const Array& indices_cast, int8_t axis, const Array& out) {
     VisitDtype(out.dtype(), [&a, &indices_cast, axis, &out](auto pt) {
         using T = typename decltype(pt)::type;
 
@@ -48,15 +107,7 @@ void NativeDevice::Take(const Array& a, const Array& indices, int8_t axis, const
         auto it_a = a_indexer.It(0);
 
         for (auto it = indices_indexer.It(0); it; ++it) {
-            int64_t index = indices_iarray[it];
-            if (index < 0) {
-                index = axis_dim - ((-index + axis_dim - 1) % axis_dim + 1);
-            } else {
-                index = index % axis_dim;
-            }
-            CHAINERX_ASSERT(0 <= index);
-            CHAINERX_ASSERT(index < axis_dim);
-            it_axis.Restart(index);
+            it_axis.Restart(WrapIndex(indices_iarray[it], axis_dim));
 
             it_out.CopyIndex(it, it_left.ndim());
             it_a.CopyIndex(it_axis, it_left.ndim());
@@ -75,13 +126,7 @@ void NativeDevice::Take(const Array& a, const Array& indices, int8_t axis, const
     });
 }
 
-void NativeDevice::AddAt(const Array& a, const Array& indices, int8_t axis, const Array& b, const Array& out) {
-    CHAINERX_ASSERT(a.shape() == out.shape());
-    CHAINERX_ASSERT(GetKind(indices.dtype()) == DtypeKind::kInt || GetKind(indices.dtype()) == DtypeKind::kUInt);
-    CheckDevicesCompatible(a, indices, b);
-
-    const Array& indices_cast = indices.dtype() == Dtype::kInt64 ? indices : indices.AsType(Dtype::kInt64);
-
+void AddAtGeneric(const Array& a, const Array& indices_cast, int8_t axis, const Array& b, const Array& out) {
     VisitDtype(a.dtype(), [&a, &indices_cast, axis, &b, &out](auto pt) {
         using T = typename decltype(pt)::type;
 
@@ -117,15 +162,7 @@ void NativeDevice::AddAt(const Array& a, const Array& indices, int8_t axis, cons
 
         // Add
         for (auto it = indices_indexer.It(0); it; ++it) {
-            int64_t index = indices_iarray[it];
-            if (index < 0) {
-                index = axis_dim - ((-index + axis_dim - 1) % axis_dim + 1);
-            } else {
-                index = index % axis_dim;
-            }
-            CHAINERX_ASSERT(0 <= index);
-            CHAINERX_ASSERT(index < axis_dim);
-            it_axis.Restart(index);
+            it_axis.Restart(WrapIndex(indices_iarray[it], axis_dim));
 
             it_out.CopyIndex(it_axis, it_left.ndim());
             it_b.CopyIndex(it, it_left.ndim());
@@ -144,5 +181,133 @@ void NativeDevice::AddAt(const Array& a, const Array& indices, int8_t axis, cons
     });
 }
 
+// Shape of the arrays of Take and AddAt seen as (left, axis, right), where a row is the elements of `right` at a position of the
+// others.
+struct RowLayout {
+    RowLayout(const Shape& shape, int8_t axis)
+        : left{std::accumulate(shape.begin(), shape.begin() + axis, int64_t{1}, std::multiplies<>())},
+          axis_dim{shape[axis]},
+          right{std::accumulate(shape.begin() + (axis + 1), shape.end(), int64_t{1}, std::multiplies<>())} {}
+
+    int64_t left;
+    int64_t axis_dim;
+    int64_t right;
+};
+
+// Copies the rows selected by the indices, in parallel over the output rows.
+void TakeRows(const Array& a, const std::vector<int64_t>& indices, int8_t axis, const Array& out) {
+    RowLayout layout{a.shape(), axis};
+    auto num_indices = static_cast<int64_t>(indices.size());
+    std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(a.device().backend()).GetThreadPool();
+
+    VisitDtype(out.dtype(), [&](auto pt) {
+        using T = typename decltype(pt)::type;
+        const T* a_ptr = static_cast<const T*>(internal::GetRawOffsetData(a));
+        T* out_ptr = static_cast<T*>(internal::GetRawOffsetData(out));
+
+        int64_t min_chunk_size = std::max(int64_t{1}, kMinChunkSize / std::max(int64_t{1}, layout.right));
+        ParallelFor(*pool, layout.left * num_indices, min_chunk_size, [&](int64_t begin, int64_t end) {
+            for (int64_t row = begin; row < end; ++row) {
+                int64_t l = row / num_indices;
+                int64_t index = indices[row % num_indices];
+                std::copy_n(a_ptr + (l * layout.axis_dim + index) * layout.right, layout.right, out_ptr + row * layout.right);
+            }
+        });
+    });
+}
+
+// Adds the rows of b to the rows of out selected by the indices.
+//
+// The positions of the indices are grouped by the destination row, so that each destination row is updated by a single thread without
+// conflicts. Rows of a group are added in the order of the indices, which gives the same result as the sequential addition.
+// If there are only a few destination rows, the rows are also split into chunks of columns.
+void AddAtRows(const std::vector<int64_t>& indices, int8_t axis, const Array& b, const Array& out) {
+    RowLayout layout{out.shape(), axis};
+    auto num_indices = static_cast<int64_t>(indices.size());
+    std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(out.device().backend()).GetThreadPool();
+
+    std::vector<int64_t> order(num_indices);
+    std::iota(order.begin(), order.end(), int64_t{0});
+    std::stable_sort(order.begin(), order.end(), [&indices](int64_t i, int64_t j) { return indices[i] < indices[j]; });
+    std::vector<int64_t> group_offsets;
+    for (int64_t i = 0; i < num_indices; ++i) {
+        if (i == 0 || indices[order[i]] != indices[order[i - 1]]) {
+            group_offsets.emplace_back(i);
+        }
+    }
+    auto num_groups = static_cast<int64_t>(group_offsets.size());
+    group_offsets.emplace_back(num_indices);
+
+    int64_t num_tasks = layout.left * num_groups;
+    int64_t column_chunks = std::max(
+            int64_t{1},
+            std::min((pool->num_threads() + num_tasks - 1) / num_tasks, layout.right / kMinColumnChunkSize));
+    int64_t min_chunk_size = std::max(int64_t{1}, kMinChunkSize * num_groups * column_chunks / std::max(int64_t{1}, num_indices * layout.right));
+
+    VisitDtype(out.dtype(), [&](auto pt) {
+        using T = typename decltype(pt)::type;
+        const T* b_ptr = static_cast<const T*>(internal::GetRawOffsetData(b));
+        T* out_ptr = static_cast<T*>(internal::GetRawOffsetData(out));
+
+        ParallelFor(*pool, num_tasks * column_chunks, min_chunk_size, [&](int64_t begin, int64_t end) {
+            for (int64_t task = begin; task < end; ++task) {
+                int64_t chunk = task % column_chunks;
+                int64_t group = task / column_chunks % num_groups;
+                int64_t l = task / column_chunks / num_groups;
+                int64_t col_begin = layout.right * chunk / column_chunks;
+                int64_t col_end = layout.right * (chunk + 1) / column_chunks;
+
+                T* dst = out_ptr + (l * layout.axis_dim + indices[order[group_offsets[group]]]) * layout.right;
+                for (int64_t i = group_offsets[group]; i < group_offsets[group + 1]; ++i) {
+                    const T* src = b_ptr + (l * num_indices + order[i]) * layout.right;
+                    for (int64_t col = col_begin; col < col_end; ++col) {
+                        dst[col] += src[col];
+                    }
+                }
+            }
+        });
+    });
+}
+
+}  // namespace
+
+void NativeDevice::Take(const Array& a, const Array& indices, int8_t axis, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Take, a, indices, axis, out};
+    native_internal::FusionBarrier fusion_barrier{};
+    CHAINERX_ASSERT(GetKind(indices.dtype()) == DtypeKind::kInt || GetKind(indices.dtype()) == DtypeKind::kUInt);
+    CheckDevicesCompatible(a, indices, out);
+
+    // Each index selects a contiguous row if both arrays are C-contiguous.
+    if (a.IsContiguous() && out.IsContiguous()) {
+        if (out.GetTotalSize() > 0) {
+            TakeRows(a, GetWrappedIndices(indices, a.shape()[axis]), axis, out);
+        }
+        return;
+    }
+
+    const Array& indices_cast = indices.dtype() == Dtype::kInt64 ? indices : indices.AsType(Dtype::kInt64);
+    TakeGeneric(a, indices_cast, axis, out);
+}
+
+void NativeDevice::AddAt(const Array& a, const Array& indices, int8_t axis, const Array& b, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::AddAt, a, indices, axis, b, out};
+    native_internal::FusionBarrier fusion_barrier{};
+    CHAINERX_ASSERT(a.shape() == out.shape());
+    CHAINERX_ASSERT(GetKind(indices.dtype()) == DtypeKind::kInt || GetKind(indices.dtype()) == DtypeKind::kUInt);
+    CheckDevicesCompatible(a, indices, b);
+
+    // Each index selects a contiguous row if both b and out are C-contiguous.
+    if (b.IsContiguous() && out.IsContiguous()) {
+        Copy(a, out);
+        if (b.GetTotalSize() > 0) {
+            AddAtRows(GetWrappedIndices(indices, a.shape()[axis]), axis, b, out);
+        }
+        return;
+    }
+
+    const Array& indices_cast = indices.dtype() == Dtype::kInt64 ? indices : indices.AsType(Dtype::kInt64);
+    AddAtGeneric(a, indices_cast, axis, b, out);
+}
+
 }  // namespace native
 }  // namespace chainerx
@@ -4,9 +4,13 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <utility>
 
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/macro.h"
+#include "chainerx/native/fusion.h"
+#include "chainerx/native/memory_pool.h"
 
 namespace chainerx {
 namespace native {
@@ -15,21 +19,29 @@ std::shared_ptr<void> NativeDevice::Allocate(size_t bytesize) {
     if (bytesize == 0) {
         return std::shared_ptr<void>{nullptr};
     }
-    return std::shared_ptr<uint8_t>{new uint8_t[bytesize], std::default_delete<uint8_t[]>()};
+    // Unlike the CUDA device, the deleter keeps the pool alive, since host memory in use may outlive the device.
+    auto deleter = [pool = memory_pool_, bytesize](void* ptr) { pool->Free(ptr, bytesize); };
+    return std::shared_ptr<void>{memory_pool_->Malloc(bytesize), std::move(deleter)};
 }
 
 void NativeDevice::MemoryCopyFrom(void* dst, const void* src, size_t bytesize, Device& src_device) {
+    internal::UncapturableDeviceCall uncapturable_call{};
+    native_internal::FusionBarrier fusion_barrier{};
     CHAINERX_ASSERT(nullptr != dynamic_cast<NativeDevice*>(&src_device) && "Native device only supports copy between native devices");
     std::memcpy(dst, src, bytesize);
 }
 
 void NativeDevice::MemoryCopyTo(void* dst, const void* src, size_t bytesize, Device& dst_device) {
+    internal::UncapturableDeviceCall uncapturable_call{};
+    native_internal::FusionBarrier fusion_barrier{};
     CHAINERX_ASSERT(nullptr != dynamic_cast<NativeDevice*>(&dst_device) && "Native device only supports copy between native devices");
     std::memcpy(dst, src, bytesize);
 }
 
 std::shared_ptr<void> NativeDevice::TransferDataFrom(
         Device& src_device, const std::shared_ptr<void>& src_ptr, size_t offset, size_t bytesize) {
+    internal::UncapturableDeviceCall uncapturable_call{};
+    native_internal::FusionBarrier fusion_barrier{};
     std::shared_ptr<void> dst_ptr = Allocate(bytesize);
     MemoryCopyFrom(dst_ptr.get(), &(static_cast<int8_t*>(src_ptr.get())[offset]), bytesize, src_device);
     return dst_ptr;
@@ -37,10 +49,13 @@ std::shared_ptr<void> NativeDevice::TransferDataFrom(
 
 std::shared_ptr<void> NativeDevice::TransferDataTo(
         Device& dst_device, const std::shared_ptr<void>& src_ptr, size_t offset, size_t bytesize) {
+    internal::UncapturableDeviceCall uncapturable_call{};
+    native_internal::FusionBarrier fusion_barrier{};
     return dst_device.TransferDataFrom(*this, src_ptr, offset, bytesize);
 }
 
 std::shared_ptr<void> NativeDevice::FromHostMemory(const std::shared_ptr<void>& src_ptr, size_t bytesize) {
+    native_internal::FusionBarrier fusion_barrier{};
     (void)bytesize;  // unused
     return src_ptr;
 }
@@ -4,17 +4,23 @@
 #include <cstdint>
 
 #include "chainerx/array.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/native/elementwise.h"
+#include "chainerx/native/fusion.h"
 #include "chainerx/numeric.h"
 
 namespace chainerx {
 namespace native {
 
 void NativeDevice::Sqrt(const Array& x, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Sqrt, x, out};
     CheckDevicesCompatible(x, out);
     const Array& x_cast = x.dtype() == out.dtype() ? x : x.AsType(out.dtype());
+    if (native_internal::RecordElementwise(native_internal::FusionOp::kSqrt, {&x_cast}, {}, out)) {
+        return;
+    }
     VisitFloatingPointDtype(out.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
         struct Impl {
@@ -25,6 +31,8 @@ void NativeDevice::Sqrt(const Array& x, const Array& out) {
 }
 
 void NativeDevice::IsNan(const Array& x, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::IsNan, x, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(x, out);
     VisitDtype(x.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
@@ -36,6 +44,8 @@ void NativeDevice::IsNan(const Array& x, const Array& out) {
 }
 
 void NativeDevice::IsInf(const Array& x, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::IsInf, x, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CheckDevicesCompatible(x, out);
     VisitDtype(x.dtype(), [&](auto pt) {
         using T = typename decltype(pt)::type;
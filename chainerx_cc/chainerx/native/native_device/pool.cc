@@ -2,25 +2,31 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <numeric>
+#include <type_traits>
 #include <utility>
 
+#include <nonstd/optional.hpp>
+
 #include "chainerx/array.h"
+#include "chainerx/axes.h"
+#include "chainerx/backend_util.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/constant.h"
+#include "chainerx/device.h"
 #include "chainerx/dtype.h"
+#include "chainerx/float16.h"
 #include "chainerx/macro.h"
-#include "chainerx/native/col2im.h"
-#include "chainerx/native/elementwise.h"
-#include "chainerx/native/im2col.h"
-#include "chainerx/native/tensor_dot.h"
+#include "chainerx/native/fusion.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/thread_pool.h"
+#include "chainerx/numeric.h"
 #include "chainerx/numeric_limits.h"
 #include "chainerx/routines/connection.h"
 #include "chainerx/routines/creation.h"
-#include "chainerx/routines/indexing.h"
-#include "chainerx/routines/math.h"
 #include "chainerx/routines/pooling.h"
-#include "chainerx/scalar.h"
 #include "chainerx/shape.h"
 #include "chainerx/stack_vector.h"
 
@@ -28,27 +34,180 @@ namespace chainerx {
 namespace native {
 namespace {
 
-Scalar GetLowestOrInf(Dtype dtype) {
-    return VisitDtype(dtype, [](auto pt) {
-        using T = typename decltype(pt)::type;
-        return Scalar{NumericLimits<T>::LowestOrInf()};
-    });
-}
+// Minimum number of output elements to compute in a single thread.
+constexpr int64_t kMinPoolChunkSize = int64_t{1} << 12;
+
+// Pooling windows over C-contiguous images of shape (in_1, ..., in_n).
+// Elements of a window are identified by their row-major indices in the kernel, and elements of an image by their row-major indices in
+// the image.
+class PoolingWindows {
+public:
+    // The part of a window inside the image.
+    class Window {
+    public:
+        explicit Window(const PoolingWindows& windows) : windows_{windows} {
+            k_begin_.resize(windows.ndim_);
+            k_end_.resize(windows.ndim_);
+        }
+
+        // Calls func(x_index, kernel_index) for each element of the window inside the image, in the row-major order of the kernel.
+        template <typename Func>
+        void ForEach(Func&& func) const {
+            const PoolingWindows& w = windows_;
+            int8_t last = w.ndim_ - 1;
+            for (int8_t i = 0; i < w.ndim_; ++i) {
+                if (k_begin_[i] >= k_end_[i]) {
+                    return;
+                }
+            }
+            StackVector<int64_t, kMaxNdim> k{k_begin_};
+            while (true) {
+                int64_t x_base = origin_;
+                int64_t kernel_base = 0;
+                for (int8_t i = 0; i < last; ++i) {
+                    x_base += k[i] * w.in_strides_[i];
+                    kernel_base += k[i] * w.kernel_strides_[i];
+                }
+                for (int64_t k_last = k_begin_[last]; k_last < k_end_[last]; ++k_last) {
+                    func(x_base + k_last, kernel_base + k_last);
+                }
+
+                int8_t i = last - 1;
+                for (; i >= 0; --i) {
+                    if (++k[i] < k_end_[i]) {
+                        break;
+                    }
+                    k[i] = k_begin_[i];
+                }
+                if (i < 0) {
+                    break;
+                }
+            }
+        }
+
+        // Returns the number of elements of the window inside the image.
+        int64_t GetSize() const {
+            int64_t size = 1;
+            for (int8_t i = 0; i < windows_.ndim_; ++i) {
+                size *= std::max(int64_t{0}, k_end_[i] - k_begin_[i]);
+            }
+            return size;
+        }
+
+        // Returns the image index of the element at the kernel index.
+        int64_t GetImageIndex(int64_t kernel_index) const {
+            const PoolingWindows& w = windows_;
+            int64_t x_index = origin_;
+            for (int8_t i = 0; i < w.ndim_; ++i) {
+                x_index += kernel_index / w.kernel_strides_[i] * w.in_strides_[i];
+                kernel_index %= w.kernel_strides_[i];
+            }
+            return x_index;
+        }
+
+    private:
+        friend class PoolingWindows;
+
+        const PoolingWindows& windows_;
+        StackVector<int64_t, kMaxNdim> k_begin_;
+        StackVector<int64_t, kMaxNdim> k_end_;
+        int64_t origin_{};  // Image index of the kernel origin, which may be in the padding.
+    };
+
+    PoolingWindows(
+            const Shape& x_shape,
+            const StackVector<int64_t, kMaxNdim>& kernel_size,
+            const StackVector<int64_t, kMaxNdim>& stride,
+            const StackVector<int64_t, kMaxNdim>& pad,
+            bool cover_all)
+        : ndim_{static_cast<int8_t>(kernel_size.size())}, kernel_size_{kernel_size}, stride_{stride}, pad_{pad} {
+        CHAINERX_ASSERT(ndim_ + 2 == x_shape.ndim());
+        CHAINERX_ASSERT(ndim_ == static_cast<int8_t>(stride.size()));
+        CHAINERX_ASSERT(ndim_ == static_cast<int8_t>(pad.size()));
+
+        out_shape_ = Shape{x_shape[0], x_shape[1]};
+        for (int8_t i = 0; i < ndim_; ++i) {
+            in_dims_.emplace_back(x_shape[2 + i]);
+            out_dims_.emplace_back(internal::GetConvOutDim(in_dims_[i], kernel_size[i], stride[i], pad[i], cover_all));
+            CHAINERX_ASSERT(out_dims_.back() > 0);
+            out_shape_.emplace_back(out_dims_.back());
+        }
+        in_strides_.resize(ndim_);
+        kernel_strides_.resize(ndim_);
+        for (int8_t i = ndim_ - 1; i >= 0; --i) {
+            in_strides_[i] = in_size_;
+            kernel_strides_[i] = kernel_total_;
+            in_size_ *= in_dims_[i];
+            kernel_total_ *= kernel_size[i];
+            out_size_ *= out_dims_[i];
+        }
+    }
 
-// Returns axes that does the following transpose.
-// (batch_size, channel, a_1, a_2, ...., a_n, b_1, b_2, ..., b_n) -> (batch_size, channel, b_1, b_2, ...., b_n, a_1, a_2, ..., a_n).
-Axes GetSwapSpatialDimensionsAxes(size_t n) {
-    Axes axes;
-    axes.resize(2 + 2 * n);  // E.g. (batch_size, channel, out_1, out_2, ..., out_n, k_1, k_2, ..., k_n).
-    axes[0] = 0;  // Batch dimension kept as is.
-    axes[1] = 1;  // Channel dimension kept as is.
-    for (size_t i = 2; i < n + 2; ++i) {  // Output and kernel spatial dimensions to be swapped.
-        axes[i] = n + i;
-        axes[n + i] = i;
+    // Calls func(out_index, window) for each output position of an image, in the row-major order.
+    template <typename Func>
+    void ForEachWindow(Func&& func) const {
+        Window window{*this};
+        StackVector<int64_t, kMaxNdim> o;
+        o.resize(ndim_);
+        for (int64_t out_index = 0; out_index < out_size_; ++out_index) {
+            window.origin_ = 0;
+            for (int8_t i = 0; i < ndim_; ++i) {
+                int64_t start = o[i] * stride_[i] - pad_[i];
+                window.k_begin_[i] = std::max(int64_t{0}, -start);
+                window.k_end_[i] = std::min(kernel_size_[i], in_dims_[i] - start);
+                window.origin_ += start * in_strides_[i];
+            }
+            func(out_index, static_cast<const Window&>(window));
+
+            for (int8_t i = ndim_ - 1; i >= 0; --i) {
+                if (++o[i] < out_dims_[i]) {
+                    break;
+                }
+                o[i] = 0;
+            }
+        }
+    }
+
+    // Calls func(image, begin, end) for ranges of images of the batch and channel dimensions, in parallel.
+    template <typename Func>
+    void ParallelForEachImage(Device& device, Func&& func) const {
+        std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(device.backend()).GetThreadPool();
+        int64_t images = out_shape_[0] * out_shape_[1];
+        ParallelFor(*pool, images, std::max(int64_t{1}, kMinPoolChunkSize / std::max(out_size_, int64_t{1})), func);
+    }
+
+    // Returns true if each image is covered by a single window without padding.
+    bool IsGlobal() const {
+        for (int8_t i = 0; i < ndim_; ++i) {
+            if (kernel_size_[i] != in_dims_[i] || pad_[i] != 0) {
+                return false;
+            }
+        }
+        return true;
     }
-    return axes;
-}
 
+    const Shape& out_shape() const { return out_shape_; }
+    int64_t in_size() const { return in_size_; }
+    int64_t out_size() const { return out_size_; }
+    int64_t kernel_total() const { return kernel_total_; }
+
+private:
+    int8_t ndim_;
+    StackVector<int64_t, kMaxNdim> kernel_size_;
+    StackVector<int64_t, kMaxNdim> stride_;
+    StackVector<int64_t, kMaxNdim> pad_;
+    StackVector<int64_t, kMaxNdim> in_dims_;
+    StackVector<int64_t, kMaxNdim> out_dims_;
+    StackVector<int64_t, kMaxNdim> in_strides_;  // In elements.
+    StackVector<int64_t, kMaxNdim> kernel_strides_;  // In elements.
+    Shape out_shape_;
+    int64_t in_size_{1};  // Number of elements of an image.
+    int64_t out_size_{1};  // Number of output elements of an image.
+    int64_t kernel_total_{1};
+};
+
+// Max pooling computed window by window. The forward pass records the kernel index of the maximum of each window as int32, so that the
+// backward passes only need arrays of the output size.
 class NativeMaxPoolForwardBackward : public chainerx::MaxPoolForwardBackward {
 public:
     explicit NativeMaxPoolForwardBackward(
@@ -59,63 +218,127 @@ public:
         : kernel_size_{std::move(kernel_size)}, stride_{std::move(stride)}, pad_{std::move(pad)}, cover_all_{cover_all} {}
 
     Array Forward(const Array& x) override {
+        internal::UncapturableDeviceCall uncapturable_call{};
+        native_internal::FusionBarrier fusion_barrier{};
         CHAINERX_ASSERT(internal::GetArrayBody(x)->nodes().empty());
 
-        // Convert to column representation of shape (batch_size, channel, k_1, k_2, ..., k_n, out_1, out_2, ..., out_n).
-        col_ = native_internal::Im2Col(x, kernel_size_, stride_, pad_, cover_all_, GetLowestOrInf(x.dtype()));
-        axes_.resize(kernel_size_.size());
-        std::iota(axes_.begin(), axes_.end(), 2);
-        x_ = x;
-        return col_.Max(axes_);
+        windows_.emplace(x.shape(), kernel_size_, stride_, pad_, cover_all_);
+        const PoolingWindows& windows = *windows_;
+        CHAINERX_ASSERT(windows.kernel_total() <= std::numeric_limits<int32_t>::max());
+        Device& device = x.device();
+        Array x_contiguous = internal::AsContiguous(x);
+        Array out = Empty(windows.out_shape(), x.dtype(), device);
+        indices_ = Empty(windows.out_shape(), Dtype::kInt32, device);
+        x_shape_ = x.shape();
+
+        VisitDtype(x.dtype(), [&](auto pt) {
+            using T = typename decltype(pt)::type;
+            const T* x_ptr = static_cast<const T*>(internal::GetRawOffsetData(x_contiguous));
+            T* out_ptr = static_cast<T*>(internal::GetRawOffsetData(out));
+            auto* indices_ptr = static_cast<int32_t*>(internal::GetRawOffsetData(indices_));
+
+            windows.ParallelForEachImage(device, [&](int64_t begin, int64_t end) {
+                for (int64_t image = begin; image < end; ++image) {
+                    const T* x_image = x_ptr + image * windows.in_size();
+                    T* out_image = out_ptr + image * windows.out_size();
+                    int32_t* indices_image = indices_ptr + image * windows.out_size();
+                    windows.ForEachWindow([&](int64_t out_index, const PoolingWindows::Window& window) {
+                        // NaN propagates as in AMax. Windows entirely in the padding result in the lowest value and no index.
+                        T max = NumericLimits<T>::LowestOrInf();
+                        int32_t argmax = -1;
+                        window.ForEach([&](int64_t x_index, int64_t kernel_index) {
+                            T value = x_image[x_index];
+                            if (argmax < 0 || max < value || (IsNan(value) && !IsNan(max))) {
+                                max = value;
+                                argmax = static_cast<int32_t>(kernel_index);
+                            }
+                        });
+                        out_image[out_index] = max;
+                        indices_image[out_index] = argmax;
+                    });
+                }
+            });
+        });
+        return out;
     }
 
     Array Backward(const Array& gout) override {
+        internal::UncapturableDeviceCall uncapturable_call{};
+        native_internal::FusionBarrier fusion_barrier{};
         CHAINERX_ASSERT(internal::GetArrayBody(gout)->nodes().empty());
-
-        indices_ = col_.ArgMax(axes_);
         CHAINERX_ASSERT(indices_.shape() == gout.shape());
 
-        // Compute flattened col gradients.
-        int64_t kernel_total_size = std::accumulate(kernel_size_.begin(), kernel_size_.end(), int64_t{1}, std::multiplies<>());
-        int64_t out_total_size = indices_.GetTotalSize();
-        Shape out_flat{out_total_size};
-        Device& device = x_.device();
-        Array gcol = Zeros({out_total_size * kernel_total_size}, x_.dtype(), device);
-        offset_ = Arange(0, out_total_size * kernel_total_size, kernel_total_size, indices_.dtype(), device);
-        device.AddAt(gcol, indices_.Reshape(out_flat) + offset_, 0, gout.Reshape(out_flat), gcol);
-
-        // Reshape col gradients to (batch_size, channel, out_1, out_2, ..., out_n, k_1, k_2, ..., k_n).
-        Shape out_shape_with_kernel = gout.shape();
-        std::copy(kernel_size_.begin(), kernel_size_.end(), std::back_inserter(out_shape_with_kernel));
-
-        // Transform col gradients to input shape.
-        return native_internal::Col2Im(
-                gcol.Reshape(out_shape_with_kernel).Transpose(GetSwapSpatialDimensionsAxes(kernel_size_.size())),
-                stride_,
-                pad_,
-                {x_.shape().begin() + 2, x_.shape().end()});
+        // Scatter the output gradients to the maxima of the windows.
+        const PoolingWindows& windows = *windows_;
+        Device& device = gout.device();
+        Array gout_contiguous = internal::AsContiguous(gout);
+        Array gx = Zeros(x_shape_, gout.dtype(), device);
+
+        VisitDtype(gout.dtype(), [&](auto pt) {
+            using T = typename decltype(pt)::type;
+            const T* gout_ptr = static_cast<const T*>(internal::GetRawOffsetData(gout_contiguous));
+            const auto* indices_ptr = static_cast<const int32_t*>(internal::GetRawOffsetData(indices_));
+            T* gx_ptr = static_cast<T*>(internal::GetRawOffsetData(gx));
+
+            // Windows of different images do not overlap, so that images can be processed in parallel.
+            windows.ParallelForEachImage(device, [&](int64_t begin, int64_t end) {
+                for (int64_t image = begin; image < end; ++image) {
+                    const T* gout_image = gout_ptr + image * windows.out_size();
+                    const int32_t* indices_image = indices_ptr + image * windows.out_size();
+                    T* gx_image = gx_ptr + image * windows.in_size();
+                    windows.ForEachWindow([&](int64_t out_index, const PoolingWindows::Window& window) {
+                        int32_t argmax = indices_image[out_index];
+                        if (argmax >= 0) {
+                            gx_image[window.GetImageIndex(argmax)] += gout_image[out_index];
+                        }
+                    });
+                }
+            });
+        });
+        return gx;
     }
 
     Array DoubleBackward(const Array& ggx) override {
+        internal::UncapturableDeviceCall uncapturable_call{};
+        native_internal::FusionBarrier fusion_barrier{};
         CHAINERX_ASSERT(internal::GetArrayBody(ggx)->nodes().empty());
+        CHAINERX_ASSERT(ggx.shape() == x_shape_);
 
-        Array col = native_internal::Im2Col(ggx, kernel_size_, stride_, pad_, cover_all_, GetLowestOrInf(x_.dtype()));
-        return Take(
-                col.Transpose(GetSwapSpatialDimensionsAxes(kernel_size_.size())).Reshape({col.GetTotalSize()}),
-                indices_ + offset_.Reshape(indices_.shape()),
-                0);
+        // Gather the input gradients at the maxima of the windows.
+        const PoolingWindows& windows = *windows_;
+        Device& device = ggx.device();
+        Array ggx_contiguous = internal::AsContiguous(ggx);
+        Array ggout = Empty(windows.out_shape(), ggx.dtype(), device);
+
+        VisitDtype(ggx.dtype(), [&](auto pt) {
+            using T = typename decltype(pt)::type;
+            const T* ggx_ptr = static_cast<const T*>(internal::GetRawOffsetData(ggx_contiguous));
+            const auto* indices_ptr = static_cast<const int32_t*>(internal::GetRawOffsetData(indices_));
+            T* ggout_ptr = static_cast<T*>(internal::GetRawOffsetData(ggout));
+
+            windows.ParallelForEachImage(device, [&](int64_t begin, int64_t end) {
+                for (int64_t image = begin; image < end; ++image) {
+                    const T* ggx_image = ggx_ptr + image * windows.in_size();
+                    const int32_t* indices_image = indices_ptr + image * windows.out_size();
+                    T* ggout_image = ggout_ptr + image * windows.out_size();
+                    windows.ForEachWindow([&](int64_t out_index, const PoolingWindows::Window& window) {
+                        int32_t argmax = indices_image[out_index];
+                        ggout_image[out_index] = argmax >= 0 ? ggx_image[window.GetImageIndex(argmax)] : static_cast<T>(0);
+                    });
+                }
+            });
+        });
+        return ggout;
     }
 
 private:
     const StackVector<int64_t, kMaxNdim> kernel_size_;
     const StackVector<int64_t, kMaxNdim> stride_;
     const StackVector<int64_t, kMaxNdim> pad_;
-    Array x_;
     bool cover_all_;
-    Array col_{};
-    Axes axes_{};
+    nonstd::optional<PoolingWindows> windows_{};
+    Shape x_shape_{};
     Array indices_{};
-    Array offset_{};
 };
 
 }  // namespace
@@ -130,73 +353,8 @@ std::unique_ptr<MaxPoolForwardBackward> NativeDevice::GetMaxPoolForwardBackward(
 
 namespace {
 
-// TODO(hvy): Use Device::Mean when implemented.
-void Mean(const Array& a, const Axes& axis, const Array& out) {
-    Device& device = a.device();
-    device.Sum(a, axis, out);
-    device.DivideAS(out, internal::CountItemsAlongAxes(a.shape(), axis), out);
-}
-
-Array GetPadModeIgnorePoolingWidths(
-        const Shape& shape,
-        const StackVector<int64_t, kMaxNdim>& kernel_size,
-        const StackVector<int64_t, kMaxNdim>& stride,
-        const StackVector<int64_t, kMaxNdim>& pad,
-        Dtype dtype) {
-    int8_t n = shape.ndim() - 2;
-    CHAINERX_ASSERT(n == static_cast<int8_t>(kernel_size.size()));
-    CHAINERX_ASSERT(n == static_cast<int8_t>(stride.size()));
-    CHAINERX_ASSERT(n == static_cast<int8_t>(pad.size()));
-    CHAINERX_ASSERT(GetKind(dtype) == DtypeKind::kFloat);
-
-    Array widths;
-    for (int64_t i = 0; i < n; ++i) {
-        int64_t dim_i = shape[2 + i];
-        int64_t kernel_size_i = kernel_size[i];
-        int64_t stride_i = stride[i];
-        int64_t pad_i = pad[i];
-
-        Array width = Empty({internal::GetConvOutDim(dim_i, kernel_size_i, stride_i, pad_i, false)}, dtype);
-        VisitFloatingPointDtype(dtype, [dim_i, kernel_size_i, stride_i, pad_i, &width](auto pt) {
-            using T = typename decltype(pt)::type;
-            struct Impl {
-                void operator()(int64_t i, T& w) {
-                    T start = static_cast<T>(i) * s - p;
-                    T end = start + k;
-                    if (start < T{0}) {
-                        start = T{0};
-                    }
-                    if (end > d) {
-                        end = d;
-                    }
-                    w = end - start;
-                }
-
-                T d;
-                T k;
-                T s;
-                T p;
-            };
-            Elementwise<T>(
-                    Impl{static_cast<T>(dim_i), static_cast<T>(kernel_size_i), static_cast<T>(stride_i), static_cast<T>(pad_i)}, width);
-        });
-
-        if (i == 0) {
-            widths = std::move(width);
-        } else {
-            Shape widths_expanded = widths.shape();
-            widths_expanded.emplace_back(1);
-
-            Shape width_expanded{1};
-            std::copy(width.shape().begin(), width.shape().end(), std::back_inserter(width_expanded));
-
-            widths = TensorDot(
-                    widths.Reshape(widths_expanded), width.Reshape(width_expanded), {static_cast<int8_t>(widths.ndim())}, {0}, dtype);
-        }
-    }
-    return widths;
-}
-
+// Average pooling computed window by window. The divisor of each window is the kernel size, or the number of its elements inside the
+// image if the padding is ignored, and is computed inline in both passes.
 class NativeAveragePoolForwardBackward : public chainerx::AveragePoolForwardBackward {
 public:
     explicit NativeAveragePoolForwardBackward(
@@ -207,69 +365,104 @@ public:
         : kernel_size_{std::move(kernel_size)}, stride_{std::move(stride)}, pad_{std::move(pad)}, pad_mode_{pad_mode} {}
 
     Array Forward(const Array& x) override {
+        internal::UncapturableDeviceCall uncapturable_call{};
+        native_internal::FusionBarrier fusion_barrier{};
         CHAINERX_ASSERT(internal::GetArrayBody(x)->nodes().empty());
 
-        Array col = native_internal::Im2Col(x, kernel_size_, stride_, pad_, false, 0);
-
-        // Average along the kernel dimensions of col with shape (batch_size, channel, k_1, k_2, ..., k_n, out_1, out_2, ..., out_n).
-        Axes kernel_axes;
-        kernel_axes.resize(kernel_size_.size());
-        std::iota(kernel_axes.begin(), kernel_axes.end(), 2);  // From k_1, up to k_n.
-
-        Array out = internal::EmptyReduced(col.shape(), col.dtype(), kernel_axes, false, col.device());
-
-        switch (pad_mode_) {
-            case AveragePoolPadMode::kZero:
-                Mean(col, kernel_axes, out);
-                break;
-            case AveragePoolPadMode::kIgnore: {
-                Device& device = x.device();
-                device.Sum(col, kernel_axes, out);
-                width_ignore_ = GetPadModeIgnorePoolingWidths(x.shape(), kernel_size_, stride_, pad_, x.dtype()).BroadcastTo(out.shape());
-                device.Divide(out, width_ignore_, out);
-                break;
-            }
-            default:
-                CHAINERX_NEVER_REACH();
+        windows_.emplace(x.shape(), kernel_size_, stride_, pad_, false);
+        const PoolingWindows& windows = *windows_;
+        Device& device = x.device();
+        Array out = Empty(windows.out_shape(), x.dtype(), device);
+        x_shape_ = x.shape();
+
+        // Global average pooling is the mean over the spatial axes, which is a contiguous reduction for each image.
+        if (windows.IsGlobal()) {
+            Axes spatial_axes;
+            spatial_axes.resize(kernel_size_.size());
+            std::iota(spatial_axes.begin(), spatial_axes.end(), 2);
+            device.Mean(x, spatial_axes, out);
+            return out;
         }
-        x_ = x;
-        gcol_shape_ = col.shape();
+
+        Array x_contiguous = internal::AsContiguous(x);
+        VisitFloatingPointDtype(x.dtype(), [&](auto pt) {
+            using T = typename decltype(pt)::type;
+            using Accum = std::conditional_t<std::is_same<T, Float16>{}, float, T>;
+            const T* x_ptr = static_cast<const T*>(internal::GetRawOffsetData(x_contiguous));
+            T* out_ptr = static_cast<T*>(internal::GetRawOffsetData(out));
+
+            windows.ParallelForEachImage(device, [&](int64_t begin, int64_t end) {
+                for (int64_t image = begin; image < end; ++image) {
+                    const T* x_image = x_ptr + image * windows.in_size();
+                    T* out_image = out_ptr + image * windows.out_size();
+                    windows.ForEachWindow([&](int64_t out_index, const PoolingWindows::Window& window) {
+                        Accum sum{0};
+                        window.ForEach([&](int64_t x_index, int64_t /*kernel_index*/) { sum += static_cast<Accum>(x_image[x_index]); });
+                        out_image[out_index] = static_cast<T>(sum / GetDivisor(window));
+                    });
+                }
+            });
+        });
         return out;
     }
 
     Array Backward(const Array& gout) override {
+        internal::UncapturableDeviceCall uncapturable_call{};
+        native_internal::FusionBarrier fusion_barrier{};
         CHAINERX_ASSERT(internal::GetArrayBody(gout)->nodes().empty());
 
-        Shape reshape_to = gcol_shape_;
-        std::fill(reshape_to.begin() + 2, reshape_to.begin() + x_.ndim(), int64_t{1});
-        Array gx{};
+        const PoolingWindows& windows = *windows_;
+        Device& device = gout.device();
+        Array gout_contiguous = internal::AsContiguous(gout);
+        bool is_global = windows.IsGlobal();
+        Array gx = is_global ? Empty(x_shape_, gout.dtype(), device) : Zeros(x_shape_, gout.dtype(), device);
+
+        VisitFloatingPointDtype(gout.dtype(), [&](auto pt) {
+            using T = typename decltype(pt)::type;
+            using Accum = std::conditional_t<std::is_same<T, Float16>{}, float, T>;
+            const T* gout_ptr = static_cast<const T*>(internal::GetRawOffsetData(gout_contiguous));
+            T* gx_ptr = static_cast<T*>(internal::GetRawOffsetData(gx));
+
+            // Windows of different images do not overlap, so that images can be processed in parallel.
+            windows.ParallelForEachImage(device, [&](int64_t begin, int64_t end) {
+                for (int64_t image = begin; image < end; ++image) {
+                    const T* gout_image = gout_ptr + image * windows.out_size();
+                    T* gx_image = gx_ptr + image * windows.in_size();
+                    if (is_global) {
+                        auto g = static_cast<T>(static_cast<Accum>(gout_image[0]) / windows.in_size());
+                        std::fill_n(gx_image, windows.in_size(), g);
+                        continue;
+                    }
+                    windows.ForEachWindow([&](int64_t out_index, const PoolingWindows::Window& window) {
+                        Accum g = static_cast<Accum>(gout_image[out_index]) / GetDivisor(window);
+                        window.ForEach([&](int64_t x_index, int64_t /*kernel_index*/) {
+                            gx_image[x_index] = static_cast<T>(static_cast<Accum>(gx_image[x_index]) + g);
+                        });
+                    });
+                }
+            });
+        });
+        return gx;
+    }
+
+private:
+    int64_t GetDivisor(const PoolingWindows::Window& window) const {
         switch (pad_mode_) {
-            case AveragePoolPadMode::kZero: {
-                Array gcol = gout.Reshape(reshape_to).BroadcastTo(gcol_shape_);
-                gx = native_internal::Col2Im(gcol, stride_, pad_, {x_.shape().begin() + 2, x_.shape().end()});
-                int64_t width_zero = std::accumulate(kernel_size_.begin(), kernel_size_.end(), int64_t{1}, std::multiplies<>());
-                gx /= width_zero;
-                break;
-            }
-            case AveragePoolPadMode::kIgnore: {
-                Array gcol = (gout / width_ignore_).Reshape(reshape_to).BroadcastTo(gcol_shape_);
-                gx = native_internal::Col2Im(gcol, stride_, pad_, {x_.shape().begin() + 2, x_.shape().end()});
-                break;
-            }
+            case AveragePoolPadMode::kZero:
+                return windows_->kernel_total();
+            case AveragePoolPadMode::kIgnore:
+                return window.GetSize();
             default:
                 CHAINERX_NEVER_REACH();
         }
-        return gx;
     }
 
-private:
     const StackVector<int64_t, kMaxNdim> kernel_size_;
     const StackVector<int64_t, kMaxNdim> stride_;
     const StackVector<int64_t, kMaxNdim> pad_;
     const AveragePoolPadMode pad_mode_;
-    Array x_;
-    Shape gcol_shape_;
-    Array width_ignore_;
+    nonstd::optional<PoolingWindows> windows_{};
+    Shape x_shape_{};
 };
 
 }  // namespace
@@ -1,11 +1,17 @@
 #include "chainerx/native/native_device.h"
 
 #include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
 
 #include "chainerx/array.h"
+#include "chainerx/captured_step.h"
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
+#include "chainerx/float16.h"
 #include "chainerx/macro.h"
+#include "chainerx/native/fusion.h"
 #include "chainerx/native/reduce.h"
 #include "chainerx/numeric.h"
 #include "chainerx/numeric_limits.h"
@@ -15,6 +21,8 @@ namespace chainerx {
 namespace native {
 
 void NativeDevice::ArgMax(const Array& a, const Axes& axis, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::ArgMax, a, axis, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CHAINERX_ASSERT(std::all_of(axis.begin(), axis.end(), [&a](int8_t i) { return a.shape()[i] > 0; }));
     CHAINERX_ASSERT(internal::IsValidReductionShape(a.shape(), axis, out.shape(), false));
     CheckDevicesCompatible(a, out);
@@ -41,8 +49,12 @@ void NativeDevice::ArgMax(const Array& a, const Axes& axis, const Array& out) {
 }
 
 void NativeDevice::Sum(const Array& a, const Axes& axis, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Sum, a, axis, out};
     CHAINERX_ASSERT(internal::IsValidReductionShape(a.shape(), axis, out.shape(), true));
     CheckDevicesCompatible(a, out);
+    if (native_internal::RecordSum(a, axis, out)) {
+        return;
+    }
 
     auto do_sum = [&a, &axis, &out](auto in_pt, auto out_pt) {
         using In = typename decltype(in_pt)::type;
@@ -61,6 +73,8 @@ void NativeDevice::Sum(const Array& a, const Axes& axis, const Array& out) {
 }
 
 void NativeDevice::AMax(const Array& a, const Axes& axis, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::AMax, a, axis, out};
+    native_internal::FusionBarrier fusion_barrier{};
     CHAINERX_ASSERT(internal::IsValidReductionShape(a.shape(), axis, out.shape(), true));
     CheckDevicesCompatible(a, out);
 
@@ -80,5 +94,105 @@ void NativeDevice::AMax(const Array& a, const Axes& axis, const Array& out) {
     });
 }
 
+void NativeDevice::Mean(const Array& a, const Axes& axis, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Mean, a, axis, out};
+    native_internal::FusionBarrier fusion_barrier{};
+    CHAINERX_ASSERT(internal::IsValidReductionShape(a.shape(), axis, out.shape(), true));
+    CheckDevicesCompatible(a, out);
+
+    if (GetKind(out.dtype()) != DtypeKind::kFloat) {
+        Device::Mean(a, axis, out);
+        return;
+    }
+
+    // The sum is divided by the count as it is written, without another pass over the output.
+    int64_t count = internal::CountItemsAlongAxes(a.shape(), axis);
+    auto do_mean = [&a, &axis, &out, count](auto in_pt, auto out_pt) {
+        using In = typename decltype(in_pt)::type;
+        using Out = typename decltype(out_pt)::type;
+        using Accum = std::conditional_t<std::is_same<Out, Float16>{}, float, Out>;
+        struct Impl {
+            Accum Identity() { return Accum{0}; }
+            Accum MapIn(In in, int64_t /*index*/) { return static_cast<Accum>(in); }
+            void Reduce(Accum next, Accum& accum) { accum += next; }
+            Out MapOut(Accum accum) { return static_cast<Out>(accum / n); }
+
+            Accum n;
+        };
+        Reduce<In, Out>(a, axis, out, Impl{static_cast<Accum>(count)});
+    };
+
+    VisitFloatingPointDtype(out.dtype(), [a_dtype = a.dtype(), &do_mean](auto out_pt) { VisitDtype(a_dtype, do_mean, out_pt); });
+}
+
+namespace {
+
+// Accumulates the mean and the variance of the inputs with Welford's algorithm.
+template <typename In, typename Accum>
+struct MeanVarImpl {
+    MeanVarAccum<Accum> Identity() { return MeanVarAccum<Accum>{}; }
+    MeanVarAccum<Accum> MapIn(In in, int64_t /*index*/) { return MeanVarAccum<Accum>{1, static_cast<Accum>(in), Accum{0}}; }
+    void Reduce(const MeanVarAccum<Accum>& next, MeanVarAccum<Accum>& accum) { accum.Merge(next); }
+
+    // The mean of no elements is NaN, as the sum divided by the count.
+    static Accum GetMean(const MeanVarAccum<Accum>& accum) {
+        return accum.count == 0 ? std::numeric_limits<Accum>::quiet_NaN() : accum.mean;
+    }
+};
+
+}  // namespace
+
+void NativeDevice::Var(const Array& a, const Axes& axis, const Array& out) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::Var, a, axis, out};
+    native_internal::FusionBarrier fusion_barrier{};
+    CHAINERX_ASSERT(internal::IsValidReductionShape(a.shape(), axis, out.shape(), true));
+    CheckDevicesCompatible(a, out);
+
+    if (GetKind(out.dtype()) != DtypeKind::kFloat) {
+        Device::Var(a, axis, out);
+        return;
+    }
+
+    auto do_var = [&a, &axis, &out](auto in_pt, auto out_pt) {
+        using In = typename decltype(in_pt)::type;
+        using Out = typename decltype(out_pt)::type;
+        using Accum = std::conditional_t<std::is_same<Out, Float16>{}, float, Out>;
+        struct Impl : MeanVarImpl<In, Accum> {
+            Out MapOut(const MeanVarAccum<Accum>& accum) { return static_cast<Out>(accum.GetVar()); }
+        };
+        Reduce<In, Out>(a, axis, out, Impl{});
+    };
+
+    VisitFloatingPointDtype(out.dtype(), [a_dtype = a.dtype(), &do_var](auto out_pt) { VisitDtype(a_dtype, do_var, out_pt); });
+}
+
+void NativeDevice::MeanVar(const Array& a, const Axes& axis, const Array& mean, const Array& var) {
+    internal::CapturedDeviceCall captured_call{*this, &NativeDevice::MeanVar, a, axis, mean, var};
+    native_internal::FusionBarrier fusion_barrier{};
+    CHAINERX_ASSERT(internal::IsValidReductionShape(a.shape(), axis, mean.shape(), true));
+    CHAINERX_ASSERT(mean.shape() == var.shape());
+    CheckDevicesCompatible(a, mean, var);
+
+    // Both outputs are written by a single reduction if they have the same layout.
+    if (GetKind(mean.dtype()) != DtypeKind::kFloat || mean.dtype() != var.dtype() || mean.strides() != var.strides()) {
+        Device::MeanVar(a, axis, mean, var);
+        return;
+    }
+
+    auto do_mean_var = [&a, &axis, &mean, &var](auto in_pt, auto out_pt) {
+        using In = typename decltype(in_pt)::type;
+        using Out = typename decltype(out_pt)::type;
+        using Accum = std::conditional_t<std::is_same<Out, Float16>{}, float, Out>;
+        struct Impl : MeanVarImpl<In, Accum> {
+            std::pair<Out, Out> MapOut(const MeanVarAccum<Accum>& accum) {
+                return {static_cast<Out>(this->GetMean(accum)), static_cast<Out>(accum.GetVar())};
+            }
+        };
+        Reduce<In, Out>(a, axis, mean, var, Impl{});
+    };
+
+    VisitFloatingPointDtype(mean.dtype(), [a_dtype = a.dtype(), &do_mean_var](auto out_pt) { VisitDtype(a_dtype, do_mean_var, out_pt); });
+}
+
 }  // namespace native
 }  // namespace chainerx
@@ -1,6 +1,8 @@
 #include "chainerx/native/native_device.h"
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <thread>
@@ -8,8 +10,21 @@
 
 #include <gtest/gtest.h>
 
+#include "chainerx/array.h"
+#include "chainerx/array_index.h"
+#include "chainerx/axes.h"
 #include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/device_id.h"
+#include "chainerx/dtype.h"
+#include "chainerx/memory_stats.h"
 #include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/shape.h"
+#include "chainerx/slice.h"
+#include "chainerx/testing/array_check.h"
+#include "chainerx/testing/device_session.h"
 #include "chainerx/testing/threading.h"
 
 namespace chainerx {
@@ -47,6 +62,25 @@ TEST(NativeDeviceTest, AllocateZero) {
     EXPECT_EQ(ptr, nullptr);
 }
 
+TEST(NativeDeviceTest, GetMemoryStats) {
+    Context ctx;
+    NativeDevice& device = GetNativeDevice(ctx, 0);
+
+    {
+        std::shared_ptr<void> ptr = device.Allocate(100);
+        MemoryStats stats = device.GetMemoryStats();
+        EXPECT_EQ(size_t{128}, stats.bytes_in_use);
+        EXPECT_EQ(1, stats.malloc_count);
+    }
+    MemoryStats stats = device.GetMemoryStats();
+    EXPECT_EQ(size_t{0}, stats.bytes_in_use);
+    EXPECT_EQ(size_t{128}, stats.peak_bytes_in_use);
+    EXPECT_EQ(size_t{128}, stats.bytes_cached);
+
+    device.ResetPeakMemoryStats();
+    EXPECT_EQ(size_t{0}, device.GetMemoryStats().peak_bytes_in_use);
+}
+
 TEST(NativeDeviceTest, AllocateFreeThreadSafe) {
     static constexpr size_t kNumThreads = 2;
     static constexpr size_t kNumLoopsPerThread = 1;
@@ -104,6 +138,158 @@ TEST(NativeDeviceTest, Synchronize) {
     device.Synchronize();  // no throw
 }
 
+TEST(NativeDeviceTest, ElementwiseParallel) {
+    Context ctx;
+    ctx.GetNativeBackend().SetNumThreads(4);
+    NativeDevice& device = GetNativeDevice(ctx, 0);
+
+    // Large enough to be split into chunks. The second operand is non-contiguous.
+    int64_t m = 300;
+    int64_t n = 500;
+    Array a = Arange(0, m * n, Dtype::kInt64, device).Reshape({m, n});
+    Array b = Arange(0, m * n, Dtype::kInt64, device).Reshape({n, m}).Transpose();
+    Array out = Empty({m, n}, Dtype::kInt64, device);
+    device.Add(a, b, out);
+
+    auto out_data = static_cast<const int64_t*>(out.data().get());
+    for (int64_t i = 0; i < m; ++i) {
+        for (int64_t j = 0; j < n; ++j) {
+            ASSERT_EQ(i * n + j + j * m + i, out_data[i * n + j]);
+        }
+    }
+}
+
+TEST(NativeDeviceTest, ElementwiseContiguous) {
+    Context ctx;
+    ctx.GetNativeBackend().SetNumThreads(4);
+    NativeDevice& device = GetNativeDevice(ctx, 0);
+
+    // Contiguous views with offsets, updated in-place.
+    int64_t n = 200000;
+    Array a = Arange(0, n + 1, Dtype::kInt64, device).At({Slice{1, n + 1}});
+    Array b = Arange(0, n + 3, Dtype::kInt64, device).At({Slice{3, n + 3}});
+    device.Add(a, b, a);
+
+    auto a_data = static_cast<const int64_t*>(a.data().get()) + 1;
+    for (int64_t i = 0; i < n; ++i) {
+        ASSERT_EQ(2 * i + 4, a_data[i]);
+    }
+}
+
+TEST(NativeDeviceTest, TakeParallel) {
+    Context ctx;
+    ctx.GetNativeBackend().SetNumThreads(4);
+    NativeDevice& device = GetNativeDevice(ctx, 0);
+
+    // Rows of the middle axis, selected by wrapped and negative indices.
+    int64_t left = 3;
+    int64_t axis_dim = 50;
+    int64_t right = 700;
+    int64_t num_indices = 40;
+    Array a = Arange(0, left * axis_dim * right, Dtype::kInt64, device).Reshape({left, axis_dim, right});
+    Array indices = Empty({num_indices}, Dtype::kInt32, device);
+    auto indices_data = static_cast<int32_t*>(indices.data().get());
+    for (int64_t i = 0; i < num_indices; ++i) {
+        indices_data[i] = static_cast<int32_t>(i * 37 % 120 - 60);
+    }
+    Array out = Empty({left, num_indices, right}, Dtype::kInt64, device);
+    device.Take(a, indices, 1, out);
+
+    auto out_data = static_cast<const int64_t*>(out.data().get());
+    for (int64_t l = 0; l < left; ++l) {
+        for (int64_t i = 0; i < num_indices; ++i) {
+            int64_t index = (indices_data[i] % axis_dim + axis_dim) % axis_dim;
+            for (int64_t r = 0; r < right; ++r) {
+                ASSERT_EQ((l * axis_dim + index) * right + r, out_data[(l * num_indices + i) * right + r]);
+            }
+        }
+    }
+}
+
+TEST(NativeDeviceTest, AddAtParallel) {
+    Context ctx;
+    ctx.GetNativeBackend().SetNumThreads(4);
+    NativeDevice& device = GetNativeDevice(ctx, 0);
+
+    // Many duplicated indices into many rows, and into only two rows, which are split into chunks of columns.
+    for (int64_t num_rows : {1000, 2}) {
+        int64_t right = 4096;
+        int64_t num_indices = 64;
+        Array a = Ones({num_rows, right}, Dtype::kInt64, device);
+        Array indices = Empty({num_indices}, Dtype::kInt64, device);
+        auto indices_data = static_cast<int64_t*>(indices.data().get());
+        for (int64_t i = 0; i < num_indices; ++i) {
+            indices_data[i] = i * 7 % num_rows - (i % 2 == 0 ? 0 : num_rows);
+        }
+        Array b = Arange(0, num_indices * right, Dtype::kInt64, device).Reshape({num_indices, right});
+        Array out = Empty({num_rows, right}, Dtype::kInt64, device);
+        device.AddAt(a, indices, 0, b, out);
+
+        std::vector<int64_t> expected(num_rows * right, 1);
+        for (int64_t i = 0; i < num_indices; ++i) {
+            int64_t index = (indices_data[i] % num_rows + num_rows) % num_rows;
+            for (int64_t r = 0; r < right; ++r) {
+                expected[index * right + r] += i * right + r;
+            }
+        }
+        auto out_data = static_cast<const int64_t*>(out.data().get());
+        for (int64_t i = 0; i < num_rows * right; ++i) {
+            ASSERT_EQ(expected[i], out_data[i]);
+        }
+    }
+}
+
+// Returns (i % period) for each flat index i.
+Array Periodic(const Shape& shape, int64_t period, Device& device) {
+    Array a = Arange(0, shape.GetTotalSize(), Dtype::kInt64, device);
+    return (a - FloorDivide(a, period) * period).Reshape(shape).AsType(Dtype::kFloat64);
+}
+
+// Compares the native batch normalization against the generic one, with inputs split into parts of the batch and chunks of the channels.
+void CheckBatchNormParallel(const Shape& x_shape, const Shape& reduced_shape, const Axes& axis, Dtype dtype, double rtol, double atol) {
+    testing::DeviceSession device_session{DeviceId{"native", 0}};
+    auto& device = static_cast<NativeDevice&>(device_session.device());
+    static_cast<NativeBackend&>(device.backend()).SetNumThreads(4);
+
+    // A large offset, so that the variance is computed from values far from zero.
+    Array x = (Periodic(x_shape, 17, device) * 0.25 + 100).AsType(dtype);
+    Array gamma = (Arange(0, reduced_shape.GetTotalSize(), Dtype::kFloat64, device) * 0.1 + 0.5).Reshape(reduced_shape).AsType(dtype);
+    Array beta = (Arange(0, reduced_shape.GetTotalSize(), Dtype::kFloat64, device) * -0.2).Reshape(reduced_shape).AsType(dtype);
+    Array gout = (Periodic(x_shape, 13, device) * 0.1 - 0.6).AsType(dtype);
+
+    Array expected_running_mean = Zeros(reduced_shape, dtype, device);
+    Array expected_running_var = Ones(reduced_shape, dtype, device);
+    GenericBatchNormForwardBackward expected_fb{expected_running_mean, expected_running_var, 2e-5, 0.9, axis};
+    Array expected_out = expected_fb.Forward(x, gamma, beta);
+    std::array<Array, 3> expected_grads = expected_fb.Backward(gout);
+
+    Array running_mean = Zeros(reduced_shape, dtype, device);
+    Array running_var = Ones(reduced_shape, dtype, device);
+    std::unique_ptr<BatchNormForwardBackward> fb = device.GetBatchNormForwardBackward(running_mean, running_var, 2e-5, 0.9, axis);
+    EXPECT_ARRAY_ALL_CLOSE4(expected_out, fb->Forward(x, gamma, beta), rtol, atol);
+    EXPECT_ARRAY_ALL_CLOSE4(expected_running_mean, running_mean, rtol, atol);
+    EXPECT_ARRAY_ALL_CLOSE4(expected_running_var, running_var, rtol, atol);
+    std::array<Array, 3> grads = fb->Backward(gout);
+    for (size_t i = 0; i < grads.size(); ++i) {
+        EXPECT_ARRAY_ALL_CLOSE4(expected_grads[i], grads[i], rtol, atol);
+    }
+}
+
+TEST(NativeDeviceTest, BatchNormParallel) { CheckBatchNormParallel({64, 3, 32, 32}, {1, 3, 1, 1}, {0, 2, 3}, Dtype::kFloat64, 1e-9, 1e-9); }
+
+TEST(NativeDeviceTest, BatchNormParallelBatchAxis) {
+    CheckBatchNormParallel({256, 3, 20, 10}, {1, 3, 20, 10}, {0}, Dtype::kFloat64, 1e-9, 1e-9);
+}
+
+TEST(NativeDeviceTest, BatchNormParallelFloat32) {
+    CheckBatchNormParallel({64, 3, 32, 32}, {1, 3, 1, 1}, {0, 2, 3}, Dtype::kFloat32, 1e-3, 1e-3);
+}
+
+// Axes that are not leading and trailing ones are handled by the generic implementation.
+TEST(NativeDeviceTest, BatchNormParallelMiddleAxis) {
+    CheckBatchNormParallel({8, 3, 5, 4}, {8, 1, 5, 1}, {1, 3}, Dtype::kFloat64, 1e-9, 1e-9);
+}
+
 TEST(NativeDeviceTest, GetBackendMultiThread) {
     Context ctx;
     NativeDevice& device = GetNativeDevice(ctx, 0);
@@ -1,67 +1,340 @@
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
 
 #include "chainerx/array.h"
+#include "chainerx/backend_util.h"
 #include "chainerx/macro.h"
 #include "chainerx/native/data_type.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/thread_pool.h"
 #include "chainerx/reduction_kernel_arg.h"
 
 namespace chainerx {
 namespace native {
 namespace reduce_detail {
 
-template <typename In, typename Out, typename ReductionImpl, int8_t InNdim = kDynamicNdim, int8_t OutNdim = kDynamicNdim>
-void ReductionKernel(ReductionKernelArg<In, Out, InNdim, OutNdim> arg, ReductionImpl&& impl) {
-    auto it_in = arg.in_indexer.It(0, arg.out_indexer.total_size());
+// Minimum number of input elements processed by a single thread.
+constexpr int64_t kMinChunkSize = 32768;
 
-    // Iterate over output dimensions
-    for (auto it_out = arg.out_indexer.It(0); it_out; ++it_out) {
-        auto accum = impl.Identity();
+// Number of elements reduced sequentially at the leaves of pairwise reduction.
+constexpr int64_t kPairwiseBlockSize = 128;
 
-        int64_t i_reduce{0};
-        for (it_in.Restart(it_out.raw_index()); it_in; ++it_in, ++i_reduce) {
-            impl.Reduce(impl.MapIn(native_internal::StorageToDataType<const In>(arg.in[it_in]), i_reduce), accum);
-        }
+// Maximum number of outputs whose accumulators are kept at once.
+constexpr int64_t kOutBlockSize = 512;
+
+template <typename ReductionImpl>
+using AccumType = decltype(std::declval<ReductionImpl&>().Identity());
+
+// Allocates accumulators initialized with the identity.
+// std::vector is not used since std::vector<bool> does not expose contiguous storage.
+template <typename ReductionImpl>
+std::unique_ptr<AccumType<ReductionImpl>[]> MakeAccums(ReductionImpl& impl, int64_t size) {
+    auto accums = std::make_unique<AccumType<ReductionImpl>[]>(size);
+    std::fill_n(accums.get(), size, impl.Identity());
+    return accums;
+}
 
-        arg.out[it_out] = native_internal::DataToStorageType<Out>(impl.MapOut(accum));
+// Reduces the range [begin, end) of the reduction index, by calling `reduce_block(block_begin, block_end, accum)` on blocks of at
+// most kPairwiseBlockSize elements and combining the partial results pairwise.
+// Partial results are always combined in the order of the index so that, e.g., ArgMax still returns the first maximum.
+// Pairwise summation bounds the rounding error of floating point sums by O(log n) instead of O(n).
+template <typename ReductionImpl, typename ReduceBlock>
+void PairwiseReduce(ReductionImpl& impl, int64_t begin, int64_t end, const ReduceBlock& reduce_block, AccumType<ReductionImpl>& accum) {
+    if (end - begin <= kPairwiseBlockSize) {
+        reduce_block(begin, end, accum);
+        return;
     }
+    int64_t mid = begin + (end - begin) / 2;
+    PairwiseReduce(impl, begin, mid, reduce_block, accum);
+    AccumType<ReductionImpl> right = impl.Identity();
+    PairwiseReduce(impl, mid, end, reduce_block, right);
+    impl.Reduce(right, accum);
 }
 
-}  // namespace reduce_detail
+// Impl of a reduction into two outputs of the same shape and strides, whose MapOut returns a std::pair of the outputs.
+// The second output is written at the same byte offset from its data as the first one.
+template <typename ReductionImpl>
+struct TwoOutputImpl {
+    auto Identity() { return impl.Identity(); }
 
-// Computes the reduction of the input and stores into the output array.
-//
-// `ReductionImpl` is required to provide the following member function.
-// T can be arbitrary but should be common between these functions.
-//
-// - T Identity();
-//       Returns the initial value of reduction.
-// - T MapIn(In in, int64_t index);
-//       Applies pre-reduction mapping of the input and its index.
-// - void Reduce(T next, T& accum);
-//       Accumulates the iterated value to accum.
-// - Out MapOut(T accum);
-//       Applies post-reduction mapping of the output.
+    template <typename In>
+    auto MapIn(In in, int64_t index) {
+        return impl.MapIn(in, index);
+    }
+
+    template <typename Accum>
+    void Reduce(const Accum& next, Accum& accum) {
+        impl.Reduce(next, accum);
+    }
+
+    ReductionImpl impl;
+    const uint8_t* out_data;
+    uint8_t* out2_data;
+};
+
+// Writes the output of an accumulator.
+template <typename Out, typename ReductionImpl>
+struct OutWriter {
+    static void Write(native_internal::StorageType<Out>& out, ReductionImpl& impl, const AccumType<ReductionImpl>& accum) {
+        out = native_internal::DataToStorageType<Out>(impl.MapOut(accum));
+    }
+};
+
+template <typename Out, typename ReductionImpl>
+struct OutWriter<Out, TwoOutputImpl<ReductionImpl>> {
+    static void Write(
+            native_internal::StorageType<Out>& out,
+            TwoOutputImpl<ReductionImpl>& impl,
+            const AccumType<TwoOutputImpl<ReductionImpl>>& accum) {
+        auto outs = impl.impl.MapOut(accum);
+        out = native_internal::DataToStorageType<Out>(static_cast<Out>(outs.first));
+        auto offset = reinterpret_cast<const uint8_t*>(&out) - impl.out_data;  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        auto out2 = reinterpret_cast<native_internal::StorageType<Out>*>(impl.out2_data + offset);  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        *out2 = native_internal::DataToStorageType<Out>(static_cast<Out>(outs.second));
+    }
+};
+
+template <typename Out, typename ReductionImpl>
+void WriteOut(native_internal::StorageType<Out>& out, ReductionImpl& impl, const AccumType<ReductionImpl>& accum) {
+    OutWriter<Out, ReductionImpl>::Write(out, impl, accum);
+}
+
+// Computes the accumulators of the outputs [out_begin, out_end) over the range [reduce_begin, reduce_end) of the reduction index.
 //
-// Example:
-//     Simple summation over a float array can be implemented as the following reduction impl.
+// Each output is reduced independently, walking the input with the reduction stride.
+template <typename In, typename Out, typename ReductionImpl, int8_t InNdim, int8_t OutNdim>
+void ReduceEachOutput(
+        const ReductionKernelArg<In, Out, InNdim, OutNdim>& arg,
+        ReductionImpl& impl,
+        int64_t out_begin,
+        int64_t out_end,
+        int64_t reduce_begin,
+        int64_t reduce_end,
+        AccumType<ReductionImpl>* accums) {
+    int64_t out_total = arg.out_indexer.total_size();
+    for (int64_t i_out = out_begin; i_out < out_end; ++i_out) {
+        AccumType<ReductionImpl>& accum = accums[i_out - out_begin];
+        accum = impl.Identity();
+        if (reduce_begin == reduce_end) {
+            continue;
+        }
+        PairwiseReduce(
+                impl,
+                reduce_begin,
+                reduce_end,
+                [&arg, &impl, i_out, out_total](int64_t begin, int64_t end, AccumType<ReductionImpl>& block_accum) {
+                    auto it_in = arg.in_indexer.It(begin * out_total + i_out, out_total);
+                    for (int64_t i_reduce = begin; i_reduce < end; ++i_reduce, ++it_in) {
+                        impl.Reduce(impl.MapIn(native_internal::StorageToDataType<const In>(arg.in[it_in]), i_reduce), block_accum);
+                    }
+                },
+                accum);
+    }
+}
+
+// Computes the accumulators of the outputs [out_begin, out_end) over the range [reduce_begin, reduce_end) of the reduction index.
 //
-//         struct SumImpl {
-//             float Identity() { return 0; }
-//             float MapIn(float in) { return in; }
-//             void Reduce(float next, float& accum) { accum += next; }
-//             float MapOut(float accum) { return accum; }
-//         };
+// The input must be contiguous with the output index running fastest, which is the case when reducing over leading axes of a
+// C-contiguous array. Rows of the input are accumulated into consecutive accumulators, so that memory is read sequentially and the
+// inner loop can be vectorized by the compiler.
+template <typename In, typename ReductionImpl>
+void ReduceRows(
+        const native_internal::StorageType<const In>* in,
+        int64_t out_total,
+        ReductionImpl& impl,
+        int64_t out_begin,
+        int64_t out_end,
+        int64_t reduce_begin,
+        int64_t reduce_end,
+        AccumType<ReductionImpl>* accums) {
+    using Accum = AccumType<ReductionImpl>;
+
+    int64_t out_size = out_end - out_begin;
+    if (reduce_end - reduce_begin <= kPairwiseBlockSize) {
+        std::fill_n(accums, out_size, impl.Identity());
+        for (int64_t i_reduce = reduce_begin; i_reduce < reduce_end; ++i_reduce) {
+            const native_internal::StorageType<const In>* row = in + i_reduce * out_total + out_begin;
+            for (int64_t i = 0; i < out_size; ++i) {
+                impl.Reduce(impl.MapIn(native_internal::StorageToDataType<const In>(row[i]), i_reduce), accums[i]);
+            }
+        }
+        return;
+    }
+    int64_t mid = reduce_begin + (reduce_end - reduce_begin) / 2;
+    ReduceRows<In>(in, out_total, impl, out_begin, out_end, reduce_begin, mid, accums);
+    std::unique_ptr<Accum[]> right = MakeAccums(impl, out_size);
+    ReduceRows<In>(in, out_total, impl, out_begin, out_end, mid, reduce_end, right.get());
+    for (int64_t i = 0; i < out_size; ++i) {
+        impl.Reduce(right[i], accums[i]);
+    }
+}
+
+// Computes the accumulators of the outputs [out_begin, out_end) over the range [reduce_begin, reduce_end) of the reduction index.
 //
-//     Then, it can be passed to Reduce like: Reduce(input, axis, output, SumImpl{});
-template <typename In, typename Out, typename ReductionImpl>
-void Reduce(const Array& in, const Axes& axis, const Array& out, ReductionImpl&& impl) {
-    if (out.GetTotalSize() == 0) {
+// The input must be contiguous with the reduction index running fastest, which is the case when reducing over trailing axes of a
+// C-contiguous array, including the reduction to a scalar. Each output is reduced pairwise over a contiguous row of the input, reading
+// it through a flat pointer instead of an index iterator.
+template <typename In, typename ReductionImpl>
+void ReduceInner(
+        const native_internal::StorageType<const In>* in,
+        int64_t reduce_total,
+        ReductionImpl& impl,
+        int64_t out_begin,
+        int64_t out_end,
+        int64_t reduce_begin,
+        int64_t reduce_end,
+        AccumType<ReductionImpl>* accums) {
+    for (int64_t i_out = out_begin; i_out < out_end; ++i_out) {
+        AccumType<ReductionImpl>& accum = accums[i_out - out_begin];
+        accum = impl.Identity();
+        if (reduce_begin == reduce_end) {
+            continue;
+        }
+        const native_internal::StorageType<const In>* row = in + i_out * reduce_total;
+        PairwiseReduce(
+                impl,
+                reduce_begin,
+                reduce_end,
+                [row, &impl](int64_t begin, int64_t end, AccumType<ReductionImpl>& block_accum) {
+                    for (int64_t i_reduce = begin; i_reduce < end; ++i_reduce) {
+                        impl.Reduce(impl.MapIn(native_internal::StorageToDataType<const In>(row[i_reduce]), i_reduce), block_accum);
+                    }
+                },
+                accum);
+    }
+}
+
+// Memory layout of the input of a reduction, which selects the kernel used by ReduceRange.
+enum class ReduceLayout {
+    kGeneric,  // ReduceEachOutput
+    kRows,  // ReduceRows
+    kInner,  // ReduceInner
+};
+
+template <typename In, typename Out, int8_t InNdim, int8_t OutNdim>
+ReduceLayout GetReduceLayout(const ReductionKernelArg<In, Out, InNdim, OutNdim>& arg) {
+    // The input is transposed so that the reduction axes come first in the indexer, followed by the output axes.
+    int8_t ndim = arg.in_indexer.ndim();
+    const int64_t* strides = arg.in.strides();
+    int64_t out_total = arg.out_indexer.total_size();
+    auto item_size = static_cast<int64_t>(sizeof(In));
+    if (ndim == 1 && strides[0] == item_size) {
+        // Reduction and output axes are squashed into a single contiguous axis.
+        return out_total > 1 ? ReduceLayout::kRows : ReduceLayout::kInner;
+    }
+    // Input and output shapes are squashed independently, so the first axis may also contain output axes, e.g. if the input is
+    // transposed. The reduction index runs fastest in memory only if the first axis consists of exactly the reduction axes.
+    int64_t reduce_total = arg.in_indexer.total_size() / out_total;
+    if (ndim == 2 && arg.in_indexer.shape()[0] == reduce_total && strides[0] == item_size && strides[1] == reduce_total * item_size) {
+        return ReduceLayout::kInner;
+    }
+    return ReduceLayout::kGeneric;
+}
+
+template <typename In, typename Out, typename ReductionImpl, int8_t InNdim, int8_t OutNdim>
+void ReduceRange(
+        const ReductionKernelArg<In, Out, InNdim, OutNdim>& arg,
+        ReduceLayout layout,
+        ReductionImpl& impl,
+        int64_t out_begin,
+        int64_t out_end,
+        int64_t reduce_begin,
+        int64_t reduce_end,
+        AccumType<ReductionImpl>* accums) {
+    auto in = static_cast<const native_internal::StorageType<const In>*>(arg.in.data());
+    int64_t out_total = arg.out_indexer.total_size();
+    switch (layout) {
+        case ReduceLayout::kRows:
+            ReduceRows<In>(in, out_total, impl, out_begin, out_end, reduce_begin, reduce_end, accums);
+            break;
+        case ReduceLayout::kInner:
+            ReduceInner<In>(in, arg.in_indexer.total_size() / out_total, impl, out_begin, out_end, reduce_begin, reduce_end, accums);
+            break;
+        case ReduceLayout::kGeneric:
+            ReduceEachOutput(arg, impl, out_begin, out_end, reduce_begin, reduce_end, accums);
+            break;
+    }
+}
+
+// Reduces and writes the outputs [out_begin, out_end) in blocks of kOutBlockSize.
+template <typename In, typename Out, typename ReductionImpl, int8_t InNdim, int8_t OutNdim>
+void ReduceOutputs(
+        const ReductionKernelArg<In, Out, InNdim, OutNdim>& arg,
+        ReduceLayout layout,
+        ReductionImpl impl,
+        int64_t out_begin,
+        int64_t out_end) {
+    int64_t reduce_total = arg.in_indexer.total_size() / arg.out_indexer.total_size();
+    std::unique_ptr<AccumType<ReductionImpl>[]> accums = MakeAccums(impl, std::min(kOutBlockSize, out_end - out_begin));
+    auto it_out = arg.out_indexer.It(out_begin);
+    for (int64_t block_begin = out_begin; block_begin < out_end; block_begin += kOutBlockSize) {
+        int64_t block_end = std::min(block_begin + kOutBlockSize, out_end);
+        ReduceRange(arg, layout, impl, block_begin, block_end, 0, reduce_total, accums.get());
+        for (int64_t i_out = block_begin; i_out < block_end; ++i_out, ++it_out) {
+            WriteOut<Out>(arg.out[it_out], impl, accums[i_out - block_begin]);
+        }
+    }
+}
+
+template <typename In, typename Out, typename ReductionImpl, int8_t InNdim = kDynamicNdim, int8_t OutNdim = kDynamicNdim>
+void ReductionKernel(ReductionKernelArg<In, Out, InNdim, OutNdim> arg, ReductionImpl&& impl, NativeBackend& backend) {
+    using Impl = std::decay_t<ReductionImpl>;
+    using Accum = AccumType<Impl>;
+
+    int64_t out_total = arg.out_indexer.total_size();
+    int64_t in_total = arg.in_indexer.total_size();
+    int64_t reduce_total = in_total / out_total;
+    ReduceLayout layout = GetReduceLayout(arg);
+
+    if (in_total < 2 * kMinChunkSize) {
+        ReduceOutputs(arg, layout, impl, 0, out_total);
         return;
     }
 
+    std::shared_ptr<ThreadPool> pool = backend.GetThreadPool();
+    int num_threads = pool->num_threads();
+
+    if (out_total >= num_threads) {
+        // Enough outputs to keep all the threads busy. Each thread reduces a contiguous range of outputs.
+        int64_t min_chunk_size = std::max<int64_t>(1, kMinChunkSize / std::max<int64_t>(1, reduce_total));
+        ParallelFor(*pool, out_total, min_chunk_size, [&arg, layout, &impl](int64_t begin, int64_t end) {
+            ReduceOutputs(arg, layout, impl, begin, end);
+        });
+        return;
+    }
+
+    // Few outputs (e.g. reduction to a scalar). The reduction index is split among the threads and the partial results are combined
+    // afterwards, in order.
+    int64_t num_chunks = std::min({int64_t{num_threads}, in_total / kMinChunkSize, reduce_total});
+    int64_t chunk_size = (reduce_total + num_chunks - 1) / num_chunks;
+    num_chunks = (reduce_total + chunk_size - 1) / chunk_size;
+    std::unique_ptr<Accum[]> partials = MakeAccums(impl, num_chunks * out_total);
+    pool->Run(num_chunks, [&arg, layout, &impl, out_total, reduce_total, chunk_size, &partials](int64_t i_chunk) {
+        Impl chunk_impl = impl;
+        int64_t begin = i_chunk * chunk_size;
+        int64_t end = std::min(begin + chunk_size, reduce_total);
+        ReduceRange(arg, layout, chunk_impl, 0, out_total, begin, end, partials.get() + i_chunk * out_total);
+    });
+
+    auto it_out = arg.out_indexer.It(0);
+    for (int64_t i_out = 0; i_out < out_total; ++i_out, ++it_out) {
+        Accum accum = partials[i_out];
+        for (int64_t i_chunk = 1; i_chunk < num_chunks; ++i_chunk) {
+            impl.Reduce(partials[i_chunk * out_total + i_out], accum);
+        }
+        WriteOut<Out>(arg.out[it_out], impl, accum);
+    }
+}
+
+template <typename In, typename Out, typename ReductionImpl>
+void DispatchReductionKernel(const Array& in, const Axes& axis, const Array& out, ReductionImpl&& impl) {
     ReductionArg arg{in, axis, out};
+    NativeBackend& backend = static_cast<NativeBackend&>(in.device().backend());
 
     // TODO(sonots): Reconsider the number of statically-optimized kernels in terms of speed and binary size trade-offs.
     // Currently, we optimize for contiguous output arrays.
@@ -69,47 +342,133 @@ void Reduce(const Array& in, const Axes& axis, const Array& out, ReductionImpl&&
         case 1:
             switch (arg.out_shape().ndim()) {
                 case 0:
-                    reduce_detail::ReductionKernel(MakeReductionKernelArg<In, Out, 1, 0>(arg), impl);
+                    ReductionKernel(MakeReductionKernelArg<In, Out, 1, 0>(arg), impl, backend);
                     return;
                 case 1:
-                    reduce_detail::ReductionKernel(MakeReductionKernelArg<In, Out, 1, 1>(arg), impl);
+                    ReductionKernel(MakeReductionKernelArg<In, Out, 1, 1>(arg), impl, backend);
                     return;
             }
             break;
         case 2:
             switch (arg.out_shape().ndim()) {
                 case 0:
-                    reduce_detail::ReductionKernel(MakeReductionKernelArg<In, Out, 2, 0>(arg), impl);
+                    ReductionKernel(MakeReductionKernelArg<In, Out, 2, 0>(arg), impl, backend);
                     return;
                 case 1:
-                    reduce_detail::ReductionKernel(MakeReductionKernelArg<In, Out, 2, 1>(arg), impl);
+                    ReductionKernel(MakeReductionKernelArg<In, Out, 2, 1>(arg), impl, backend);
                     return;
             }
             break;
         case 3:
             switch (arg.out_shape().ndim()) {
                 case 0:
-                    reduce_detail::ReductionKernel(MakeReductionKernelArg<In, Out, 3, 0>(arg), impl);
+                    ReductionKernel(MakeReductionKernelArg<In, Out, 3, 0>(arg), impl, backend);
                     return;
                 case 1:
-                    reduce_detail::ReductionKernel(MakeReductionKernelArg<In, Out, 3, 1>(arg), impl);
+                    ReductionKernel(MakeReductionKernelArg<In, Out, 3, 1>(arg), impl, backend);
                     return;
             }
             break;
         case 4:
             switch (arg.out_shape().ndim()) {
                 case 0:
-                    reduce_detail::ReductionKernel(MakeReductionKernelArg<In, Out, 4, 0>(arg), impl);
+                    ReductionKernel(MakeReductionKernelArg<In, Out, 4, 0>(arg), impl, backend);
                     return;
                 case 1:
-                    reduce_detail::ReductionKernel(MakeReductionKernelArg<In, Out, 4, 1>(arg), impl);
+                    ReductionKernel(MakeReductionKernelArg<In, Out, 4, 1>(arg), impl, backend);
                     return;
             }
             break;
     }
 
-    reduce_detail::ReductionKernel(MakeReductionKernelArg<In, Out>(arg), impl);
+    ReductionKernel(MakeReductionKernelArg<In, Out>(arg), impl, backend);
 }
 
+}  // namespace reduce_detail
+
+// Computes the reduction of the input and stores into the output array.
+//
+// `ReductionImpl` is required to provide the following member function.
+// T can be arbitrary but should be common between these functions.
+//
+// - T Identity();
+//       Returns the initial value of reduction.
+// - T MapIn(In in, int64_t index);
+//       Applies pre-reduction mapping of the input and its index.
+// - void Reduce(T next, T& accum);
+//       Accumulates the iterated value to accum.
+// - Out MapOut(T accum);
+//       Applies post-reduction mapping of the output.
+//
+// Reduce is also used to combine partial results of disjoint ranges, always passing the later range as `next`.
+// The reduction is parallelized either over the outputs or, if there are only a few of them, over the reduced elements.
+// The impl is copied for each thread and therefore must not rely on mutable state.
+//
+// Example:
+//     Simple summation over a float array can be implemented as the following reduction impl.
+//
+//         struct SumImpl {
+//             float Identity() { return 0; }
+//             float MapIn(float in) { return in; }
+//             void Reduce(float next, float& accum) { accum += next; }
+//             float MapOut(float accum) { return accum; }
+//         };
+//
+//     Then, it can be passed to Reduce like: Reduce(input, axis, output, SumImpl{});
+template <typename In, typename Out, typename ReductionImpl>
+void Reduce(const Array& in, const Axes& axis, const Array& out, ReductionImpl&& impl) {
+    if (out.GetTotalSize() == 0) {
+        return;
+    }
+    reduce_detail::DispatchReductionKernel<In, Out>(in, axis, out, impl);
+}
+
+// Computes a reduction with two outputs, such as the mean and the variance, in a single pass over the input.
+//
+// `ReductionImpl` is the same as Reduce() except that MapOut returns a std::pair of the values of the outputs.
+// The outputs must have the same shape, strides and dtype.
+template <typename In, typename Out, typename ReductionImpl>
+void Reduce(const Array& in, const Axes& axis, const Array& out, const Array& out2, ReductionImpl&& impl) {
+    CHAINERX_ASSERT(out.shape() == out2.shape());
+    CHAINERX_ASSERT(out.strides() == out2.strides());
+    CHAINERX_ASSERT(out.dtype() == out2.dtype());
+    if (out.GetTotalSize() == 0) {
+        return;
+    }
+    reduce_detail::DispatchReductionKernel<In, Out>(
+            in,
+            axis,
+            out,
+            reduce_detail::TwoOutputImpl<std::decay_t<ReductionImpl>>{std::forward<ReductionImpl>(impl),
+                                                                      static_cast<const uint8_t*>(internal::GetRawOffsetData(out)),
+                                                                      static_cast<uint8_t*>(internal::GetRawOffsetData(out2))});
+}
+
+// Count, mean and sum of squared deviations of a set of values.
+//
+// Values are accumulated with Welford's algorithm, and the statistics of disjoint sets are merged with the formula of Chan et al., so
+// that the variance is computed accurately in a single pass.
+template <typename T>
+struct MeanVarAccum {
+    // Merges the statistics of another set.
+    void Merge(const MeanVarAccum& other) {
+        if (other.count == 0) {
+            return;
+        }
+        int64_t total = count + other.count;
+        T delta = other.mean - mean;
+        T other_ratio = static_cast<T>(other.count) / total;
+        mean += delta * other_ratio;
+        m2 += other.m2 + delta * delta * count * other_ratio;
+        count = total;
+    }
+
+    T GetVar() const { return m2 / count; }
+
+    int64_t count{0};
+    T mean{0};
+    T m2{0};
+};
+
 }  // namespace native
 }  // namespace chainerx
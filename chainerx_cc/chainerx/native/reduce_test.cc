@@ -0,0 +1,232 @@
+#include "chainerx/native/reduce.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "chainerx/array.h"
+#include "chainerx/axes.h"
+#include "chainerx/context.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/shape.h"
+
+namespace chainerx {
+namespace native {
+namespace {
+
+class ReduceTest : public ::testing::TestWithParam<int> {
+protected:
+    void SetUp() override {
+        context_.GetNativeBackend().SetNumThreads(GetParam());
+        device_ = &context_.GetDevice({"native", 0});
+    }
+
+    Device& device() { return *device_; }
+
+private:
+    Context context_;
+    Device* device_{nullptr};
+};
+
+template <typename T>
+const T* GetData(const Array& a) {
+    return static_cast<const T*>(a.data().get());
+}
+
+TEST_P(ReduceTest, SumToScalarPairwise) {
+    // Sequential accumulation of 0.1f would be off by ~1% at this size.
+    int64_t n = 1 << 20;
+    Array a = Full({n}, 0.1f, Dtype::kFloat32, device());
+    Array out = Empty({}, Dtype::kFloat32, device());
+    device().Sum(a, Axes{0}, out);
+    EXPECT_NEAR(0.1 * n, GetData<float>(out)[0], 0.1 * n * 1e-5);
+}
+
+TEST_P(ReduceTest, SumLeadingAxisFewOutputs) {
+    int64_t m = 100000;
+    int64_t n = 3;
+    Array a = Arange(0, m * n, Dtype::kInt64, device()).Reshape({m, n});
+    Array out = Empty({n}, Dtype::kInt64, device());
+    device().Sum(a, Axes{0}, out);
+    for (int64_t j = 0; j < n; ++j) {
+        EXPECT_EQ(n * m * (m - 1) / 2 + m * j, GetData<int64_t>(out)[j]);
+    }
+}
+
+TEST_P(ReduceTest, SumLeadingAxisManyOutputs) {
+    int64_t m = 64;
+    int64_t n = 4096;
+    Array a = Arange(0, m * n, Dtype::kInt64, device()).Reshape({m, n});
+    Array out = Empty({n}, Dtype::kInt64, device());
+    device().Sum(a, Axes{0}, out);
+    for (int64_t j = 0; j < n; ++j) {
+        ASSERT_EQ(n * m * (m - 1) / 2 + m * j, GetData<int64_t>(out)[j]);
+    }
+}
+
+TEST_P(ReduceTest, SumTrailingAxis) {
+    int64_t m = 3;
+    int64_t n = 100000;
+    for (bool transpose : {false, true}) {
+        Array a = transpose ? Arange(0, m * n, Dtype::kInt64, device()).Reshape({n, m}).Transpose()
+                            : Arange(0, m * n, Dtype::kInt64, device()).Reshape({m, n});
+        Array out = Empty({m}, Dtype::kInt64, device());
+        device().Sum(a, Axes{1}, out);
+        for (int64_t i = 0; i < m; ++i) {
+            int64_t expected = transpose ? m * n * (n - 1) / 2 + n * i : n * n * i + n * (n - 1) / 2;
+            EXPECT_EQ(expected, GetData<int64_t>(out)[i]);
+        }
+    }
+}
+
+TEST_P(ReduceTest, SumTrailingAxisPairwise) {
+    int64_t m = 8;
+    int64_t n = 1 << 18;
+    Array a = Full({m, n}, 0.1f, Dtype::kFloat32, device());
+    Array out = Empty({m}, Dtype::kFloat32, device());
+    device().Sum(a, Axes{1}, out);
+    for (int64_t i = 0; i < m; ++i) {
+        EXPECT_NEAR(0.1 * n, GetData<float>(out)[i], 0.1 * n * 1e-5);
+    }
+}
+
+TEST_P(ReduceTest, ArgMaxTrailingAxis) {
+    int64_t m = 4;
+    int64_t n = 50000;
+    Array a = Zeros({m, n}, Dtype::kFloat32, device());
+    auto a_data = static_cast<float*>(a.data().get());
+    for (int64_t i = 0; i < m; ++i) {
+        a_data[i * n + n - 1 - i * 1000] = 1.0f;
+        a_data[i * n + n - 1] = 1.0f;
+    }
+    Array out = Empty({m}, Dtype::kInt64, device());
+    device().ArgMax(a, Axes{1}, out);
+    for (int64_t i = 0; i < m; ++i) {
+        EXPECT_EQ(n - 1 - i * 1000, GetData<int64_t>(out)[i]);
+    }
+}
+
+TEST_P(ReduceTest, AMax) {
+    int64_t n = 200000;
+    Array a = Arange(-n + 1, 1, Dtype::kFloat32, device());
+    Array out = Empty({}, Dtype::kFloat32, device());
+    device().AMax(a, Axes{0}, out);
+    EXPECT_EQ(0.0f, GetData<float>(out)[0]);
+}
+
+TEST_P(ReduceTest, ArgMaxFirstOccurrence) {
+    int64_t n = 200000;
+    Array a = Zeros({n}, Dtype::kFloat32, device());
+    auto a_data = static_cast<float*>(a.data().get());
+    for (int64_t i : {150000, 70000, 190000}) {
+        a_data[i] = 1.0f;
+    }
+    Array out = Empty({}, Dtype::kInt64, device());
+    device().ArgMax(a, Axes{0}, out);
+    EXPECT_EQ(70000, GetData<int64_t>(out)[0]);
+}
+
+TEST_P(ReduceTest, ArgMaxLeadingAxis) {
+    int64_t m = 50000;
+    int64_t n = 4;
+    Array a = Zeros({m, n}, Dtype::kFloat32, device());
+    auto a_data = static_cast<float*>(a.data().get());
+    for (int64_t j = 0; j < n; ++j) {
+        a_data[(m - 1 - j * 1000) * n + j] = 1.0f;
+        a_data[(m - 1) * n + j] = 1.0f;
+    }
+    Array out = Empty({n}, Dtype::kInt64, device());
+    device().ArgMax(a, Axes{0}, out);
+    for (int64_t j = 0; j < n; ++j) {
+        EXPECT_EQ(m - 1 - j * 1000, GetData<int64_t>(out)[j]);
+    }
+}
+
+TEST_P(ReduceTest, SumTransposedLeadingAxes) {
+    // The reduction axes are not contiguous in memory; the squashed input merges an output axis with a reduction axis.
+    Array a = Arange(0, 24, Dtype::kFloat32, device()).Reshape({3, 4, 2}).Transpose({2, 0, 1});
+    Array out = Empty({4}, Dtype::kFloat32, device());
+    device().Sum(a, Axes{0, 1}, out);
+    for (int64_t j = 0; j < 4; ++j) {
+        EXPECT_EQ(51 + 12 * j, GetData<float>(out)[j]);
+    }
+}
+
+TEST_P(ReduceTest, AMaxTransposedLeadingAxes) {
+    Array a = Arange(0, 24, Dtype::kFloat32, device()).Reshape({3, 4, 2}).Transpose({2, 0, 1});
+    Array out = Empty({4}, Dtype::kFloat32, device());
+    device().AMax(a, Axes{0, 1}, out);
+    for (int64_t j = 0; j < 4; ++j) {
+        EXPECT_EQ(17 + 2 * j, GetData<float>(out)[j]);
+    }
+}
+
+TEST_P(ReduceTest, ArgMaxTransposedAllAxes) {
+    Array a = Zeros({2, 3}, Dtype::kFloat32, device());
+    static_cast<float*>(a.data().get())[1] = 1.0f;
+    Array out = Empty({}, Dtype::kInt64, device());
+    device().ArgMax(a.Transpose(), Axes{0, 1}, out);
+    EXPECT_EQ(2, GetData<int64_t>(out)[0]);
+}
+
+TEST_P(ReduceTest, MeanVarToScalar) {
+    // Values alternating around a large offset, whose variance would be lost by the sum of squares in float32.
+    int64_t n = 1 << 20;
+    Array a = Empty({n}, Dtype::kFloat32, device());
+    auto a_data = static_cast<float*>(a.data().get());
+    for (int64_t i = 0; i < n; ++i) {
+        a_data[i] = i % 2 == 0 ? 10000.5f : 9999.5f;
+    }
+    Array mean = Empty({}, Dtype::kFloat32, device());
+    Array var = Empty({}, Dtype::kFloat32, device());
+    device().MeanVar(a, Axes{0}, mean, var);
+    EXPECT_FLOAT_EQ(10000.0f, GetData<float>(mean)[0]);
+    EXPECT_NEAR(0.25f, GetData<float>(var)[0], 1e-4f);
+
+    Array var_only = Empty({}, Dtype::kFloat32, device());
+    device().Var(a, Axes{0}, var_only);
+    EXPECT_NEAR(0.25f, GetData<float>(var_only)[0], 1e-4f);
+}
+
+TEST_P(ReduceTest, MeanVarLeadingAxis) {
+    int64_t m = 50000;
+    int64_t n = 3;
+    Array a = Arange(0, m * n, Dtype::kFloat64, device()).Reshape({m, n});
+    Array mean = Empty({n}, Dtype::kFloat64, device());
+    Array var = Empty({n}, Dtype::kFloat64, device());
+    device().MeanVar(a, Axes{0}, mean, var);
+    for (int64_t j = 0; j < n; ++j) {
+        // Arithmetic progression of m elements with the step n.
+        EXPECT_DOUBLE_EQ(n * (m - 1) / 2.0 + j, GetData<double>(mean)[j]);
+        EXPECT_NEAR(n * n * (m * m - 1) / 12.0, GetData<double>(var)[j], 1e-6);
+    }
+
+    Array mean_only = Empty({n}, Dtype::kFloat64, device());
+    device().Mean(a, Axes{0}, mean_only);
+    for (int64_t j = 0; j < n; ++j) {
+        EXPECT_DOUBLE_EQ(n * (m - 1) / 2.0 + j, GetData<double>(mean_only)[j]);
+    }
+}
+
+TEST_P(ReduceTest, MeanVarTrailingAxisInteger) {
+    int64_t m = 4;
+    int64_t n = 9;
+    Array a = Arange(0, m * n, Dtype::kInt32, device()).Reshape({m, n});
+    Array mean = Empty({m}, Dtype::kFloat32, device());
+    Array var = Empty({m}, Dtype::kFloat32, device());
+    device().MeanVar(a, Axes{1}, mean, var);
+    for (int64_t i = 0; i < m; ++i) {
+        EXPECT_FLOAT_EQ(n * i + 4.0f, GetData<float>(mean)[i]);
+        EXPECT_FLOAT_EQ(20.0f / 3.0f, GetData<float>(var)[i]);
+    }
+}
+
+INSTANTIATE_TEST_CASE_P(ForEachNumThreads, ReduceTest, ::testing::Values(1, 4));
+
+}  // namespace
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,138 @@
+#include "chainerx/native/thread_pool.h"
+
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "chainerx/macro.h"
+
+namespace chainerx {
+namespace native {
+namespace {
+
+// True while the current thread is executing a task of some parallel region.
+thread_local bool t_in_parallel_region{false};
+
+void RunSerially(int64_t num_tasks, const std::function<void(int64_t)>& task) {
+    for (int64_t i = 0; i < num_tasks; ++i) {
+        task(i);
+    }
+}
+
+}  // namespace
+
+ThreadPool::ThreadPool(int num_threads) {
+    CHAINERX_ASSERT(num_threads >= 1);
+    workers_.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; ++i) {
+        workers_.emplace_back([this]() { WorkerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        stopping_ = true;
+    }
+    region_started_.notify_all();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::Run(int64_t num_tasks, const std::function<void(int64_t)>& task) {
+    if (num_tasks <= 0) {
+        return;
+    }
+    if (workers_.empty() || num_tasks == 1 || t_in_parallel_region) {
+        RunSerially(num_tasks, task);
+        return;
+    }
+    std::unique_lock<std::mutex> run_lock{run_mutex_, std::try_to_lock};
+    if (!run_lock.owns_lock()) {
+        // Another thread is running a parallel region. Falls back to serial execution instead of waiting for it.
+        RunSerially(num_tasks, task);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex_};
+        task_ = &task;
+        num_tasks_ = num_tasks;
+        next_task_ = 0;
+        num_finished_tasks_ = 0;
+        exception_ = nullptr;
+        ++generation_;
+    }
+    region_started_.notify_all();
+
+    int64_t num_executed = ExecuteTasks();
+
+    std::exception_ptr exception{nullptr};
+    {
+        std::unique_lock<std::mutex> lock{mutex_};
+        num_finished_tasks_ += num_executed;
+        // Workers must have left the region before its state is reset, since they still refer to `task`.
+        region_finished_.wait(lock, [this]() { return num_finished_tasks_ == num_tasks_ && num_active_workers_ == 0; });
+        task_ = nullptr;
+        std::swap(exception, exception_);
+    }
+    if (exception != nullptr) {
+        std::rethrow_exception(exception);
+    }
+}
+
+void ThreadPool::WorkerLoop() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    uint64_t seen_generation = generation_;
+    while (true) {
+        region_started_.wait(lock, [this, &seen_generation]() { return stopping_ || generation_ != seen_generation; });
+        if (stopping_) {
+            return;
+        }
+        seen_generation = generation_;
+        if (task_ == nullptr) {
+            // Woke up after the region has already been finished by other threads.
+            continue;
+        }
+
+        ++num_active_workers_;
+        lock.unlock();
+        int64_t num_executed = ExecuteTasks();
+        lock.lock();
+        --num_active_workers_;
+        num_finished_tasks_ += num_executed;
+
+        if (num_finished_tasks_ == num_tasks_ && num_active_workers_ == 0) {
+            region_finished_.notify_all();
+        }
+    }
+}
+
+int64_t ThreadPool::ExecuteTasks() {
+    CHAINERX_ASSERT(!t_in_parallel_region);
+    t_in_parallel_region = true;
+    int64_t num_executed{0};
+    while (true) {
+        int64_t i = next_task_.fetch_add(1);
+        if (i >= num_tasks_) {
+            break;
+        }
+        try {
+            (*task_)(i);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock{mutex_};
+            if (exception_ == nullptr) {
+                exception_ = std::current_exception();
+            }
+        }
+        ++num_executed;
+    }
+    t_in_parallel_region = false;
+    return num_executed;
+}
+
+}  // namespace native
+}  // namespace chainerx
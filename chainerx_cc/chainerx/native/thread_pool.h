@@ -0,0 +1,84 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace chainerx {
+namespace native {
+
+// A fixed-size pool of worker threads executing intra-op parallel loops.
+//
+// The calling thread participates in the execution, i.e. a pool with `num_threads` threads spawns `num_threads - 1` workers.
+// Only one parallel region runs at a time. Calls made while another region is running (either from another thread or nested from
+// within a task) are executed serially on the calling thread, so that they can never deadlock.
+//
+// This class is thread safe.
+class ThreadPool {
+public:
+    explicit ThreadPool(int num_threads);
+
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    int num_threads() const { return static_cast<int>(workers_.size()) + 1; }
+
+    // Calls `task(i)` for each i in [0, num_tasks) and blocks until all calls have returned.
+    // If any of the tasks throws, the first exception is rethrown on the calling thread after all tasks have finished.
+    void Run(int64_t num_tasks, const std::function<void(int64_t)>& task);
+
+private:
+    void WorkerLoop();
+
+    // Executes tasks of the current region until none are left, and returns the number of executed tasks.
+    int64_t ExecuteTasks();
+
+    std::vector<std::thread> workers_;
+
+    // Serializes parallel regions.
+    std::mutex run_mutex_;
+
+    // Guards the region state below.
+    std::mutex mutex_;
+    std::condition_variable region_started_;
+    std::condition_variable region_finished_;
+    bool stopping_{false};
+    uint64_t generation_{0};
+    const std::function<void(int64_t)>* task_{nullptr};
+    int64_t num_tasks_{0};
+    std::atomic<int64_t> next_task_{0};
+    int64_t num_finished_tasks_{0};
+    int num_active_workers_{0};
+    std::exception_ptr exception_{nullptr};
+};
+
+// Splits [0, total_size) into contiguous chunks of at least `min_chunk_size` elements and calls `func(begin, end)` for each chunk
+// using the given pool.
+// If the range is too small to be split, `func` is called once on the calling thread without touching the pool.
+template <typename Func>
+void ParallelFor(ThreadPool& pool, int64_t total_size, int64_t min_chunk_size, Func&& func) {
+    int64_t num_chunks = std::min<int64_t>(pool.num_threads(), total_size / std::max<int64_t>(min_chunk_size, 1));
+    if (num_chunks <= 1) {
+        func(int64_t{0}, total_size);
+        return;
+    }
+    int64_t chunk_size = (total_size + num_chunks - 1) / num_chunks;
+    pool.Run(num_chunks, [total_size, chunk_size, &func](int64_t i_chunk) {
+        int64_t begin = i_chunk * chunk_size;
+        int64_t end = std::min(begin + chunk_size, total_size);
+        func(begin, end);
+    });
+}
+
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,99 @@
+#include "chainerx/native/thread_pool.h"
+
+#include <atomic>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "chainerx/testing/threading.h"
+
+namespace chainerx {
+namespace native {
+namespace {
+
+TEST(ThreadPoolTest, NumThreads) {
+    EXPECT_EQ(1, ThreadPool{1}.num_threads());
+    EXPECT_EQ(4, ThreadPool{4}.num_threads());
+}
+
+TEST(ThreadPoolTest, Run) {
+    for (int num_threads : {1, 2, 4}) {
+        ThreadPool pool{num_threads};
+        for (int64_t num_tasks : {0, 1, 3, 100}) {
+            std::vector<int> counts(num_tasks);
+            pool.Run(num_tasks, [&counts](int64_t i) { ++counts[i]; });
+            for (int64_t i = 0; i < num_tasks; ++i) {
+                EXPECT_EQ(1, counts[i]);
+            }
+        }
+    }
+}
+
+TEST(ThreadPoolTest, RunRepeatedly) {
+    ThreadPool pool{4};
+    std::atomic<int64_t> sum{0};
+    for (int i = 0; i < 1000; ++i) {
+        pool.Run(8, [&sum](int64_t i_task) { sum += i_task; });
+    }
+    EXPECT_EQ(1000 * 28, sum.load());
+}
+
+TEST(ThreadPoolTest, RunNested) {
+    ThreadPool pool{4};
+    std::atomic<int64_t> count{0};
+    pool.Run(4, [&pool, &count](int64_t /*i*/) { pool.Run(4, [&count](int64_t /*j*/) { ++count; }); });
+    EXPECT_EQ(16, count.load());
+}
+
+TEST(ThreadPoolTest, RunThrow) {
+    ThreadPool pool{4};
+    std::atomic<int64_t> count{0};
+    EXPECT_THROW(
+            pool.Run(
+                    8,
+                    [&count](int64_t i) {
+                        ++count;
+                        if (i == 3) {
+                            throw std::runtime_error{"error"};
+                        }
+                    }),
+            std::runtime_error);
+    EXPECT_EQ(8, count.load());
+
+    // The pool is still usable after an exception.
+    count = 0;
+    pool.Run(8, [&count](int64_t /*i*/) { ++count; });
+    EXPECT_EQ(8, count.load());
+}
+
+TEST(ThreadPoolTest, RunThreadSafe) {
+    ThreadPool pool{2};
+    testing::RunThreads(4, [&pool]() {
+        std::atomic<int64_t> count{0};
+        pool.Run(10, [&count](int64_t /*i*/) { ++count; });
+        EXPECT_EQ(10, count.load());
+    });
+}
+
+TEST(ThreadPoolTest, ParallelFor) {
+    ThreadPool pool{4};
+    for (int64_t total_size : {0, 1, 7, 100, 1001}) {
+        for (int64_t min_chunk_size : {1, 10, 1000}) {
+            std::vector<int> counts(total_size);
+            ParallelFor(pool, total_size, min_chunk_size, [&counts](int64_t begin, int64_t end) {
+                for (int64_t i = begin; i < end; ++i) {
+                    ++counts[i];
+                }
+            });
+            for (int64_t i = 0; i < total_size; ++i) {
+                EXPECT_EQ(1, counts[i]);
+            }
+        }
+    }
+}
+
+}  // namespace
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,304 @@
+#include "chainerx/native/winograd_conv.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/array_index.h"
+#include "chainerx/backend_util.h"
+#include "chainerx/constant.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
+#include "chainerx/macro.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/thread_pool.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/slice.h"
+#include "chainerx/stack_vector.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+namespace {
+
+constexpr int64_t kKernelSize = 3;
+
+// Minimum number of input and output channels. With fewer channels, the transforms dominate and the generic path is faster.
+constexpr int64_t kMinChannels = 16;
+
+// Minimum output size to use F(4x4, 3x3) instead of F(2x2, 3x3).
+constexpr int64_t kMinOutSizeForLargeTiles = 8;
+
+// Upper bound of the number of elements of the transformed input of a block of tiles, and the minimum number of tiles in a block.
+constexpr int64_t kMaxBlockSize = int64_t{1} << 20;
+constexpr int64_t kMinBlockTiles = 32;
+
+// Transforms of F(2x2, 3x3): B^T, G and A^T respectively.
+constexpr float kInputTransform2[4][4] = {{1, 0, -1, 0}, {0, 1, 1, 0}, {0, -1, 1, 0}, {0, 1, 0, -1}};
+constexpr float kFilterTransform2[4][3] = {{1, 0, 0}, {0.5f, 0.5f, 0.5f}, {0.5f, -0.5f, 0.5f}, {0, 0, 1}};
+constexpr float kOutputTransform2[2][4] = {{1, 1, 1, 0}, {0, 1, -1, -1}};
+
+// Transforms of F(4x4, 3x3): B^T, G and A^T respectively.
+constexpr float kInputTransform4[6][6] = {{4, 0, -5, 0, 1, 0},
+                                          {0, -4, -4, 1, 1, 0},
+                                          {0, 4, -4, -1, 1, 0},
+                                          {0, -2, -1, 2, 1, 0},
+                                          {0, 2, -1, -2, 1, 0},
+                                          {0, 4, 0, -5, 0, 1}};
+constexpr float kFilterTransform4[6][3] = {{1.f / 4, 0, 0},
+                                           {-1.f / 6, -1.f / 6, -1.f / 6},
+                                           {-1.f / 6, 1.f / 6, -1.f / 6},
+                                           {1.f / 24, 1.f / 12, 1.f / 6},
+                                           {1.f / 24, -1.f / 12, 1.f / 6},
+                                           {0, 0, 1}};
+constexpr float kOutputTransform4[4][6] = {{1, 1, 1, 1, 1, 0}, {0, 1, -1, 2, -2, 0}, {0, 1, 1, 4, 4, 0}, {0, 1, -1, 8, -8, 1}};
+
+// Computes out = t * x * t^T.
+template <int64_t R, int64_t K>
+void Transform(const float (&t)[R][K], const float (&x)[K][K], float (&out)[R][R]) {
+    float tmp[R][K];
+    for (int64_t i = 0; i < R; ++i) {
+        for (int64_t j = 0; j < K; ++j) {
+            float sum = 0;
+            for (int64_t p = 0; p < K; ++p) {
+                sum += t[i][p] * x[p][j];
+            }
+            tmp[i][j] = sum;
+        }
+    }
+    for (int64_t i = 0; i < R; ++i) {
+        for (int64_t j = 0; j < R; ++j) {
+            float sum = 0;
+            for (int64_t p = 0; p < K; ++p) {
+                sum += tmp[i][p] * t[j][p];
+            }
+            out[i][j] = sum;
+        }
+    }
+}
+
+// Computes the convolution of x (batch_size, channels, in_h, in_w) by w (out_channels, channels, 3, 3) with stride 1.
+// kM is the size of output tiles, and kAlpha = kM + 2 the size of input tiles.
+//
+// The output is computed by blocks of tiles. For each block, the input tiles are transformed into v (kAlpha^2, channels, tiles), then
+// multiplied by the transformed filters u (kAlpha^2, out_channels, channels) into m (kAlpha^2, out_channels, tiles) with a batched
+// matrix product, and finally transformed back to output tiles.
+template <int64_t kM, int64_t kAlpha>
+Array WinogradConvImpl(
+        const Array& x,
+        const Array& w,
+        const nonstd::optional<Array>& b,
+        int64_t pad_h,
+        int64_t pad_w,
+        const float (&input_transform)[kAlpha][kAlpha],
+        const float (&filter_transform)[kAlpha][kKernelSize],
+        const float (&output_transform)[kM][kAlpha]) {
+    constexpr int64_t kTileArea = kAlpha * kAlpha;
+    CHAINERX_ASSERT(x.IsContiguous());
+    CHAINERX_ASSERT(w.IsContiguous());
+
+    Device& device = x.device();
+    std::shared_ptr<ThreadPool> pool = static_cast<NativeBackend&>(device.backend()).GetThreadPool();
+    int64_t batch_size = x.shape()[0];
+    int64_t channels = x.shape()[1];
+    int64_t in_h = x.shape()[2];
+    int64_t in_w = x.shape()[3];
+    int64_t out_channels = w.shape()[0];
+    int64_t out_h = in_h + 2 * pad_h - (kKernelSize - 1);
+    int64_t out_w = in_w + 2 * pad_w - (kKernelSize - 1);
+    int64_t tiles_h = (out_h + kM - 1) / kM;
+    int64_t tiles_w = (out_w + kM - 1) / kM;
+    int64_t tiles_per_image = tiles_h * tiles_w;
+    int64_t total_tiles = batch_size * tiles_per_image;
+
+    // Transform the filters.
+    Array u = Empty({kTileArea, out_channels, channels}, Dtype::kFloat32, device);
+    {
+        const auto* w_ptr = static_cast<const float*>(internal::GetRawOffsetData(w));
+        auto* u_ptr = static_cast<float*>(internal::GetRawOffsetData(u));
+        int64_t filter_count = out_channels * channels;
+        ParallelFor(*pool, filter_count, 256, [&](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end; ++i) {
+                float g[kKernelSize][kKernelSize];
+                std::copy_n(w_ptr + i * kKernelSize * kKernelSize, kKernelSize * kKernelSize, &g[0][0]);
+                float ut[kAlpha][kAlpha];
+                Transform(filter_transform, g, ut);
+                for (int64_t xi = 0; xi < kTileArea; ++xi) {
+                    u_ptr[xi * filter_count + i] = ut[xi / kAlpha][xi % kAlpha];
+                }
+            }
+        });
+    }
+
+    Array b_cast{};
+    if (b.has_value()) {
+        b_cast = internal::AsContiguous(*b, Dtype::kFloat32);
+    }
+    const float* b_ptr = b.has_value() ? static_cast<const float*>(internal::GetRawOffsetData(b_cast)) : nullptr;
+
+    Array y = Empty({batch_size, out_channels, out_h, out_w}, Dtype::kFloat32, device);
+    int64_t block_tiles = std::min(total_tiles, std::max(kMinBlockTiles, kMaxBlockSize / (kTileArea * channels)));
+    Array v = Empty({kTileArea, channels, block_tiles}, Dtype::kFloat32, device);
+    Array m = Empty({kTileArea, out_channels, block_tiles}, Dtype::kFloat32, device);
+
+    const auto* x_ptr = static_cast<const float*>(internal::GetRawOffsetData(x));
+    auto* y_ptr = static_cast<float*>(internal::GetRawOffsetData(y));
+    auto* v_ptr = static_cast<float*>(internal::GetRawOffsetData(v));
+    const auto* m_ptr = static_cast<const float*>(internal::GetRawOffsetData(m));
+
+    for (int64_t tile_begin = 0; tile_begin < total_tiles; tile_begin += block_tiles) {
+        int64_t tb = std::min(block_tiles, total_tiles - tile_begin);
+
+        // Transform the input tiles.
+        ParallelFor(*pool, channels * tb, 64, [&](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end; ++i) {
+                int64_t c = i / tb;
+                int64_t t = i % tb;
+                int64_t tile = tile_begin + t;
+                int64_t n = tile / tiles_per_image;
+                int64_t row0 = tile % tiles_per_image / tiles_w * kM - pad_h;
+                int64_t col0 = tile % tiles_w * kM - pad_w;
+                const float* x_channel = x_ptr + (n * channels + c) * in_h * in_w;
+
+                float d[kAlpha][kAlpha];
+                for (int64_t r = 0; r < kAlpha; ++r) {
+                    int64_t row = row0 + r;
+                    for (int64_t s = 0; s < kAlpha; ++s) {
+                        int64_t col = col0 + s;
+                        d[r][s] = row >= 0 && row < in_h && col >= 0 && col < in_w ? x_channel[row * in_w + col] : 0.f;
+                    }
+                }
+                float vt[kAlpha][kAlpha];
+                Transform(input_transform, d, vt);
+                for (int64_t xi = 0; xi < kTileArea; ++xi) {
+                    v_ptr[(xi * channels + c) * block_tiles + t] = vt[xi / kAlpha][xi % kAlpha];
+                }
+            }
+        });
+
+        // Multiply the transformed filters and input tiles at each position in a tile.
+        Slice tile_slice{0, tb};
+        device.BatchDot(u, v.At({Slice{}, Slice{}, tile_slice}), m.At({Slice{}, Slice{}, tile_slice}));
+
+        // Transform back to the output tiles.
+        ParallelFor(*pool, out_channels * tb, 64, [&](int64_t begin, int64_t end) {
+            for (int64_t i = begin; i < end; ++i) {
+                int64_t oc = i / tb;
+                int64_t t = i % tb;
+                int64_t tile = tile_begin + t;
+                int64_t n = tile / tiles_per_image;
+                int64_t row0 = tile % tiles_per_image / tiles_w * kM;
+                int64_t col0 = tile % tiles_w * kM;
+
+                float mt[kAlpha][kAlpha];
+                for (int64_t xi = 0; xi < kTileArea; ++xi) {
+                    mt[xi / kAlpha][xi % kAlpha] = m_ptr[(xi * out_channels + oc) * block_tiles + t];
+                }
+                float yt[kM][kM];
+                Transform(output_transform, mt, yt);
+
+                float bias = b_ptr == nullptr ? 0.f : b_ptr[oc];
+                float* y_channel = y_ptr + (n * out_channels + oc) * out_h * out_w;
+                for (int64_t r = 0; r < std::min(kM, out_h - row0); ++r) {
+                    for (int64_t s = 0; s < std::min(kM, out_w - col0); ++s) {
+                        y_channel[(row0 + r) * out_w + col0 + s] = yt[r][s] + bias;
+                    }
+                }
+            }
+        });
+    }
+
+    return y;
+}
+
+// Dispatches to F(4x4, 3x3) or F(2x2, 3x3) by the output size.
+Array WinogradConvWithTileSize(const Array& x, const Array& w, const nonstd::optional<Array>& b, int64_t pad_h, int64_t pad_w) {
+    int64_t out_h = x.shape()[2] + 2 * pad_h - (kKernelSize - 1);
+    int64_t out_w = x.shape()[3] + 2 * pad_w - (kKernelSize - 1);
+    if (out_h >= kMinOutSizeForLargeTiles && out_w >= kMinOutSizeForLargeTiles) {
+        return WinogradConvImpl<4, 6>(x, w, b, pad_h, pad_w, kInputTransform4, kFilterTransform4, kOutputTransform4);
+    }
+    return WinogradConvImpl<2, 4>(x, w, b, pad_h, pad_w, kInputTransform2, kFilterTransform2, kOutputTransform2);
+}
+
+bool IsWinogradApplicable(
+        const Array& x,
+        const Array& w,
+        const nonstd::optional<Array>& b,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        Dtype out_dtype) {
+    if (x.ndim() != 4 || w.ndim() != 4) {
+        return false;
+    }
+    if (x.dtype() != Dtype::kFloat32 || w.dtype() != Dtype::kFloat32 || out_dtype != Dtype::kFloat32 ||
+        (b.has_value() && b->dtype() != Dtype::kFloat32)) {
+        return false;
+    }
+    if (w.shape()[2] != kKernelSize || w.shape()[3] != kKernelSize) {
+        return false;
+    }
+    if (stride[0] != 1 || stride[1] != 1) {
+        return false;
+    }
+    return x.shape()[2] + 2 * pad[0] >= kKernelSize && x.shape()[3] + 2 * pad[1] >= kKernelSize && x.GetTotalSize() > 0;
+}
+
+}  // namespace
+
+bool IsWinogradConvEnabled(
+        const Array& x,
+        const Array& w,
+        const nonstd::optional<Array>& b,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        Dtype out_dtype) {
+    return IsWinogradApplicable(x, w, b, stride, pad, out_dtype) && w.shape()[1] >= kMinChannels && w.shape()[0] >= kMinChannels;
+}
+
+Array WinogradConv(const Array& x, const Array& w, const nonstd::optional<Array>& b, const StackVector<int64_t, kMaxNdim>& pad) {
+    CHAINERX_ASSERT(pad.size() == 2);
+    return WinogradConvWithTileSize(internal::AsContiguous(x), internal::AsContiguous(w), b, pad[0], pad[1]);
+}
+
+bool IsWinogradConvTransposeEnabled(
+        const Array& x,
+        const Array& w,
+        const nonstd::optional<Array>& b,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        Dtype out_dtype) {
+    // The equivalent convolution is padded by kKernelSize - 1 - pad, which must not be negative.
+    return IsWinogradApplicable(x, w, b, stride, pad, out_dtype) && w.shape()[0] >= kMinChannels && w.shape()[1] >= kMinChannels &&
+           pad[0] <= kKernelSize - 1 && pad[1] <= kKernelSize - 1;
+}
+
+Array WinogradConvTranspose(const Array& x, const Array& w, const nonstd::optional<Array>& b, const StackVector<int64_t, kMaxNdim>& pad) {
+    CHAINERX_ASSERT(pad.size() == 2);
+
+    // The transposed convolution with stride 1 is the convolution by the kernel with swapped channel axes and flipped spatial axes.
+    int64_t in_channels = w.shape()[0];
+    int64_t out_channels = w.shape()[1];
+    Array w_contiguous = internal::AsContiguous(w);
+    Array w_conv = Empty({out_channels, in_channels, kKernelSize, kKernelSize}, Dtype::kFloat32, w.device());
+    const auto* src = static_cast<const float*>(internal::GetRawOffsetData(w_contiguous));
+    auto* dst = static_cast<float*>(internal::GetRawOffsetData(w_conv));
+    constexpr int64_t kKernelArea = kKernelSize * kKernelSize;
+    for (int64_t ic = 0; ic < in_channels; ++ic) {
+        for (int64_t oc = 0; oc < out_channels; ++oc) {
+            for (int64_t k = 0; k < kKernelArea; ++k) {
+                dst[(oc * in_channels + ic) * kKernelArea + k] = src[(ic * out_channels + oc) * kKernelArea + kKernelArea - 1 - k];
+            }
+        }
+    }
+
+    return WinogradConvWithTileSize(
+            internal::AsContiguous(x), w_conv, b, kKernelSize - 1 - pad[0], kKernelSize - 1 - pad[1]);
+}
+
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
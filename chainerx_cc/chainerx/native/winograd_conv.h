@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/constant.h"
+#include "chainerx/dtype.h"
+#include "chainerx/stack_vector.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+
+// Returns true if the convolution can be computed by WinogradConv, and is expected to be faster that way.
+//
+// Winograd convolution is used for 2-dimensional float32 convolutions with 3x3 kernels and stride 1, with enough input and output
+// channels for the matrix products to dominate the cost of the transforms.
+bool IsWinogradConvEnabled(
+        const Array& x,
+        const Array& w,
+        const nonstd::optional<Array>& b,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        Dtype out_dtype);
+
+// Computes the 2-dimensional convolution of x by w with stride 1 using the Winograd minimal filtering algorithm.
+//
+// F(4x4, 3x3) is used if the output is large enough, and F(2x2, 3x3) otherwise.
+// The arguments and the returned array are the same as those of Device::Conv.
+Array WinogradConv(const Array& x, const Array& w, const nonstd::optional<Array>& b, const StackVector<int64_t, kMaxNdim>& pad);
+
+// Returns true if the transposed convolution can be computed by WinogradConvTranspose. See IsWinogradConvEnabled for the conditions.
+bool IsWinogradConvTransposeEnabled(
+        const Array& x,
+        const Array& w,
+        const nonstd::optional<Array>& b,
+        const StackVector<int64_t, kMaxNdim>& stride,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        Dtype out_dtype);
+
+// Computes the 2-dimensional transposed convolution with stride 1, as the convolution by the flipped kernel.
+// The arguments and the returned array are the same as those of Device::ConvTranspose, where out_size is determined by the other
+// arguments for stride 1.
+Array WinogradConvTranspose(const Array& x, const Array& w, const nonstd::optional<Array>& b, const StackVector<int64_t, kMaxNdim>& pad);
+
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
@@ -0,0 +1,142 @@
+#include "chainerx/native/winograd_conv.h"
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+#include <nonstd/optional.hpp>
+
+#include "chainerx/array.h"
+#include "chainerx/constant.h"
+#include "chainerx/device.h"
+#include "chainerx/device_id.h"
+#include "chainerx/dtype.h"
+#include "chainerx/native/col2im.h"
+#include "chainerx/native/implicit_gemm_conv.h"
+#include "chainerx/native/native_backend.h"
+#include "chainerx/native/tensor_dot.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/routines/manipulation.h"
+#include "chainerx/shape.h"
+#include "chainerx/slice.h"
+#include "chainerx/stack_vector.h"
+#include "chainerx/testing/array_check.h"
+#include "chainerx/testing/device_session.h"
+
+namespace chainerx {
+namespace native {
+namespace native_internal {
+namespace {
+
+Array MakeInput(const Shape& shape, int64_t seed, Device& device) {
+    Array a = Empty(shape, Dtype::kFloat32, device);
+    auto data = static_cast<float*>(a.raw_data());
+    for (int64_t i = 0; i < a.GetTotalSize(); ++i) {
+        data[i] = static_cast<float>((i * 7 + seed) % 11 - 5) / 4;
+    }
+    return a;
+}
+
+// Transposed convolution through the column representation, computed in float64.
+Array ReferenceConvTranspose(
+        const Array& x,
+        const Array& w,
+        const Array& b,
+        const StackVector<int64_t, kMaxNdim>& pad,
+        const StackVector<int64_t, kMaxNdim>& out_size) {
+    Array col = TensorDot(w, x, {0}, {1}, Dtype::kFloat64);
+    col = RollAxis(col, x.ndim() - 1);
+    Array y = Col2Im(col, {1, 1}, pad, out_size);
+    return (y + b.At({NewAxis{}, Slice{}, NewAxis{}, NewAxis{}}).AsType(Dtype::kFloat64)).AsType(Dtype::kFloat32);
+}
+
+class WinogradConvTest : public ::testing::TestWithParam<int> {
+protected:
+    void SetUp() override {
+        device_session_.emplace(DeviceId{"native", 0});
+        static_cast<NativeBackend&>(device().backend()).SetNumThreads(GetParam());
+    }
+
+    void TearDown() override { device_session_.reset(); }
+
+    Device& device() { return device_session_->device(); }
+
+    // Compares against the convolution computed in float64.
+    // The transforms of F(4x4, 3x3) involve cancellation of terms as large as 8 times the inputs, hence the absolute tolerance.
+    void CheckConv(const Shape& x_shape, int64_t out_channels, const StackVector<int64_t, kMaxNdim>& pad) {
+        Array x = MakeInput(x_shape, 0, device());
+        Array w = MakeInput({out_channels, x_shape[1], 3, 3}, 1, device());
+        Array b = MakeInput({out_channels}, 2, device());
+        ASSERT_TRUE(IsWinogradConvEnabled(x, w, b, {1, 1}, pad, Dtype::kFloat32));
+
+        Array y_expected = ImplicitGemmConv(x, w, b, {1, 1}, pad, false, Dtype::kFloat64).AsType(Dtype::kFloat32);
+        Array y = WinogradConv(x, w, b, pad);
+        EXPECT_ARRAY_ALL_CLOSE4(y_expected, y, 1e-4, 1e-3);
+    }
+
+    void CheckConvTranspose(const Shape& x_shape, int64_t out_channels, const StackVector<int64_t, kMaxNdim>& pad) {
+        Array x = MakeInput(x_shape, 0, device());
+        Array w = MakeInput({x_shape[1], out_channels, 3, 3}, 1, device());
+        Array b = MakeInput({out_channels}, 2, device());
+        ASSERT_TRUE(IsWinogradConvTransposeEnabled(x, w, b, {1, 1}, pad, Dtype::kFloat32));
+
+        StackVector<int64_t, kMaxNdim> out_size{x_shape[2] + 2 - 2 * pad[0], x_shape[3] + 2 - 2 * pad[1]};
+        Array y_expected = ReferenceConvTranspose(x, w, b, pad, out_size);
+        Array y = WinogradConvTranspose(x, w, b, pad);
+        EXPECT_ARRAY_ALL_CLOSE4(y_expected, y, 1e-4, 1e-3);
+    }
+
+private:
+    nonstd::optional<testing::DeviceSession> device_session_;
+};
+
+// Outputs smaller than 8 use F(2x2, 3x3).
+TEST_P(WinogradConvTest, ConvSmallTiles) { CheckConv({2, 16, 7, 6}, 17, {1, 1}); }
+
+TEST_P(WinogradConvTest, ConvSmallTilesNoPad) { CheckConv({3, 16, 5, 9}, 16, {0, 0}); }
+
+TEST_P(WinogradConvTest, ConvLargeTiles) { CheckConv({2, 16, 13, 17}, 18, {1, 1}); }
+
+TEST_P(WinogradConvTest, ConvLargeTilesPad) { CheckConv({1, 19, 11, 10}, 16, {2, 0}); }
+
+// Many tiles with many channels, spanning multiple blocks of tiles.
+TEST_P(WinogradConvTest, ConvManyBlocks) { CheckConv({4, 64, 34, 30}, 16, {1, 1}); }
+
+TEST_P(WinogradConvTest, ConvNonContiguous) {
+    Array x = MakeInput({2, 16, 20, 10}, 0, device()).At({Slice{}, Slice{}, Slice{0, 20, 2}, Slice{}});
+    Array w = MakeInput({16, 16, 3, 3}, 1, device()).Transpose({0, 1, 3, 2});
+    Array b = MakeInput({16}, 2, device());
+    Array y_expected = ImplicitGemmConv(x, w, b, {1, 1}, {1, 1}, false, Dtype::kFloat64).AsType(Dtype::kFloat32);
+    EXPECT_ARRAY_ALL_CLOSE4(y_expected, WinogradConv(x, w, b, {1, 1}), 1e-4, 1e-4);
+}
+
+TEST_P(WinogradConvTest, ConvTransposeSmallTiles) { CheckConvTranspose({2, 16, 4, 5}, 16, {1, 1}); }
+
+TEST_P(WinogradConvTest, ConvTransposeLargeTiles) { CheckConvTranspose({2, 17, 12, 9}, 16, {1, 1}); }
+
+TEST_P(WinogradConvTest, ConvTransposePad) { CheckConvTranspose({1, 16, 10, 12}, 20, {0, 2}); }
+
+TEST_P(WinogradConvTest, Selection) {
+    Array x = MakeInput({1, 16, 8, 8}, 0, device());
+    Array w = MakeInput({16, 16, 3, 3}, 1, device());
+    EXPECT_TRUE(IsWinogradConvEnabled(x, w, nonstd::nullopt, {1, 1}, {1, 1}, Dtype::kFloat32));
+    EXPECT_FALSE(IsWinogradConvEnabled(x, w, nonstd::nullopt, {2, 1}, {1, 1}, Dtype::kFloat32));
+    EXPECT_FALSE(IsWinogradConvEnabled(x, w, nonstd::nullopt, {1, 1}, {1, 1}, Dtype::kFloat64));
+    EXPECT_FALSE(IsWinogradConvEnabled(x.AsType(Dtype::kFloat64), w, nonstd::nullopt, {1, 1}, {1, 1}, Dtype::kFloat32));
+
+    Array x_few_channels = MakeInput({1, 4, 8, 8}, 0, device());
+    Array w_few_channels = MakeInput({16, 4, 3, 3}, 1, device());
+    EXPECT_FALSE(IsWinogradConvEnabled(x_few_channels, w_few_channels, nonstd::nullopt, {1, 1}, {1, 1}, Dtype::kFloat32));
+
+    Array w_5x5 = MakeInput({16, 16, 5, 5}, 1, device());
+    EXPECT_FALSE(IsWinogradConvEnabled(x, w_5x5, nonstd::nullopt, {1, 1}, {1, 1}, Dtype::kFloat32));
+
+    EXPECT_TRUE(IsWinogradConvTransposeEnabled(x, w, nonstd::nullopt, {1, 1}, {2, 2}, Dtype::kFloat32));
+    EXPECT_FALSE(IsWinogradConvTransposeEnabled(x, w, nonstd::nullopt, {1, 1}, {3, 3}, Dtype::kFloat32));
+}
+
+INSTANTIATE_TEST_CASE_P(ForEachNumThreads, WinogradConvTest, ::testing::Values(1, 4));
+
+}  // namespace
+}  // namespace native_internal
+}  // namespace native
+}  // namespace chainerx
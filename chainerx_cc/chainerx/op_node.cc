@@ -1,7 +1,6 @@
 #include "chainerx/op_node.h"
 
 #include <algorithm>
-#include <functional>
 #include <memory>
 #include <tuple>
 #include <utility>
@@ -12,6 +11,7 @@
 #include "chainerx/array_node.h"
 #include "chainerx/error.h"
 #include "chainerx/graph.h"
+#include "chainerx/graph_arena.h"
 #include "chainerx/macro.h"
 
 namespace chainerx {
@@ -21,7 +21,7 @@ ArrayProps::ArrayProps(const Array& array) : shape{array.shape()}, dtype{array.d
 ArrayProps::ArrayProps(const ArrayNode& array_node) : shape{array_node.shape()}, dtype{array_node.dtype()}, device{array_node.device()} {}
 ArrayProps::ArrayProps(const ArrayBody& array_body) : shape{array_body.shape()}, dtype{array_body.dtype()}, device{array_body.device()} {}
 
-OpNodeBackwardEntry::OpNodeBackwardEntry(OpNode& op_node, std::vector<size_t> input_array_node_indices, BackwardFunction backward_func)
+OpNodeBackwardEntry::OpNodeBackwardEntry(OpNode& op_node, GraphArenaVector<size_t> input_array_node_indices, BackwardFunction backward_func)
     : op_node_{op_node}, input_array_node_indices_{std::move(input_array_node_indices)}, backward_func_{std::move(backward_func)} {}
 
 std::shared_ptr<ArrayNode> FabricateOutputArrayNode(std::shared_ptr<OpNode> op_node, size_t output_array_node_index) {
@@ -47,15 +47,21 @@ std::shared_ptr<OpNode> OpNode::CreateWithOutputArrayNodes(
         OpNodeWithPublicCtor(std::string name, BackpropId backprop_id, size_t input_count)
             : OpNode{std::move(name), backprop_id, input_count} {}
     };
-    std::shared_ptr<OpNode> op_node = std::make_shared<OpNodeWithPublicCtor>(std::move(name), backprop_id, input_count);
+    // The op node is allocated from the graph arena. Its output array nodes are allocated on the heap, since they are held by the output
+    // arrays, which users often keep across iterations (e.g. losses), and would otherwise pin their chunks.
+    std::shared_ptr<OpNode> op_node = std::allocate_shared<OpNodeWithPublicCtor>(
+            GraphArenaAllocator<OpNodeWithPublicCtor>{}, std::move(name), backprop_id, input_count);
 
+    op_node->output_array_props_.reserve(outputs.size());
+    op_node->output_array_nodes_.reserve(outputs.size());
     for (const Array& out : outputs) {
         const std::shared_ptr<ArrayBody>& out_body = GetArrayBody(out);
         CHAINERX_ASSERT(out_body != nullptr);
         op_node->output_array_props_.emplace_back(*out_body);
         if (GetKind(out_body->dtype()) == DtypeKind::kFloat) {
             CHAINERX_ASSERT(!out_body->HasArrayNode(backprop_id));
-            const std::shared_ptr<ArrayNode>& output_array_node = ArrayBody::CreateArrayNode(out_body, backprop_id);
+            const std::shared_ptr<ArrayNode>& output_array_node = ArrayBody::AddNode(
+                    out_body, std::make_shared<ArrayNode>(out_body->shape(), out_body->dtype(), out_body->device(), backprop_id));
             op_node->output_array_nodes_.emplace_back(output_array_node);
             output_array_node->set_creator_op_node(op_node);
         } else {
@@ -150,14 +156,14 @@ void OpNode::AssertConsistency() const {
 #endif  // CHAINERX_DEBUG
 }
 
-std::vector<std::shared_ptr<ArrayNode>>& OpNode::input_array_nodes() {
+GraphArenaVector<std::shared_ptr<ArrayNode>>& OpNode::input_array_nodes() {
     CHAINERX_ASSERT(std::all_of(input_array_nodes_.begin(), input_array_nodes_.end(), [this](const std::shared_ptr<ArrayNode>& arr_node) {
         return arr_node == nullptr || arr_node->backprop_id() == backprop_id_;
     }));
     return input_array_nodes_;
 }
 
-const std::vector<std::shared_ptr<ArrayNode>>& OpNode::input_array_nodes() const {
+const GraphArenaVector<std::shared_ptr<ArrayNode>>& OpNode::input_array_nodes() const {
     CHAINERX_ASSERT(std::all_of(input_array_nodes_.begin(), input_array_nodes_.end(), [this](const std::shared_ptr<ArrayNode>& arr_node) {
         return arr_node == nullptr || arr_node->backprop_id() == backprop_id_;
     }));
@@ -165,7 +171,7 @@ const std::vector<std::shared_ptr<ArrayNode>>& OpNode::input_array_nodes() const
 }
 
 OpNodeBackwardEntry& OpNode::RegisterBackwardFunction(
-        std::vector<std::tuple<size_t, std::shared_ptr<ArrayNode>>> input_array_nodes, BackwardFunction backward_func) {
+        GraphArenaVector<std::tuple<size_t, std::shared_ptr<ArrayNode>>> input_array_nodes, BackwardFunction backward_func) {
     AssertConsistency();
     CHAINERX_ASSERT(!input_array_nodes.empty());
     CHAINERX_ASSERT(std::all_of(input_array_nodes.begin(), input_array_nodes.end(), [this](const auto& tup) {
@@ -183,7 +189,7 @@ OpNodeBackwardEntry& OpNode::RegisterBackwardFunction(
     }
 
     // Store input nodes and record indices of them
-    std::vector<size_t> input_array_node_indices;
+    GraphArenaVector<size_t> input_array_node_indices;
     input_array_node_indices.reserve(input_array_nodes.size());
     for (auto& tup : input_array_nodes) {
         size_t input_index = std::get<0>(tup);
@@ -1,7 +1,7 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
-#include <functional>
 #include <memory>
 #include <string>
 #include <tuple>
@@ -16,15 +16,21 @@
 #include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/graph.h"
+#include "chainerx/graph_arena.h"
 #include "chainerx/macro.h"
 #include "chainerx/shape.h"
+#include "chainerx/small_function.h"
 
 namespace chainerx {
 
 class BackwardContext;
 class Device;
 
-using BackwardFunction = std::function<void(BackwardContext&)>;
+// The size of the closures of backward functions that are stored without heap allocations.
+// It is large enough for a closure that captures a retained input or output token and a few scalars.
+constexpr size_t kBackwardFunctionInlineSize = 256;
+
+using BackwardFunction = SmallFunction<void(BackwardContext&), kBackwardFunctionInlineSize>;
 
 namespace internal {
 
@@ -43,13 +49,13 @@ struct ArrayProps {
 
 class OpNodeBackwardEntry {
 public:
-    OpNodeBackwardEntry(OpNode& op_node, std::vector<size_t> input_array_node_indices, BackwardFunction backward_func);
+    OpNodeBackwardEntry(OpNode& op_node, GraphArenaVector<size_t> input_array_node_indices, BackwardFunction backward_func);
 
     OpNode& op_node() const { return op_node_; }
 
     size_t input_array_node_count() const { return input_array_node_indices_.size(); }
 
-    const std::vector<size_t>& input_array_node_indices() const { return input_array_node_indices_; }
+    const GraphArenaVector<size_t>& input_array_node_indices() const { return input_array_node_indices_; }
 
     const BackwardFunction& backward_func() const { return backward_func_; }
 
@@ -60,7 +66,7 @@ private:
 
     // The index mapping from local (this backward function) to global (op node).
     // Can be unset if the input array does not require grad.
-    std::vector<size_t> input_array_node_indices_;
+    GraphArenaVector<size_t> input_array_node_indices_;
 
     BackwardFunction backward_func_;
 };
@@ -82,7 +88,7 @@ public:
     OpNode& operator=(OpNode&&) = delete;
 
     OpNodeBackwardEntry& RegisterBackwardFunction(
-            std::vector<std::tuple<size_t, std::shared_ptr<ArrayNode>>> input_array_nodes, BackwardFunction backward_func);
+            GraphArenaVector<std::tuple<size_t, std::shared_ptr<ArrayNode>>> input_array_nodes, BackwardFunction backward_func);
 
     // Adds links to input array nodes of other graphs.
     // The size of the vector must be equal to the number of inputs.
@@ -104,9 +110,9 @@ public:
 
     std::string name() const { return name_; }
 
-    std::vector<std::shared_ptr<ArrayNode>>& input_array_nodes();
+    GraphArenaVector<std::shared_ptr<ArrayNode>>& input_array_nodes();
 
-    const std::vector<std::shared_ptr<ArrayNode>>& input_array_nodes() const;
+    const GraphArenaVector<std::shared_ptr<ArrayNode>>& input_array_nodes() const;
 
     gsl::span<OpNodeBackwardEntry> backward_entries() { return backward_entries_; }
 
@@ -126,10 +132,10 @@ public:
     }
 
     // Returns the list of output array nodes on "this" graph.
-    const std::vector<nonstd::optional<std::weak_ptr<ArrayNode>>>& output_array_nodes() const { return output_array_nodes_; }
+    const GraphArenaVector<nonstd::optional<std::weak_ptr<ArrayNode>>>& output_array_nodes() const { return output_array_nodes_; }
 
     // Returns the list of output array nodes on "this" graph.
-    std::vector<nonstd::optional<std::weak_ptr<ArrayNode>>>& output_array_nodes() { return output_array_nodes_; }
+    GraphArenaVector<nonstd::optional<std::weak_ptr<ArrayNode>>>& output_array_nodes() { return output_array_nodes_; }
 
     // Returns the input array nodes of all graphs.
     const std::vector<std::tuple<BackpropId, std::vector<std::shared_ptr<ArrayNode>>>>& outer_graphs_input_array_nodes() const {
@@ -156,10 +162,10 @@ private:
     int64_t rank_{0};
 
     // List of input array nodes.
-    std::vector<std::shared_ptr<ArrayNode>> input_array_nodes_;
+    GraphArenaVector<std::shared_ptr<ArrayNode>> input_array_nodes_;
 
     // List of output array nodes of this graph.
-    std::vector<nonstd::optional<std::weak_ptr<ArrayNode>>> output_array_nodes_;
+    GraphArenaVector<nonstd::optional<std::weak_ptr<ArrayNode>>> output_array_nodes_;
 
     // List of input/output array nodes of outer graphs.
     // Outer graphs refer to graphs with lower ordinals.
@@ -168,9 +174,9 @@ private:
     std::vector<std::tuple<BackpropId, std::vector<std::shared_ptr<ArrayNode>>>> outer_graphs_output_array_nodes_;
 
     // Array props of output array nodes. This is used for creating dummy gradients.
-    std::vector<ArrayProps> output_array_props_;
+    GraphArenaVector<ArrayProps> output_array_props_;
 
-    std::vector<OpNodeBackwardEntry> backward_entries_;
+    GraphArenaVector<OpNodeBackwardEntry> backward_entries_;
 };
 
 }  // namespace internal
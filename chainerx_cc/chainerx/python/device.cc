@@ -6,6 +6,7 @@
 #include "chainerx/backend.h"
 #include "chainerx/context.h"
 #include "chainerx/device.h"
+#include "chainerx/memory_stats.h"
 
 #include "chainerx/python/common.h"
 
@@ -33,6 +34,30 @@ Device& GetDevice(py::handle handle) {
     throw py::type_error{"Device not understood: " + py::cast<std::string>(py::repr(handle))};
 }
 
+py::dict MemoryStatsToDict(const MemoryStats& stats) {
+    py::dict size_classes{};
+    for (const auto& pair : stats.size_classes) {
+        const MemoryStats::SizeClass& size_class = pair.second;
+        py::dict d{};
+        d["malloc_count"] = size_class.malloc_count;
+        d["hit_count"] = size_class.hit_count;
+        d["bytes_in_use"] = size_class.bytes_in_use;
+        d["bytes_cached"] = size_class.bytes_cached;
+        size_classes[py::int_(pair.first)] = d;
+    }
+
+    py::dict d{};
+    d["bytes_in_use"] = stats.bytes_in_use;
+    d["peak_bytes_in_use"] = stats.peak_bytes_in_use;
+    d["bytes_cached"] = stats.bytes_cached;
+    d["malloc_count"] = stats.malloc_count;
+    d["hit_count"] = stats.hit_count;
+    d["split_count"] = stats.split_count;
+    d["merge_count"] = stats.merge_count;
+    d["size_classes"] = size_classes;
+    return d;
+}
+
 class PyDeviceScope {
 public:
     explicit PyDeviceScope(Device& device) : device_{device} {}
@@ -67,6 +92,8 @@ void InitChainerxDevice(pybind11::module& m) {
     });
     c.def("__repr__", &Device::name);
     c.def("synchronize", &Device::Synchronize);
+    c.def("get_memory_stats", [](Device& self) { return MemoryStatsToDict(self.GetMemoryStats()); });
+    c.def("reset_peak_memory_stats", &Device::ResetPeakMemoryStats);
     c.def_property_readonly("name", &Device::name);
     c.def_property_readonly("backend", &Device::backend, py::return_value_policy::reference);
     c.def_property_readonly("context", &Device::context, py::return_value_policy::reference);
@@ -222,6 +222,10 @@ void InitChainerxCreation(pybind11::module& m) {
           py::arg("a"),
           py::arg("device") = nullptr);
     m.def("copy", [](const ArrayBodyPtr& a) { return MoveArrayBody(Copy(Array{a})); }, py::arg("a"));
+    m.def("copyto",
+          [](const ArrayBodyPtr& dst, const ArrayBodyPtr& src) { CopyTo(Array{dst}, Array{src}); },
+          py::arg("dst"),
+          py::arg("src"));
     m.def("frombuffer",
           &MakeArrayFromBuffer,
           py::arg("buffer"),
@@ -304,7 +308,17 @@ void InitChainerxIndexing(pybind11::module& m) {
 void InitChainerxLinalg(pybind11::module& m) {
     // linalg routines
     m.def("dot",
-          [](const ArrayBodyPtr& a, const ArrayBodyPtr& b) { return MoveArrayBody(Dot(Array{a}, Array{b})); },
+          [](const ArrayBodyPtr& a, const ArrayBodyPtr& b, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Dot(Array{a}, Array{b}, Array{*out}));
+              }
+              return MoveArrayBody(Dot(Array{a}, Array{b}));
+          },
+          py::arg("a"),
+          py::arg("b"),
+          py::arg("out") = nullptr);
+    m.def("matmul",
+          [](const ArrayBodyPtr& a, const ArrayBodyPtr& b) { return MoveArrayBody(Matmul(Array{a}, Array{b})); },
           py::arg("a"),
           py::arg("b"));
 }
@@ -498,40 +512,94 @@ void InitChainerxMath(pybind11::module& m) {
     // math routines
     m.def("negative", [](const ArrayBodyPtr& x) { return MoveArrayBody(Negative(Array{x})); }, py::arg("x"));
     m.def("add",
-          [](const ArrayBodyPtr& x1, const ArrayBodyPtr& x2) { return MoveArrayBody(Array{x1} + Array{x2}); },
+          [](const ArrayBodyPtr& x1, const ArrayBodyPtr& x2, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Add(Array{x1}, Array{x2}, Array{*out}));
+              }
+              return MoveArrayBody(Array{x1} + Array{x2});
+          },
           py::arg("x1"),
-          py::arg("x2"));
-    m.def("add", [](const ArrayBodyPtr& x1, Scalar x2) { return MoveArrayBody(Add(Array{x1}, x2)); }, py::arg("x1"), py::arg("x2"));
+          py::arg("x2"),
+          py::arg("out") = nullptr);
+    m.def("add",
+          [](const ArrayBodyPtr& x1, Scalar x2, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Add(Array{x1}, x2, Array{*out}));
+              }
+              return MoveArrayBody(Add(Array{x1}, x2));
+          },
+          py::arg("x1"),
+          py::arg("x2"),
+          py::arg("out") = nullptr);
     m.def("add", [](Scalar x1, const ArrayBodyPtr& x2) { return MoveArrayBody(Add(x1, Array{x2})); }, py::arg("x1"), py::arg("x2"));
     m.def("subtract",
-          [](const ArrayBodyPtr& x1, const ArrayBodyPtr& x2) { return MoveArrayBody(Array{x1} - Array{x2}); },
+          [](const ArrayBodyPtr& x1, const ArrayBodyPtr& x2, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Subtract(Array{x1}, Array{x2}, Array{*out}));
+              }
+              return MoveArrayBody(Array{x1} - Array{x2});
+          },
           py::arg("x1"),
-          py::arg("x2"));
+          py::arg("x2"),
+          py::arg("out") = nullptr);
     m.def("subtract",
-          [](const ArrayBodyPtr& x1, Scalar x2) { return MoveArrayBody(Subtract(Array{x1}, x2)); },
+          [](const ArrayBodyPtr& x1, Scalar x2, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Subtract(Array{x1}, x2, Array{*out}));
+              }
+              return MoveArrayBody(Subtract(Array{x1}, x2));
+          },
           py::arg("x1"),
-          py::arg("x2"));
+          py::arg("x2"),
+          py::arg("out") = nullptr);
     m.def("subtract",
           [](Scalar x1, const ArrayBodyPtr& x2) { return MoveArrayBody(Subtract(x1, Array{x2})); },
           py::arg("x1"),
           py::arg("x2"));
     m.def("multiply",
-          [](const ArrayBodyPtr& x1, const ArrayBodyPtr& x2) { return MoveArrayBody(Array{x1} * Array{x2}); },
+          [](const ArrayBodyPtr& x1, const ArrayBodyPtr& x2, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Multiply(Array{x1}, Array{x2}, Array{*out}));
+              }
+              return MoveArrayBody(Array{x1} * Array{x2});
+          },
           py::arg("x1"),
-          py::arg("x2"));
+          py::arg("x2"),
+          py::arg("out") = nullptr);
     m.def("multiply",
-          [](const ArrayBodyPtr& x1, Scalar x2) { return MoveArrayBody(Multiply(Array{x1}, x2)); },
+          [](const ArrayBodyPtr& x1, Scalar x2, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Multiply(Array{x1}, x2, Array{*out}));
+              }
+              return MoveArrayBody(Multiply(Array{x1}, x2));
+          },
           py::arg("x1"),
-          py::arg("x2"));
+          py::arg("x2"),
+          py::arg("out") = nullptr);
     m.def("multiply",
           [](Scalar x1, const ArrayBodyPtr& x2) { return MoveArrayBody(Multiply(x1, Array{x2})); },
           py::arg("x1"),
           py::arg("x2"));
     m.def("divide",
-          [](const ArrayBodyPtr& x1, const ArrayBodyPtr& x2) { return MoveArrayBody(Array{x1} / Array{x2}); },
+          [](const ArrayBodyPtr& x1, const ArrayBodyPtr& x2, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Divide(Array{x1}, Array{x2}, Array{*out}));
+              }
+              return MoveArrayBody(Array{x1} / Array{x2});
+          },
           py::arg("x1"),
-          py::arg("x2"));
-    m.def("divide", [](const ArrayBodyPtr& x1, Scalar x2) { return MoveArrayBody(Divide(Array{x1}, x2)); }, py::arg("x1"), py::arg("x2"));
+          py::arg("x2"),
+          py::arg("out") = nullptr);
+    m.def("divide",
+          [](const ArrayBodyPtr& x1, Scalar x2, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Divide(Array{x1}, x2, Array{*out}));
+              }
+              return MoveArrayBody(Divide(Array{x1}, x2));
+          },
+          py::arg("x1"),
+          py::arg("x2"),
+          py::arg("out") = nullptr);
     m.def("divide", [](Scalar x1, const ArrayBodyPtr& x2) { return MoveArrayBody(Divide(x1, Array{x2})); }, py::arg("x1"), py::arg("x2"));
     m.def("floor_divide",
           [](const ArrayBodyPtr& x1, const ArrayBodyPtr& x2) { return MoveArrayBody(FloorDivide(Array{x1}, Array{x2})); },
@@ -558,23 +626,52 @@ void InitChainerxMath(pybind11::module& m) {
           py::arg("x1"),
           py::arg("x2"));
     m.def("sum",
-          [](const ArrayBodyPtr& a, int8_t axis, bool keepdims) { return MoveArrayBody(Sum(Array{a}, Axes{axis}, keepdims)); },
+          [](const ArrayBodyPtr& a, int8_t axis, bool keepdims, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Sum(Array{a}, Axes{axis}, keepdims, Array{*out}));
+              }
+              return MoveArrayBody(Sum(Array{a}, Axes{axis}, keepdims));
+          },
           py::arg("a"),
           py::arg("axis"),
-          py::arg("keepdims") = false);
+          py::arg("keepdims") = false,
+          py::arg("out") = nullptr);
     m.def("sum",
-          [](const ArrayBodyPtr& a, const nonstd::optional<std::vector<int8_t>>& axis, bool keepdims) {
+          [](const ArrayBodyPtr& a,
+             const nonstd::optional<std::vector<int8_t>>& axis,
+             bool keepdims,
+             const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Sum(Array{a}, ToAxes(axis), keepdims, Array{*out}));
+              }
               return MoveArrayBody(Sum(Array{a}, ToAxes(axis), keepdims));
           },
           py::arg("a"),
           py::arg("axis") = nullptr,
-          py::arg("keepdims") = false);
+          py::arg("keepdims") = false,
+          py::arg("out") = nullptr);
     m.def("maximum", [](const ArrayBodyPtr& x1, Scalar x2) { return MoveArrayBody(Maximum(Array{x1}, x2)); }, py::arg("x1"), py::arg("x2"));
     m.def("maximum", [](Scalar x1, const ArrayBodyPtr& x2) { return MoveArrayBody(Maximum(x1, Array{x2})); }, py::arg("x1"), py::arg("x2"));
     m.def("minimum", [](const ArrayBodyPtr& x1, Scalar x2) { return MoveArrayBody(Minimum(Array{x1}, x2)); }, py::arg("x1"), py::arg("x2"));
     m.def("minimum", [](Scalar x1, const ArrayBodyPtr& x2) { return MoveArrayBody(Minimum(x1, Array{x2})); }, py::arg("x1"), py::arg("x2"));
-    m.def("exp", [](const ArrayBodyPtr& x) { return MoveArrayBody(Exp(Array{x})); }, py::arg("x"));
-    m.def("log", [](const ArrayBodyPtr& x) { return MoveArrayBody(Log(Array{x})); }, py::arg("x"));
+    m.def("exp",
+          [](const ArrayBodyPtr& x, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Exp(Array{x}, Array{*out}));
+              }
+              return MoveArrayBody(Exp(Array{x}));
+          },
+          py::arg("x"),
+          py::arg("out") = nullptr);
+    m.def("log",
+          [](const ArrayBodyPtr& x, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Log(Array{x}, Array{*out}));
+              }
+              return MoveArrayBody(Log(Array{x}));
+          },
+          py::arg("x"),
+          py::arg("out") = nullptr);
     m.def("logsumexp",
           [](const ArrayBodyPtr& x, int8_t axis, bool keepdims) { return MoveArrayBody(LogSumExp(Array{x}, Axes{axis}, keepdims)); },
           py::arg("x"),
@@ -597,8 +694,24 @@ void InitChainerxMath(pybind11::module& m) {
           },
           py::arg("x"),
           py::arg("axis") = nullptr);
-    m.def("sqrt", [](const ArrayBodyPtr& x) { return MoveArrayBody(Sqrt(Array{x})); }, py::arg("x"));
-    m.def("tanh", [](const ArrayBodyPtr& x) { return MoveArrayBody(Tanh(Array{x})); }, py::arg("x"));
+    m.def("sqrt",
+          [](const ArrayBodyPtr& x, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Sqrt(Array{x}, Array{*out}));
+              }
+              return MoveArrayBody(Sqrt(Array{x}));
+          },
+          py::arg("x"),
+          py::arg("out") = nullptr);
+    m.def("tanh",
+          [](const ArrayBodyPtr& x, const nonstd::optional<ArrayBodyPtr>& out) {
+              if (out.has_value()) {
+                  return MoveArrayBody(Tanh(Array{x}, Array{*out}));
+              }
+              return MoveArrayBody(Tanh(Array{x}));
+          },
+          py::arg("x"),
+          py::arg("out") = nullptr);
     m.def("isnan", [](const ArrayBodyPtr& x) { return MoveArrayBody(IsNan(Array{x})); }, py::arg("x"));
     m.def("isinf", [](const ArrayBodyPtr& x) { return MoveArrayBody(IsInf(Array{x})); }, py::arg("x"));
 }
@@ -22,6 +22,7 @@
 #include "chainerx/shape.h"
 #include "chainerx/strides.h"
 
+#include "chainerx/routines/routines_util.h"
 #include "chainerx/routines/type_util.h"
 
 namespace chainerx {
@@ -171,6 +172,28 @@ Array Copy(const Array& a) {
     return out;
 }
 
+void CopyTo(const Array& dst, const Array& src) {
+    internal::CheckOutArray(dst, dst.shape(), dst.dtype(), src.device(), {src}, true);
+
+    Array src_broadcast = src.shape() == dst.shape() ? src : src.BroadcastTo(dst.shape());
+    {
+        NoBackpropModeScope scope{};
+        if (src.dtype() == dst.dtype()) {
+            dst.device().Copy(src_broadcast, dst);
+        } else {
+            dst.device().AsType(src_broadcast, dst);
+        }
+    }
+
+    if (GetKind(dst.dtype()) == DtypeKind::kFloat) {
+        BackwardBuilder bb{"copyto", src_broadcast, dst};
+        if (BackwardBuilder::Target bt = bb.CreateTarget(0)) {
+            bt.Define([src_dtype = src.dtype()](BackwardContext& bctx) { bctx.input_grad() = bctx.output_grad()->AsType(src_dtype); });
+        }
+        bb.Finalize();
+    }
+}
+
 // Creates the identity array.
 Array Identity(int64_t n, Dtype dtype, Device& device) {
     if (n < 0) {
@@ -80,6 +80,11 @@ Array OnesLike(const Array& a, Device& device = GetDefaultDevice());
 // It will be always C-contiguous.
 Array Copy(const Array& a);
 
+// Copies the elements of src to dst, casting them to the dtype of dst and broadcasting src to the shape of dst, as numpy.copyto.
+// dst is connected to the graphs of src if its dtype is a floating point type. It must be on the device of src and must not overlap src in
+// memory unless they are identical views.
+void CopyTo(const Array& dst, const Array& src);
+
 // Creates the identity array.
 Array Identity(int64_t n, Dtype dtype, Device& device = GetDefaultDevice());
 
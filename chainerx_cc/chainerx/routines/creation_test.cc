@@ -11,6 +11,7 @@
 #include <nonstd/optional.hpp>
 
 #include "chainerx/array.h"
+#include "chainerx/array_index.h"
 #include "chainerx/check_backward.h"
 #include "chainerx/device.h"
 #include "chainerx/device_id.h"
@@ -18,6 +19,7 @@
 #include "chainerx/routines/type_util.h"
 #include "chainerx/scalar.h"
 #include "chainerx/shape.h"
+#include "chainerx/slice.h"
 #include "chainerx/testing/array.h"
 #include "chainerx/testing/array_check.h"
 #include "chainerx/testing/device_session.h"
@@ -661,6 +663,45 @@ TEST_P(CreationTest, Copy) {
     });
 }
 
+TEST_P(CreationTest, CopyTo) {
+    Array src = testing::BuildArray({3}).WithData<int32_t>({1, 2, 3});
+    Array dst_base = Zeros({2, 3, 2}, Dtype::kFloat32);
+    Array dst = dst_base.At({Slice{}, Slice{}, 1});
+    CopyTo(dst, src);
+    Array e = testing::BuildArray({2, 3, 2}).WithData<float>({0, 1, 0, 2, 0, 3, 0, 1, 0, 2, 0, 3});
+    EXPECT_ARRAY_EQ(e, dst_base);
+}
+
+TEST_P(CreationTest, CopyToSameDtype) {
+    Array src = testing::BuildArray({2, 3}).WithLinearData<int64_t>().WithPadding(1);
+    Array dst = Empty({2, 3}, Dtype::kInt64);
+    CopyTo(dst, src);
+    EXPECT_ARRAY_EQ(src, dst);
+}
+
+TEST_P(CreationTest, CopyToInvalid) {
+    Array src = testing::BuildArray({2, 3}).WithLinearData<float>();
+    EXPECT_THROW(CopyTo(Empty({3, 2}, Dtype::kFloat32), src), DimensionError);
+    EXPECT_THROW(CopyTo(src.At({Slice{}, Slice{1, 3}}), src.At({Slice{}, Slice{0, 2}})), ChainerxError);
+}
+
+TEST_P(CreationTest, CopyToBackward) {
+    using T = double;
+    Array src = (*testing::BuildArray({3}).WithLinearData<T>(-1).WithPadding(1)).RequireGrad();
+    Array go = testing::BuildArray({2, 3}).WithLinearData<T>(-0.3, 0.1);
+    Array eps = Full({3}, 1e-3, Dtype::kFloat64);
+
+    CheckBackward(
+            [](const std::vector<Array>& xs) -> std::vector<Array> {
+                Array dst = Empty({2, 3}, Dtype::kFloat64);
+                CopyTo(dst, xs[0]);
+                return {dst};
+            },
+            {src},
+            {go},
+            {eps});
+}
+
 TEST_P(CreationTest, Identity) {
     testing::RunTestWithThreads([]() {
         Array o = Identity(3, Dtype::kFloat32);
@@ -9,13 +9,18 @@
 #include <nonstd/optional.hpp>
 
 #include "chainerx/array.h"
+#include "chainerx/axes.h"
 #include "chainerx/backprop_mode.h"
 #include "chainerx/backward_builder.h"
 #include "chainerx/backward_context.h"
+#include "chainerx/device.h"
 #include "chainerx/dtype.h"
 #include "chainerx/error.h"
 #include "chainerx/graph.h"
+#include "chainerx/macro.h"
 #include "chainerx/routines/creation.h"
+#include "chainerx/routines/math.h"
+#include "chainerx/routines/routines_util.h"
 #include "chainerx/routines/type_util.h"
 #include "chainerx/shape.h"
 
@@ -83,4 +88,172 @@ Array Dot(const Array& a, const Array& b, nonstd::optional<Dtype> out_dtype) {
     return out_matrix.Reshape(out_shape);
 }
 
+Array Dot(const Array& a, const Array& b, const Array& out) {
+    Dtype out_dtype = ResultType(a, b);
+
+    if (a.ndim() == 0 || b.ndim() == 0) {
+        const Array& a_cast = a.dtype() == out_dtype ? a : a.AsType(out_dtype);
+        const Array& b_cast = b.dtype() == out_dtype ? b : b.AsType(out_dtype);
+        return Multiply(a_cast, b_cast, out);
+    }
+
+    if (b.ndim() > 2) {
+        throw NotImplementedError{"dot does not support rhs operand with ndim > 2"};
+    }
+
+    Shape out_shape{};
+    std::copy(a.shape().begin(), a.shape().end() - 1, std::back_inserter(out_shape));
+    std::copy(b.shape().begin() + 1, b.shape().end(), std::back_inserter(out_shape));
+
+    int64_t k = a.shape()[a.ndim() - 1];
+    if (b.shape()[0] != k) {
+        throw DimensionError{"Axis dimension mismatch"};
+    }
+    // Each element of out is computed from multiple elements of the inputs, so out must not overlap them even if identical.
+    internal::CheckOutArray(out, out_shape, out_dtype, a.device(), {a, b}, false);
+
+    Device& device = a.device();
+    if (k == 0) {
+        NoBackpropModeScope scope{};
+        device.Fill(out, 0);
+        return out;
+    }
+
+    int64_t m = a.GetTotalSize() / k;
+    int64_t n = b.GetTotalSize() / k;
+    {
+        NoBackpropModeScope scope{};
+        Array a_matrix = a.Reshape({m, k});
+        Array b_matrix = b.Reshape({k, n});
+        if (out.IsContiguous()) {
+            device.Dot(a_matrix, b_matrix, out.Reshape({m, n}));
+        } else {
+            Array out_matrix = Empty({m, n}, out_dtype, device);
+            device.Dot(a_matrix, b_matrix, out_matrix);
+            device.Copy(out_matrix.Reshape(out_shape), out);
+        }
+    }
+
+    {
+        BackwardBuilder bb{"dot", {a, b}, out};
+        if (BackwardBuilder::Target bt = bb.CreateTarget(0)) {
+            bt.Define([b_tok = bb.RetainInput(1), a_shape = a.shape(), a_dtype = a.dtype(), m, k, n](BackwardContext& bctx) {
+                const Array& b = bctx.GetRetainedInput(b_tok);
+                Array gout = bctx.output_grad()->Reshape({m, n});
+                bctx.input_grad() = Dot(gout, b.Reshape({k, n}).Transpose(), a_dtype).Reshape(a_shape);
+            });
+        }
+        if (BackwardBuilder::Target bt = bb.CreateTarget(1)) {
+            bt.Define([a_tok = bb.RetainInput(0), b_shape = b.shape(), b_dtype = b.dtype(), m, k, n](BackwardContext& bctx) {
+                const Array& a = bctx.GetRetainedInput(a_tok);
+                Array gout = bctx.output_grad()->Reshape({m, n});
+                bctx.input_grad() = Dot(a.Reshape({m, k}).Transpose(), gout, b_dtype).Reshape(b_shape);
+            });
+        }
+        bb.Finalize();
+    }
+
+    return out;
+}
+
+namespace {
+
+// Swaps the last two axes.
+Array TransposeMatrices(const Array& a) {
+    Axes axes{};
+    for (int8_t i = 0; i < a.ndim(); ++i) {
+        axes.emplace_back(i);
+    }
+    std::swap(axes[a.ndim() - 2], axes[a.ndim() - 1]);
+    return a.Transpose(axes);
+}
+
+// Computes the batched matrix product of a and b, whose batch axes are the same.
+Array BatchMatmul(const Array& a, const Array& b, Dtype out_dtype) {
+    CHAINERX_ASSERT(a.ndim() >= 2);
+    CHAINERX_ASSERT(a.ndim() == b.ndim());
+
+    Shape out_shape{a.shape().begin(), a.shape().end() - 1};
+    out_shape.emplace_back(b.shape().back());
+
+    if (a.shape().back() == 0) {
+        return Zeros(out_shape, out_dtype, a.device());
+    }
+
+    Array out = Empty(out_shape, out_dtype, a.device());
+    {
+        NoBackpropModeScope scope{};
+        a.device().BatchDot(a, b, out);
+    }
+
+    {
+        BackwardBuilder bb{"matmul", {a, b}, out};
+        if (BackwardBuilder::Target bt = bb.CreateTarget(0)) {
+            bt.Define([b_tok = bb.RetainInput(1), a_dtype = a.dtype()](BackwardContext& bctx) {
+                const Array& b = bctx.GetRetainedInput(b_tok);
+                const Array& gout = *bctx.output_grad();
+                bctx.input_grad() = BatchMatmul(gout, TransposeMatrices(b), a_dtype);
+            });
+        }
+        if (BackwardBuilder::Target bt = bb.CreateTarget(1)) {
+            bt.Define([a_tok = bb.RetainInput(0), b_dtype = b.dtype()](BackwardContext& bctx) {
+                const Array& a = bctx.GetRetainedInput(a_tok);
+                const Array& gout = *bctx.output_grad();
+                bctx.input_grad() = BatchMatmul(TransposeMatrices(a), gout, b_dtype);
+            });
+        }
+        bb.Finalize();
+    }
+
+    return out;
+}
+
+}  // namespace
+
+Array Matmul(const Array& a, const Array& b) {
+    if (a.ndim() == 0 || b.ndim() == 0) {
+        throw DimensionError{"matmul does not support 0-dimensional operands"};
+    }
+
+    Dtype out_dtype = ResultType(a, b);
+
+    // Promote vectors to matrices.
+    Array a_matrix = a.ndim() == 1 ? a.Reshape({1, a.shape()[0]}) : a;
+    Array b_matrix = b.ndim() == 1 ? b.Reshape({b.shape()[0], 1}) : b;
+
+    int64_t m = a_matrix.shape()[a_matrix.ndim() - 2];
+    int64_t k = a_matrix.shape()[a_matrix.ndim() - 1];
+    int64_t n = b_matrix.shape()[b_matrix.ndim() - 1];
+    if (b_matrix.shape()[b_matrix.ndim() - 2] != k) {
+        throw DimensionError{"Axis dimension mismatch"};
+    }
+
+    // Broadcast the batch axes. Broadcast operands are views, which are not copied by BatchDot.
+    Shape batch_shape = internal::BroadcastShapes(
+            Shape{a_matrix.shape().begin(), a_matrix.shape().end() - 2}, Shape{b_matrix.shape().begin(), b_matrix.shape().end() - 2});
+    Shape a_shape = batch_shape;
+    a_shape.emplace_back(m);
+    a_shape.emplace_back(k);
+    Shape b_shape = batch_shape;
+    b_shape.emplace_back(k);
+    b_shape.emplace_back(n);
+    Array out = BatchMatmul(
+            a_matrix.shape() == a_shape ? a_matrix : a_matrix.BroadcastTo(a_shape),
+            b_matrix.shape() == b_shape ? b_matrix : b_matrix.BroadcastTo(b_shape),
+            out_dtype);
+
+    // Remove the axes added to the vectors.
+    if (a.ndim() == 1 || b.ndim() == 1) {
+        Shape out_shape = batch_shape;
+        if (a.ndim() != 1) {
+            out_shape.emplace_back(m);
+        }
+        if (b.ndim() != 1) {
+            out_shape.emplace_back(n);
+        }
+        return out.Reshape(out_shape);
+    }
+    return out;
+}
+
 }  // namespace chainerx
@@ -9,4 +9,14 @@ namespace chainerx {
 
 Array Dot(const Array& a, const Array& b, nonstd::optional<Dtype> out_dtype = nonstd::nullopt);
 
+// Stores the result to out and returns it. out must have the shape and the dtype of the result, be on the device of the inputs and must
+// not overlap the inputs in memory.
+Array Dot(const Array& a, const Array& b, const Array& out);
+
+// Returns the matrix product of a and b, following the semantics of numpy.matmul.
+//
+// Arrays with more than 2 dimensions are treated as stacks of matrices residing in the last two axes, and the leading batch axes are
+// broadcast. A 1-dimensional a (or b) is promoted to a matrix by prepending (or appending) an axis, which is removed after the product.
+Array Matmul(const Array& a, const Array& b);
+
 }  // namespace chainerx
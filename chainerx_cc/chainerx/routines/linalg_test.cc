@@ -7,10 +7,13 @@
 #include <nonstd/optional.hpp>
 
 #include "chainerx/array.h"
+#include "chainerx/array_index.h"
 #include "chainerx/check_backward.h"
 #include "chainerx/device_id.h"
 #include "chainerx/dtype.h"
 #include "chainerx/error.h"
+#include "chainerx/routines/creation.h"
+#include "chainerx/slice.h"
 #include "chainerx/testing/array.h"
 #include "chainerx/testing/array_check.h"
 #include "chainerx/testing/device_session.h"
@@ -118,6 +121,140 @@ TEST_P(LinalgTest, DotDoubleBackward) {
             {a_eps, b_eps, go_eps});
 }
 
+TEST_P(LinalgTest, DotOut) {
+    Array a = testing::BuildArray({2, 3}).WithLinearData(1.f).WithPadding(1);
+    Array b = testing::BuildArray({3, 2}).WithData<float>({1.f, 2.f, -1.f, -3.f, 2.f, 4.f}).WithPadding(2);
+    Array out = Empty({2, 2}, Dtype::kFloat32);
+    Array c = Dot(a, b, out);
+    EXPECT_EQ(internal::GetArrayBody(out), internal::GetArrayBody(c));
+    EXPECT_ARRAY_EQ(testing::BuildArray({2, 2}).WithData<float>({5.f, 8.f, 11.f, 17.f}), out);
+}
+
+TEST_P(LinalgTest, DotOutNonContiguous) {
+    Array a = testing::BuildArray({2, 3}).WithLinearData(1.f);
+    Array b = testing::BuildArray({3}).WithLinearData(1.f, 2.f);
+    Array out_base = Zeros({2, 2}, Dtype::kFloat32);
+    Dot(a, b, out_base.At({Slice{}, 1}));
+    EXPECT_ARRAY_EQ(testing::BuildArray({2, 2}).WithData<float>({0.f, 22.f, 0.f, 49.f}), out_base);
+}
+
+TEST_P(LinalgTest, DotOutZeroDim) {
+    Array a = testing::BuildArray({2, 3}).WithLinearData<float>(1.f);
+    Array b = testing::BuildArray({}).WithData<float>({2.f});
+    Array out = Empty({2, 3}, Dtype::kFloat32);
+    Dot(a, b, out);
+    EXPECT_ARRAY_EQ(testing::BuildArray({2, 3}).WithLinearData(2.f, 2.f), out);
+}
+
+TEST_P(LinalgTest, DotOutAlongZeroLengthAxis) {
+    Array a = Empty({2, 0}, Dtype::kFloat32);
+    Array b = Empty({0, 2}, a.dtype());
+    Array out = Full({2, 2}, 1.f);
+    Dot(a, b, out);
+    EXPECT_ARRAY_EQ(Zeros({2, 2}, a.dtype()), out);
+}
+
+TEST_P(LinalgTest, DotOutInvalid) {
+    Array a = testing::BuildArray({2, 2}).WithLinearData(1.f);
+    Array b = testing::BuildArray({2, 2}).WithLinearData(2.f);
+    EXPECT_THROW(Dot(a, b, Empty({2, 3}, Dtype::kFloat32)), DimensionError);
+    EXPECT_THROW(Dot(a, b, Empty({2, 2}, Dtype::kFloat64)), DtypeError);
+    // Unlike elementwise routines, the output cannot be identical to an input.
+    EXPECT_THROW(Dot(a, b, a), ChainerxError);
+}
+
+TEST_P(LinalgTest, DotOutBackward) {
+    Array a = (*testing::BuildArray({2, 3}).WithLinearData(1.f)).RequireGrad();
+    Array b = (*testing::BuildArray({3}).WithData<float>({1.f, 2.f, -1.f})).RequireGrad();
+
+    Array go = testing::BuildArray({2}).WithData<float>({-0.1f, 0.1f}).WithPadding(1);
+    Array a_eps = Full(a.shape(), 1e-1f);
+    Array b_eps = Full(b.shape(), 1e-1f);
+
+    CheckBackward(
+            [](const std::vector<Array>& xs) -> std::vector<Array> { return {Dot(xs[0], xs[1], Empty({2}, Dtype::kFloat32))}; },
+            {a, b},
+            {go},
+            {a_eps, b_eps});
+}
+
+TEST_P(LinalgTest, Matmul) {
+    Array a = testing::BuildArray({2, 2, 3}).WithLinearData(1.f).WithPadding(1);
+    Array b = testing::BuildArray({3, 2}).WithData<float>({1.f, 2.f, -1.f, -3.f, 2.f, 4.f});
+    Array c = Matmul(a, b);
+    Array e = testing::BuildArray({2, 2, 2}).WithData<float>({5.f, 8.f, 11.f, 17.f, 17.f, 26.f, 23.f, 35.f});
+    EXPECT_ARRAY_EQ(e, c);
+}
+
+TEST_P(LinalgTest, MatmulBroadcastBatch) {
+    Array a = testing::BuildArray({2, 1, 1, 3}).WithLinearData(1.f);
+    Array b = testing::BuildArray({2, 3, 2}).WithLinearData(0.f);
+    Array c = Matmul(a, b);
+    Array e = testing::BuildArray({2, 2, 1, 2}).WithData<float>({16.f, 22.f, 52.f, 58.f, 34.f, 49.f, 124.f, 139.f});
+    EXPECT_ARRAY_EQ(e, c);
+}
+
+TEST_P(LinalgTest, MatmulTransposedBatch) {
+    Array a = (*testing::BuildArray({2, 3, 2}).WithLinearData(1.f)).Transpose({0, 2, 1});
+    Array b = testing::BuildArray({3, 2}).WithData<float>({1.f, 2.f, -1.f, -3.f, 2.f, 4.f});
+    Array c = Matmul(a, b);
+    Array e = Matmul(a.Copy(), b);
+    EXPECT_ARRAY_EQ(e, c);
+}
+
+TEST_P(LinalgTest, MatmulMatVec) {
+    Array a = testing::BuildArray({2, 2, 3}).WithLinearData(1.f);
+    Array b = testing::BuildArray({3}).WithLinearData(1.f);
+    Array c = Matmul(a, b);
+    Array e = testing::BuildArray({2, 2}).WithData<float>({14.f, 32.f, 50.f, 68.f});
+    EXPECT_ARRAY_EQ(e, c);
+}
+
+TEST_P(LinalgTest, MatmulVecMat) {
+    Array a = testing::BuildArray({3}).WithLinearData(1.f);
+    Array b = testing::BuildArray({2, 3, 2}).WithLinearData(0.f);
+    Array c = Matmul(a, b);
+    Array e = testing::BuildArray({2, 2}).WithData<float>({16.f, 22.f, 52.f, 58.f});
+    EXPECT_ARRAY_EQ(e, c);
+}
+
+TEST_P(LinalgTest, MatmulInvalidShape) {
+    Array a = testing::BuildArray({2, 2, 3}).WithLinearData(1.f);
+    Array b = testing::BuildArray({3, 2, 2}).WithLinearData(1.f);
+    EXPECT_THROW(Matmul(a, b), DimensionError);
+    EXPECT_THROW(Matmul(a, testing::BuildArray({2, 2}).WithLinearData(1.f)), DimensionError);
+    EXPECT_THROW(Matmul(a, testing::BuildArray({}).WithData<float>({1.f})), DimensionError);
+}
+
+TEST_P(LinalgTest, MatmulBackward) {
+    Array a = (*testing::BuildArray({2, 1, 2, 3}).WithLinearData(1.f)).RequireGrad();
+    Array b = (*testing::BuildArray({3, 3, 2}).WithLinearData(-1.f, 0.5f).WithPadding(1)).RequireGrad();
+    Array go = testing::BuildArray({2, 3, 2, 2}).WithLinearData(-0.1f, 0.1f).WithPadding(1);
+    Array a_eps = Full(a.shape(), 1e-1f);
+    Array b_eps = Full(b.shape(), 1e-1f);
+
+    CheckBackward([](const std::vector<Array>& xs) -> std::vector<Array> { return {Matmul(xs[0], xs[1])}; }, {a, b}, {go}, {a_eps, b_eps});
+}
+
+TEST_P(LinalgTest, MatmulDoubleBackward) {
+    Array a = (*testing::BuildArray({2, 2, 3}).WithLinearData(1.f)).RequireGrad();
+    Array b = (*testing::BuildArray({3, 2}).WithData<float>({1.f, 2.f, -1.f, -3.f, 2.f, 4.f})).RequireGrad();
+    Array go = (*testing::BuildArray({2, 2, 2}).WithLinearData(-0.1f, 0.1f).WithPadding(1)).RequireGrad();
+
+    Array gga = testing::BuildArray(a.shape()).WithLinearData(-0.3f, 0.1f).WithPadding(1);
+    Array ggb = testing::BuildArray(b.shape()).WithLinearData(-0.2f, 0.1f).WithPadding(1);
+    Array a_eps = Full(a.shape(), 1e-1f);
+    Array b_eps = Full(b.shape(), 1e-1f);
+    Array go_eps = Full(go.shape(), 1e-1f);
+
+    CheckDoubleBackwardComputation(
+            [](const std::vector<Array>& xs) -> std::vector<Array> { return {Matmul(xs[0], xs[1])}; },
+            {a, b},
+            {go},
+            {gga, ggb},
+            {a_eps, b_eps, go_eps});
+}
+
 INSTANTIATE_TEST_CASE_P(
         ForEachBackend,
         LinalgTest,
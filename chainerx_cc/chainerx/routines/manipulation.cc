@@ -35,6 +35,9 @@ Scalar AsScalar(const Array& a) {
         throw DimensionError{"Cannot convert an array of size ", a.GetTotalSize(), " to a scalar, size must be 1."};
     }
 
+    // Complete the pending operations of the device, e.g. those deferred by native::FusionScope, before the value is read.
+    a.device().Synchronize();
+
     // Copy to the native device
     Array native_copy = a.ToNative();
 
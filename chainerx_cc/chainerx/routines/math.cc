@@ -81,6 +81,24 @@ void BinaryInPlace(Impl&& impl, const Array& x1, Scalar x2) {
     impl(x1, x2, x1);
 }
 
+// Called from Add, Subtract, Multiply, Divide, etc. given an output array to handle broadcasting.
+template <typename Impl>
+Array BroadcastBinaryOut(Impl&& impl, const Array& x1, const Array& x2, const Array& out) {
+    Shape result_shape = x1.shape() == x2.shape() ? x1.shape() : internal::BroadcastShapes(x1.shape(), x2.shape());
+    internal::CheckOutArray(out, result_shape, x1.dtype(), x1.device(), {x1, x2}, true);
+    impl(x1.shape() == result_shape ? x1 : x1.BroadcastTo(result_shape),
+         x2.shape() == result_shape ? x2 : x2.BroadcastTo(result_shape),
+         out);
+    return out;
+}
+
+template <typename Impl>
+Array BinaryOut(Impl&& impl, const Array& x1, Scalar x2, const Array& out) {
+    internal::CheckOutArray(out, x1.shape(), x1.dtype(), x1.device(), {x1}, true);
+    impl(x1, x2, out);
+    return out;
+}
+
 void AddImpl(const Array& x1, const Array& x2, const Array& out) {
     // TODO(sonots): dtype conversion
     CheckEqual(x1.dtype(), x2.dtype());
@@ -132,6 +150,10 @@ Array Add(const Array& x1, const Array& x2) { return BroadcastBinary(&AddImpl, x
 
 Array Add(const Array& x1, Scalar x2) { return Binary(&AddASImpl, x1, x2); }
 
+Array Add(const Array& x1, const Array& x2, const Array& out) { return BroadcastBinaryOut(&AddImpl, x1, x2, out); }
+
+Array Add(const Array& x1, Scalar x2, const Array& out) { return BinaryOut(&AddASImpl, x1, x2, out); }
+
 Array Add(Scalar x1, const Array& x2) { return Add(x2, x1); }
 
 namespace {
@@ -193,6 +215,10 @@ Array Subtract(const Array& x1, const Array& x2) { return BroadcastBinary(&Subtr
 
 Array Subtract(const Array& x1, Scalar x2) { return Binary(&SubtractASImpl, x1, x2); }
 
+Array Subtract(const Array& x1, const Array& x2, const Array& out) { return BroadcastBinaryOut(&SubtractImpl, x1, x2, out); }
+
+Array Subtract(const Array& x1, Scalar x2, const Array& out) { return BinaryOut(&SubtractASImpl, x1, x2, out); }
+
 Array Subtract(Scalar x1, const Array& x2) { return Add(-x2, x1); }
 
 namespace {
@@ -254,6 +280,10 @@ Array Multiply(const Array& x1, const Array& x2) { return BroadcastBinary(&Multi
 
 Array Multiply(const Array& x1, Scalar x2) { return Binary(&MultiplyASImpl, x1, x2); }
 
+Array Multiply(const Array& x1, const Array& x2, const Array& out) { return BroadcastBinaryOut(&MultiplyImpl, x1, x2, out); }
+
+Array Multiply(const Array& x1, Scalar x2, const Array& out) { return BinaryOut(&MultiplyASImpl, x1, x2, out); }
+
 Array Multiply(Scalar x1, const Array& x2) { return Multiply(x2, x1); }
 
 namespace {
@@ -379,29 +409,42 @@ Array Divide(const Array& x1, Scalar x2) { return TrueDivide(x1, x2); }
 
 Array Divide(Scalar x1, const Array& x2) { return TrueDivide(x1, x2); }
 
+Array Divide(const Array& x1, const Array& x2, const Array& out) {
+    if (GetKind(x1.dtype()) == DtypeKind::kFloat) {
+        return BroadcastBinaryOut(&DivideImpl, x1, x2, out);
+    }
+    CheckEqual(x1.dtype(), x2.dtype());
+    return BroadcastBinaryOut(&DivideImpl, x1.AsType(Dtype::kFloat64), x2.AsType(Dtype::kFloat64), out);
+}
+
+Array Divide(const Array& x1, Scalar x2, const Array& out) {
+    if (GetKind(x1.dtype()) == DtypeKind::kFloat) {
+        return BinaryOut(&DivideASImpl, x1, x2, out);
+    }
+    return BinaryOut(&DivideASImpl, x1.AsType(Dtype::kFloat64), Scalar{static_cast<double>(x2)}, out);
+}
+
 Array Reciprocal(const Array& x) {
     // TODO(hvy): Optimize the implementation using e.g. 1 / x.
     return OnesLike(x, x.device()) / x;
 }
 
-Array Sum(const Array& a, const OptionalAxes& axis, bool keepdims) {
-    Axes sorted_axis = internal::GetSortedAxesOrAll(axis, a.ndim());
+namespace {
 
-    // Decide the output dtype for integral input dtype.
-    Dtype out_dtype{};
-    switch (GetKind(a.dtype())) {
+// Returns the output dtype of Sum, which differs from the input dtype for integral input dtypes.
+Dtype GetSumResultDtype(Dtype dtype) {
+    switch (GetKind(dtype)) {
         case DtypeKind::kBool:
         case DtypeKind::kInt:  // fallthrough
-            out_dtype = Dtype::kInt64;
-            break;
+            return Dtype::kInt64;
         case DtypeKind::kUInt:
-            out_dtype = Dtype::kInt64;  // TODO(niboshi): This should be kUInt64
-            break;
+            return Dtype::kInt64;  // TODO(niboshi): This should be kUInt64
         default:
-            out_dtype = a.dtype();
+            return dtype;
     }
+}
 
-    Array out = internal::EmptyReduced(a.shape(), out_dtype, sorted_axis, keepdims, a.device());
+void SumImpl(const Array& a, const Axes& sorted_axis, bool keepdims, const Array& out) {
     {
         NoBackpropModeScope scope{};
         a.device().Sum(a, sorted_axis, out);
@@ -425,6 +468,22 @@ Array Sum(const Array& a, const OptionalAxes& axis, bool keepdims) {
         });
     }
     bb.Finalize();
+}
+
+}  // namespace
+
+Array Sum(const Array& a, const OptionalAxes& axis, bool keepdims) {
+    Axes sorted_axis = internal::GetSortedAxesOrAll(axis, a.ndim());
+    Array out = internal::EmptyReduced(a.shape(), GetSumResultDtype(a.dtype()), sorted_axis, keepdims, a.device());
+    SumImpl(a, sorted_axis, keepdims, out);
+    return out;
+}
+
+Array Sum(const Array& a, const OptionalAxes& axis, bool keepdims, const Array& out) {
+    Axes sorted_axis = internal::GetSortedAxesOrAll(axis, a.ndim());
+    Shape out_shape = internal::ReduceShape(a.shape(), sorted_axis, keepdims);
+    internal::CheckOutArray(out, out_shape, GetSumResultDtype(a.dtype()), a.device(), {a}, false);
+    SumImpl(a, sorted_axis, keepdims, out);
     return out;
 }
 
@@ -544,10 +603,9 @@ Array Minimum(const Array& x1, Scalar x2) {
 
 Array Minimum(Scalar x1, const Array& x2) { return Minimum(x2, x1); }
 
-Array Exp(const Array& x) {
-    Dtype dtype = GetMathResultDtype(x.dtype());
-    Array out = Empty(x.shape(), dtype, x.device());
+namespace {
 
+void ExpImpl(const Array& x, const Array& out) {
     {
         NoBackpropModeScope scope{};
         x.device().Exp(x, out);
@@ -561,14 +619,25 @@ Array Exp(const Array& x) {
         });
     }
     bb.Finalize();
+}
+
+}  // namespace
 
+Array Exp(const Array& x) {
+    Array out = Empty(x.shape(), GetMathResultDtype(x.dtype()), x.device());
+    ExpImpl(x, out);
     return out;
 }
 
-Array Log(const Array& x) {
-    Dtype dtype = GetMathResultDtype(x.dtype());
-    Array out = Empty(x.shape(), dtype, x.device());
+Array Exp(const Array& x, const Array& out) {
+    internal::CheckOutArray(out, x.shape(), GetMathResultDtype(x.dtype()), x.device(), {x}, true);
+    ExpImpl(x, out);
+    return out;
+}
 
+namespace {
+
+void LogImpl(const Array& x, const Array& out) {
     {
         NoBackpropModeScope scope{};
         x.device().Log(x, out);
@@ -582,7 +651,19 @@ Array Log(const Array& x) {
         });
     }
     bb.Finalize();
+}
+
+}  // namespace
 
+Array Log(const Array& x) {
+    Array out = Empty(x.shape(), GetMathResultDtype(x.dtype()), x.device());
+    LogImpl(x, out);
+    return out;
+}
+
+Array Log(const Array& x, const Array& out) {
+    internal::CheckOutArray(out, x.shape(), GetMathResultDtype(x.dtype()), x.device(), {x}, true);
+    LogImpl(x, out);
     return out;
 }
 
@@ -605,10 +686,9 @@ Array LogSoftmax(const Array& x, const OptionalAxes& axis) {
     return x_cast - LogSumExp(x_cast, axis.has_value() ? axis : OptionalAxes{1}, true);
 }
 
-Array Sqrt(const Array& x) {
-    Dtype dtype = GetMathResultDtype(x.dtype());
-    Array out = Empty(x.shape(), dtype, x.device());
+namespace {
 
+void SqrtImpl(const Array& x, const Array& out) {
     {
         NoBackpropModeScope scope{};
         x.device().Sqrt(x, out);
@@ -623,14 +703,25 @@ Array Sqrt(const Array& x) {
         });
     }
     bb.Finalize();
+}
+
+}  // namespace
 
+Array Sqrt(const Array& x) {
+    Array out = Empty(x.shape(), GetMathResultDtype(x.dtype()), x.device());
+    SqrtImpl(x, out);
     return out;
 }
 
-Array Tanh(const Array& x) {
-    Dtype dtype = GetMathResultDtype(x.dtype());
-    Array out = Empty(x.shape(), dtype, x.device());
+Array Sqrt(const Array& x, const Array& out) {
+    internal::CheckOutArray(out, x.shape(), GetMathResultDtype(x.dtype()), x.device(), {x}, true);
+    SqrtImpl(x, out);
+    return out;
+}
 
+namespace {
+
+void TanhImpl(const Array& x, const Array& out) {
     {
         NoBackpropModeScope scope{};
         x.device().Tanh(x, out);
@@ -645,7 +736,19 @@ Array Tanh(const Array& x) {
         });
     }
     bb.Finalize();
+}
+
+}  // namespace
+
+Array Tanh(const Array& x) {
+    Array out = Empty(x.shape(), GetMathResultDtype(x.dtype()), x.device());
+    TanhImpl(x, out);
+    return out;
+}
 
+Array Tanh(const Array& x, const Array& out) {
+    internal::CheckOutArray(out, x.shape(), GetMathResultDtype(x.dtype()), x.device(), {x}, true);
+    TanhImpl(x, out);
     return out;
 }
 
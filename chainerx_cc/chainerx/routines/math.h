@@ -23,6 +23,12 @@ Array Add(const Array& x1, const Array& x2);
 Array Add(const Array& x1, Scalar x2);
 Array Add(Scalar x1, const Array& x2);
 
+// Overloads taking out store the result to out and return it, like the out argument of NumPy routines, so that loops can reuse arrays
+// instead of allocating new ones. out must have the shape and the dtype of the result and be on the device of the inputs. Elementwise
+// routines allow an input identical to out, i.e. a view of the same elements; out must not overlap the inputs in memory otherwise.
+Array Add(const Array& x1, const Array& x2, const Array& out);
+Array Add(const Array& x1, Scalar x2, const Array& out);
+
 namespace internal {
 
 void ISubtract(const Array& x1, const Array& x2);
@@ -33,6 +39,8 @@ void ISubtract(const Array& x1, Scalar x2);
 Array Subtract(const Array& x1, const Array& x2);
 Array Subtract(const Array& x1, Scalar x2);
 Array Subtract(Scalar x1, const Array& x2);
+Array Subtract(const Array& x1, const Array& x2, const Array& out);
+Array Subtract(const Array& x1, Scalar x2, const Array& out);
 
 namespace internal {
 
@@ -44,6 +52,8 @@ void IMultiply(const Array& x1, Scalar x2);
 Array Multiply(const Array& x1, const Array& x2);
 Array Multiply(const Array& x1, Scalar x2);
 Array Multiply(Scalar x1, const Array& x2);
+Array Multiply(const Array& x1, const Array& x2, const Array& out);
+Array Multiply(const Array& x1, Scalar x2, const Array& out);
 
 namespace internal {
 
@@ -60,6 +70,8 @@ void IDivide(const Array& x1, Scalar x2);
 Array Divide(const Array& x1, const Array& x2);
 Array Divide(const Array& x1, Scalar x2);
 Array Divide(Scalar x1, const Array& x2);
+Array Divide(const Array& x1, const Array& x2, const Array& out);
+Array Divide(const Array& x1, Scalar x2, const Array& out);
 
 // TODO(imanishi): Support bool
 Array FloorDivide(const Array& x1, const Array& x2);
@@ -73,6 +85,7 @@ Array TrueDivide(Scalar x1, const Array& x2);
 Array Reciprocal(const Array& x);
 
 Array Sum(const Array& a, const OptionalAxes& axis = nonstd::nullopt, bool keepdims = false);
+Array Sum(const Array& a, const OptionalAxes& axis, bool keepdims, const Array& out);
 // TODO(niboshi): Move to statistics routines
 Array AMax(const Array& a, const OptionalAxes& axis = nonstd::nullopt, bool keepdims = false);
 
@@ -83,7 +96,9 @@ Array Minimum(const Array& x1, Scalar x2);
 Array Minimum(Scalar x1, const Array& x2);
 
 Array Exp(const Array& x);
+Array Exp(const Array& x, const Array& out);
 Array Log(const Array& x);
+Array Log(const Array& x, const Array& out);
 
 // Returns the LogSumExp (LSE) of x, reduced along the specified axes.
 // If no axes are specified, all axes will be reduced.
@@ -94,11 +109,13 @@ Array LogSumExp(const Array& x, const OptionalAxes& axis = nonstd::nullopt, bool
 Array LogSoftmax(const Array& x, const OptionalAxes& axis = nonstd::nullopt);
 
 Array Sqrt(const Array& x);
+Array Sqrt(const Array& x, const Array& out);
 
 Array IsNan(const Array& x);
 
 Array IsInf(const Array& x);
 
 Array Tanh(const Array& x);
+Array Tanh(const Array& x, const Array& out);
 
 }  // namespace chainerx
@@ -390,6 +390,76 @@ TEST_THREAD_SAFE_P(MathTest, AddScalarArray) {
     Run([&]() { testing::CheckForward([&b](const std::vector<Array>& xs) { return std::vector<Array>{Add(b, xs[0])}; }, {a}, {e}); });
 }
 
+TEST_P(MathTest, AddOut) {
+    Array a = testing::BuildArray({3, 2}).WithLinearData<float>();
+    Array b = testing::BuildArray({2}).WithData<float>({1, 2});
+    Array out = Empty({3, 2}, Dtype::kFloat32);
+    Array e = testing::BuildArray({3, 2}).WithData<float>({1, 3, 3, 5, 5, 7});
+
+    Array y = Add(a, b, out);
+    EXPECT_EQ(internal::GetArrayBody(out), internal::GetArrayBody(y));
+    EXPECT_ARRAY_EQ(e, out);
+}
+
+TEST_P(MathTest, AddOutNonContiguous) {
+    Array a = testing::BuildArray({3, 2}).WithLinearData<int32_t>();
+    Array out_base = Zeros({3, 4}, Dtype::kInt32);
+    Array out = out_base.At({Slice{}, Slice{1, 3}});
+    Array e = testing::BuildArray({3, 4}).WithData<int32_t>({0, 2, 3, 0, 0, 4, 5, 0, 0, 6, 7, 0});
+
+    Add(a, Scalar{2}, out);
+    EXPECT_ARRAY_EQ(e, out_base);
+}
+
+TEST_P(MathTest, AddOutIdenticalInput) {
+    Array a = testing::BuildArray({3, 2}).WithLinearData<float>();
+    Array b = testing::BuildArray({3, 2}).WithLinearData<float>(1);
+    Array e = testing::BuildArray({3, 2}).WithLinearData<float>(1, 2);
+
+    Add(a, b, a);
+    EXPECT_ARRAY_EQ(e, a);
+
+    // A different view of the same elements is also allowed.
+    Add(a.MakeView(), Scalar{-1.f}, a);
+    EXPECT_ARRAY_EQ(e - 1, a);
+}
+
+TEST_P(MathTest, AddOutInvalid) {
+    Array a = testing::BuildArray({3, 2}).WithLinearData<float>();
+    Array b = testing::BuildArray({3, 2}).WithLinearData<float>(1);
+    EXPECT_THROW(Add(a, b, Empty({3, 1}, Dtype::kFloat32)), DimensionError);
+    EXPECT_THROW(Add(a, b, Empty({2, 3}, Dtype::kFloat32)), DimensionError);
+    EXPECT_THROW(Add(a, b, Empty({3, 2}, Dtype::kFloat64)), DtypeError);
+
+    // Partially overlapping.
+    Array c = testing::BuildArray({4, 2}).WithLinearData<float>();
+    EXPECT_THROW(Add(c.At({Slice{0, 3}}), b, c.At({Slice{1, 4}})), ChainerxError);
+
+    // Identical to an input requiring grad.
+    Array x = (*testing::BuildArray({3, 2}).WithLinearData<float>()).RequireGrad();
+    EXPECT_THROW(Add(x, b, x), ChainerxError);
+    EXPECT_THROW(Add(x.MakeView(), b, x.AsGradStopped(CopyKind::kView)), ChainerxError);
+
+    // Requiring grad.
+    EXPECT_THROW(Add(a, b, Empty({3, 2}, Dtype::kFloat32).RequireGrad()), ChainerxError);
+}
+
+TEST_P(MathTest, AddOutBackward) {
+    using T = double;
+    Shape shape{2, 3};
+    Array a = (*testing::BuildArray(shape).WithLinearData<T>(-2).WithPadding(1)).RequireGrad();
+    Array b = (*testing::BuildArray({3}).WithData<T>({-6, -4, -2}).WithPadding(2)).RequireGrad();
+    Array go = testing::BuildArray(shape).WithLinearData<T>(-0.1, 0.1).WithPadding(3);
+    Array eps_a = Full(shape, 1e-3, Dtype::kFloat64);
+    Array eps_b = Full({3}, 1e-3, Dtype::kFloat64);
+
+    CheckBackward(
+            [&shape](const std::vector<Array>& xs) -> std::vector<Array> { return {Add(xs[0], xs[1], Empty(shape, Dtype::kFloat64))}; },
+            {a, b},
+            {go},
+            {eps_a, eps_b});
+}
+
 TEST_P(MathTest, AddBackward) {
     using T = double;
     Shape shape{2, 3};
@@ -717,6 +787,36 @@ TEST_THREAD_SAFE_P(MathTest, MultiplyScalarArray) {
     Run([&]() { testing::CheckForward([&b](const std::vector<Array>& xs) { return std::vector<Array>{Multiply(b, xs[0])}; }, {a}, {e}); });
 }
 
+TEST_P(MathTest, MultiplyOut) {
+    Array a = testing::BuildArray({3, 1}).WithData<int32_t>({1, 2, 3});
+    Array b = testing::BuildArray({1, 2}).WithData<int32_t>({1, 2});
+    Array out = Empty({3, 2}, Dtype::kInt32);
+    Array e = testing::BuildArray({3, 2}).WithData<int32_t>({1, 2, 2, 4, 3, 6});
+
+    Multiply(a, b, out);
+    EXPECT_ARRAY_EQ(e, out);
+
+    Multiply(out, Scalar{3}, out);
+    EXPECT_ARRAY_EQ(e * 3, out);
+}
+
+TEST_P(MathTest, MultiplyOutBackward) {
+    using T = double;
+    Shape shape{2, 3};
+    Array a = (*testing::BuildArray(shape).WithLinearData<T>(-2).WithPadding(1)).RequireGrad();
+    Array b = (*testing::BuildArray(shape).WithData<T>({-6, -4, -2, 2, 4, 6}).WithPadding(2)).RequireGrad();
+    Array go = testing::BuildArray(shape).WithLinearData<T>(-0.1, 0.1).WithPadding(3);
+    Array eps = Full(shape, 1e-3, Dtype::kFloat64);
+
+    CheckBackward(
+            [&shape](const std::vector<Array>& xs) -> std::vector<Array> {
+                return {Multiply(xs[0], xs[1], Empty(shape, Dtype::kFloat64))};
+            },
+            {a, b},
+            {go},
+            {eps, eps});
+}
+
 TEST_P(MathTest, MultiplyBackward) {
     using T = double;
     Shape shape{2, 3};
@@ -881,6 +981,30 @@ TEST_P(MathTest, DivideScalarInteger) {
     testing::CheckForward([](const std::vector<Array>& xs) { return std::vector<Array>{Divide(xs[0], Scalar{2})}; }, {a}, {e});
 }
 
+TEST_P(MathTest, DivideOut) {
+    Array a = testing::BuildArray({3}).WithData<double>({1, 2, 3});
+    Array b = testing::BuildArray({3}).WithData<double>({2, 4, 2});
+    Array out = Empty({3}, Dtype::kFloat64);
+
+    Divide(a, b, out);
+    EXPECT_ARRAY_EQ(testing::BuildArray({3}).WithData<double>({0.5, 0.5, 1.5}), out);
+
+    Divide(a, Scalar{4.0}, out);
+    EXPECT_ARRAY_EQ(testing::BuildArray({3}).WithData<double>({0.25, 0.5, 0.75}), out);
+}
+
+TEST_P(MathTest, DivideOutInteger) {
+    Array a = testing::BuildArray({3}).WithData<int32_t>({1, 2, 3});
+    Array b = testing::BuildArray({3}).WithData<int32_t>({2, 4, 2});
+
+    Array out = Empty({3}, Dtype::kFloat64);
+    Divide(a, b, out);
+    EXPECT_ARRAY_EQ(testing::BuildArray({3}).WithData<double>({0.5, 0.5, 1.5}), out);
+
+    // True division of integers results in float64.
+    EXPECT_THROW(Divide(a, b, Empty({3}, Dtype::kInt32)), DtypeError);
+}
+
 TEST_P(MathTest, DivideBackward) {
     using T = double;
     Shape shape{2, 3};
@@ -1125,6 +1249,43 @@ TEST_P(MathTest, InvalidSumOutOfRangeAxes) {
     EXPECT_THROW(Sum(a, Axes{3}), DimensionError);
 }
 
+TEST_P(MathTest, SumOut) {
+    using T = float;
+
+    Array a = testing::BuildArray({2, 3, 4, 3}).WithLinearData<T>().WithPadding(1);
+    Array out = Empty({2}, Dtype::kFloat32);
+    Array e = testing::BuildArray({2}).WithData<T>({630.0f, 1926.0f});
+
+    Sum(a, Axes{2, 1, -1}, false, out);
+    EXPECT_ARRAY_EQ(e, out);
+
+    Array out_keepdims = Empty({2, 1, 1, 1}, Dtype::kFloat32);
+    Sum(a, Axes{2, 1, -1}, true, out_keepdims);
+    EXPECT_ARRAY_EQ(e.Reshape({2, 1, 1, 1}), out_keepdims);
+}
+
+TEST_P(MathTest, SumOutInvalid) {
+    Array a = testing::BuildArray({2, 3}).WithLinearData<int32_t>();
+    EXPECT_THROW(Sum(a, Axes{1}, false, Empty({2, 1}, Dtype::kInt64)), DimensionError);
+    // Integers are summed in int64.
+    EXPECT_THROW(Sum(a, Axes{1}, false, Empty({2}, Dtype::kInt32)), DtypeError);
+    // Elements of the output are not computed elementwise from the input.
+    Array b = testing::BuildArray({2, 2}).WithLinearData<int64_t>();
+    EXPECT_THROW(Sum(b, Axes{1}, true, b.At({Slice{}, Slice{0, 1}})), ChainerxError);
+}
+
+TEST_P(MathTest, SumOutBackward) {
+    using T = double;
+
+    CheckBackward(
+            [](const std::vector<Array>& xs) -> std::vector<Array> {
+                return {Sum(xs[0], Axes{1, 3}, false, Empty({2, 4}, Dtype::kFloat64))};
+            },
+            {(*testing::BuildArray({2, 3, 4, 3}).WithLinearData<T>().WithPadding(1)).RequireGrad()},
+            {testing::BuildArray({2, 4}).WithLinearData<T>(-0.1, 0.1)},
+            {Full({2, 3, 4, 3}, 1e-1, Dtype::kFloat64)});
+}
+
 TEST_P(MathTest, SumBackward) {
     using T = double;
 
@@ -1386,6 +1547,36 @@ TEST_THREAD_SAFE_P(MathTest, Exp) {
     Run([&]() { testing::CheckForward([](const std::vector<Array>& xs) { return std::vector<Array>{Exp(xs[0])}; }, {a}, {e}); });
 }
 
+TEST_P(MathTest, ExpOut) {
+    Array a = testing::BuildArray({3}).WithData<float>({0.f, 1.f, std::log(3.f)});
+    Array e = testing::BuildArray({3}).WithData<float>({1.f, std::exp(1.f), 3.f});
+
+    Array out = Empty({3}, Dtype::kFloat32);
+    Exp(a, out);
+    EXPECT_ARRAY_ALL_CLOSE(e, out);
+
+    Exp(a, a);
+    EXPECT_ARRAY_ALL_CLOSE(e, a);
+
+    // Integers result in float32.
+    Array i = testing::BuildArray({3}).WithData<int32_t>({0, 1, 2});
+    EXPECT_THROW(Exp(i, i), DtypeError);
+}
+
+TEST_P(MathTest, ExpOutBackward) {
+    using T = double;
+    Shape shape{2, 3};
+    Array a = (*testing::BuildArray(shape).WithLinearData<T>().WithPadding(1)).RequireGrad();
+    Array go = testing::BuildArray(shape).WithLinearData<T>(-0.1, 0.1).WithPadding(1);
+    Array eps = Full(shape, 1e-3, Dtype::kFloat64);
+
+    CheckBackward(
+            [&shape](const std::vector<Array>& xs) -> std::vector<Array> { return {Exp(xs[0], Empty(shape, Dtype::kFloat64))}; },
+            {a},
+            {go},
+            {eps});
+}
+
 TEST_P(MathTest, ExpBackward) {
     using T = double;
     Shape shape{2, 3};
@@ -12,6 +12,7 @@
 #include "chainerx/check_backward.h"
 #include "chainerx/constant.h"
 #include "chainerx/device_id.h"
+#include "chainerx/dtype.h"
 #include "chainerx/error.h"
 #include "chainerx/shape.h"
 #include "chainerx/stack_vector.h"
@@ -380,6 +381,34 @@ TEST_P(PoolingTest, MaxPoolNoCoverAllBackward) {
             1e-3);
 }
 
+TEST_P(PoolingTest, MaxPool3dBackward) {
+    using T = double;
+
+    Shape x_shape{2, 3, 5, 4, 6};
+    StackVector<int64_t, kMaxNdim> kernel_size{2, 3, 2};
+    StackVector<int64_t, kMaxNdim> stride{2, 1, 3};
+    StackVector<int64_t, kMaxNdim> pad{1, 1, 0};
+
+    // Distinct values in no particular order, so that the maxima are well separated from the other elements.
+    std::vector<T> data;
+    int64_t total_size = x_shape.GetTotalSize();
+    for (int64_t i = 0; i < total_size; ++i) {
+        data.emplace_back(static_cast<T>(i * 97 % total_size) / 100);
+    }
+    Array x = (*testing::BuildArray(x_shape).WithData<T>(data)).RequireGrad();
+    Array go = testing::BuildArray({2, 3, 3, 4, 2}).WithLinearData<T>(-0.1, 0.1).WithPadding(1);
+    Array eps = Full(x.shape(), 1e-3, Dtype::kFloat64);
+
+    CheckBackward(
+            [&](const std::vector<Array>& xs) -> std::vector<Array> { return {MaxPool(xs[0], kernel_size, stride, pad, false)}; },
+            {x},
+            {go},
+            {eps},
+            2U,
+            1e-6,
+            1e-3);
+}
+
 TEST_P(PoolingTest, MaxPoolDoubleBackward) {
     using T = float;
 
@@ -636,6 +665,53 @@ TEST_THREAD_SAFE_P(PoolingTest, AveragePoolPadModeZero) {
     });
 }
 
+// The kernel covers each image, which is the global average pooling.
+TEST_THREAD_SAFE_P(PoolingTest, AveragePoolGlobal) {
+    using T = float;
+
+    Shape x_shape{2, 3, 4, 5};
+    StackVector<int64_t, kMaxNdim> kernel_size{4, 5};
+    StackVector<int64_t, kMaxNdim> stride{1, 2};
+    StackVector<int64_t, kMaxNdim> pad{0, 0};
+
+    Array x = testing::BuildArray(x_shape).WithLinearData<T>(-1.f, 0.25f).WithPadding(1);
+    Array e_out = testing::BuildArray({2, 3, 1, 1}).WithData<T>({1.375f, 6.375f, 11.375f, 16.375f, 21.375f, 26.375f});
+
+    Run([&]() {
+        testing::CheckForward(
+                [&kernel_size, &stride, &pad](const std::vector<Array>& xs) {
+                    return std::vector<Array>{AveragePool(xs[0], kernel_size, stride, pad, AveragePoolPadMode::kZero),
+                                              AveragePool(xs[0], kernel_size, stride, pad, AveragePoolPadMode::kIgnore)};
+                },
+                {x},
+                {e_out, e_out});
+    });
+}
+
+TEST_P(PoolingTest, AveragePoolGlobalBackward) {
+    using T = float;
+
+    Shape x_shape{2, 3, 4, 5};
+    StackVector<int64_t, kMaxNdim> kernel_size{4, 5};
+    StackVector<int64_t, kMaxNdim> stride{1, 1};
+    StackVector<int64_t, kMaxNdim> pad{0, 0};
+
+    Array x = (*testing::BuildArray(x_shape).WithLinearData<T>(-1.f, 0.25f).WithPadding(1)).RequireGrad();
+    Array go = testing::BuildArray({2, 3, 1, 1}).WithLinearData(-0.1f, 0.1f).WithPadding(1);
+    Array eps = Full(x.shape(), 1e-3f);
+
+    CheckBackward(
+            [&](const std::vector<Array>& xs) -> std::vector<Array> {
+                return {AveragePool(xs[0], kernel_size, stride, pad, AveragePoolPadMode::kZero)};
+            },
+            {x},
+            {go},
+            {eps},
+            2U,
+            1e-6,
+            1e-3);
+}
+
 TEST_P(PoolingTest, AveragePoolInvalidKernelSize) {
     int64_t batch_size = 3;
     int64_t channels = 4;
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <memory>
+#include <tuple>
 
 #include "chainerx/array.h"
+#include "chainerx/device.h"
+#include "chainerx/dtype.h"
 #include "chainerx/error.h"
+#include "chainerx/shape.h"
+#include "chainerx/strides.h"
 
 namespace chainerx {
 namespace internal {
@@ -37,6 +43,51 @@ inline void CheckNoUnsafeInplace(const Array& out, std::initializer_list<std::re
     }
 }
 
+// Returns true if the arrays may have an element in common.
+inline bool MayShareMemory(const Array& a, const Array& b) {
+    if (a.data() != b.data() || a.GetTotalSize() == 0 || b.GetTotalSize() == 0) {
+        return false;
+    }
+    std::tuple<int64_t, int64_t> a_range = GetDataRange(a.shape(), a.strides(), a.GetItemSize());
+    std::tuple<int64_t, int64_t> b_range = GetDataRange(b.shape(), b.strides(), b.GetItemSize());
+    return a.offset() + std::get<0>(a_range) < b.offset() + std::get<1>(b_range) &&
+           b.offset() + std::get<0>(b_range) < a.offset() + std::get<1>(a_range);
+}
+
+// Returns true if the arrays are views of the same elements in the same layout.
+inline bool IsSameView(const Array& a, const Array& b) {
+    return a.data() == b.data() && a.offset() == b.offset() && a.shape() == b.shape() && a.strides() == b.strides();
+}
+
+// Checks an output array given to a routine, in addition to the checks of CheckNoUnsafeInplace.
+// The output array must have the given shape and dtype, and be on the given device. It must not overlap any input array in memory, except
+// that inputs identical to the output are allowed if allow_identical is true, which is safe for elementwise routines, and if the input is
+// not to be backpropped, since the input may be retained for the backward computation.
+inline void CheckOutArray(
+        const Array& out,
+        const Shape& shape,
+        Dtype dtype,
+        Device& device,
+        std::initializer_list<std::reference_wrapper<const Array>> inputs,
+        bool allow_identical) {
+    if (out.shape() != shape) {
+        throw DimensionError{"Output array has shape ", out.shape(), " but the result has shape ", shape, "."};
+    }
+    if (out.dtype() != dtype) {
+        throw DtypeError{"Output array has dtype ", out.dtype(), " but the result has dtype ", dtype, "."};
+    }
+    if (&out.device() != &device) {
+        throw DeviceError{"Output array is on device ", out.device().name(), " but the inputs are on device ", device.name(), "."};
+    }
+    for (const Array& input : inputs) {
+        bool identical_allowed = allow_identical && IsSameView(out, input) && !input.IsBackpropRequired(AnyGraph{});
+        if (MayShareMemory(out, input) && !identical_allowed) {
+            throw ChainerxError{"Output array must not overlap the input arrays in memory."};
+        }
+    }
+    CheckNoUnsafeInplace(out, inputs);
+}
+
 // Makes view of output arrays of ForwardBackward implementations to avoid cyclic references since ForwardBackward may internally capture
 // the output arrays.
 template <size_t N>
@@ -1,5 +1,8 @@
 #include "chainerx/routines/statistics.h"
 
+#include <algorithm>
+#include <cstdint>
+
 #include "chainerx/array.h"
 #include "chainerx/axes.h"
 
@@ -9,8 +12,26 @@
 #include "chainerx/backward_context.h"
 #include "chainerx/macro.h"
 #include "chainerx/routines/creation.h"
+#include "chainerx/shape.h"
 
 namespace chainerx {
+namespace {
+
+// Broadcasts the gradient of a reduction to the shape of its input.
+Array BroadcastReducedGrad(const Array& gout, const Axes& sorted_axis, const Shape& in_shape, bool keepdims) {
+    CHAINERX_ASSERT(std::is_sorted(sorted_axis.begin(), sorted_axis.end()));
+
+    if (!(in_shape.ndim() == 0 || sorted_axis.empty() || keepdims)) {
+        Shape out_shape_broadcastable = gout.shape();
+        for (auto axis : sorted_axis) {
+            out_shape_broadcastable.insert(out_shape_broadcastable.begin() + axis, 1);
+        }
+        return gout.Reshape(out_shape_broadcastable).BroadcastTo(in_shape);
+    }
+    return gout.BroadcastTo(in_shape);
+}
+
+}  // namespace
 
 Array Mean(const Array& a, const OptionalAxes& axis, bool keepdims) {
     Axes sorted_axis = internal::GetSortedAxesOrAll(axis, a.ndim());
@@ -19,25 +40,13 @@ Array Mean(const Array& a, const OptionalAxes& axis, bool keepdims) {
 
     {
         NoBackpropModeScope scope{};
-        a.device().Sum(a, sorted_axis, out);
-        a.device().DivideAS(out, n, out);
+        a.device().Mean(a, sorted_axis, out);
     }
 
     BackwardBuilder bb{"mean", a, out};
     if (BackwardBuilder::Target bt = bb.CreateTarget(0)) {
         bt.Define([n, sorted_axis, in_shape = a.shape(), keepdims](BackwardContext& bctx) {
-            const Array& gout = *bctx.output_grad();
-            CHAINERX_ASSERT(std::is_sorted(sorted_axis.begin(), sorted_axis.end()));
-
-            if (!(in_shape.ndim() == 0 || sorted_axis.empty() || keepdims)) {
-                Shape out_shape_broadcastable = gout.shape();
-                for (auto axis : sorted_axis) {
-                    out_shape_broadcastable.insert(out_shape_broadcastable.begin() + axis, 1);
-                }
-                bctx.input_grad() = gout.Reshape(out_shape_broadcastable).BroadcastTo(in_shape) / n;
-            } else {
-                bctx.input_grad() = gout.BroadcastTo(in_shape) / n;
-            }
+            bctx.input_grad() = BroadcastReducedGrad(*bctx.output_grad(), sorted_axis, in_shape, keepdims) / n;
         });
     }
     bb.Finalize();
@@ -46,10 +55,28 @@ Array Mean(const Array& a, const OptionalAxes& axis, bool keepdims) {
 }
 
 Array Var(const Array& a, const OptionalAxes& axis, bool keepdims) {
-    // TODO(hvy): Consider allowing device implementations.
     Axes sorted_axis = internal::GetSortedAxesOrAll(axis, a.ndim());
-    Array diff = a - Mean(a, sorted_axis, true);
-    return Mean(diff * diff, sorted_axis, keepdims);
+    Array out = internal::EmptyReduced(a.shape(), a.dtype(), sorted_axis, keepdims, a.device());
+    int64_t n = internal::CountItemsAlongAxes(a.shape(), sorted_axis);
+
+    {
+        NoBackpropModeScope scope{};
+        a.device().Var(a, sorted_axis, out);
+    }
+
+    BackwardBuilder bb{"var", a, out};
+    if (BackwardBuilder::Target bt = bb.CreateTarget(0)) {
+        bt.Define([a_tok = bb.RetainInput(0), n, sorted_axis, in_shape = a.shape(), keepdims](BackwardContext& bctx) {
+            const Array& a = bctx.GetRetainedInput(a_tok);
+            // The gradient is 2 * (a - mean) / n, since the deviations sum to zero and the terms through the mean cancel out.
+            // The mean is recomputed from the retained input so that the gradient is differentiable again.
+            Array diff = a - Mean(a, sorted_axis, true);
+            bctx.input_grad() = BroadcastReducedGrad(*bctx.output_grad(), sorted_axis, in_shape, keepdims) * diff * (2.0 / n);
+        });
+    }
+    bb.Finalize();
+
+    return out;
 }
 
 }  // namespace chainerx
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "chainerx/macro.h"
+
+namespace chainerx {
+
+template <typename Signature, size_t InlineSize>
+class SmallFunction;
+
+// Copyable function wrapper similar to std::function, that stores callables of up to InlineSize bytes in itself instead of on the heap.
+// Larger callables, and those that may throw on move, are stored on the heap.
+// Not all features in std::function are implemented.
+template <typename R, typename... Args, size_t InlineSize>
+class SmallFunction<R(Args...), InlineSize> {
+public:
+    SmallFunction() = default;
+
+    SmallFunction(std::nullptr_t) {}  // NOLINT(google-explicit-constructor)
+
+    template <typename F, typename = std::enable_if_t<!std::is_same<std::decay_t<F>, SmallFunction>::value>>
+    SmallFunction(F&& func) {  // NOLINT(google-explicit-constructor, bugprone-forwarding-reference-overload)
+        using Callable = std::decay_t<F>;
+        using IsInlineType = std::integral_constant<bool, IsInline<Callable>()>;
+        Emplace<Callable>(std::forward<F>(func), IsInlineType{});
+        ops_ = GetOps<Callable>(IsInlineType{});
+    }
+
+    SmallFunction(const SmallFunction& other) : ops_{other.ops_} {
+        if (ops_ != nullptr) {
+            ops_->copy(&storage_, &other.storage_);
+        }
+    }
+
+    SmallFunction(SmallFunction&& other) noexcept : ops_{other.ops_} {
+        if (ops_ != nullptr) {
+            ops_->move(&storage_, &other.storage_);
+            other.ops_ = nullptr;
+        }
+    }
+
+    SmallFunction& operator=(const SmallFunction& other) {
+        if (this != &other) {
+            SmallFunction copy{other};
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    SmallFunction& operator=(SmallFunction&& other) noexcept {
+        if (this != &other) {
+            Reset();
+            if (other.ops_ != nullptr) {
+                other.ops_->move(&storage_, &other.storage_);
+                ops_ = other.ops_;
+                other.ops_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    ~SmallFunction() { Reset(); }
+
+    R operator()(Args... args) const {
+        CHAINERX_ASSERT(ops_ != nullptr);
+        return ops_->invoke(const_cast<void*>(static_cast<const void*>(&storage_)), std::forward<Args>(args)...);
+    }
+
+    explicit operator bool() const { return ops_ != nullptr; }
+
+private:
+    struct Ops {
+        R (*invoke)(void* storage, Args&&... args);
+        void (*copy)(void* dst, const void* src);
+        // Moves the callable and destroys the source.
+        void (*move)(void* dst, void* src) noexcept;
+        void (*destroy)(void* storage) noexcept;
+    };
+
+    template <typename Callable>
+    static constexpr bool IsInline() {
+        return sizeof(Callable) <= InlineSize && alignof(Callable) <= alignof(std::max_align_t) &&
+               std::is_nothrow_move_constructible<Callable>::value;
+    }
+
+    template <typename Callable, typename F>
+    void Emplace(F&& func, std::true_type /*is_inline*/) {
+        new (&storage_) Callable(std::forward<F>(func));
+    }
+
+    template <typename Callable, typename F>
+    void Emplace(F&& func, std::false_type /*is_inline*/) {
+        new (&storage_) Callable*(new Callable(std::forward<F>(func)));
+    }
+
+    template <typename Callable>
+    static const Ops* GetOps(std::true_type /*is_inline*/) {
+        static const Ops kOps{
+                [](void* storage, Args&&... args) -> R { return (*static_cast<Callable*>(storage))(std::forward<Args>(args)...); },
+                [](void* dst, const void* src) { new (dst) Callable(*static_cast<const Callable*>(src)); },
+                [](void* dst, void* src) noexcept {
+                    new (dst) Callable(std::move(*static_cast<Callable*>(src)));
+                    static_cast<Callable*>(src)->~Callable();
+                },
+                [](void* storage) noexcept { static_cast<Callable*>(storage)->~Callable(); }};
+        return &kOps;
+    }
+
+    template <typename Callable>
+    static const Ops* GetOps(std::false_type /*is_inline*/) {
+        static const Ops kOps{
+                [](void* storage, Args&&... args) -> R { return (**static_cast<Callable**>(storage))(std::forward<Args>(args)...); },
+                [](void* dst, const void* src) { new (dst) Callable*(new Callable(**static_cast<Callable* const*>(src))); },
+                [](void* dst, void* src) noexcept { new (dst) Callable*(*static_cast<Callable**>(src)); },
+                [](void* storage) noexcept { delete *static_cast<Callable**>(storage); }};
+        return &kOps;
+    }
+
+    void Reset() noexcept {
+        if (ops_ != nullptr) {
+            ops_->destroy(&storage_);
+            ops_ = nullptr;
+        }
+    }
+
+    std::aligned_storage_t<(InlineSize < sizeof(void*) ? sizeof(void*) : InlineSize), alignof(std::max_align_t)> storage_;
+    const Ops* ops_{nullptr};
+};
+
+}  // namespace chainerx
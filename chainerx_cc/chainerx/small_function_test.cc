@@ -0,0 +1,83 @@
+#include "chainerx/small_function.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+namespace chainerx {
+namespace {
+
+using Function = SmallFunction<int(int), 32>;
+
+TEST(SmallFunctionTest, Empty) {
+    Function func{};
+    EXPECT_FALSE(static_cast<bool>(func));
+
+    Function null_func{nullptr};
+    EXPECT_FALSE(static_cast<bool>(null_func));
+}
+
+TEST(SmallFunctionTest, Call) {
+    Function func = [](int x) { return x + 1; };
+    ASSERT_TRUE(static_cast<bool>(func));
+    EXPECT_EQ(3, func(2));
+}
+
+TEST(SmallFunctionTest, ReferenceArgument) {
+    SmallFunction<void(int&), 32> func = [](int& x) { x *= 2; };
+    int value = 3;
+    func(value);
+    EXPECT_EQ(6, value);
+}
+
+TEST(SmallFunctionTest, MutableCallable) {
+    Function func = [count = 0](int x) mutable { return x + ++count; };
+    EXPECT_EQ(1, func(0));
+    EXPECT_EQ(2, func(0));
+}
+
+// The captured shared_ptr tracks the copies of the callable.
+template <size_t N>
+void CheckCopyAndMove() {
+    auto captured = std::make_shared<int>(10);
+    std::array<int64_t, N> padding{};
+    Function func = [captured, padding](int x) { return *captured + x + static_cast<int>(padding[0]); };
+    EXPECT_EQ(2, captured.use_count());
+
+    {
+        Function copied{func};
+        EXPECT_EQ(3, captured.use_count());
+        EXPECT_EQ(11, copied(1));
+        EXPECT_EQ(12, func(2));
+
+        Function moved{std::move(copied)};
+        EXPECT_EQ(3, captured.use_count());
+        EXPECT_FALSE(static_cast<bool>(copied));  // NOLINT(bugprone-use-after-move)
+        EXPECT_EQ(13, moved(3));
+
+        Function assigned{};
+        assigned = moved;
+        EXPECT_EQ(4, captured.use_count());
+        assigned = std::move(moved);
+        EXPECT_EQ(3, captured.use_count());
+        EXPECT_EQ(14, assigned(4));
+
+        assigned = [](int x) { return x; };
+        EXPECT_EQ(2, captured.use_count());
+        EXPECT_EQ(5, assigned(5));
+    }
+    EXPECT_EQ(2, captured.use_count());
+
+    func = nullptr;
+    EXPECT_EQ(1, captured.use_count());
+}
+
+TEST(SmallFunctionTest, CopyAndMoveInline) { CheckCopyAndMove<1>(); }
+
+TEST(SmallFunctionTest, CopyAndMoveHeap) { CheckCopyAndMove<16>(); }
+
+}  // namespace
+}  // namespace chainerx
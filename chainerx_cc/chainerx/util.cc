@@ -1,10 +1,13 @@
 #include "chainerx/util.h"
 
+#include <cstddef>
 #include <cstdlib>
+#include <exception>
 #include <string>
 
 #include <nonstd/optional.hpp>
 
+#include "chainerx/error.h"
 #include "chainerx/platform.h"
 
 namespace chainerx {
@@ -16,6 +19,24 @@ nonstd::optional<std::string> GetEnv(const std::string& name) {
     return nonstd::nullopt;  // No matching environment variable.
 }
 
+nonstd::optional<int> GetEnvInt(const std::string& name) {
+    nonstd::optional<std::string> env = GetEnv(name);
+    if (!env) {
+        return nonstd::nullopt;
+    }
+    size_t pos{};
+    int value{};
+    try {
+        value = std::stoi(*env, &pos);
+    } catch (const std::exception&) {
+        throw ChainerxError{"Environment variable ", name, " must be an integer: ", *env};
+    }
+    if (pos != env->size()) {
+        throw ChainerxError{"Environment variable ", name, " must be an integer: ", *env};
+    }
+    return value;
+}
+
 void SetEnv(const std::string& name, const std::string& value) { platform::SetEnv(name, value); }
 
 void UnsetEnv(const std::string& name) { platform::UnsetEnv(name); }
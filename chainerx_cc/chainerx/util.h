@@ -8,6 +8,10 @@ namespace chainerx {
 
 nonstd::optional<std::string> GetEnv(const std::string& name);
 
+// Returns the value of the environment variable parsed as an integer, or nullopt if it is not set.
+// Throws ChainerxError if the value is not an integer.
+nonstd::optional<int> GetEnvInt(const std::string& name);
+
 void SetEnv(const std::string& name, const std::string& value);
 
 void UnsetEnv(const std::string& name);
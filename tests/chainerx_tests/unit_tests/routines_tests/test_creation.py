@@ -1149,3 +1149,14 @@ def test_copy(xp, shape, dtype, device, is_module):
         return xp.copy(a)
     else:
         return a.copy()
+
+
+@chainerx.testing.numpy_chainerx_array_equal()
+@pytest.mark.parametrize('src_shape', [(3,), (2, 3), (2, 1)])
+@pytest.mark.parametrize('src_dtype', ['int32', 'float32', 'float64'])
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_copyto(xp, device, src_shape, src_dtype):
+    src = array_utils.create_dummy_ndarray(xp, src_shape, src_dtype)
+    dst = xp.zeros((2, 3), 'float32')
+    xp.copyto(dst, src)
+    return dst
@@ -87,3 +87,96 @@ def test_dot_invalid(is_module, xp, device, a_shape, b_shape, dtype):
         return xp.dot(a, b)
     else:
         return a.dot(b)
+
+
+@chainerx.testing.numpy_chainerx_array_equal()
+@pytest.mark.parametrize('a_shape,b_shape', [
+    ((2, 3), (3, 4)),
+    ((2, 3), (3,)),
+    ((2, 0), (0, 3)),
+    ((2, 3), ()),
+])
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_dot_out(xp, device, a_shape, b_shape):
+    a = array_utils.create_dummy_ndarray(xp, a_shape, 'float32')
+    b = array_utils.create_dummy_ndarray(xp, b_shape, 'float32')
+    out_shape = xp.dot(a, b).shape
+    out = xp.full(out_shape, 7, 'float32')
+    y = xp.dot(a, b, out=out)
+    assert y is out
+    return out
+
+
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_dot_out_invalid(device):
+    a = chainerx.ones((2, 2), 'float32')
+    b = chainerx.ones((2, 2), 'float32')
+    with pytest.raises(chainerx.DtypeError):
+        chainerx.dot(a, b, out=chainerx.empty((2, 2), 'float64'))
+    # The output must not overlap the inputs.
+    with pytest.raises(chainerx.ChainerxError):
+        chainerx.dot(a, b, out=a)
+
+
+@op_utils.op_test(['native:0', 'cuda:0'])
+@chainer.testing.parameterize_pytest('a_shape,b_shape', [
+    ((2, 3), (3, 4)),
+    ((3,), (3, 4)),
+    ((2, 3), (3,)),
+    ((5, 2, 3), (5, 3, 4)),
+    ((5, 2, 3), (3, 4)),
+    ((2, 1, 2, 3), (4, 3, 2)),
+    ((0, 2, 3), (3, 4)),
+])
+@chainer.testing.parameterize_pytest(
+    'in_dtypes,chx_expected_dtype', dtype_utils.result_dtypes_two_arrays)
+class TestMatmul(op_utils.NumpyOpTest):
+
+    def setup(self):
+        device = chainerx.get_default_device()
+        a_dtype, b_dtype = self.in_dtypes
+        a_kind = numpy.dtype(a_dtype).kind
+        b_kind = numpy.dtype(b_dtype).kind
+        if device.name == 'cuda:0' and (a_kind != 'f' and b_kind != 'f'):
+            pytest.skip('non-float matmul is not supported on CUDA')
+
+        # Skip backward/double-backward tests for int dtypes
+        if a_kind != 'f' or b_kind != 'f':
+            self.skip_backward_test = True
+            self.skip_double_backward_test = True
+
+        if a_dtype == 'float16' or b_dtype == 'float16':
+            self.check_forward_options.update({
+                'rtol': 1e-2, 'atol': 1e-2})
+            self.check_backward_options.update({
+                'rtol': 1e-2, 'atol': 1e-2})
+            self.check_double_backward_options.update({
+                'rtol': 1e-2, 'atol': 1e-2})
+
+    def generate_inputs(self):
+        a_dtype, b_dtype = self.in_dtypes
+        a = numpy.random.uniform(-1, 1, self.a_shape).astype(a_dtype)
+        b = numpy.random.uniform(-1, 1, self.b_shape).astype(b_dtype)
+        return a, b
+
+    def forward_xp(self, inputs, xp):
+        a, b = inputs
+        y = xp.matmul(a, b)
+        y = dtype_utils.cast_if_numpy_array(xp, y, self.chx_expected_dtype)
+        return y,
+
+
+@chainerx.testing.numpy_chainerx_array_equal(
+    accept_error=(chainerx.DimensionError, ValueError))
+@pytest.mark.parametrize('a_shape,b_shape', [
+    ((), (2, 3)),
+    ((3, 2), (1, 3)),
+    ((2, 2, 3), (3, 3, 2)),
+])
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_matmul_invalid(xp, device, a_shape, b_shape, dtype):
+    if device.name == 'cuda:0' and numpy.dtype(dtype).kind != 'f':
+        return chainerx.testing.ignore()
+    a = array_utils.create_dummy_ndarray(xp, a_shape, dtype)
+    b = array_utils.create_dummy_ndarray(xp, b_shape, dtype)
+    return xp.matmul(a, b)
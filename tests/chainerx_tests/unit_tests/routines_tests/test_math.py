@@ -900,6 +900,27 @@ def test_sum_invalid(is_module, xp, shape, axis, keepdims, dtype):
         a.sum(axis=axis, keepdims=keepdims)
 
 
+@chainerx.testing.numpy_chainerx_array_equal()
+@pytest.mark.parametrize('keepdims', [False, True])
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_sum_out(xp, device, keepdims):
+    a = array_utils.create_dummy_ndarray(xp, (2, 3, 4), 'float32')
+    out = xp.empty((2, 1, 4) if keepdims else (2, 4), 'float32')
+    y = xp.sum(a, axis=1, keepdims=keepdims, out=out)
+    assert y is out
+    return out
+
+
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_sum_out_invalid(device):
+    a = array_utils.create_dummy_ndarray(chainerx, (2, 3), 'int32')
+    with pytest.raises(chainerx.DimensionError):
+        chainerx.sum(a, axis=1, out=chainerx.empty((3,), 'int64'))
+    # Integers are summed in int64.
+    with pytest.raises(chainerx.DtypeError):
+        chainerx.sum(a, axis=1, out=chainerx.empty((2,), 'int32'))
+
+
 # TODO(sonots): Fix type compatibility for when shape is ()
 @chainerx.testing.numpy_chainerx_array_equal(dtype_check=False)
 @pytest.mark.parametrize('shape,value', [
@@ -973,6 +994,53 @@ def test_log(xp, device, input, in_dtype, out_dtype):
     return xp.log(a)
 
 
+@chainerx.testing.numpy_chainerx_allclose()
+@pytest.mark.parametrize('func', ['exp', 'log', 'sqrt', 'tanh'])
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_math_function_out(xp, device, func):
+    a = xp.array([[1, 2, 3], [4, 5, 6]], 'float32')
+    out = xp.empty((2, 3), 'float32')
+    y = getattr(xp, func)(a, out=out)
+    assert y is out
+    return out
+
+
+@chainerx.testing.numpy_chainerx_array_equal()
+@pytest.mark.parametrize('func', ['add', 'subtract', 'multiply', 'divide'])
+@pytest.mark.parametrize('x2_is_scalar', [False, True])
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_binary_out(xp, device, func, x2_is_scalar):
+    x1 = xp.array([[1, 2, 3], [4, 5, 6]], 'float32')
+    x2 = 2.0 if x2_is_scalar else xp.array([4, 2, 1], 'float32')
+    out = xp.empty((2, 3), 'float32')
+    y = getattr(xp, func)(x1, x2, out=out)
+    assert y is out
+    return out
+
+
+@chainerx.testing.numpy_chainerx_array_equal()
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_add_out_identical(xp, device):
+    x1 = xp.array([[1, 2, 3], [4, 5, 6]], 'float32')
+    x2 = xp.array([4, 2, 1], 'float32')
+    xp.add(x1, x2, out=x1)
+    return x1
+
+
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_add_out_invalid(device):
+    x1 = chainerx.ones((2, 3), 'float32')
+    x2 = chainerx.ones((2, 3), 'float32')
+    with pytest.raises(chainerx.DimensionError):
+        chainerx.add(x1, x2, out=chainerx.empty((3, 2), 'float32'))
+    with pytest.raises(chainerx.DtypeError):
+        chainerx.add(x1, x2, out=chainerx.empty((2, 3), 'float64'))
+    # Partially overlapping output.
+    a = chainerx.ones((3, 3), 'float32')
+    with pytest.raises(chainerx.ChainerxError):
+        chainerx.add(a[:2], x2, out=a[1:])
+
+
 _logsumexp_params = [
     ((2,), 0),
     ((2,), -1),
@@ -65,6 +65,31 @@ def test_synchronize():
     device.synchronize()
 
 
+@pytest.mark.parametrize_device(['native:0', 'cuda:0'])
+def test_get_memory_stats(device):
+    device.reset_peak_memory_stats()
+    stats = device.get_memory_stats()
+    a = chainerx.ones((100,), 'float32', device=device)
+    stats2 = device.get_memory_stats()
+    assert stats2['malloc_count'] > stats['malloc_count']
+    assert stats2['bytes_in_use'] >= stats['bytes_in_use'] + a.nbytes
+    assert stats2['peak_bytes_in_use'] >= stats2['bytes_in_use']
+    assert stats2['hit_count'] <= stats2['malloc_count']
+    assert sum(
+        size_class['malloc_count']
+        for size_class in stats2['size_classes'].values()
+    ) == stats2['malloc_count']
+
+    del a
+    stats3 = device.get_memory_stats()
+    assert stats3['bytes_in_use'] < stats2['bytes_in_use']
+    assert stats3['peak_bytes_in_use'] == stats2['peak_bytes_in_use']
+
+    device.reset_peak_memory_stats()
+    stats4 = device.get_memory_stats()
+    assert stats4['peak_bytes_in_use'] == stats4['bytes_in_use']
+
+
 @pytest.mark.usefixtures('cache_restore_device')
 def test_default_device(device_instance1):
     device = device_instance1